@@ -1,4 +1,14 @@
 include(UsePETSc)
+
+# OpenMP parallelizes the BLAS-1 kernels of the vector backends. The flags are
+# only added to all targets if requested, add_dune_openmp_flags() adds them to
+# single targets.
+find_package(OpenMP)
+option(DUNE_PDELAB_ENABLE_OPENMP "Compile with OpenMP to parallelize the BLAS-1 kernels of the vector backends" OFF)
+if(OPENMP_FOUND AND DUNE_PDELAB_ENABLE_OPENMP)
+  set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} ${OpenMP_C_FLAGS}")
+  set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} ${OpenMP_CXX_FLAGS}")
+endif(OPENMP_FOUND AND DUNE_PDELAB_ENABLE_OPENMP)
 message(AUTHOR_WARNING "TODO: Implement Eigen test.")
 
 function(add_dune_petsc_flags)
@@ -27,3 +37,12 @@ function(add_dune_petsc_flags)
 
   endif(PETSC_FOUND)
 endfunction(add_dune_petsc_flags)
+
+function(add_dune_openmp_flags)
+  if(OPENMP_FOUND)
+    foreach(_target ${ARGN})
+      set_property(TARGET ${_target} APPEND_STRING PROPERTY COMPILE_FLAGS " ${OpenMP_CXX_FLAGS}")
+      set_property(TARGET ${_target} APPEND_STRING PROPERTY LINK_FLAGS " ${OpenMP_CXX_FLAGS}")
+    endforeach(_target ${ARGN})
+  endif(OPENMP_FOUND)
+endfunction(add_dune_openmp_flags)
@@ -6,12 +6,17 @@
 
 #include<dune/common/exceptions.hh>
 
+#include<cmath>
+#include<functional>
 #include<limits>
 #include<vector>
 #include<map>
+#include<type_traits>
 #include<unordered_map>
+#include<utility>
 #include<dune/common/dynmatrix.hh>
 #include<dune/geometry/quadraturerules.hh>
+#include<dune/geometry/referenceelements.hh>
 #include<dune/pdelab/gridfunctionspace/genericdatahandle.hh>
 #include<dune/pdelab/gridfunctionspace/localfunctionspace.hh>
 
@@ -132,12 +137,171 @@ namespace Dune {
 
       };
 
+      // The embedding of a cell into the reference element of one of its ancestors,
+      // composed from the geometryInFather() maps of the cells in between. For nested
+      // refinement, it maps local coordinates of the cell to the local coordinates of
+      // the ancestor without inverting the global geometry of the ancestor.
+      template<typename Cell>
+      class NestedEmbedding
+      {
+
+        typedef typename Cell::LocalGeometry LocalGeometry;
+        typedef decltype(std::declval<const Cell&>().father()) CellPointer;
+        typedef typename LocalGeometry::ctype DF;
+        static const int dim = Cell::dimension;
+
+      public:
+
+        typedef typename LocalGeometry::LocalCoordinate Coordinate;
+
+        void update(const Cell& descendant, const Cell& ancestor)
+        {
+          _chain.clear();
+          _affine = true;
+          if (descendant.level() <= ancestor.level())
+            return;
+          push(descendant);
+          CellPointer p = descendant.father();
+          while (p->level() > ancestor.level())
+            {
+              push(*p);
+              p = p->father();
+            }
+        }
+
+        Coordinate global(const Coordinate& x) const
+        {
+          Coordinate y(x);
+          for (typename std::vector<LocalGeometry>::const_iterator it = _chain.begin(); it != _chain.end(); ++it)
+            y = it->global(y);
+          return y;
+        }
+
+        // whether all maps of the chain are affine
+        bool affine() const
+        {
+          return _affine;
+        }
+
+        // the images of the corners of the reference element of type gt as integer
+        // multiples of 2^-dyadic_level; false if a corner is not on this lattice
+        bool dyadicCorners(GeometryType gt, std::vector<long long>& c) const
+        {
+          const ReferenceElement<DF,dim>& ref = ReferenceElements<DF,dim>::general(gt);
+          const DF scale = DF(1L << dyadic_level);
+          c.resize(ref.size(dim) * dim);
+          for (int i = 0; i < ref.size(dim); ++i)
+            {
+              const Coordinate x = global(ref.position(i,dim));
+              for (int k = 0; k < dim; ++k)
+                {
+                  const DF y = x[k] * scale;
+                  const long long n = std::llround(y);
+                  if (std::abs(y - DF(n)) > 1e-6)
+                    return false;
+                  c[i*dim + k] = n;
+                }
+            }
+          return true;
+        }
+
+        // the finest refinement level relative to the ancestor that dyadicCorners() resolves
+        static const int dyadic_level = 20;
+
+        NestedEmbedding()
+          : _affine(true)
+        {}
+
+      private:
+
+        void push(const Cell& e)
+        {
+          _chain.push_back(e.geometryInFather());
+          _affine = _affine && _chain.back().affine();
+        }
+
+        std::vector<LocalGeometry> _chain;
+        bool _affine;
+
+      };
+
+      // Identifies a transfer matrix by the tree leaf, the finite elements on the
+      // coarse and the fine cell and the exact dyadic corners of the fine cell in the
+      // reference element of the coarse cell.
+      struct TransferMatrixKey
+      {
+
+        bool operator<(const TransferMatrixKey& other) const
+        {
+          if (leaf != other.leaf)
+            return leaf < other.leaf;
+          if (coarse_fe != other.coarse_fe)
+            return std::less<const void*>()(coarse_fe,other.coarse_fe);
+          if (fine_fe != other.fine_fe)
+            return std::less<const void*>()(fine_fe,other.fine_fe);
+          return corners < other.corners;
+        }
+
+        std::size_t leaf;
+        const void* coarse_fe;
+        const void* fine_fe;
+        std::vector<long long> corners;
+
+      };
+
+      // Whether the finite element map returns references to finite elements that it
+      // stores, so that their addresses identify them for the lifetime of the map. Maps
+      // that create their finite elements on the fly return them by value.
+      template<typename FEM, typename Cell>
+      struct stores_finite_elements
+        : public std::is_lvalue_reference<decltype(std::declval<const FEM&>().find(std::declval<const Cell&>()))>
+      {};
+
+      // A basis function of the coarse finite element, evaluated on the fine cell.
+      template<typename FiniteElement, typename Embedding>
+      struct coarse_basis_function
+      {
+
+        template<typename X, typename Y>
+        void evaluate(const X& x, Y& y) const
+        {
+          _finite_element.localBasis().evaluateFunction(_embedding.global(x),_phi);
+          y = _phi[_index];
+        }
+
+        coarse_basis_function(const FiniteElement& finite_element, const Embedding& embedding, std::size_t index)
+          : _finite_element(finite_element)
+          , _embedding(embedding)
+          , _index(index)
+        {}
+
+        const FiniteElement& _finite_element;
+        const Embedding& _embedding;
+        mutable std::vector<typename FiniteElement::Traits::LocalBasisType::Traits::RangeType> _phi;
+        std::size_t _index;
+
+      };
+
     } // anonymous namespace
 
 
     /*! @class L2Projection
      *
-     * @brief @todo
+     * @brief Local L2 projection between the finite elements of nested cells.
+     *
+     * Besides the inverse mass matrices of the reference elements, the projection
+     * caches the matrices that transfer the coefficients of a finite element on a
+     * cell to the one on an ancestor (restriction) and back (prolongation). For
+     * nested, affine refinement these matrices only depend on the finite elements
+     * and on the position of the cell in the reference element of the ancestor, so
+     * they are computed once for each child of a reference element and applied as
+     * small dense matrix-vector products during the adaptation.
+     *
+     * The cache identifies finite elements by their address, so it is only used for
+     * finite element maps that return references to stored finite elements, and
+     * positions by the exact dyadic coordinates of the cell corners. Cells that are
+     * not at such a position, e.g. for non-dyadic refinement, as well as non-affine
+     * cells use quadrature and interpolation on the global geometries.
      *
      * @tparam GFS Type of ansatz space
      * @tparam U   Container class for the solution
@@ -149,22 +313,35 @@ namespace Dune {
       typedef typename Grid::template Codim<0>::Entity Element;
       typedef LocalFunctionSpace<GFS> LFS;
       typedef typename U::ElementType DF;
+      typedef typename Grid::ctype ctype;
+      static const int dim = Element::dimension;
+      typedef TransferMatrixKey Key;
 
     public:
 
       typedef DynamicMatrix<typename U::ElementType> MassMatrix;
       typedef array<MassMatrix,TypeTree::TreeInfo<GFS>::leafCount> MassMatrices;
+      typedef DynamicMatrix<typename U::ElementType> TransferMatrix;
 
       /*! @brief The constructor.
        *
-       * @todo Doc params!
+       * @param gfs                     The ansatz space
+       * @param intorder                Quadrature order of the mass and restriction matrices
+       * @param cache_transfer_matrices Whether to use cached transfer matrices where possible
        */
-      explicit L2Projection(const GFS& gfs, int intorder = 2)
+      explicit L2Projection(const GFS& gfs, int intorder = 2, bool cache_transfer_matrices = true)
         : _gfs(gfs)
         , _intorder(intorder)
+        , _cache_transfer_matrices(cache_transfer_matrices)
         , _inverse_mass_matrices(GlobalGeometryTypeIndex::size(Element::dimension))
       {}
 
+      //! Whether the transfer matrices are cached.
+      bool cachesTransferMatrices() const
+      {
+        return _cache_transfer_matrices;
+      }
+
       /*! @brief Calculate the inverse local mass matrix, used in the local L2 projection
        *
        * @todo Doc template params
@@ -189,11 +366,131 @@ namespace Dune {
         return inverse_mass_matrices;
       }
 
+      /*! @brief Matrix of the L2 projection of the fine finite element onto the coarse one.
+       *
+       * The coarse coefficients are R u_fine, where R has coarse_fe.localBasis().size()
+       * rows and fine_fe.localBasis().size() columns. The matrix is only valid if the
+       * embedding and both geometries are affine, and the finite elements must be
+       * stored by their finite element map. Returns nullptr if the fine cell is not
+       * at a dyadic position in the coarse cell.
+       *
+       * @param leaf            Index of the leaf of the function space tree
+       * @param coarse_fe       Finite element on the ancestor
+       * @param fine_fe         Finite element on the descendant
+       * @param embedding       Embedding of the descendant into the ancestor
+       * @param inverse_mass    Inverse mass matrix of coarse_fe
+       * @param intorder        Quadrature order on the descendant
+       * @param coarse_geometry Geometry of the ancestor
+       * @param fine_geometry   Geometry of the descendant
+       */
+      template<typename CoarseFE, typename FineFE, typename Embedding, typename Geometry>
+      const TransferMatrix* restrictionMatrix(std::size_t leaf,
+                                              const CoarseFE& coarse_fe,
+                                              const FineFE& fine_fe,
+                                              const Embedding& embedding,
+                                              const MassMatrix& inverse_mass,
+                                              int intorder,
+                                              const Geometry& coarse_geometry,
+                                              const Geometry& fine_geometry)
+      {
+        Key key;
+        key.leaf = leaf;
+        key.coarse_fe = &coarse_fe;
+        key.fine_fe = &fine_fe;
+        if (!embedding.dyadicCorners(fine_geometry.type(),key.corners))
+          return nullptr;
+        typename std::map<Key,TransferMatrix>::iterator it = _restriction_matrices.find(key);
+        if (it != _restriction_matrices.end())
+          return &it->second;
+
+        typedef typename FineFE::Traits::LocalBasisType::Traits::RangeType Range;
+        std::vector<Range> coarse_phi;
+        std::vector<Range> fine_phi;
+
+        TransferMatrix& r = _restriction_matrices[key];
+        r.resize(coarse_fe.localBasis().size(),fine_fe.localBasis().size());
+
+        const QuadratureRule<ctype,dim>& rule = QuadratureRules<ctype,dim>::rule(fine_geometry.type(),intorder);
+        for (typename QuadratureRule<ctype,dim>::const_iterator qit = rule.begin(); qit != rule.end(); ++qit)
+          {
+            const typename Embedding::Coordinate coarse_local = embedding.global(qit->position());
+            fine_fe.localBasis().evaluateFunction(qit->position(),fine_phi);
+            coarse_fe.localBasis().evaluateFunction(coarse_local,coarse_phi);
+            const ctype factor = qit->weight()
+              * fine_geometry.integrationElement(qit->position())
+              / coarse_geometry.integrationElement(coarse_local);
+
+            for (std::size_t i = 0; i < coarse_phi.size(); ++i)
+              {
+                Range x(0.0);
+                for (std::size_t j = 0; j < inverse_mass.M(); ++j)
+                  x.axpy(inverse_mass[i][j],coarse_phi[j]);
+                for (std::size_t l = 0; l < fine_phi.size(); ++l)
+                  r[i][l] += factor * (x * fine_phi[l]);
+              }
+          }
+        return &r;
+      }
+
+      /*! @brief Matrix of the interpolation of the coarse finite element into the fine one.
+       *
+       * The fine coefficients are P u_coarse, where P has fine_fe.localBasis().size()
+       * rows and coarse_fe.localBasis().size() columns. The columns are the
+       * interpolants of the coarse basis functions, so the matrix reproduces the
+       * interpolation of the coarse function as long as the local interpolation is
+       * linear and the embedding describes the fine cell exactly. As for
+       * restrictionMatrix(), the finite elements must be stored by their finite
+       * element map, and nullptr is returned for cells at non-dyadic positions.
+       *
+       * @param leaf      Index of the leaf of the function space tree
+       * @param coarse_fe Finite element on the ancestor
+       * @param fine_fe   Finite element on the descendant
+       * @param embedding Embedding of the descendant into the ancestor
+       * @param fine_type GeometryType of the descendant
+       */
+      template<typename CoarseFE, typename FineFE, typename Embedding>
+      const TransferMatrix* prolongationMatrix(std::size_t leaf,
+                                               const CoarseFE& coarse_fe,
+                                               const FineFE& fine_fe,
+                                               const Embedding& embedding,
+                                               GeometryType fine_type)
+      {
+        Key key;
+        key.leaf = leaf;
+        key.coarse_fe = &coarse_fe;
+        key.fine_fe = &fine_fe;
+        if (!embedding.dyadicCorners(fine_type,key.corners))
+          return nullptr;
+        typename std::map<Key,TransferMatrix>::iterator it = _prolongation_matrices.find(key);
+        if (it != _prolongation_matrices.end())
+          return &it->second;
+
+        const std::size_t coarse_size = coarse_fe.localBasis().size();
+        const std::size_t fine_size = fine_fe.localBasis().size();
+
+        TransferMatrix& p = _prolongation_matrices[key];
+        p.resize(fine_size,coarse_size);
+
+        std::vector<DF> column;
+        for (std::size_t j = 0; j < coarse_size; ++j)
+          {
+            coarse_basis_function<CoarseFE,Embedding> f(coarse_fe,embedding,j);
+            column.assign(fine_size,DF(0));
+            fine_fe.localInterpolation().interpolate(f,column);
+            for (std::size_t l = 0; l < fine_size; ++l)
+              p[l][j] = column[l];
+          }
+        return &p;
+      }
+
     private:
 
       const GFS& _gfs;
       int _intorder;
+      bool _cache_transfer_matrices;
       std::vector<MassMatrices> _inverse_mass_matrices;
+      std::map<Key,TransferMatrix> _restriction_matrices;
+      std::map<Key,TransferMatrix> _prolongation_matrices;
     };
 
 
@@ -220,6 +517,8 @@ namespace Dune {
       typedef L2Projection<typename LFS::Traits::GridFunctionSpace,DOFVector> Projection;
       typedef typename Projection::MassMatrices MassMatrices;
       typedef typename Projection::MassMatrix MassMatrix;
+      typedef typename Projection::TransferMatrix TransferMatrix;
+      typedef NestedEmbedding<Cell> Embedding;
 
       typedef std::size_t size_type;
       typedef typename GFS::Traits::GridView::ctype DF;
@@ -238,21 +537,42 @@ namespace Dune {
 
         const MassMatrix& inverse_mass_matrix = _projection.inverseMassMatrices(*_element)[_leaf_index];
 
-        std::vector<Range> coarse_phi;
-        std::vector<Range> fine_phi;
-
         Geometry fine_geometry = _current->geometry();
         Geometry coarse_geometry = _ancestor->geometry();
 
+        const FE& fine_fe = fem.find(*_current);
+        const FE& coarse_fe = fem.find(*_ancestor);
+
+        // nested, affine cells: apply the cached reference restriction matrix
+        const TransferMatrix* r = nullptr;
+        if (stores_finite_elements<FEM,Cell>::value && _projection.cachesTransferMatrices() &&
+            _embedding.affine() && fine_geometry.affine() && coarse_geometry.affine())
+          r = _projection.restrictionMatrix(_leaf_index,coarse_fe,fine_fe,_embedding,
+                                            inverse_mass_matrix,_int_order,
+                                            coarse_geometry,fine_geometry);
+        if (r)
+          {
+            for (size_type i = 0; i < r->N(); ++i)
+              {
+                RF value(0);
+                for (size_type l = 0; l < r->M(); ++l)
+                  value += (*r)[i][l] * _u_fine[fine_offset + l];
+                (*_u_coarse)[coarse_offset + i] += value;
+              }
+            ++_leaf_index;
+            return;
+          }
+
+        std::vector<Range> coarse_phi;
+        std::vector<Range> fine_phi;
+
         const QuadratureRule<DF,dim>& rule = QuadratureRules<DF,dim>::rule(_current->type(),_int_order);
         // iterate over quadrature points
         for (typename QuadratureRule<DF,dim>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
           {
             typename Geometry::LocalCoordinate coarse_local = coarse_geometry.local(fine_geometry.global(it->position()));
-            const FE* fe = &fem.find(*_current);
-            fe->localBasis().evaluateFunction(it->position(),fine_phi);
-            fe = &fem.find(*_ancestor);
-            fe->localBasis().evaluateFunction(coarse_local,coarse_phi);
+            fine_fe.localBasis().evaluateFunction(it->position(),fine_phi);
+            coarse_fe.localBasis().evaluateFunction(coarse_local,coarse_phi);
             const DF factor = it->weight()
               * fine_geometry.integrationElement(it->position())
               / coarse_geometry.integrationElement(coarse_local);
@@ -317,6 +637,7 @@ namespace Dune {
                 if (hit->isLeaf())
                   {
                     _current = &(*hit);
+                    _embedding.update(*_current,*_ancestor);
                     // reset leaf_index for next run over tree
                     _leaf_index = 0;
                     // load data
@@ -369,6 +690,7 @@ namespace Dune {
       size_type _int_order;
       size_type _leaf_index;
       LocalDOFVector _u_fine;
+      Embedding _embedding;
 
     };
 
@@ -390,6 +712,10 @@ namespace Dune {
       typedef std::vector<RF> LocalDOFVector;
       typedef std::vector<typename CountVector::ElementType> LocalCountVector;
 
+      typedef L2Projection<typename LFS::Traits::GridFunctionSpace,DOFVector> Projection;
+      typedef typename Projection::TransferMatrix TransferMatrix;
+      typedef NestedEmbedding<Cell> Embedding;
+
       typedef std::size_t size_type;
 
       template<typename FiniteElement>
@@ -433,12 +759,29 @@ namespace Dune {
         size_type element_offset = _leaf_offset_cache[_element->type()][_leaf_index];
         size_type ancestor_offset = _leaf_offset_cache[_ancestor->type()][_leaf_index];
 
-        coarse_function<typename FEM::Traits::FiniteElement> f(fem.find(*_ancestor),_ancestor->geometry(),_element->geometry(),*_u_coarse,ancestor_offset);
-        const typename FEM::Traits::FiniteElement& fe = fem.find(*_element);
+        typedef typename FEM::Traits::FiniteElement FE;
+        const FE& coarse_fe = fem.find(*_ancestor);
+        const FE& fe = fem.find(*_element);
 
         _u_tmp.resize(fe.localBasis().size());
         std::fill(_u_tmp.begin(),_u_tmp.end(),RF(0.0));
-        fe.localInterpolation().interpolate(f,_u_tmp);
+
+        // nested, affine cells: apply the cached reference prolongation matrix
+        const TransferMatrix* p = nullptr;
+        if (stores_finite_elements<FEM,Cell>::value && _projection.cachesTransferMatrices() &&
+            _embedding.affine() && _element->geometry().affine() && _ancestor->geometry().affine())
+          p = _projection.prolongationMatrix(_leaf_index,coarse_fe,fe,_embedding,_element->type());
+        if (p)
+          {
+            for (size_type l = 0; l < p->N(); ++l)
+              for (size_type j = 0; j < p->M(); ++j)
+                _u_tmp[l] += (*p)[l][j] * (*_u_coarse)[ancestor_offset + j];
+          }
+        else
+          {
+            coarse_function<FE> f(coarse_fe,_ancestor->geometry(),_element->geometry(),*_u_coarse,ancestor_offset);
+            fe.localInterpolation().interpolate(f,_u_tmp);
+          }
         std::copy(_u_tmp.begin(),_u_tmp.end(),_u_fine.begin() + element_offset);
 
         ++_leaf_index;
@@ -465,6 +808,7 @@ namespace Dune {
           {
             _u_fine.resize(_lfs_cache.size());
             std::fill(_u_fine.begin(),_u_fine.end(),RF(0));
+            _embedding.update(element,ancestor);
             _leaf_index = 0;
             TypeTree::applyToTree(_lfs,*this);
             _u_view.add(_u_fine);
@@ -477,11 +821,12 @@ namespace Dune {
         _uc_view.commit();
       }
 
-      replay_visitor(const GFS& gfs, DOFVector& u, CountVector& uc, LeafOffsetCache& leaf_offset_cache)
+      replay_visitor(const GFS& gfs, Projection& projection, DOFVector& u, CountVector& uc, LeafOffsetCache& leaf_offset_cache)
         : _lfs(gfs)
         , _lfs_cache(_lfs)
         , _element(nullptr)
         , _ancestor(nullptr)
+        , _projection(projection)
         , _u_view(u)
         , _uc_view(uc)
         , _leaf_offset_cache(leaf_offset_cache)
@@ -492,6 +837,7 @@ namespace Dune {
       LFSCache _lfs_cache;
       const Cell* _element;
       const Cell* _ancestor;
+      Projection& _projection;
       typename DOFVector::template LocalView<LFSCache> _u_view;
       typename CountVector::template LocalView<LFSCache> _uc_view;
       const LocalDOFVector* _u_coarse;
@@ -500,6 +846,7 @@ namespace Dune {
       LocalDOFVector _u_fine;
       LocalDOFVector _u_tmp;
       LocalCountVector _counts;
+      Embedding _embedding;
 
     };
 
@@ -575,7 +922,7 @@ namespace Dune {
         CountVector uc(gfsu,0);
 
         typedef replay_visitor<GFSU,U,CountVector> Visitor;
-        Visitor visitor(gfsu,u,uc,_leaf_offset_cache);
+        Visitor visitor(gfsu,projection,u,uc,_leaf_offset_cache);
 
         // iterate over all elems
         LeafGridView leafView = grid.leafGridView();
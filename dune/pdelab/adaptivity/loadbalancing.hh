@@ -0,0 +1,318 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_ADAPTIVITY_LOADBALANCING_HH
+#define DUNE_PDELAB_ADAPTIVITY_LOADBALANCING_HH
+
+#include <cstddef>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/grid/common/datahandleif.hh>
+#include <dune/grid/common/gridenums.hh>
+
+#include <dune/pdelab/gridfunctionspace/genericdatahandle.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! Load balancing weight that counts the degrees of freedom of each cell.
+    /**
+     * A weight is a function object that is called with a cell and a LocalFunctionSpace
+     * bound to that cell and returns the work associated with the cell. Other weights,
+     * e.g. the measured assembly time per cell, can be supplied in the same way.
+     */
+    struct LoadBalanceDOFWeight
+    {
+      template<typename Element, typename LFS>
+      double operator()(const Element& e, const LFS& lfs) const
+      {
+        return lfs.size();
+      }
+    };
+
+    //! Statistics returned by load_balance().
+    struct LoadBalanceStatistics
+    {
+      //! Ratio of the maximum and the mean weight per rank before balancing.
+      double imbalance_before;
+      //! Ratio of the maximum and the mean weight per rank after balancing.
+      double imbalance_after;
+      //! Whether the grid was repartitioned.
+      bool rebalanced;
+    };
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // common field type of the migrated vectors, double if no vectors are migrated
+      template<typename... X>
+      struct load_balance_field_type
+        : public std::common_type<typename X::ElementType...>
+      {};
+
+      template<>
+      struct load_balance_field_type<>
+      {
+        typedef double type;
+      };
+
+      // Data handle that migrates the values stored for each cell along with
+      // the cell. The values are identified by the global id of the cell, as
+      // the DOFs of a migrated cell do not exist on the receiving rank before
+      // the function space has been updated.
+      template<typename IdSet, typename Map>
+      class LoadBalanceDataHandle
+        : public CommDataHandleIF<LoadBalanceDataHandle<IdSet,Map>,typename Map::mapped_type::value_type>
+      {
+
+      public:
+
+        typedef typename Map::mapped_type::value_type DataType;
+        typedef std::size_t size_type;
+
+        LoadBalanceDataHandle(const IdSet& id_set, Map& map)
+          : _id_set(id_set)
+          , _map(map)
+        {}
+
+        bool contains(int dim, int codim) const
+        {
+          return codim == 0;
+        }
+
+        bool fixedsize(int dim, int codim) const
+        {
+          return false;
+        }
+
+        template<typename Entity>
+        size_type size(const Entity& e) const
+        {
+          typename Map::const_iterator it = _map.find(_id_set.id(e));
+          return it != _map.end() ? it->second.size() : 0;
+        }
+
+        template<typename MessageBuffer, typename Entity>
+        void gather(MessageBuffer& buff, const Entity& e) const
+        {
+          typename Map::const_iterator it = _map.find(_id_set.id(e));
+          if (it == _map.end())
+            return;
+          for (size_type i = 0; i < it->second.size(); ++i)
+            buff.write(it->second[i]);
+        }
+
+        template<typename MessageBuffer, typename Entity>
+        void scatter(MessageBuffer& buff, const Entity& e, size_type n)
+        {
+          typename Map::mapped_type& values = _map[_id_set.id(e)];
+          values.resize(n);
+          for (size_type i = 0; i < n; ++i)
+            buff.read(values[i]);
+        }
+
+      private:
+
+        const IdSet& _id_set;
+        Map& _map;
+
+      };
+
+      template<typename LFSCache, typename Values>
+      void load_balance_backup(const LFSCache& lfs_cache, Values& values)
+      {}
+
+      // appends the local coefficients of all vectors to values
+      template<typename LFSCache, typename Values, typename X, typename... Xs>
+      void load_balance_backup(const LFSCache& lfs_cache, Values& values, const X& x, const Xs&... xs)
+      {
+        typename X::template ConstLocalView<LFSCache> x_view(x);
+        x_view.bind(lfs_cache);
+        for (std::size_t i = 0; i < x_view.size(); ++i)
+          values.push_back(x_view[i]);
+        x_view.unbind();
+        load_balance_backup(lfs_cache,values,xs...);
+      }
+
+      template<typename LFSCache, typename Values>
+      void load_balance_restore(const LFSCache& lfs_cache, const Values& values, std::size_t offset)
+      {}
+
+      // reads the local coefficients of all vectors from values
+      template<typename LFSCache, typename Values, typename X, typename... Xs>
+      void load_balance_restore(const LFSCache& lfs_cache, const Values& values, std::size_t offset, X& x, Xs&... xs)
+      {
+        typename X::template LocalView<LFSCache> x_view(x);
+        x_view.bind(lfs_cache);
+        if (offset + x_view.size() > values.size())
+          DUNE_THROW(Exception,"load_balance(): migrated data does not match the function space");
+        for (std::size_t i = 0; i < x_view.size(); ++i)
+          x_view[i] = values[offset + i];
+        x_view.commit();
+        x_view.unbind();
+        load_balance_restore(lfs_cache,values,offset + lfs_cache.size(),xs...);
+      }
+
+      template<typename GFS>
+      void load_balance_reset(const GFS& gfs)
+      {}
+
+      template<typename GFS, typename X, typename... Xs>
+      void load_balance_reset(const GFS& gfs, X& x, Xs&... xs)
+      {
+        x = X(gfs,0.0);
+        load_balance_reset(gfs,xs...);
+      }
+
+      template<typename GFS>
+      void load_balance_complete(const GFS& gfs)
+      {}
+
+      // fills the DOFs that are only attached to overlap and ghost cells
+      template<typename GFS, typename X, typename... Xs>
+      void load_balance_complete(const GFS& gfs, X& x, Xs&... xs)
+      {
+        if (gfs.gridView().comm().size() > 1)
+          {
+            CopyDataHandle<GFS,X> handle(gfs,x);
+            gfs.gridView().communicate(handle,InteriorBorder_All_Interface,ForwardCommunication);
+          }
+        load_balance_complete(gfs,xs...);
+      }
+
+      // ratio of the maximum and the mean weight of all ranks
+      template<typename GFS, typename Weight>
+      double load_imbalance(const GFS& gfs, Weight& weight)
+      {
+        typedef typename GFS::Traits::GridViewType GV;
+        typedef typename GV::template Codim<0>::template Partition<Interior_Partition>::Iterator ElementIterator;
+
+        LocalFunctionSpace<GFS> lfs(gfs);
+        const GV& gv = gfs.gridView();
+
+        double local_weight = 0.0;
+        for (ElementIterator it = gv.template begin<0,Interior_Partition>();
+             it != gv.template end<0,Interior_Partition>(); ++it)
+          {
+            lfs.bind(*it);
+            local_weight += weight(*it,lfs);
+          }
+
+        const double max_weight = gv.comm().max(local_weight);
+        const double mean_weight = gv.comm().sum(local_weight) / gv.comm().size();
+        return mean_weight > 0.0 ? max_weight / mean_weight : 1.0;
+      }
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    /*! load balancing as a function
+     *
+     * @brief repartition a grid and migrate the DOF vectors of a function space along with the cells
+     *
+     * The imbalance of the current partitioning, i.e. the ratio of the maximum and the mean
+     * weight per rank, is computed from the given weight. If it exceeds tolerance, the grid
+     * is repartitioned with Grid::loadBalance(). The coefficients of all vectors are sent
+     * along with their cells, the function space is updated and the vectors are rebuilt on
+     * the new partitioning, including the DOFs on overlap and ghost cells. If the imbalance
+     * does not exceed tolerance, neither the grid nor the vectors are touched.
+     *
+     * \note The weight is only used to measure the imbalance; the new partitioning is computed
+     *       by the grid manager.
+     *
+     * \warning load_balance() only knows the function space and the given vectors. If the
+     *          returned statistics report that the grid was rebalanced, the caller must
+     *          reassemble all constraints containers of the space (e.g. with constraints())
+     *          and call update() on all GridOperators built on it before the next assembly,
+     *          as both refer to the DOF indices of the old partitioning. Vectors that were not
+     *          passed to load_balance() are invalid as well.
+     *
+     * @tparam Grid   Type of the grid that is repartitioned
+     * @tparam GFS    Type of ansatz space, we need to update it after repartitioning
+     * @tparam Weight Function object returning the weight of a cell, see LoadBalanceDOFWeight
+     * @tparam X      Container classes for DOF vectors of GFS
+     */
+    template<typename Grid, typename GFS, typename Weight, typename... X>
+    LoadBalanceStatistics load_balance(Grid& grid, GFS& gfs, Weight weight, double tolerance, X&... x)
+    {
+      typedef typename GFS::Traits::GridViewType GV;
+      typedef typename GV::template Codim<0>::template Partition<Interior_Partition>::Iterator ElementIterator;
+      typedef typename Grid::GlobalIdSet IdSet;
+      typedef typename impl::load_balance_field_type<X...>::type E;
+      typedef std::unordered_map<typename IdSet::IdType,std::vector<E> > MapType;
+      typedef LocalFunctionSpace<GFS> LFS;
+      typedef LFSIndexCache<LFS> LFSCache;
+
+      LoadBalanceStatistics statistics;
+      statistics.imbalance_before = impl::load_imbalance(gfs,weight);
+      statistics.imbalance_after = statistics.imbalance_before;
+      statistics.rebalanced = false;
+
+      if (statistics.imbalance_before <= tolerance)
+        return statistics;
+
+      const IdSet& id_set = grid.globalIdSet();
+      LFS lfs(gfs);
+      LFSCache lfs_cache(lfs);
+
+      // save the coefficients of all interior cells
+      MapType transfer_map;
+      {
+        const GV& gv = gfs.gridView();
+        for (ElementIterator it = gv.template begin<0,Interior_Partition>();
+             it != gv.template end<0,Interior_Partition>(); ++it)
+          {
+            lfs.bind(*it);
+            lfs_cache.update();
+            std::vector<E>& values = transfer_map[id_set.id(*it)];
+            values.reserve(lfs_cache.size() * sizeof...(X));
+            impl::load_balance_backup(lfs_cache,values,x...);
+          }
+      }
+
+      // repartition the grid and migrate the coefficients along with the cells
+      impl::LoadBalanceDataHandle<IdSet,MapType> handle(id_set,transfer_map);
+      statistics.rebalanced = grid.loadBalance(handle);
+      if (!statistics.rebalanced)
+        return statistics;
+
+      // update the function space and rebuild the vectors
+      gfs.update();
+      impl::load_balance_reset(gfs,x...);
+
+      const GV& gv = gfs.gridView();
+      for (ElementIterator it = gv.template begin<0,Interior_Partition>();
+           it != gv.template end<0,Interior_Partition>(); ++it)
+        {
+          typename MapType::const_iterator map_it = transfer_map.find(id_set.id(*it));
+          if (map_it == transfer_map.end())
+            DUNE_THROW(Exception,
+                       "load_balance(): no data was migrated for element with id " << id_set.id(*it));
+          lfs.bind(*it);
+          lfs_cache.update();
+          impl::load_balance_restore(lfs_cache,map_it->second,0,x...);
+        }
+
+      impl::load_balance_complete(gfs,x...);
+
+      statistics.imbalance_after = impl::load_imbalance(gfs,weight);
+      return statistics;
+    }
+
+    //! Repartitions the grid if the number of DOFs per rank is unbalanced by more than tolerance.
+    template<typename Grid, typename GFS, typename... X>
+    LoadBalanceStatistics load_balance(Grid& grid, GFS& gfs, double tolerance, X&... x)
+    {
+      return load_balance(grid,gfs,LoadBalanceDOFWeight(),tolerance,x...);
+    }
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_ADAPTIVITY_LOADBALANCING_HH
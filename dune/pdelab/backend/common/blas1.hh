@@ -0,0 +1,238 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_BACKEND_COMMON_BLAS1_HH
+#define DUNE_PDELAB_BACKEND_COMMON_BLAS1_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/dotproduct.hh>
+#include <dune/common/ftraits.hh>
+#include <dune/common/fvector.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! BLAS level 1 kernels on the flat, contiguous storage of backend vectors.
+    /**
+     * The kernels split the index range into chunks of chunk_size entries. If the
+     * code is compiled with OpenMP support, the chunks are distributed statically
+     * among the threads; otherwise they are processed in order by the calling
+     * thread. Within a chunk, reductions use four independent accumulators, which
+     * allows the compiler to vectorise the loops.
+     *
+     * The partial results of the chunks are always combined sequentially in chunk
+     * order. As the chunk boundaries only depend on the vector length, reductions
+     * are bitwise reproducible independent of the number of threads.
+     */
+    namespace blas1 {
+
+      //! The number of entries that are processed as a unit.
+      static const std::size_t chunk_size = 4096;
+
+#ifndef DOXYGEN
+
+      namespace impl {
+
+        inline std::size_t chunks(std::size_t n)
+        {
+          return (n + chunk_size - 1) / chunk_size;
+        }
+
+        template<typename R, typename F>
+        R chunk_sum(std::size_t begin, std::size_t end, const F& f)
+        {
+          R s0(0), s1(0), s2(0), s3(0);
+          std::size_t i = begin;
+          for (; i + 4 <= end; i += 4)
+            {
+              s0 += f(i);
+              s1 += f(i+1);
+              s2 += f(i+2);
+              s3 += f(i+3);
+            }
+          for (; i < end; ++i)
+            s0 += f(i);
+          return (s0 + s1) + (s2 + s3);
+        }
+
+        template<typename R, typename F>
+        R chunk_max(std::size_t begin, std::size_t end, const F& f)
+        {
+          R m(0);
+          for (std::size_t i = begin; i < end; ++i)
+            m = std::max(m,f(i));
+          return m;
+        }
+
+        // sum of f(i) for i in [0,n)
+        template<typename R, typename F>
+        R sum(std::size_t n, const F& f)
+        {
+          const std::size_t c = chunks(n);
+          if (c <= 1)
+            return chunk_sum<R>(0,n,f);
+          std::vector<R> partial(c);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+          for (long k = 0; k < static_cast<long>(c); ++k)
+            partial[k] = chunk_sum<R>(k * chunk_size,std::min(n,(k + 1) * chunk_size),f);
+          R s(0);
+          for (std::size_t k = 0; k < c; ++k)
+            s += partial[k];
+          return s;
+        }
+
+        // maximum of f(i) for i in [0,n), or 0 for n == 0
+        template<typename R, typename F>
+        R max(std::size_t n, const F& f)
+        {
+          const std::size_t c = chunks(n);
+          if (c <= 1)
+            return chunk_max<R>(0,n,f);
+          std::vector<R> partial(c);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+          for (long k = 0; k < static_cast<long>(c); ++k)
+            partial[k] = chunk_max<R>(k * chunk_size,std::min(n,(k + 1) * chunk_size),f);
+          return *std::max_element(partial.begin(),partial.end());
+        }
+
+        // calls f(i) for i in [0,n)
+        template<typename F>
+        void for_each(std::size_t n, const F& f)
+        {
+          const std::size_t c = chunks(n);
+          if (c <= 1)
+            {
+              for (std::size_t i = 0; i < n; ++i)
+                f(i);
+              return;
+            }
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+          for (long k = 0; k < static_cast<long>(c); ++k)
+            {
+              const std::size_t end = std::min(n,(k + 1) * chunk_size);
+              for (std::size_t i = k * chunk_size; i < end; ++i)
+                f(i);
+            }
+        }
+
+      } // namespace impl
+
+#endif // DOXYGEN
+
+      //! x = a
+      template<typename T>
+      void fill(std::size_t n, T* x, const T& a)
+      {
+        impl::for_each(n,[=](std::size_t i) { x[i] = a; });
+      }
+
+      //! y = x
+      template<typename T>
+      void copy(std::size_t n, const T* x, T* y)
+      {
+        impl::for_each(n,[=](std::size_t i) { y[i] = x[i]; });
+      }
+
+      //! x *= a
+      template<typename T>
+      void scale(std::size_t n, const T& a, T* x)
+      {
+        impl::for_each(n,[=](std::size_t i) { x[i] *= a; });
+      }
+
+      //! x += a (for every entry)
+      template<typename T>
+      void shift(std::size_t n, const T& a, T* x)
+      {
+        impl::for_each(n,[=](std::size_t i) { x[i] += a; });
+      }
+
+      //! y += a x
+      template<typename T>
+      void axpy(std::size_t n, const T& a, const T* x, T* y)
+      {
+        impl::for_each(n,[=](std::size_t i) { y[i] += a * x[i]; });
+      }
+
+      //! y += x
+      template<typename T>
+      void add(std::size_t n, const T* x, T* y)
+      {
+        impl::for_each(n,[=](std::size_t i) { y[i] += x[i]; });
+      }
+
+      //! y -= x
+      template<typename T>
+      void subtract(std::size_t n, const T* x, T* y)
+      {
+        impl::for_each(n,[=](std::size_t i) { y[i] -= x[i]; });
+      }
+
+      //! Scalar product, conjugating the entries of x (cf. Dune::dot()).
+      template<typename T>
+      T dot(std::size_t n, const T* x, const T* y)
+      {
+        return impl::sum<T>(n,[=](std::size_t i) { return Dune::dot(x[i],y[i]); });
+      }
+
+      //! Indefinite scalar product without conjugation (cf. Dune::dotT()).
+      template<typename T>
+      T dotT(std::size_t n, const T* x, const T* y)
+      {
+        return impl::sum<T>(n,[=](std::size_t i) { return x[i] * y[i]; });
+      }
+
+      //! Scalar product restricted to the entries i with mask[i] == rank.
+      template<typename T, typename M>
+      T masked_dot(std::size_t n, const T* x, const T* y, const M* mask, M rank)
+      {
+        return impl::sum<T>(n,[=](std::size_t i) { return mask[i] == rank ? Dune::dot(x[i],y[i]) : T(0); });
+      }
+
+      //! Squared Euclidean norm
+      template<typename T>
+      typename FieldTraits<T>::real_type two_norm2(std::size_t n, const T* x)
+      {
+        typedef typename FieldTraits<T>::real_type Real;
+        return impl::sum<Real>(n,[=](std::size_t i) { return Dune::fvmeta::abs2(x[i]); });
+      }
+
+      //! Euclidean norm
+      template<typename T>
+      typename FieldTraits<T>::real_type two_norm(std::size_t n, const T* x)
+      {
+        using std::sqrt;
+        return sqrt(two_norm2(n,x));
+      }
+
+      //! Sum of the absolute values
+      template<typename T>
+      typename FieldTraits<T>::real_type one_norm(std::size_t n, const T* x)
+      {
+        typedef typename FieldTraits<T>::real_type Real;
+        return impl::sum<Real>(n,[=](std::size_t i) -> Real { using std::abs; return abs(x[i]); });
+      }
+
+      //! Maximum of the absolute values
+      template<typename T>
+      typename FieldTraits<T>::real_type infinity_norm(std::size_t n, const T* x)
+      {
+        typedef typename FieldTraits<T>::real_type Real;
+        return impl::max<Real>(n,[=](std::size_t i) -> Real { using std::abs; return abs(x[i]); });
+      }
+
+    } // namespace blas1
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_COMMON_BLAS1_HH
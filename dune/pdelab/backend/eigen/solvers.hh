@@ -3,6 +3,10 @@
 #ifndef DUNE_PDELAB_EIGEN_SOLVERS_HH
 #define DUNE_PDELAB_EIGEN_SOLVERS_HH
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include <dune/common/deprecated.hh>
 #include <dune/common/timer.hh>
 #include <dune/common/parallel/mpihelper.hh>
@@ -24,6 +28,146 @@ namespace Dune {
     // interface required to solve linear and nonlinear problems.
     //==============================================================================
 
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // Type-erased storage for an Eigen solver object that is kept alive between
+      // calls to apply(). The backends are not templated on the matrix type, so they
+      // recover the concrete solver type with a dynamic_pointer_cast.
+      struct EigenSolverHolderBase
+      {
+        virtual ~EigenSolverHolderBase()
+        {}
+      };
+
+      template<typename Solver>
+      struct EigenSolverHolder
+        : public EigenSolverHolderBase
+      {
+        EigenSolverHolder()
+          : matrix(nullptr)
+          , computed(false)
+          , revision(0)
+        {}
+
+        Solver solver;
+        // the matrix the solver has been set up with (iterative solvers keep a pointer to it)
+        const void* matrix;
+        // copy of the sparsity pattern the symbolic analysis has been computed for
+        std::vector<typename Solver::Index> outer;
+        std::vector<typename Solver::Index> inner;
+        // whether the preconditioner or factorisation has been computed, and for which
+        // revision of the backend
+        bool computed;
+        unsigned long revision;
+      };
+
+      // Matrix in the storage order required by a solver, together with the position of
+      // every entry of the source matrix in its value array. As long as the pattern does
+      // not change, the values are scattered into place without any reallocation.
+      template<typename Mat>
+      struct EigenScratchMatrix
+        : public EigenSolverHolderBase
+      {
+        Mat matrix;
+        std::vector<typename Mat::Index> positions;
+      };
+
+      // Returns the holder for Solver stored in ptr, creating a new one if the stored
+      // holder is missing or belongs to a different solver type.
+      template<typename Solver>
+      EigenSolverHolder<Solver>& eigenSolverHolder(std::shared_ptr<EigenSolverHolderBase>& ptr)
+      {
+        std::shared_ptr<EigenSolverHolder<Solver> > holder = std::dynamic_pointer_cast<EigenSolverHolder<Solver> >(ptr);
+        if (!holder)
+          {
+            holder = std::make_shared<EigenSolverHolder<Solver> >();
+            ptr = holder;
+          }
+        return *holder;
+      }
+
+      // Compares the pattern of the compressed matrix A with the pattern stored in holder
+      // and updates the stored pattern. Returns true if the pattern has changed.
+      template<typename Holder, typename Mat>
+      bool eigenPatternChanged(Holder& holder, const Mat& A)
+      {
+        const std::size_t outer_size = A.outerSize() + 1;
+        const std::size_t nnz = A.nonZeros();
+        if (A.isCompressed() &&
+            holder.outer.size() == outer_size &&
+            holder.inner.size() == nnz &&
+            std::equal(holder.outer.begin(),holder.outer.end(),A.outerIndexPtr()) &&
+            std::equal(holder.inner.begin(),holder.inner.end(),A.innerIndexPtr()))
+          return false;
+        holder.outer.assign(A.outerIndexPtr(),A.outerIndexPtr() + outer_size);
+        holder.inner.assign(A.innerIndexPtr(),A.innerIndexPtr() + (A.isCompressed() ? nnz : 0));
+        return true;
+      }
+
+      // Binders that turn Eigen solver templates into templates over the matrix type only.
+      template<template<class, int> class Solver, int UpLo>
+      struct EigenSPDSolver
+      {
+        template<typename Mat>
+        using type = Solver<Mat,UpLo>;
+      };
+
+      template<int UpLo>
+      struct EigenSimplicialLDLT
+      {
+        template<typename Mat>
+        using type = Eigen::SimplicialLDLT<Mat,UpLo>;
+      };
+
+      // SparseLU only works on column-major matrices, so it operates on a converted copy.
+      struct EigenSparseLU
+      {
+        template<typename Mat>
+        using type = Eigen::SparseLU<Eigen::SparseMatrix<typename Mat::Scalar,Eigen::ColMajor,typename Mat::Index>,
+                                     Eigen::COLAMDOrdering<typename Mat::Index> >;
+      };
+
+      // Returns A if it has the storage layout expected by the solver, otherwise converts
+      // A into the given scratch matrix. The conversion only reallocates if the pattern of A
+      // has changed (or A is not compressed), otherwise it copies the values into place.
+      template<typename Mat>
+      const Mat& eigenSolverMatrix(const Mat& A, EigenScratchMatrix<Mat>& scratch, bool pattern_changed)
+      {
+        return A;
+      }
+
+      template<typename SolverMat, typename Mat>
+      const SolverMat& eigenSolverMatrix(const Mat& A, EigenScratchMatrix<SolverMat>& scratch, bool pattern_changed)
+      {
+        typedef typename SolverMat::Index Index;
+        const Index nnz = A.nonZeros();
+        if (pattern_changed || !A.isCompressed() || scratch.positions.size() != static_cast<std::size_t>(nnz))
+          {
+            scratch.matrix = A;
+            scratch.matrix.makeCompressed();
+            scratch.positions.clear();
+            if (!A.isCompressed())
+              return scratch.matrix;
+            // the inner vectors of the converted matrix are sorted by the outer index of A
+            std::vector<Index> next(scratch.matrix.outerIndexPtr(),
+                                    scratch.matrix.outerIndexPtr() + scratch.matrix.outerSize());
+            scratch.positions.resize(nnz);
+            for (Index o = 0; o < A.outerSize(); ++o)
+              for (Index k = A.outerIndexPtr()[o]; k < A.outerIndexPtr()[o+1]; ++k)
+                scratch.positions[k] = next[A.innerIndexPtr()[k]]++;
+            return scratch.matrix;
+          }
+        for (Index k = 0; k < nnz; ++k)
+          scratch.matrix.valuePtr()[scratch.positions[k]] = A.valuePtr()[k];
+        return scratch.matrix;
+      }
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
   template<class PreconditionerImp>
     class EigenBackend_BiCGSTAB_Base
       : public LinearResultStorage
@@ -32,12 +176,37 @@ namespace Dune {
       /*! \brief make a linear solver object
 
         \param[in] maxiter_ maximum number of iterations to do
-        \param[in] verbose_ print messages if true
+        \param[in] reuse_ reuse the preconditioner until invalidate() is called
       */
-      explicit EigenBackend_BiCGSTAB_Base(unsigned maxiter_=5000)
+      explicit EigenBackend_BiCGSTAB_Base(unsigned maxiter_=5000, bool reuse_=false)
         : maxiter(maxiter_)
+        , reuse(reuse_)
+        , revision(0)
       {}
 
+      /*! \brief Set whether the preconditioner should be reused.
+
+        If set, the preconditioner is only rebuilt after a call to invalidate() or if apply()
+        is called with a different matrix object, as the Eigen solvers keep a pointer to the
+        matrix they have been set up with.
+      */
+      void setReuse(bool reuse_)
+      {
+        reuse = reuse_;
+      }
+
+      //! Return whether the preconditioner is reused.
+      bool getReuse() const
+      {
+        return reuse;
+      }
+
+      //! Marks the preconditioner as outdated, e.g. because the matrix values have changed.
+      void invalidate()
+      {
+        ++revision;
+      }
+
       /*! \brief solve the given linear system
 
         \param[in] A the given matrix
@@ -48,14 +217,21 @@ namespace Dune {
       template<class M, class V, class W>
       void apply(M& A, V& z, W& r, typename W::field_type reduction)
       {
-        // PreconditionerImp preconditioner;
         typedef typename M::Container Mat;
-        Eigen::BiCGSTAB<Mat, PreconditionerImp> solver;
+        typedef Eigen::BiCGSTAB<Mat, PreconditionerImp> Solver;
+        impl::EigenSolverHolder<Solver>& holder = impl::eigenSolverHolder<Solver>(cache);
+        Solver& solver = holder.solver;
         solver.setMaxIterations(maxiter);
         solver.setTolerance(reduction);
         Dune::Timer watch;
         watch.reset();
-        solver.compute(A.base());
+        if (!reuse || !holder.computed || holder.revision != revision || holder.matrix != &A.base())
+          {
+            solver.compute(A.base());
+            holder.matrix = &A.base();
+            holder.computed = true;
+            holder.revision = revision;
+          }
         z.base() = solver.solve(r.base());
         double elapsed = watch.elapsed();
 
@@ -75,15 +251,17 @@ namespace Dune {
 
     private:
       unsigned maxiter;
-      int verbose;
+      bool reuse;
+      unsigned long revision;
+      std::shared_ptr<impl::EigenSolverHolderBase> cache;
     };
 
     class EigenBackend_BiCGSTAB_IILU
       : public EigenBackend_BiCGSTAB_Base<Eigen::IncompleteLUT<double> >
     {
     public:
-        explicit EigenBackend_BiCGSTAB_IILU(unsigned maxiter_=5000)
-          : EigenBackend_BiCGSTAB_Base(maxiter_)
+        explicit EigenBackend_BiCGSTAB_IILU(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_BiCGSTAB_Base(maxiter_,reuse_)
         {
         }
     };
@@ -92,8 +270,8 @@ namespace Dune {
       : public EigenBackend_BiCGSTAB_Base<Eigen::DiagonalPreconditioner<double> >
     {
     public:
-        explicit EigenBackend_BiCGSTAB_Diagonal(unsigned maxiter_=5000)
-          : EigenBackend_BiCGSTAB_Base(maxiter_)
+        explicit EigenBackend_BiCGSTAB_Diagonal(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_BiCGSTAB_Base(maxiter_,reuse_)
         {}
     };
 
@@ -105,12 +283,37 @@ namespace Dune {
       /*! \brief make a linear solver object
 
         \param[in] maxiter_ maximum number of iterations to do
-        \param[in] verbose_ print messages if true
+        \param[in] reuse_ reuse the preconditioner until invalidate() is called
         */
-      explicit EigenBackend_CG_Base(unsigned maxiter_=5000)
+      explicit EigenBackend_CG_Base(unsigned maxiter_=5000, bool reuse_=false)
         : maxiter(maxiter_)
+        , reuse(reuse_)
+        , revision(0)
       {}
 
+      /*! \brief Set whether the preconditioner should be reused.
+
+        If set, the preconditioner is only rebuilt after a call to invalidate() or if apply()
+        is called with a different matrix object, as the Eigen solvers keep a pointer to the
+        matrix they have been set up with.
+      */
+      void setReuse(bool reuse_)
+      {
+        reuse = reuse_;
+      }
+
+      //! Return whether the preconditioner is reused.
+      bool getReuse() const
+      {
+        return reuse;
+      }
+
+      //! Marks the preconditioner as outdated, e.g. because the matrix values have changed.
+      void invalidate()
+      {
+        ++revision;
+      }
+
       /*! \brief solve the given linear system
 
         \param[in] A the given matrix
@@ -122,12 +325,20 @@ namespace Dune {
       void apply(M& A, V& z, W& r, typename W::field_type reduction)
       {
         typedef typename M::Container Mat;
-        Eigen::ConjugateGradient<Mat, UpLo, Preconditioner> solver;
+        typedef Eigen::ConjugateGradient<Mat, UpLo, Preconditioner> Solver;
+        impl::EigenSolverHolder<Solver>& holder = impl::eigenSolverHolder<Solver>(cache);
+        Solver& solver = holder.solver;
         solver.setMaxIterations(maxiter);
         solver.setTolerance(reduction);
         Dune::Timer watch;
         watch.reset();
-        solver.compute(A.base());
+        if (!reuse || !holder.computed || holder.revision != revision || holder.matrix != &A.base())
+          {
+            solver.compute(A.base());
+            holder.matrix = &A.base();
+            holder.computed = true;
+            holder.revision = revision;
+          }
         z.base() = solver.solve(r.base());
         double elapsed = watch.elapsed();
 
@@ -141,7 +352,9 @@ namespace Dune {
 
     private:
       unsigned maxiter;
-      int verbose;
+      bool reuse;
+      unsigned long revision;
+      std::shared_ptr<impl::EigenSolverHolderBase> cache;
     };
 
 
@@ -149,8 +362,8 @@ namespace Dune {
       : public EigenBackend_CG_Base<Eigen::IncompleteLUT<double>, Eigen::Upper >
     {
     public:
-        explicit EigenBackend_CG_IILU_Up(unsigned maxiter_=5000)
-          : EigenBackend_CG_Base(maxiter_)
+        explicit EigenBackend_CG_IILU_Up(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_CG_Base(maxiter_,reuse_)
         {}
     };
 
@@ -158,8 +371,8 @@ namespace Dune {
       : public EigenBackend_CG_Base<Eigen::DiagonalPreconditioner<double>, Eigen::Upper >
     {
     public:
-        explicit EigenBackend_CG_Diagonal_Up(unsigned maxiter_=5000)
-          : EigenBackend_CG_Base(maxiter_)
+        explicit EigenBackend_CG_Diagonal_Up(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_CG_Base(maxiter_,reuse_)
         {}
     };
 
@@ -167,8 +380,8 @@ namespace Dune {
       : public EigenBackend_CG_Base<Eigen::IncompleteLUT<double>, Eigen::Lower >
     {
     public:
-        explicit EigenBackend_CG_IILU_Lo(unsigned maxiter_=5000)
-          : EigenBackend_CG_Base(maxiter_)
+        explicit EigenBackend_CG_IILU_Lo(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_CG_Base(maxiter_,reuse_)
         {}
     };
 
@@ -176,24 +389,64 @@ namespace Dune {
       : public EigenBackend_CG_Base<Eigen::DiagonalPreconditioner<double>, Eigen::Lower >
     {
     public:
-        explicit EigenBackend_CG_Diagonal_Lo(unsigned maxiter_=5000)
-          : EigenBackend_CG_Base(maxiter_)
+        explicit EigenBackend_CG_Diagonal_Lo(unsigned maxiter_=5000, bool reuse_=false)
+          : EigenBackend_CG_Base(maxiter_,reuse_)
         {}
     };
 
-    template<template<class, int> class Solver, int UpLo>
-      class EigenBackend_SPD_Base
+    //! Base class for the sparse direct solvers of Eigen.
+    /**
+     * The solver object is kept alive between calls to apply(). The symbolic analysis
+     * (analyzePattern()) is only redone if the sparsity pattern of the matrix changes,
+     * otherwise only the numeric factorisation is recomputed. If reuse is set, the
+     * factorisation itself is kept as well until the pattern changes or invalidate()
+     * is called.
+     *
+     * Solvers that need a different storage order than the assembled matrix (SparseLU)
+     * work on a converted copy, which is only updated when the matrix is factorised.
+     *
+     * \tparam Solver  Template alias mapping the matrix type to the Eigen solver type.
+     */
+    template<template<class> class Solver>
+      class EigenBackend_Direct_Base
       : public SequentialNorm, public LinearResultStorage
     {
     public:
       /*! \brief make a linear solver object
 
-        \param[in] maxiter_ maximum number of iterations to do
-        \param[in] verbose_ print messages if true
+        \param[in] reuse_ reuse the factorisation until the pattern changes or invalidate() is called
         */
-      explicit EigenBackend_SPD_Base()
+      explicit EigenBackend_Direct_Base(bool reuse_=false)
+        : reuse(reuse_)
+        , revision(0)
       {}
 
+      /*! \brief Set whether the factorisation should be reused.
+
+        If set, the matrix is only refactorised if its pattern changes or after a call to
+        invalidate(). Use this if the values of the matrix are known not to change between
+        calls to apply().
+      */
+      void setReuse(bool reuse_)
+      {
+        reuse = reuse_;
+      }
+
+      //! Return whether the factorisation is reused.
+      bool getReuse() const
+      {
+        return reuse;
+      }
+
+      //! Marks the factorisation as outdated, e.g. because the matrix values have changed.
+      /**
+       * The symbolic analysis is kept, as it only depends on the pattern.
+       */
+      void invalidate()
+      {
+        ++revision;
+      }
+
       /*! \brief solve the given linear system
 
         \param[in] A the given matrix
@@ -205,27 +458,73 @@ namespace Dune {
       void apply(M& A, V& z, W& r, typename W::field_type reduction)
       {
         typedef typename M::Container Mat;
-        Solver<Mat, UpLo> solver;
+        typedef Solver<Mat> SolverImp;
+        typedef typename SolverImp::MatrixType SolverMat;
+        impl::EigenSolverHolder<SolverImp>& holder = impl::eigenSolverHolder<SolverImp>(cache);
+        SolverImp& solver = holder.solver;
         Dune::Timer watch;
         watch.reset();
-        solver.compute(A.base());
+        const bool pattern_changed = impl::eigenPatternChanged(holder,A.base());
+        if (pattern_changed || !reuse || !holder.computed || holder.revision != revision)
+          {
+            const SolverMat& mat = impl::eigenSolverMatrix(A.base(),scratch<SolverMat>(),pattern_changed);
+            if (pattern_changed)
+              solver.analyzePattern(mat);
+            solver.factorize(mat);
+            holder.computed = true;
+            holder.revision = revision;
+          }
         z.base() = solver.solve(r.base());
         double elapsed = watch.elapsed();
 
         res.converged  = solver.info() == Eigen::ComputationInfo::Success;
-        res.iterations = solver.iterations();
+        res.iterations = 1;
         res.elapsed    = elapsed;
-        res.reduction  = solver.error();
+        res.reduction  = 0.0;
         res.conv_rate  = 0;
       }
+
     private:
+
+      template<typename SolverMat>
+      impl::EigenScratchMatrix<SolverMat>& scratch()
+      {
+        std::shared_ptr<impl::EigenScratchMatrix<SolverMat> > s =
+          std::dynamic_pointer_cast<impl::EigenScratchMatrix<SolverMat> >(matrix_cache);
+        if (!s)
+          {
+            s = std::make_shared<impl::EigenScratchMatrix<SolverMat> >();
+            matrix_cache = s;
+          }
+        return *s;
+      }
+
+      bool reuse;
+      unsigned long revision;
+      std::shared_ptr<impl::EigenSolverHolderBase> cache;
+      std::shared_ptr<impl::EigenSolverHolderBase> matrix_cache;
+    };
+
+    template<template<class, int> class Solver, int UpLo>
+      class EigenBackend_SPD_Base
+      : public EigenBackend_Direct_Base<impl::EigenSPDSolver<Solver,UpLo>::template type>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] reuse_ reuse the factorisation as long as the matrix pattern does not change
+        */
+      explicit EigenBackend_SPD_Base(bool reuse_=false)
+        : EigenBackend_Direct_Base<impl::EigenSPDSolver<Solver,UpLo>::template type>(reuse_)
+      {}
     };
 
     class EigenBackend_SimplicialCholesky_Up
       : public EigenBackend_SPD_Base<Eigen::SimplicialCholesky, Eigen::Upper >
     {
     public:
-        explicit EigenBackend_SimplicialCholesky_Up()
+        explicit EigenBackend_SimplicialCholesky_Up(bool reuse_=false)
+          : EigenBackend_SPD_Base(reuse_)
         {}
     };
 
@@ -233,7 +532,35 @@ namespace Dune {
       : public EigenBackend_SPD_Base<Eigen::SimplicialCholesky, Eigen::Lower >
     {
     public:
-        explicit EigenBackend_SimplicialCholesky_Lo()
+        explicit EigenBackend_SimplicialCholesky_Lo(bool reuse_=false)
+          : EigenBackend_SPD_Base(reuse_)
+        {}
+    };
+
+    class EigenBackend_SimplicialLDLT_Up
+      : public EigenBackend_Direct_Base<impl::EigenSimplicialLDLT<Eigen::Upper>::type>
+    {
+    public:
+        explicit EigenBackend_SimplicialLDLT_Up(bool reuse_=false)
+          : EigenBackend_Direct_Base(reuse_)
+        {}
+    };
+
+    class EigenBackend_SimplicialLDLT_Lo
+      : public EigenBackend_Direct_Base<impl::EigenSimplicialLDLT<Eigen::Lower>::type>
+    {
+    public:
+        explicit EigenBackend_SimplicialLDLT_Lo(bool reuse_=false)
+          : EigenBackend_Direct_Base(reuse_)
+        {}
+    };
+
+    class EigenBackend_SparseLU
+      : public EigenBackend_Direct_Base<impl::EigenSparseLU::type>
+    {
+    public:
+        explicit EigenBackend_SparseLU(bool reuse_=false)
+          : EigenBackend_Direct_Base(reuse_)
         {}
     };
 
@@ -0,0 +1,461 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_PDELAB_BACKEND_ISTL_DIRECTSOLVERCACHE_HH
+#define DUNE_PDELAB_BACKEND_ISTL_DIRECTSOLVERCACHE_HH
+
+#include <complex>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#if HAVE_UMFPACK
+#include <dune/istl/umfpack.hh>
+#endif
+
+namespace Dune {
+  namespace PDELab {
+    namespace istl {
+
+      //! Statistics about the factorisations performed by a caching direct solver backend.
+      struct DirectSolverStatistics
+      {
+        //! The number of symbolic analyses (ordering + symbolic factorisation).
+        std::size_t symbolic_factorizations;
+        //! The number of numeric factorisations.
+        std::size_t numeric_factorizations;
+        //! The number of right hand sides that have been solved for.
+        std::size_t solves;
+        //! The time spent in the last symbolic analysis.
+        double tsymbolic;
+        //! The time spent in the last numeric factorisation.
+        double tnumeric;
+        //! The time spent in the last call to apply(), without factorisation.
+        double tsolve;
+
+        DirectSolverStatistics()
+          : symbolic_factorizations(0)
+          , numeric_factorizations(0)
+          , solves(0)
+          , tsymbolic(0.0)
+          , tnumeric(0.0)
+          , tsolve(0.0)
+        {}
+      };
+
+      //! Type-erased base class for the factorisation data cached by a direct solver backend.
+      /**
+       * The solver backends are not templated on the matrix type, so they store their
+       * cached factorisation through a pointer to this base class and recover the concrete
+       * type with a dynamic_pointer_cast.
+       */
+      struct SolverCacheBase
+      {
+        virtual ~SolverCacheBase()
+        {}
+      };
+
+      //! The former name of SolverCacheBase.
+      typedef SolverCacheBase DirectSolverCacheBase;
+
+      //! Keeps a flat copy of the pattern and the values of a BCRSMatrix to detect changes.
+      /**
+       * A direct solver backend can use this class to figure out whether the matrix it
+       * has been handed has changed since the last factorisation. The comparison is exact,
+       * i.e. the snapshot stores a copy of the column indices and of all scalar entries.
+       * Compared to the size of a sparse LU factorisation, this overhead is negligible.
+       *
+       * \tparam M  A BCRSMatrix with FieldMatrix blocks.
+       */
+      template<typename M>
+      class BCRSMatrixSnapshot
+      {
+
+        typedef typename M::block_type Block;
+        typedef typename Block::field_type field_type;
+
+        static const int rows_per_block = Block::rows;
+        static const int cols_per_block = Block::cols;
+
+      public:
+
+        //! Result of comparing a matrix with the stored snapshot.
+        enum Change {
+          //! Neither the pattern nor the values have changed.
+          unchanged,
+          //! The pattern is identical, but at least one value has changed.
+          values_changed,
+          //! The pattern has changed (or there was no snapshot yet).
+          pattern_changed
+        };
+
+        BCRSMatrixSnapshot()
+          : _valid(false)
+        {}
+
+        //! Compares the matrix with the snapshot and updates the snapshot to reflect the matrix.
+        Change update(const M& m)
+        {
+          if (!_valid || !samePattern(m))
+            {
+              storePattern(m);
+              storeValues(m);
+              _valid = true;
+              return pattern_changed;
+            }
+          if (sameValues(m))
+            return unchanged;
+          storeValues(m);
+          return values_changed;
+        }
+
+        //! Forgets the stored snapshot, the next call to update() will report a pattern change.
+        void reset()
+        {
+          _valid = false;
+          _row_sizes.clear();
+          _col_indices.clear();
+          _values.clear();
+        }
+
+      private:
+
+        bool samePattern(const M& m) const
+        {
+          if (m.N() != _row_sizes.size() || m.nonzeroes() != _col_indices.size())
+            return false;
+          std::size_t k = 0;
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            {
+              if (row->size() != _row_sizes[row.index()])
+                return false;
+              for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col, ++k)
+                if (col.index() != _col_indices[k])
+                  return false;
+            }
+          return true;
+        }
+
+        bool sameValues(const M& m) const
+        {
+          typename std::vector<field_type>::const_iterator v = _values.begin();
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              for (int i = 0; i < rows_per_block; ++i)
+                for (int j = 0; j < cols_per_block; ++j, ++v)
+                  if ((*col)[i][j] != *v)
+                    return false;
+          return true;
+        }
+
+        void storePattern(const M& m)
+        {
+          _row_sizes.resize(m.N());
+          _col_indices.resize(m.nonzeroes());
+          std::size_t k = 0;
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            {
+              _row_sizes[row.index()] = row->size();
+              for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col, ++k)
+                _col_indices[k] = col.index();
+            }
+        }
+
+        void storeValues(const M& m)
+        {
+          _values.resize(m.nonzeroes() * rows_per_block * cols_per_block);
+          typename std::vector<field_type>::iterator v = _values.begin();
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              for (int i = 0; i < rows_per_block; ++i)
+                for (int j = 0; j < cols_per_block; ++j, ++v)
+                  *v = (*col)[i][j];
+        }
+
+        bool _valid;
+        std::vector<std::size_t> _row_sizes;
+        std::vector<std::size_t> _col_indices;
+        std::vector<field_type> _values;
+
+      };
+
+#if HAVE_UMFPACK || DOXYGEN
+
+#ifndef DOXYGEN
+
+      namespace impl {
+
+        // Forwards to the UMFPack routines for the field type T, using long indices.
+        // Only double (umfpack_dl_*) and std::complex<double> (umfpack_zl_*) are supported.
+        template<typename T>
+        struct UMFPackCaller;
+
+        template<>
+        struct UMFPackCaller<double>
+        {
+          typedef SuiteSparse_long index_type;
+
+          static void defaults(double* control)
+          {
+            umfpack_dl_defaults(control);
+          }
+
+          static void symbolic(index_type n, const index_type* col_start, const index_type* row_index,
+                               const double* values, void** symbolic, const double* control, double* info)
+          {
+            umfpack_dl_symbolic(n,n,col_start,row_index,values,symbolic,control,info);
+          }
+
+          static void numeric(const index_type* col_start, const index_type* row_index, const double* values,
+                              void* symbolic, void** numeric, const double* control, double* info)
+          {
+            umfpack_dl_numeric(col_start,row_index,values,symbolic,numeric,control,info);
+          }
+
+          static void solve(const index_type* col_start, const index_type* row_index, const double* values,
+                            double* x, const double* b, void* numeric, const double* control, double* info)
+          {
+            umfpack_dl_solve(UMFPACK_A,col_start,row_index,values,x,b,numeric,control,info);
+          }
+
+          static void free_symbolic(void** symbolic)
+          {
+            umfpack_dl_free_symbolic(symbolic);
+          }
+
+          static void free_numeric(void** numeric)
+          {
+            umfpack_dl_free_numeric(numeric);
+          }
+        };
+
+        // The complex values are passed in packed form, i.e. with interleaved real and
+        // imaginary parts and a null pointer for the separate imaginary array.
+        template<>
+        struct UMFPackCaller<std::complex<double> >
+        {
+          typedef SuiteSparse_long index_type;
+
+          static void defaults(double* control)
+          {
+            umfpack_zl_defaults(control);
+          }
+
+          static void symbolic(index_type n, const index_type* col_start, const index_type* row_index,
+                               const std::complex<double>* values, void** symbolic, const double* control, double* info)
+          {
+            umfpack_zl_symbolic(n,n,col_start,row_index,reinterpret_cast<const double*>(values),nullptr,
+                                symbolic,control,info);
+          }
+
+          static void numeric(const index_type* col_start, const index_type* row_index, const std::complex<double>* values,
+                              void* symbolic, void** numeric, const double* control, double* info)
+          {
+            umfpack_zl_numeric(col_start,row_index,reinterpret_cast<const double*>(values),nullptr,
+                               symbolic,numeric,control,info);
+          }
+
+          static void solve(const index_type* col_start, const index_type* row_index, const std::complex<double>* values,
+                            std::complex<double>* x, const std::complex<double>* b, void* numeric,
+                            const double* control, double* info)
+          {
+            umfpack_zl_solve(UMFPACK_A,col_start,row_index,reinterpret_cast<const double*>(values),nullptr,
+                             reinterpret_cast<double*>(x),nullptr,reinterpret_cast<const double*>(b),nullptr,
+                             numeric,control,info);
+          }
+
+          static void free_symbolic(void** symbolic)
+          {
+            umfpack_zl_free_symbolic(symbolic);
+          }
+
+          static void free_numeric(void** numeric)
+          {
+            umfpack_zl_free_numeric(numeric);
+          }
+        };
+
+      } // namespace impl
+
+#endif // DOXYGEN
+
+      //! UMFPack factorisation of a BCRSMatrix with separate symbolic and numeric phases.
+      /**
+       * In contrast to Dune::UMFPack, this class exposes the two phases of the UMFPack
+       * factorisation: analyzePattern() computes the fill-reducing ordering and the symbolic
+       * factorisation and only has to be repeated if the sparsity pattern changes, while
+       * factorize() recomputes the numeric factors for new matrix values.
+       *
+       * Warnings reported by UMFPack (e.g. a singular matrix) are not fatal; they are
+       * printed if verbose is positive. Only errors raise a Dune::MathError.
+       *
+       * \tparam M  A BCRSMatrix with FieldMatrix<double,n,n> or
+       *            FieldMatrix<std::complex<double>,n,n> blocks.
+       */
+      template<typename M>
+      class UMFPackFactorization
+      {
+
+        typedef typename M::block_type Block;
+        typedef typename Block::field_type field_type;
+        typedef impl::UMFPackCaller<field_type> Caller;
+        typedef typename Caller::index_type index_type;
+
+        static const int rows_per_block = Block::rows;
+        static const int cols_per_block = Block::cols;
+
+      public:
+
+        explicit UMFPackFactorization(int verbose = 0)
+          : _n(0)
+          , _symbolic(nullptr)
+          , _numeric(nullptr)
+          , _verbose(verbose)
+        {
+          Caller::defaults(_control);
+          _control[UMFPACK_PRL] = verbose;
+        }
+
+        ~UMFPackFactorization()
+        {
+          free();
+        }
+
+        UMFPackFactorization(const UMFPackFactorization&) = delete;
+        UMFPackFactorization& operator=(const UMFPackFactorization&) = delete;
+
+        //! Computes the column ordering and the symbolic factorisation of m.
+        void analyzePattern(const M& m)
+        {
+          free();
+          buildPattern(m);
+          copyValues(m);
+          Caller::symbolic(_n, _col_start.data(), _row_index.data(), _values.data(),
+                           &_symbolic, _control, _info);
+          checkStatus("symbolic factorization");
+        }
+
+        //! Computes the numeric factorisation of m, which must have the pattern passed to analyzePattern().
+        void factorize(const M& m)
+        {
+          if (!_symbolic)
+            DUNE_THROW(Dune::InvalidStateException,"UMFPackFactorization: factorize() called before analyzePattern()");
+          if (_numeric)
+            Caller::free_numeric(&_numeric);
+          copyValues(m);
+          Caller::numeric(_col_start.data(), _row_index.data(), _values.data(),
+                          _symbolic, &_numeric, _control, _info);
+          checkStatus("numeric factorization");
+        }
+
+        //! Solves A x = b with the current factorisation.
+        template<typename X, typename Y>
+        void solve(X& x, const Y& b)
+        {
+          if (!_numeric)
+            DUNE_THROW(Dune::InvalidStateException,"UMFPackFactorization: solve() called before factorize()");
+          _x.resize(_n);
+          _b.resize(_n);
+          std::size_t k = 0;
+          for (typename Y::const_iterator bit = b.begin(); bit != b.end(); ++bit)
+            for (int i = 0; i < rows_per_block; ++i, ++k)
+              _b[k] = (*bit)[i];
+          Caller::solve(_col_start.data(), _row_index.data(), _values.data(),
+                        _x.data(), _b.data(), _numeric, _control, _info);
+          checkStatus("solve");
+          k = 0;
+          for (typename X::iterator xit = x.begin(); xit != x.end(); ++xit)
+            for (int i = 0; i < cols_per_block; ++i, ++k)
+              (*xit)[i] = _x[k];
+        }
+
+        //! Releases all factorisation data held by UMFPack.
+        void free()
+        {
+          if (_numeric)
+            Caller::free_numeric(&_numeric);
+          if (_symbolic)
+            Caller::free_symbolic(&_symbolic);
+          _numeric = nullptr;
+          _symbolic = nullptr;
+        }
+
+      private:
+
+        // Builds the scalar compressed column structure of m and remembers for every
+        // scalar entry in BCRS traversal order its position in the CSC value array.
+        void buildPattern(const M& m)
+        {
+          static_assert(rows_per_block == cols_per_block,
+                        "UMFPackFactorization requires square blocks");
+          _n = m.N() * rows_per_block;
+          const std::size_t nnz = m.nonzeroes() * rows_per_block * cols_per_block;
+
+          _col_start.assign(_n + 1,0);
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              for (int j = 0; j < cols_per_block; ++j)
+                _col_start[col.index() * cols_per_block + j + 1] += rows_per_block;
+          for (index_type c = 0; c < _n; ++c)
+            _col_start[c+1] += _col_start[c];
+
+          std::vector<index_type> next(_col_start.begin(),_col_start.end() - 1);
+          _row_index.resize(nnz);
+          _values.resize(nnz);
+          _positions.resize(nnz);
+          std::size_t k = 0;
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              for (int i = 0; i < rows_per_block; ++i)
+                for (int j = 0; j < cols_per_block; ++j, ++k)
+                  {
+                    const index_type pos = next[col.index() * cols_per_block + j]++;
+                    _row_index[pos] = row.index() * rows_per_block + i;
+                    _positions[k] = pos;
+                  }
+        }
+
+        void copyValues(const M& m)
+        {
+          std::size_t k = 0;
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              for (int i = 0; i < rows_per_block; ++i)
+                for (int j = 0; j < cols_per_block; ++j, ++k)
+                  _values[_positions[k]] = (*col)[i][j];
+        }
+
+        // UMFPack reports errors with negative and warnings with positive status values
+        void checkStatus(const char* phase) const
+        {
+          const double status = _info[UMFPACK_STATUS];
+          if (status < UMFPACK_OK)
+            DUNE_THROW(Dune::MathError,"UMFPack " << phase << " failed with status " << status);
+          if (status > UMFPACK_OK && _verbose > 0)
+            std::cerr << "UMFPack " << phase << " reported warning " << status << std::endl;
+        }
+
+        index_type _n;
+        std::vector<index_type> _col_start;
+        std::vector<index_type> _row_index;
+        std::vector<field_type> _values;
+        std::vector<index_type> _positions;
+        std::vector<field_type> _x;
+        std::vector<field_type> _b;
+        void* _symbolic;
+        void* _numeric;
+        int _verbose;
+        double _control[UMFPACK_CONTROL];
+        double _info[UMFPACK_INFO];
+
+      };
+
+#endif // HAVE_UMFPACK || DOXYGEN
+
+    } // namespace istl
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_ISTL_DIRECTSOLVERCACHE_HH
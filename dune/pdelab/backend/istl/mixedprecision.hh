@@ -0,0 +1,439 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_PDELAB_BACKEND_ISTL_MIXEDPRECISION_HH
+#define DUNE_PDELAB_BACKEND_ISTL_MIXEDPRECISION_HH
+
+#include <cstddef>
+#include <memory>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/istl/bcrsmatrix.hh>
+#include <dune/istl/bvector.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/preconditioners.hh>
+#include <dune/istl/solvercategory.hh>
+#include <dune/istl/paamg/amg.hh>
+
+#include <dune/pdelab/backend/istl/directsolvercache.hh>
+
+namespace Dune {
+  namespace PDELab {
+    namespace istl {
+
+      //! \addtogroup Backend
+      //! \ingroup PDELab
+      //! \{
+
+      //! TMP for obtaining the single precision version of an ISTL container.
+      /**
+       * Only flat containers (BCRSMatrix of FieldMatrix, BlockVector of FieldVector)
+       * are supported, as these are the only ones the ISTL preconditioners can work on.
+       */
+      template<typename C>
+      struct float_container;
+
+#ifndef DOXYGEN
+
+      template<typename T, int n, int m, typename A>
+      struct float_container<Dune::BCRSMatrix<Dune::FieldMatrix<T,n,m>,A> >
+      {
+        typedef Dune::FieldMatrix<float,n,m> block_type;
+        typedef Dune::BCRSMatrix<block_type,typename A::template rebind<block_type>::other> type;
+      };
+
+      template<typename T, int n, typename A>
+      struct float_container<Dune::BlockVector<Dune::FieldVector<T,n>,A> >
+      {
+        typedef Dune::FieldVector<float,n> block_type;
+        typedef Dune::BlockVector<block_type,typename A::template rebind<block_type>::other> type;
+      };
+
+#endif // DOXYGEN
+
+      //! Copies a flat block vector into a block vector with a different field type.
+      template<typename X, typename Y>
+      void convert_vector(const X& x, Y& y)
+      {
+        if (y.N() != x.N())
+          y = Y(x.N());
+        typename Y::iterator yit = y.begin();
+        for (typename X::const_iterator xit = x.begin(); xit != x.end(); ++xit, ++yit)
+          for (std::size_t k = 0; k < xit->size(); ++k)
+            (*yit)[k] = (*xit)[k];
+      }
+
+      //! Single precision copy of a BCRSMatrix that tracks whether its values change.
+      /**
+       * update() compares the rounded values of the source matrix with the stored copy
+       * in a single pass, so the copy never needs a second double precision snapshot to
+       * detect changes. Changes of the source values that vanish in the rounding to float
+       * do not count as changes, as they would not influence a preconditioner built from
+       * the copy.
+       */
+      template<typename M>
+      class FloatMatrixCopy
+      {
+
+      public:
+
+        typedef typename float_container<M>::type FloatMatrix;
+
+        FloatMatrixCopy()
+        {}
+
+        //! Updates the copy from m and returns whether the copy has changed.
+        bool update(const M& m)
+        {
+          if (!_m || !copyValues(m))
+            {
+              buildPattern(m);
+              copyValues(m);
+              return true;
+            }
+          return _changed;
+        }
+
+        //! The single precision matrix.
+        const FloatMatrix& matrix() const
+        {
+          return *_m;
+        }
+
+      private:
+
+        void buildPattern(const M& m)
+        {
+          _m = std::make_shared<FloatMatrix>(m.N(),m.M(),m.nonzeroes(),FloatMatrix::row_wise);
+          typename M::ConstRowIterator row = m.begin();
+          for (typename FloatMatrix::CreateIterator frow = _m->createbegin(); frow != _m->createend(); ++frow, ++row)
+            for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col)
+              frow.insert(col.index());
+        }
+
+        // Copies the values and sets _changed. Returns false if the patterns do not match.
+        bool copyValues(const M& m)
+        {
+          _changed = false;
+          if (_m->N() != m.N() || _m->M() != m.M() || _m->nonzeroes() != m.nonzeroes())
+            return false;
+          typename FloatMatrix::RowIterator frow = _m->begin();
+          for (typename M::ConstRowIterator row = m.begin(); row != m.end(); ++row, ++frow)
+            {
+              if (row->size() != frow->size())
+                return false;
+              typename FloatMatrix::ColIterator fcol = frow->begin();
+              for (typename M::ConstColIterator col = row->begin(); col != row->end(); ++col, ++fcol)
+                {
+                  if (col.index() != fcol.index())
+                    return false;
+                  for (int i = 0; i < M::block_type::rows; ++i)
+                    for (int j = 0; j < M::block_type::cols; ++j)
+                      {
+                        const float v = static_cast<float>((*col)[i][j]);
+                        if ((*fcol)[i][j] != v)
+                          {
+                            (*fcol)[i][j] = v;
+                            _changed = true;
+                          }
+                      }
+                }
+            }
+          return true;
+        }
+
+        std::shared_ptr<FloatMatrix> _m;
+        bool _changed;
+
+      };
+
+      //! Sequential preconditioner that works on a single precision copy of the matrix.
+      /**
+       * The preconditioner is built from a float copy of the matrix and applied to float
+       * copies of the defect and the correction, while the outer Krylov method continues to
+       * work in the precision of the assembled system. As preconditioner application is
+       * bandwidth bound, halving the size of the matrix entries roughly doubles its
+       * throughput.
+       *
+       * The float preconditioner is created by a factory (see SeqRelaxationFactory,
+       * SeqILU0Factory, SeqILUnFactory and SeqAMGFactory) and only rebuilt by update() if
+       * the float copy of the matrix has changed.
+       *
+       * \tparam M        The matrix type of the assembled system.
+       * \tparam X        The domain type.
+       * \tparam Y        The range type.
+       * \tparam Factory  Factory for the single precision preconditioner.
+       */
+      template<typename M, typename X, typename Y, typename Factory>
+      class MixedPrecisionPreconditioner
+        : public Dune::Preconditioner<X,Y>
+      {
+
+        typedef FloatMatrixCopy<M> Copy;
+        typedef typename Copy::FloatMatrix FloatMatrix;
+        typedef typename float_container<X>::type FloatX;
+        typedef typename float_container<Y>::type FloatY;
+
+      public:
+
+        typedef M matrix_type;
+        typedef X domain_type;
+        typedef Y range_type;
+        typedef typename X::field_type field_type;
+
+        enum {
+          //! \brief The category the preconditioner is part of.
+          category=Dune::SolverCategory::sequential
+        };
+
+        MixedPrecisionPreconditioner(const M& A, const Factory& factory)
+          : _factory(factory)
+        {
+          update(A);
+        }
+
+        //! Refreshes the float copy of A and rebuilds the preconditioner if it has changed.
+        /**
+         * \returns true if the preconditioner has been rebuilt.
+         */
+        bool update(const M& A)
+        {
+          if (!_copy.update(A) && _prec)
+            return false;
+          _prec = _factory.template create<FloatMatrix,FloatX,FloatY>(_copy.matrix());
+          return true;
+        }
+
+        // The float preconditioner only sees copies in pre() and post(), writing them
+        // back would truncate the iterate of the outer method to single precision.
+        virtual void pre(X& x, Y& b)
+        {
+          convert_vector(x,_x);
+          convert_vector(b,_b);
+          _prec->pre(_x,_b);
+        }
+
+        virtual void apply(X& v, const Y& d)
+        {
+          convert_vector(d,_b);
+          if (_x.N() != _b.N())
+            _x = FloatX(_b.N());
+          _x = 0.0;
+          _prec->apply(_x,_b);
+          convert_vector(_x,v);
+        }
+
+        virtual void post(X& x)
+        {
+          convert_vector(x,_x);
+          _prec->post(_x);
+        }
+
+      private:
+
+        Factory _factory;
+        Copy _copy;
+        std::shared_ptr<Dune::Preconditioner<FloatX,FloatY> > _prec;
+        FloatX _x;
+        FloatY _b;
+
+      };
+
+      //! Keeps a MixedPrecisionPreconditioner alive between calls to a solver backend.
+      /**
+       * The solver backends do not know the matrix and vector types at construction time,
+       * so the cache stores the preconditioner type-erased and recreates it if it is asked
+       * for a different combination of types.
+       */
+      template<typename Factory>
+      class MixedPrecisionPreconditionerCache
+      {
+
+        template<typename M, typename X, typename Y>
+        struct Entry
+          : public SolverCacheBase
+        {
+          std::shared_ptr<MixedPrecisionPreconditioner<M,X,Y,Factory> > prec;
+        };
+
+      public:
+
+        explicit MixedPrecisionPreconditionerCache(const Factory& factory)
+          : _factory(factory)
+        {}
+
+        //! Returns the preconditioner for A, updated to the current values of A.
+        template<typename M, typename X, typename Y>
+        MixedPrecisionPreconditioner<M,X,Y,Factory>& get(const M& A)
+        {
+          std::shared_ptr<Entry<M,X,Y> > entry = std::dynamic_pointer_cast<Entry<M,X,Y> >(_entry);
+          if (!entry)
+            {
+              entry = std::make_shared<Entry<M,X,Y> >();
+              _entry = entry;
+            }
+          if (entry->prec)
+            entry->prec->update(A);
+          else
+            entry->prec = std::make_shared<MixedPrecisionPreconditioner<M,X,Y,Factory> >(A,_factory);
+          return *entry->prec;
+        }
+
+        //! Drops the cached preconditioner.
+        void reset()
+        {
+          _entry.reset();
+        }
+
+      private:
+        Factory _factory;
+        std::shared_ptr<SolverCacheBase> _entry;
+      };
+
+      //! Factory for the relaxation-type preconditioners of ISTL (SeqJac, SeqSOR, SeqSSOR).
+      template<template<class,class,class,int> class Preconditioner>
+      class SeqRelaxationFactory
+      {
+
+      public:
+
+        SeqRelaxationFactory(int steps = 1, double w = 1.0)
+          : _steps(steps)
+          , _w(w)
+        {}
+
+        template<typename M, typename X, typename Y>
+        std::shared_ptr<Dune::Preconditioner<X,Y> > create(const M& A) const
+        {
+          return std::make_shared<Preconditioner<M,X,Y,1> >(A,_steps,_w);
+        }
+
+      private:
+        int _steps;
+        double _w;
+      };
+
+      //! Factory for SeqILU0.
+      class SeqILU0Factory
+      {
+
+      public:
+
+        explicit SeqILU0Factory(double w = 1.0)
+          : _w(w)
+        {}
+
+        template<typename M, typename X, typename Y>
+        std::shared_ptr<Dune::Preconditioner<X,Y> > create(const M& A) const
+        {
+          return std::make_shared<Dune::SeqILU0<M,X,Y,1> >(A,_w);
+        }
+
+      private:
+        double _w;
+      };
+
+      //! Factory for SeqILUn.
+      class SeqILUnFactory
+      {
+
+      public:
+
+        explicit SeqILUnFactory(int n = 1, double w = 1.0)
+          : _n(n)
+          , _w(w)
+        {}
+
+        template<typename M, typename X, typename Y>
+        std::shared_ptr<Dune::Preconditioner<X,Y> > create(const M& A) const
+        {
+          return std::make_shared<Dune::SeqILUn<M,X,Y,1> >(A,_n,_w);
+        }
+
+      private:
+        int _n;
+        double _w;
+      };
+
+#ifndef DOXYGEN
+
+      // Owns the matrix operator together with the AMG hierarchy built on top of it.
+      template<typename M, typename X, typename Y, template<class,class,class,int> class Smoother>
+      class SeqAMGPreconditioner
+        : public Dune::Preconditioner<X,Y>
+      {
+
+        typedef Dune::MatrixAdapter<M,X,Y> Operator;
+        typedef Smoother<M,X,Y,1> SmootherType;
+        typedef typename Dune::Amg::SmootherTraits<SmootherType>::Arguments SmootherArgs;
+        typedef Dune::Amg::CoarsenCriterion<Dune::Amg::SymmetricCriterion<M,Dune::Amg::FirstDiagonal> > Criterion;
+        typedef Dune::Amg::AMG<Operator,X,SmootherType> AMG;
+
+      public:
+
+        enum {
+          category=Dune::SolverCategory::sequential
+        };
+
+        SeqAMGPreconditioner(const M& A, const Dune::Amg::Parameters& params)
+          : _op(A)
+        {
+          SmootherArgs smootherArgs;
+          smootherArgs.iterations = 1;
+          smootherArgs.relaxationFactor = 1;
+          Criterion criterion(params);
+          _amg = std::make_shared<AMG>(_op,criterion,smootherArgs);
+        }
+
+        virtual void pre(X& x, Y& b)
+        {
+          _amg->pre(x,b);
+        }
+
+        virtual void apply(X& v, const Y& d)
+        {
+          _amg->apply(v,d);
+        }
+
+        virtual void post(X& x)
+        {
+          _amg->post(x);
+        }
+
+      private:
+        Operator _op;
+        std::shared_ptr<AMG> _amg;
+      };
+
+#endif // DOXYGEN
+
+      //! Factory for a sequential AMG preconditioner with the given smoother.
+      template<template<class,class,class,int> class Smoother>
+      class SeqAMGFactory
+      {
+
+      public:
+
+        explicit SeqAMGFactory(const Dune::Amg::Parameters& params)
+          : _params(params)
+        {}
+
+        template<typename M, typename X, typename Y>
+        std::shared_ptr<Dune::Preconditioner<X,Y> > create(const M& A) const
+        {
+          return std::make_shared<SeqAMGPreconditioner<M,X,Y,Smoother> >(A,_params);
+        }
+
+      private:
+        Dune::Amg::Parameters _params;
+      };
+
+      //! \} group Backend
+
+    } // namespace istl
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_ISTL_MIXEDPRECISION_HH
@@ -4,6 +4,7 @@
 #define DUNE_PDELAB_BACKEND_ISTL_PARALLELHELPER_HH
 
 #include <limits>
+#include <type_traits>
 
 #include <dune/common/deprecated.hh>
 #include <dune/common/parallel/mpihelper.hh>
@@ -23,6 +24,7 @@
 #include <dune/pdelab/constraints/common/constraints.hh>
 #include <dune/pdelab/gridfunctionspace/genericdatahandle.hh>
 #include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/common/blas1.hh>
 #include <dune/pdelab/backend/istl/utility.hh>
 #include <dune/pdelab/gridfunctionspace/tags.hh>
 
@@ -156,7 +158,17 @@ namespace Dune {
           >::PromotedType
         disjointDot(const X& x, const Y& y) const
         {
-          return disjointDot(istl::container_tag(istl::raw(x)),
+          typedef typename istl::raw_type<X>::type RawX;
+          typedef typename istl::raw_type<Y>::type RawY;
+          typedef typename istl::raw_type<RankVector>::type RawMask;
+          typedef std::integral_constant<
+            bool,
+            istl::flat_vector<RawX>::value &&
+            istl::flat_vector<RawY>::value &&
+            istl::flat_vector<RawMask>::value &&
+            std::is_same<typename X::field_type,typename Y::field_type>::value
+            > Flat;
+          return disjointDot(Flat(),
                              istl::raw(x),
                              istl::raw(y),
                              istl::raw(_ranks)
@@ -165,6 +177,29 @@ namespace Dune {
 
       private:
 
+        // Vectors with a single level of blocking are handled by the BLAS-1 kernels on
+        // their flat storage.
+        template<typename X, typename Y, typename Mask>
+        typename X::field_type
+        disjointDot(std::true_type, const X& x, const Y& y, const Mask& mask) const
+        {
+          return blas1::masked_dot(istl::flat_vector<X>::size(x),
+                                   istl::flat_vector<X>::data(x),
+                                   istl::flat_vector<Y>::data(y),
+                                   istl::flat_vector<Mask>::data(mask),
+                                   _rank);
+        }
+
+        template<typename X, typename Y, typename Mask>
+        typename PromotionTraits<
+          typename X::field_type,
+          typename Y::field_type
+          >::PromotedType
+        disjointDot(std::false_type, const X& x, const Y& y, const Mask& mask) const
+        {
+          return disjointDot(istl::container_tag(x),x,y,mask);
+        }
+
         // Implementation for BlockVector, collects the result of recursively
         // invoking the algorithm on the vector blocks.
         template<typename X, typename Y, typename Mask>
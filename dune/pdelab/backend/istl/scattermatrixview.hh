@@ -0,0 +1,258 @@
+// -*- tab-width: 4; indent-tabs-mode: nil -*-
+#ifndef DUNE_PDELAB_BACKEND_ISTL_SCATTERMATRIXVIEW_HH
+#define DUNE_PDELAB_BACKEND_ISTL_SCATTERMATRIXVIEW_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/istl/bcrsmatrix.hh>
+
+#include <dune/pdelab/backend/common/uncachedmatrixview.hh>
+#include <dune/pdelab/common/exceptions.hh>
+
+namespace Dune {
+  namespace PDELab {
+    namespace istl {
+
+      //! Tests whether M is a BCRSMatrix with FieldMatrix blocks, i.e. has a single level of sparse blocking.
+      template<typename M>
+      struct is_flat_bcrs_matrix
+      {
+        static const bool value = false;
+      };
+
+      template<typename E, int n, int m, typename A>
+      struct is_flat_bcrs_matrix<Dune::BCRSMatrix<Dune::FieldMatrix<E,n,m>,A> >
+      {
+        static const bool value = true;
+      };
+
+      //! Local matrix view for BCRS matrices that scatters through a precomputed position table.
+      /**
+       * Adding an entry to a BCRSMatrix through its container index requires a binary search
+       * in the matrix row for every single entry. This view instead computes the addresses of
+       * all entries coupling the DOFs of the bound row and column caches in a single pass:
+       * the column blocks of the cell are sorted once and then merged with each BCRS row of
+       * the cell. Afterwards, adding a local entry is a plain indexed add.
+       *
+       * The table is built lazily on the first local add() after bind(), so views that are
+       * bound but never written to do not pay for it. If the DOFs of the bound caches are
+       * the same as for the current table, e.g. when a cell is bound again for another
+       * assembly pass, the table is kept. Entries addressed by container index (as they
+       * occur for constrained DOFs) still go through the regular access path.
+       *
+       * Local entries that are not part of the matrix pattern can only receive zeros;
+       * adding a non-zero value to them throws a MatrixPatternError.
+       *
+       * \tparam M_  An ISTLMatrixContainer wrapping a BCRSMatrix with FieldMatrix blocks.
+       */
+      template<typename M_, typename RowCache, typename ColCache>
+      class ScatterMatrixView
+        : public UncachedMatrixView<M_,RowCache,ColCache>
+      {
+
+        typedef UncachedMatrixView<M_,RowCache,ColCache> BaseT;
+        typedef typename M_::Container Matrix;
+        typedef typename Matrix::block_type Block;
+
+        static_assert(is_flat_bcrs_matrix<Matrix>::value,
+                      "ScatterMatrixView only supports BCRSMatrix<FieldMatrix>");
+
+      public:
+
+        typedef typename BaseT::Container Container;
+        typedef typename BaseT::ElementType ElementType;
+        typedef typename BaseT::size_type size_type;
+
+        using BaseT::rowIndexCache;
+        using BaseT::colIndexCache;
+        using BaseT::N;
+        using BaseT::M;
+        using BaseT::container;
+        using BaseT::add;
+
+        ScatterMatrixView()
+          : _table_valid(false)
+          , _table_built(false)
+          , _sink(0)
+        {}
+
+        ScatterMatrixView(Container& container)
+          : BaseT(container)
+          , _table_valid(false)
+          , _table_built(false)
+          , _sink(0)
+        {}
+
+        void attach(Container& container)
+        {
+          BaseT::attach(container);
+          _table_valid = false;
+          _table_built = false;
+        }
+
+        void detach()
+        {
+          BaseT::detach();
+          _table_valid = false;
+          _table_built = false;
+        }
+
+        void bind(const RowCache& row_cache, const ColCache& col_cache)
+        {
+          BaseT::bind(row_cache,col_cache);
+          _table_valid = false;
+        }
+
+        template<typename LC>
+        void add(const LC& local_container)
+        {
+          if (!_table_valid)
+            update_table();
+          const size_type n = N();
+          const size_type m = M();
+          for (size_type i = 0; i < n; ++i)
+            for (size_type j = 0; j < m; ++j)
+              {
+                ElementType* entry = _entries[i*m + j];
+                if (entry != &_sink)
+                  *entry += local_container.getEntry(i,j);
+                else if (local_container.getEntry(i,j) != ElementType(0))
+                  out_of_pattern(i,j);
+              }
+        }
+
+        void add(size_type i, size_type j, const ElementType& v)
+        {
+          if (!_table_valid)
+            update_table();
+          ElementType* entry = _entries[i*M() + j];
+          if (entry != &_sink)
+            *entry += v;
+          else if (v != ElementType(0))
+            out_of_pattern(i,j);
+        }
+
+      private:
+
+        typedef std::pair<std::size_t,std::size_t> Index;
+
+        // block index and index within the block of a container index of a flat BCRS matrix
+        template<typename CI>
+        static Index split(const CI& ci)
+        {
+          return Index(std::size_t(ci.back()), ci.size() > 1 ? std::size_t(ci[0]) : std::size_t(0));
+        }
+
+        // entries outside of the pattern may only receive zeros, the assemblers add those
+        // for couplings that the local operator does not declare
+        void out_of_pattern(size_type i, size_type j) const
+        {
+          DUNE_THROW(MatrixPatternError,"non-zero entry (" << rowIndexCache().containerIndex(i)
+                     << "," << colIndexCache().containerIndex(j)
+                     << ") is not part of the matrix pattern");
+        }
+
+        // computes the indices of the bound DOFs and rebuilds the table if they changed
+        void update_table()
+        {
+          const size_type n = N();
+          const size_type m = M();
+
+          bool same = _table_built && _row_indices.size() == n && _col_indices.size() == m;
+          _row_indices.resize(n);
+          _col_indices.resize(m);
+          for (size_type i = 0; i < n; ++i)
+            {
+              const Index index = split(rowIndexCache().containerIndex(i));
+              same = same && _row_indices[i] == index;
+              _row_indices[i] = index;
+            }
+          for (size_type j = 0; j < m; ++j)
+            {
+              const Index index = split(colIndexCache().containerIndex(j));
+              same = same && _col_indices[j] == index;
+              _col_indices[j] = index;
+            }
+
+          if (!same)
+            build_table();
+
+          _table_built = true;
+          _table_valid = true;
+        }
+
+        void build_table()
+        {
+          Matrix& matrix = container().base();
+          const size_type n = N();
+          const size_type m = M();
+
+          _entries.resize(n*m);
+          _rows.resize(n);
+          _cols.resize(m);
+          _blocks.resize(m);
+
+          for (size_type i = 0; i < n; ++i)
+            _rows[i] = std::make_pair(_row_indices[i].first,i);
+          std::sort(_rows.begin(),_rows.end());
+          // for square operators, the columns usually are the rows of the cell
+          if (_col_indices == _row_indices)
+            _cols = _rows;
+          else
+            {
+              for (size_type j = 0; j < m; ++j)
+                _cols[j] = std::make_pair(_col_indices[j].first,j);
+              std::sort(_cols.begin(),_cols.end());
+            }
+
+          for (size_type r = 0; r < n; )
+            {
+              // merge the sorted column blocks with the BCRS row
+              const std::size_t row_block = _rows[r].first;
+              typename Matrix::row_type& row = matrix[row_block];
+              typename Matrix::row_type::iterator it = row.begin();
+              const typename Matrix::row_type::iterator end = row.end();
+              for (size_type c = 0; c < m; ++c)
+                {
+                  while (it != end && it.index() < _cols[c].first)
+                    ++it;
+                  _blocks[_cols[c].second] = (it != end && it.index() == _cols[c].first) ? &(*it) : nullptr;
+                }
+
+              // fill in the entries of all local rows in this block row
+              for (; r < n && _rows[r].first == row_block; ++r)
+                {
+                  const size_type i = _rows[r].second;
+                  const std::size_t ii = _row_indices[i].second;
+                  for (size_type j = 0; j < m; ++j)
+                    {
+                      Block* block = _blocks[j];
+                      _entries[i*m + j] = block
+                        ? &((*block)[ii][_col_indices[j].second])
+                        : &_sink;
+                    }
+                }
+            }
+        }
+
+        bool _table_valid;
+        bool _table_built;
+        std::vector<ElementType*> _entries;
+        std::vector<Index> _row_indices;
+        std::vector<Index> _col_indices;
+        std::vector<std::pair<std::size_t,size_type> > _rows;
+        std::vector<std::pair<std::size_t,size_type> > _cols;
+        std::vector<Block*> _blocks;
+        ElementType _sink;
+
+      };
+
+    } // namespace istl
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_ISTL_SCATTERMATRIXVIEW_HH
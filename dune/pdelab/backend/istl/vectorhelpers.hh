@@ -3,6 +3,10 @@
 #ifndef DUNE_PDELAB_BACKEND_ISTL_VECTORHELPERS_HH
 #define DUNE_PDELAB_BACKEND_ISTL_VECTORHELPERS_HH
 
+#include <cstddef>
+#include <type_traits>
+
+#include <dune/common/fvector.hh>
 #include <dune/common/typetraits.hh>
 
 #include <dune/istl/bvector.hh>
@@ -384,6 +388,37 @@ namespace Dune {
                                                   TypeTree::bottom_up_reduction>
       {};
 
+      // Flat access to the entries of vectors with a single level of blocking,
+      // which store all of their entries in one contiguous array.
+      template<typename V>
+      struct flat_vector
+        : public std::false_type
+      {};
+
+      template<typename F, int n, typename A>
+      struct flat_vector<BlockVector<FieldVector<F,n>,A> >
+        : public std::integral_constant<bool,sizeof(FieldVector<F,n>) == n * sizeof(F)>
+      {
+
+        typedef BlockVector<FieldVector<F,n>,A> Vector;
+
+        static F* data(Vector& v)
+        {
+          return v.N() > 0 ? &v[0][0] : nullptr;
+        }
+
+        static const F* data(const Vector& v)
+        {
+          return v.N() > 0 ? &v[0][0] : nullptr;
+        }
+
+        static std::size_t size(const Vector& v)
+        {
+          return v.N() * n;
+        }
+
+      };
+
     } // namespace istl
 
 #endif // DOXYGEN
@@ -6,6 +6,7 @@
 #include <dune/pdelab/backend/tags.hh>
 #include <dune/pdelab/backend/common/uncachedmatrixview.hh>
 #include <dune/pdelab/backend/istl/matrixhelpers.hh>
+#include <dune/pdelab/backend/istl/scattermatrixview.hh>
 #include <dune/pdelab/backend/istl/descriptors.hh>
 
 namespace Dune {
@@ -49,8 +50,13 @@ namespace Dune {
 
 #if HAVE_TEMPLATE_ALIASES
 
+      // BCRS matrices with a single level of blocking scatter through a precomputed position table
       template<typename RowCache, typename ColCache>
-      using LocalView = UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>;
+      using LocalView = typename conditional<
+        istl::is_flat_bcrs_matrix<C>::value,
+        istl::ScatterMatrixView<ISTLMatrixContainer,RowCache,ColCache>,
+        UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>
+        >::type;
 
       template<typename RowCache, typename ColCache>
       using ConstLocalView = ConstUncachedMatrixView<const ISTLMatrixContainer,RowCache,ColCache>;
@@ -59,14 +65,24 @@ namespace Dune {
 
       template<typename RowCache, typename ColCache>
       struct LocalView
-        : public UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>
+        : public conditional<
+            istl::is_flat_bcrs_matrix<C>::value,
+            istl::ScatterMatrixView<ISTLMatrixContainer,RowCache,ColCache>,
+            UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>
+            >::type
       {
 
+        typedef typename conditional<
+          istl::is_flat_bcrs_matrix<C>::value,
+          istl::ScatterMatrixView<ISTLMatrixContainer,RowCache,ColCache>,
+          UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>
+          >::type BaseT;
+
         LocalView()
         {}
 
         LocalView(ISTLMatrixContainer& mc)
-          : UncachedMatrixView<ISTLMatrixContainer,RowCache,ColCache>(mc)
+          : BaseT(mc)
         {}
 
       };
@@ -8,6 +8,7 @@
 #include <dune/typetree/typetree.hh>
 
 #include <dune/pdelab/backend/tags.hh>
+#include <dune/pdelab/backend/common/blas1.hh>
 #include <dune/pdelab/backend/common/uncachedvectorview.hh>
 #include <dune/pdelab/backend/istl/descriptors.hh>
 #include <dune/pdelab/backend/istl/vectorhelpers.hh>
@@ -39,6 +40,9 @@ namespace Dune {
       typedef istl::vector_iterator<C> iterator;
       typedef istl::vector_iterator<const C> const_iterator;
 
+      //! Whether the entries are stored contiguously and the BLAS-1 kernels can be used.
+      typedef istl::flat_vector<C> Flat;
+
 
 #if HAVE_TEMPLATE_ALIASES
 
@@ -86,7 +90,7 @@ namespace Dune {
         , _container(std::make_shared<Container>(_gfs.ordering().blockCount()))
       {
         istl::dispatch_vector_allocation(_gfs.ordering(),*_container,typename GFS::Ordering::ContainerAllocationTag());
-        (*_container) = rhs.base();
+        assign(rhs,Flat());
       }
 
       ISTLBlockVectorContainer (const GFS& gfs, tags::attached_container = tags::attached_container())
@@ -119,7 +123,7 @@ namespace Dune {
         , _container(std::make_shared<Container>(gfs.ordering().blockCount()))
       {
         istl::dispatch_vector_allocation(gfs.ordering(),*_container,typename GFS::Ordering::ContainerAllocationTag());
-        (*_container)=e;
+        fill(e,Flat());
       }
 
       void detach()
@@ -153,7 +157,7 @@ namespace Dune {
           return *this;
         if (attached())
           {
-            (*_container) = r.base();
+            assign(r,Flat());
           }
         else
           {
@@ -164,32 +168,32 @@ namespace Dune {
 
       ISTLBlockVectorContainer& operator= (const E& e)
       {
-        (*_container)=e;
+        fill(e,Flat());
         return *this;
       }
 
       ISTLBlockVectorContainer& operator*= (const E& e)
       {
-        (*_container)*=e;
+        scale(e,Flat());
         return *this;
       }
 
 
       ISTLBlockVectorContainer& operator+= (const E& e)
       {
-        (*_container)+=e;
+        shift(e,Flat());
         return *this;
       }
 
       ISTLBlockVectorContainer& operator+= (const ISTLBlockVectorContainer& e)
       {
-        (*_container)+= e.base();
+        add(e,Flat());
         return *this;
       }
 
       ISTLBlockVectorContainer& operator-= (const ISTLBlockVectorContainer& e)
       {
-        (*_container)-= e.base();
+        subtract(e,Flat());
         return *this;
       }
 
@@ -215,32 +219,32 @@ namespace Dune {
 
       typename Dune::template FieldTraits<E>::real_type two_norm() const
       {
-        return _container->two_norm();
+        return two_norm(Flat());
       }
 
       typename Dune::template FieldTraits<E>::real_type one_norm() const
       {
-        return _container->one_norm();
+        return one_norm(Flat());
       }
 
       typename Dune::template FieldTraits<E>::real_type infinity_norm() const
       {
-        return _container->infinity_norm();
+        return infinity_norm(Flat());
       }
 
       E operator*(const ISTLBlockVectorContainer& y) const
       {
-        return (*_container)*y.base();
+        return dotT(y,Flat());
       }
 
       E dot(const ISTLBlockVectorContainer& y) const
       {
-        return _container->dot(y.base());
+        return dot(y,Flat());
       }
 
       ISTLBlockVectorContainer& axpy(const E& a, const ISTLBlockVectorContainer& y)
       {
-        _container->axpy(a, y.base());
+        axpy(a,y,Flat());
         return *this;
       }
 
@@ -298,6 +302,133 @@ namespace Dune {
       }
 
     private:
+
+      // Vectors with a single level of blocking are processed by the BLAS-1 kernels on
+      // their flat storage, all other vectors by the ISTL implementation.
+
+      void assign(const ISTLBlockVectorContainer& r, std::true_type)
+      {
+        if (N() != r.N())
+          (*_container) = r.base();
+        else
+          blas1::copy(Flat::size(*_container),Flat::data(r.base()),Flat::data(*_container));
+      }
+
+      void assign(const ISTLBlockVectorContainer& r, std::false_type)
+      {
+        (*_container) = r.base();
+      }
+
+      void fill(const E& e, std::true_type)
+      {
+        blas1::fill(Flat::size(*_container),Flat::data(*_container),e);
+      }
+
+      void fill(const E& e, std::false_type)
+      {
+        (*_container) = e;
+      }
+
+      void scale(const E& e, std::true_type)
+      {
+        blas1::scale(Flat::size(*_container),e,Flat::data(*_container));
+      }
+
+      void scale(const E& e, std::false_type)
+      {
+        (*_container) *= e;
+      }
+
+      void shift(const E& e, std::true_type)
+      {
+        blas1::shift(Flat::size(*_container),e,Flat::data(*_container));
+      }
+
+      void shift(const E& e, std::false_type)
+      {
+        (*_container) += e;
+      }
+
+      void add(const ISTLBlockVectorContainer& y, std::true_type)
+      {
+        blas1::add(Flat::size(*_container),Flat::data(y.base()),Flat::data(*_container));
+      }
+
+      void add(const ISTLBlockVectorContainer& y, std::false_type)
+      {
+        (*_container) += y.base();
+      }
+
+      void subtract(const ISTLBlockVectorContainer& y, std::true_type)
+      {
+        blas1::subtract(Flat::size(*_container),Flat::data(y.base()),Flat::data(*_container));
+      }
+
+      void subtract(const ISTLBlockVectorContainer& y, std::false_type)
+      {
+        (*_container) -= y.base();
+      }
+
+      void axpy(const E& a, const ISTLBlockVectorContainer& y, std::true_type)
+      {
+        blas1::axpy(Flat::size(*_container),a,Flat::data(y.base()),Flat::data(*_container));
+      }
+
+      void axpy(const E& a, const ISTLBlockVectorContainer& y, std::false_type)
+      {
+        _container->axpy(a, y.base());
+      }
+
+      E dot(const ISTLBlockVectorContainer& y, std::true_type) const
+      {
+        return blas1::dot(Flat::size(*_container),Flat::data(*_container),Flat::data(y.base()));
+      }
+
+      E dot(const ISTLBlockVectorContainer& y, std::false_type) const
+      {
+        return _container->dot(y.base());
+      }
+
+      E dotT(const ISTLBlockVectorContainer& y, std::true_type) const
+      {
+        return blas1::dotT(Flat::size(*_container),Flat::data(*_container),Flat::data(y.base()));
+      }
+
+      E dotT(const ISTLBlockVectorContainer& y, std::false_type) const
+      {
+        return (*_container)*y.base();
+      }
+
+      typename Dune::template FieldTraits<E>::real_type two_norm(std::true_type) const
+      {
+        return blas1::two_norm(Flat::size(*_container),Flat::data(*_container));
+      }
+
+      typename Dune::template FieldTraits<E>::real_type two_norm(std::false_type) const
+      {
+        return _container->two_norm();
+      }
+
+      typename Dune::template FieldTraits<E>::real_type one_norm(std::true_type) const
+      {
+        return blas1::one_norm(Flat::size(*_container),Flat::data(*_container));
+      }
+
+      typename Dune::template FieldTraits<E>::real_type one_norm(std::false_type) const
+      {
+        return _container->one_norm();
+      }
+
+      typename Dune::template FieldTraits<E>::real_type infinity_norm(std::true_type) const
+      {
+        return blas1::infinity_norm(Flat::size(*_container),Flat::data(*_container));
+      }
+
+      typename Dune::template FieldTraits<E>::real_type infinity_norm(std::false_type) const
+      {
+        return _container->infinity_norm();
+      }
+
       const GFS& _gfs;
       std::shared_ptr<Container> _container;
     };
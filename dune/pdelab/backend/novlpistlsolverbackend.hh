@@ -801,6 +801,121 @@ namespace Dune {
       int verbose;
     };
 
+    //! Nonoverlapping solver base with a single precision block preconditioner.
+    /**
+     * Works like ISTLBackend_NOVLP_BASE_PREC, but the sequential block preconditioner is
+     * built from a single precision copy of the local matrix and kept between calls to
+     * apply(). It is only rebuilt if the rounded matrix values change.
+     */
+    template<class GO,
+             typename Factory,
+             template<class> class Solver>
+    class ISTLBackend_NOVLP_MixedPrecision_BASE_PREC
+    {
+      typedef typename GO::Traits::TrialGridFunctionSpace GFS;
+      typedef istl::ParallelHelper<GFS> PHELPER;
+
+    public:
+      /*! \brief Constructor.
+
+        \param[in] grid_operator the grid operator
+        \param[in] factory_ factory for the single precision block preconditioner
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+      */
+      ISTLBackend_NOVLP_MixedPrecision_BASE_PREC (const GO& grid_operator, const Factory& factory_,
+                                                  unsigned maxiter_ = 5000, int verbose_ = 1)
+        : _grid_operator(grid_operator)
+        , gfs(grid_operator.trialGridFunctionSpace())
+        , phelper(gfs,verbose_)
+        , prec_cache(factory_)
+        , maxiter(maxiter_)
+        , verbose(verbose_)
+      {}
+
+      /*! \brief Compute global norm of a vector.
+
+        \param[in] v the given vector
+      */
+      template<class Vector>
+      typename Vector::ElementType norm (const Vector& v) const
+      {
+        Vector x(v); // make a copy because it has to be made consistent
+        typedef Dune::PDELab::NonoverlappingScalarProduct<GFS,Vector> PSP;
+        PSP psp(gfs,phelper);
+        psp.make_consistent(x);
+        return psp.norm(x);
+      }
+
+      /*! \brief Solve the given linear system.
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename V::ElementType reduction)
+      {
+        typedef typename M::BaseT MatrixType;
+        MatrixType& mat=istl::raw(A);
+        typedef typename V::BaseT VectorType;
+        typedef istl::MixedPrecisionPreconditioner<MatrixType,VectorType,VectorType,Factory> Smoother;
+#if HAVE_MPI
+        typedef typename istl::CommSelector<96,Dune::MPIHelper::isFake>::type Comm;
+        _grid_operator.make_consistent(A);
+        Comm oocc(gfs.gridView().comm(),Dune::SolverCategory::nonoverlapping);
+        phelper.createIndexSetAndProjectForAMG(mat, oocc);
+        Smoother& smoother = prec_cache.template get<MatrixType,VectorType,VectorType>(mat);
+        typedef Dune::NonoverlappingSchwarzScalarProduct<VectorType,Comm> PSP;
+        PSP psp(oocc);
+        typedef Dune::NonoverlappingSchwarzOperator<MatrixType,VectorType,VectorType,Comm> Operator;
+        Operator oop(mat,oocc);
+        typedef Dune::NonoverlappingBlockPreconditioner<Comm, Smoother> ParSmoother;
+        ParSmoother parsmoother(smoother, oocc);
+#else
+        Smoother& parsmoother = prec_cache.template get<MatrixType,VectorType,VectorType>(mat);
+        typedef Dune::SeqScalarProduct<VectorType> PSP;
+        PSP psp;
+        typedef Dune::MatrixAdapter<MatrixType,VectorType,VectorType> Operator;
+        Operator oop(mat);
+#endif
+        int verb=0;
+        if (gfs.gridView().comm().rank()==0) verb=verbose;
+        Solver<VectorType> solver(oop,psp,parsmoother,reduction,maxiter,verb);
+        Dune::InverseOperatorResult stat;
+        //make r consistent
+        if (gfs.gridView().comm().size()>1){
+          Dune::PDELab::AddDataHandle<GFS,V> adddh(gfs,r);
+          gfs.gridView().communicate(adddh,
+                                     Dune::InteriorBorder_InteriorBorder_Interface,
+                                     Dune::ForwardCommunication);
+        }
+
+        solver.apply(z,r,stat);
+        res.converged  = stat.converged;
+        res.iterations = stat.iterations;
+        res.elapsed    = stat.elapsed;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+
+      /*! \brief Return access to result data. */
+      const Dune::PDELab::LinearSolverResult<double>& result() const
+      {
+        return res;
+      }
+
+    private:
+      const GO& _grid_operator;
+      const GFS& gfs;
+      PHELPER phelper;
+      istl::MixedPrecisionPreconditionerCache<Factory> prec_cache;
+      Dune::PDELab::LinearSolverResult<double> res;
+      unsigned maxiter;
+      int verbose;
+    };
+
     //! \addtogroup PDELab_novlpsolvers Nonoverlapping Solvers
     //! \{
 
@@ -855,6 +970,54 @@ namespace Dune {
       : ISTLBackend_NOVLP_BASE_PREC<GO,Dune::SeqSSOR, Dune::CGSolver>(grid_operator, maxiter_, steps_, verbose_)
     {}
   };
+
+  /**
+   * @brief Nonoverlapping parallel BiCGSTAB solver preconditioned by block SSOR in single precision.
+   * @tparam GO The type of the grid operator
+   */
+  template<class GO>
+  class ISTLBackend_NOVLP_BCGS_SSORk_MixedPrecision
+    : public ISTLBackend_NOVLP_MixedPrecision_BASE_PREC<GO,istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::BiCGSTABSolver>
+  {
+
+  public:
+    /*! \brief make a linear solver object
+
+      \param[in] grid_operator the grid operator
+      \param[in] maxiter_ maximum number of iterations to do
+      \param[in] steps_ number of SSOR steps to apply as inner iteration
+      \param[in] verbose_ print messages if true
+    */
+    explicit ISTLBackend_NOVLP_BCGS_SSORk_MixedPrecision (const GO& grid_operator, unsigned maxiter_=5000,
+                                                          int steps_=5, int verbose_=1)
+      : ISTLBackend_NOVLP_MixedPrecision_BASE_PREC<GO,istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::BiCGSTABSolver>
+        (grid_operator, istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps_,1.0), maxiter_, verbose_)
+    {}
+  };
+
+  /**
+   * @brief Nonoverlapping parallel CG solver preconditioned by block SSOR in single precision.
+   * @tparam GO The type of the grid operator
+   */
+  template<class GO>
+  class ISTLBackend_NOVLP_CG_SSORk_MixedPrecision
+    : public ISTLBackend_NOVLP_MixedPrecision_BASE_PREC<GO,istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::CGSolver>
+  {
+
+  public:
+    /*! \brief make a linear solver object
+
+      \param[in] grid_operator the grid operator
+      \param[in] maxiter_ maximum number of iterations to do
+      \param[in] steps_ number of SSOR steps to apply as inner iteration
+      \param[in] verbose_ print messages if true
+    */
+    explicit ISTLBackend_NOVLP_CG_SSORk_MixedPrecision (const GO& grid_operator, unsigned maxiter_=5000,
+                                                        int steps_=5, int verbose_=1)
+      : ISTLBackend_NOVLP_MixedPrecision_BASE_PREC<GO,istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::CGSolver>
+        (grid_operator, istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps_,1.0), maxiter_, verbose_)
+    {}
+  };
     //! \} Nonoverlapping Solvers
     //! \} group Backend
 
@@ -559,6 +559,66 @@ namespace Dune {
       int verbose;
     };
 
+    // Base class for single precision preconditioners
+    template<class GFS, class C, typename Factory,
+             template<class> class Solver>
+    class ISTLBackend_OVLP_MixedPrecision_Base
+      : public OVLPScalarProductImplementation<GFS>, public LinearResultStorage
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        The subdomain preconditioner is built from a single precision copy of the local
+        matrix and is only rebuilt if the rounded matrix values change.
+
+        \param[in] gfs_ a grid function space
+        \param[in] c_ a constraints object
+        \param[in] factory_ factory for the single precision subdomain preconditioner
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ verbosity level (0=silent)
+      */
+      ISTLBackend_OVLP_MixedPrecision_Base (const GFS& gfs_, const C& c_, const Factory& factory_,
+                                            unsigned maxiter_=5000, int verbose_=1)
+        : OVLPScalarProductImplementation<GFS>(gfs_), gfs(gfs_), c(c_), prec_cache(factory_), maxiter(maxiter_), verbose(verbose_)
+      {}
+
+      /*! \brief solve the given linear system
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename V::ElementType reduction)
+      {
+        typedef OverlappingOperator<C,M,V,W> POP;
+        POP pop(c,A);
+        typedef OVLPScalarProduct<GFS,V> PSP;
+        PSP psp(*this);
+        typedef istl::MixedPrecisionPreconditioner<typename M::BaseT,typename V::BaseT,typename W::BaseT,Factory> SeqPrec;
+        SeqPrec& seqprec = prec_cache.template get<typename M::BaseT,typename V::BaseT,typename W::BaseT>(istl::raw(A));
+        typedef OverlappingWrappedPreconditioner<C,GFS,SeqPrec> WPREC;
+        WPREC wprec(gfs,seqprec,c,this->parallelHelper());
+        int verb=0;
+        if (gfs.gridView().comm().rank()==0) verb=verbose;
+        Solver<V> solver(pop,psp,wprec,reduction,maxiter,verb);
+        Dune::InverseOperatorResult stat;
+        solver.apply(z,r,stat);
+        res.converged  = stat.converged;
+        res.iterations = stat.iterations;
+        res.elapsed    = stat.elapsed;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+    private:
+      const GFS& gfs;
+      const C& c;
+      istl::MixedPrecisionPreconditionerCache<Factory> prec_cache;
+      unsigned maxiter;
+      int verbose;
+    };
+
     //! \addtogroup PDELab_ovlpsolvers Overlapping Solvers
     //! \{
 
@@ -652,6 +712,79 @@ namespace Dune {
       {}
     };
 
+    /**
+     * @brief Overlapping parallel BiCGStab solver with single precision SSOR preconditioner
+     * @tparam GFS The Type of the GridFunctionSpace.
+     * @tparam CC The Type of the Constraints Container.
+     */
+    template<class GFS, class CC>
+    class ISTLBackend_OVLP_BCGS_SSORk_MixedPrecision
+      : public ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqRelaxationFactory<Dune::SeqSSOR>,Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] gfs a grid function space
+        \param[in] cc a constraints container object
+        \param[in] maxiter maximum number of iterations to do
+        \param[in] steps number of SSOR steps to apply as inner iteration
+        \param[in] verbose print messages if true
+      */
+      ISTLBackend_OVLP_BCGS_SSORk_MixedPrecision (const GFS& gfs, const CC& cc, unsigned maxiter=5000,
+                                                  int steps=5, int verbose=1)
+        : ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqRelaxationFactory<Dune::SeqSSOR>,Dune::BiCGSTABSolver>
+          (gfs, cc, istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps,1.0), maxiter, verbose)
+      {}
+    };
+
+    /**
+     * @brief Overlapping parallel CG solver with single precision SSOR preconditioner
+     * @tparam GFS The Type of the GridFunctionSpace.
+     * @tparam CC The Type of the Constraints Container.
+     */
+    template<class GFS, class CC>
+    class ISTLBackend_OVLP_CG_SSORk_MixedPrecision
+      : public ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqRelaxationFactory<Dune::SeqSSOR>,Dune::CGSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] gfs a grid function space
+        \param[in] cc a constraints container object
+        \param[in] maxiter maximum number of iterations to do
+        \param[in] steps number of SSOR steps to apply as inner iteration
+        \param[in] verbose print messages if true
+      */
+      ISTLBackend_OVLP_CG_SSORk_MixedPrecision (const GFS& gfs, const CC& cc, unsigned maxiter=5000,
+                                                int steps=5, int verbose=1)
+        : ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqRelaxationFactory<Dune::SeqSSOR>,Dune::CGSolver>
+          (gfs, cc, istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps,1.0), maxiter, verbose)
+      {}
+    };
+
+    /**
+     * @brief Overlapping parallel BiCGStab solver with single precision ILU0 preconditioner
+     * @tparam GFS The Type of the GridFunctionSpace.
+     * @tparam CC The Type of the Constraints Container.
+     */
+    template<class GFS, class CC>
+    class ISTLBackend_OVLP_BCGS_ILU0_MixedPrecision
+      : public ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqILU0Factory,Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] gfs a grid function space
+        \param[in] cc a constraints container object
+        \param[in] maxiter maximum number of iterations to do
+        \param[in] verbose print messages if true
+      */
+      ISTLBackend_OVLP_BCGS_ILU0_MixedPrecision (const GFS& gfs, const CC& cc, unsigned maxiter=5000, int verbose=1)
+        : ISTLBackend_OVLP_MixedPrecision_Base<GFS,CC,istl::SeqILU0Factory,Dune::BiCGSTABSolver>
+          (gfs, cc, istl::SeqILU0Factory(1.0), maxiter, verbose)
+      {}
+    };
+
     /**
      * @brief Overlapping parallel restarted GMRes solver with ILU0 preconditioner
      * @tparam GFS The Type of the GridFunctionSpace.
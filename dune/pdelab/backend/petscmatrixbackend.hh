@@ -6,6 +6,8 @@
 #if HAVE_PETSC
 
 #include<vector>
+#include <set>
+#include <utility>
 #include <functional>
 #include <algorithm>
 #include <complex>
@@ -33,22 +35,107 @@ namespace Dune {
     template<typename LFSV, typename LFSU>
     class PetscNestedMatrixAccessor;
 
+    //! Sparsity pattern for PETSc AIJ matrices.
+    /**
+     * The pattern stores the column indices of each row in a flat array with a fixed
+     * number of slots per row. Entries that do not fit into their row spill into an
+     * overflow set, so a good estimate of the number of entries per row keeps almost
+     * all insertions in the flat array. Once complete, the pattern can count the exact
+     * number of nonzeros in the diagonal and off-diagonal block of each row, which is
+     * what PETSc needs for an exact preallocation.
+     */
     template<typename T>
-    class Pattern : public std::vector< std::set<T> >
+    class Pattern
     {
 
-      typedef std::vector< std::set<T> > BaseT;
+      //! Marker value indicating an empty slot.
+      static const T empty = ~static_cast<T>(0);
 
     public:
 
-      Pattern (T m_, T n_)
-        : BaseT(m_)
+      typedef T size_type;
+
+      Pattern (T m_, T n_, T entries_per_row = 27)
+        : _m(m_)
+        , _n(n_)
+        , _entries_per_row(entries_per_row)
+        , _indices(m_ * entries_per_row,empty)
       {}
 
       void add_link (T i, T j)
       {
-        (*this)[i].insert(j);
+        typename std::vector<T>::iterator it = _indices.begin() + i * _entries_per_row;
+        const typename std::vector<T>::iterator end = it + _entries_per_row;
+        for (; it != end; ++it)
+          {
+            if (*it == j)
+              return;
+            if (*it == empty)
+              {
+                *it = j;
+                return;
+              }
+          }
+        _overflow.insert(std::make_pair(i,j));
+      }
+
+      //! The number of rows.
+      T rows () const
+      {
+        return _m;
+      }
+
+      //! The number of columns.
+      T cols () const
+      {
+        return _n;
       }
+
+      //! Writes the unique column indices of row i into cols (in arbitrary order).
+      void row (T i, std::vector<T>& cols) const
+      {
+        cols.clear();
+        typename std::vector<T>::const_iterator it = _indices.begin() + i * _entries_per_row;
+        const typename std::vector<T>::const_iterator end = it + _entries_per_row;
+        for (; it != end && *it != empty; ++it)
+          cols.push_back(*it);
+        typename std::set<std::pair<T,T> >::const_iterator oit = _overflow.lower_bound(std::make_pair(i,T(0)));
+        for (; oit != _overflow.end() && oit->first == i; ++oit)
+          cols.push_back(oit->second);
+      }
+
+      //! Counts the nonzeros per row inside and outside of the column range [col_begin,col_end).
+      template<typename I>
+      void count_nonzeros (T col_begin, T col_end, std::vector<I>& d_nnz, std::vector<I>& o_nnz) const
+      {
+        d_nnz.assign(_m,0);
+        o_nnz.assign(_m,0);
+        typename std::vector<T>::const_iterator it = _indices.begin();
+        for (T i = 0; i < _m; ++i)
+          {
+            const typename std::vector<T>::const_iterator end = it + _entries_per_row;
+            for (; it != end && *it != empty; ++it)
+              if (col_begin <= *it && *it < col_end)
+                ++d_nnz[i];
+              else
+                ++o_nnz[i];
+            it = end;
+          }
+        for (typename std::set<std::pair<T,T> >::const_iterator oit = _overflow.begin(); oit != _overflow.end(); ++oit)
+          if (col_begin <= oit->second && oit->second < col_end)
+            ++d_nnz[oit->first];
+          else
+            ++o_nnz[oit->first];
+      }
+
+    private:
+
+      const T _m;
+      const T _n;
+      const T _entries_per_row;
+      std::vector<T> _indices;
+      std::set<std::pair<T,T> > _overflow;
+
     };
 
     namespace {
@@ -109,15 +196,7 @@ namespace Dune {
     {
       static MatrixPtr build(const GFSV& gfsv, const GFSU& gfsu, const Pattern& pattern)
       {
-        const size_type M = gfsv.size();
-        const size_type N = gfsu.size();
-
-        std::vector<int> nnz(M);
-        std::vector<int>::iterator oit = nnz.begin();
-        for (Pattern::const_iterator it = pattern.begin(); it != pattern.end(); ++it, ++oit)
-          (*oit) = it->size();
-
-        return std::make_shared<PetscMatrixContainer>(M,N,nnz);
+        return std::make_shared<PetscMatrixContainer>(pattern);
       }
     };
 
@@ -146,15 +225,14 @@ namespace Dune {
       static Pattern extract_pattern(const Pattern& p, const size_type r_l, const size_type r_h, const size_type c_l, const size_type c_h)
       {
         Pattern out(r_h-r_l,c_h-c_l);
-        Pattern::const_iterator endit = p.begin() + r_h;
-        Pattern::iterator outit = out.begin();
-        typedef Pattern::value_type::const_iterator ColIterator;
-        for (Pattern::const_iterator rit = p.begin() + r_l; rit != endit; ++rit, ++outit)
+        std::vector<size_type> cols;
+        for (size_type i = r_l; i < r_h; ++i)
           {
-            for (ColIterator cit = rit->begin(); cit != rit->end(); ++cit)
+            p.row(i,cols);
+            for (std::vector<size_type>::const_iterator cit = cols.begin(); cit != cols.end(); ++cit)
               {
                 if (*cit >= c_l && *cit < c_h)
-                  outit->insert(*cit-c_l);
+                  out.add_link(i-r_l,*cit-c_l);
               }
           }
         return std::move(out);
@@ -256,15 +334,52 @@ namespace Dune {
         _m = matrix->_m;
       }
 
-      PetscMatrixContainer (const size_type M, const size_type N, const std::vector<int>& nnz)
+      //! Creates an AIJ matrix with exact preallocation and a locked nonzero structure.
+      /**
+       * The number of nonzeros in the diagonal and off-diagonal block of every row is
+       * counted from the pattern and passed to PETSc, and the complete pattern is inserted
+       * as explicit zeros. Afterwards, the nonzero structure is locked, which allows PETSc to
+       * skip all reallocation logic during assembly and makes insertions outside of the
+       * pattern an error. Values are inserted through a local-to-global mapping, so the
+       * accessors can directly use the local container indices.
+       */
+      explicit PetscMatrixContainer (const Pattern& pattern)
         : _accessorState(clean)
         , _rowsToClear()
         , _managed(true)
       {
-        PetscInt nz = 0;
-        PETSC_CALL(MatCreateSeqAIJ(PETSC_COMM_SELF,M,N,nz,&(nnz[0]),&_m));
-        PETSC_CALL(MatSetOption(_m,MAT_IGNORE_ZERO_ENTRIES,PETSC_TRUE));
-        PETSC_CALL(MatSetOption(_m,MAT_NO_OFF_PROC_ZERO_ROWS,PETSC_TRUE)); // we only ever zero our own rows
+        const PetscInt M = pattern.rows();
+        const PetscInt N = pattern.cols();
+
+        PETSC_CALL(MatCreate(PETSC_COMM_SELF,&_m));
+        PETSC_CALL(MatSetSizes(_m,M,N,PETSC_DETERMINE,PETSC_DETERMINE));
+        PETSC_CALL(MatSetType(_m,MATAIJ));
+
+        // We own all columns in the sequential case, but keep the split to stay
+        // compatible with MPIAIJ matrices.
+        std::vector<PetscInt> d_nnz, o_nnz;
+        pattern.count_nonzeros(0,N,d_nnz,o_nnz);
+        PETSC_CALL(MatSeqAIJSetPreallocation(_m,0,d_nnz.data()));
+        PETSC_CALL(MatMPIAIJSetPreallocation(_m,0,d_nnz.data(),0,o_nnz.data()));
+
+        setup_local_to_global_mapping();
+
+        // Insert the complete pattern as explicit zeros, so that the structure is fixed
+        // before any values are assembled.
+        std::vector<size_type> cols;
+        std::vector<PetscInt> petsc_cols;
+        std::vector<PetscScalar> zeros;
+        for (PetscInt i = 0; i < M; ++i)
+          {
+            pattern.row(i,cols);
+            petsc_cols.assign(cols.begin(),cols.end());
+            zeros.assign(cols.size(),0.0);
+            PETSC_CALL(MatSetValuesLocal(_m,1,&i,petsc_cols.size(),petsc_cols.data(),zeros.data(),INSERT_VALUES));
+          }
+        PETSC_CALL(MatAssemblyBegin(_m,MAT_FINAL_ASSEMBLY));
+        PETSC_CALL(MatAssemblyEnd(_m,MAT_FINAL_ASSEMBLY));
+
+        lock_nonzero_structure();
       }
 
       PetscMatrixContainer (const PetscMatrixContainer& rhs)
@@ -273,8 +388,8 @@ namespace Dune {
         , _managed(true)
       {
         PETSC_CALL(MatDuplicate(rhs._m,MAT_COPY_VALUES,&_m));
-        PETSC_CALL(MatSetOption(_m,MAT_IGNORE_ZERO_ENTRIES,PETSC_TRUE));
-        PETSC_CALL(MatSetOption(_m,MAT_NO_OFF_PROC_ZERO_ROWS,PETSC_TRUE)); // we only ever zero our own rows
+        setup_local_to_global_mapping();
+        lock_nonzero_structure();
       }
 
       PetscMatrixContainer (Mat m, bool managed = true)
@@ -301,12 +416,61 @@ namespace Dune {
           PETSC_CALL(MatDestroy(&_m));
       }
 
+      //! Copies the values of rhs.
+      /**
+       * If both matrices have the same nonzero structure (e.g. because they have been
+       * created from the same grid operator or by copying each other), only the value
+       * arrays are copied. Otherwise, a managed matrix is replaced by a duplicate of rhs.
+       */
       PetscMatrixContainer& operator=(const PetscMatrixContainer& rhs)
       {
         assert(_accessorState == clean);
         assert(_rowsToClear.empty());
-        PETSC_CALL(MatCopy(rhs._m,_m, DIFFERENT_NONZERO_PATTERN));
-        _managed = true;
+        if (this == &rhs)
+          return *this;
+        if (same_pattern(rhs))
+          PETSC_CALL(MatCopy(rhs._m,_m,SAME_NONZERO_PATTERN));
+        else if (_managed)
+          {
+            PETSC_CALL(MatDestroy(&_m));
+            PETSC_CALL(MatDuplicate(rhs._m,MAT_COPY_VALUES,&_m));
+            setup_local_to_global_mapping();
+            lock_nonzero_structure();
+          }
+        else
+          PETSC_CALL(MatCopy(rhs._m,_m,DIFFERENT_NONZERO_PATTERN));
+        return *this;
+      }
+
+      //! Returns whether rhs has exactly the same nonzero structure as this matrix.
+      /**
+       * The comparison works on the compressed row structure of sequential AIJ matrices
+       * and costs a single pass over the column indices. For other matrix types, it
+       * returns false unless both containers wrap the same PETSc matrix.
+       */
+      bool same_pattern(const PetscMatrixContainer& rhs) const
+      {
+        if (_m == rhs._m)
+          return true;
+        PetscInt m = 0, n = 0, rhs_m = 0, rhs_n = 0;
+        PETSC_CALL(MatGetSize(_m,&m,&n));
+        PETSC_CALL(MatGetSize(rhs._m,&rhs_m,&rhs_n));
+        if (m != rhs_m || n != rhs_n)
+          return false;
+
+        PetscInt rows = 0, rhs_rows = 0;
+        const PetscInt *ia = PETSC_NULL, *ja = PETSC_NULL, *rhs_ia = PETSC_NULL, *rhs_ja = PETSC_NULL;
+        PetscBool done = PETSC_FALSE, rhs_done = PETSC_FALSE;
+        PETSC_CALL(MatGetRowIJ(_m,0,PETSC_FALSE,PETSC_FALSE,&rows,&ia,&ja,&done));
+        PETSC_CALL(MatGetRowIJ(rhs._m,0,PETSC_FALSE,PETSC_FALSE,&rhs_rows,&rhs_ia,&rhs_ja,&rhs_done));
+        const bool same = done && rhs_done && rows == rhs_rows &&
+          std::equal(ia,ia + rows + 1,rhs_ia) &&
+          std::equal(ja,ja + ia[rows],rhs_ja);
+        if (done)
+          PETSC_CALL(MatRestoreRowIJ(_m,0,PETSC_FALSE,PETSC_FALSE,&rows,&ia,&ja,&done));
+        if (rhs_done)
+          PETSC_CALL(MatRestoreRowIJ(rhs._m,0,PETSC_FALSE,PETSC_FALSE,&rhs_rows,&rhs_ia,&rhs_ja,&rhs_done));
+        return same;
       }
 
       Mat& base ()
@@ -357,6 +521,36 @@ namespace Dune {
 
       bool _managed;
 
+      //! Installs the identity local-to-global mapping shifted by the ownership range.
+      void setup_local_to_global_mapping()
+      {
+        PetscInt m_offset = 0, m_size = 0, n_offset = 0, n_size = 0;
+        PETSC_CALL(MatGetOwnershipRange(_m,&m_offset,PETSC_NULL));
+        PETSC_CALL(MatGetOwnershipRangeColumn(_m,&n_offset,PETSC_NULL));
+        PETSC_CALL(MatGetLocalSize(_m,&m_size,&n_size));
+
+        std::vector<PetscInt> row_map(m_size), col_map(n_size);
+        for (PetscInt i = 0; i < m_size; ++i)
+          row_map[i] = m_offset + i;
+        for (PetscInt i = 0; i < n_size; ++i)
+          col_map[i] = n_offset + i;
+
+        ISLocalToGlobalMapping rmap, cmap;
+        PETSC_CALL(ISLocalToGlobalMappingCreate(PETSC_COMM_SELF,1,m_size,row_map.data(),PETSC_COPY_VALUES,&rmap));
+        PETSC_CALL(ISLocalToGlobalMappingCreate(PETSC_COMM_SELF,1,n_size,col_map.data(),PETSC_COPY_VALUES,&cmap));
+        PETSC_CALL(MatSetLocalToGlobalMapping(_m,rmap,cmap));
+        PETSC_CALL(ISLocalToGlobalMappingDestroy(&rmap));
+        PETSC_CALL(ISLocalToGlobalMappingDestroy(&cmap));
+      }
+
+      //! Forbids any change of the nonzero structure after the pattern has been inserted.
+      void lock_nonzero_structure()
+      {
+        PETSC_CALL(MatSetOption(_m,MAT_NEW_NONZERO_LOCATION_ERR,PETSC_TRUE));
+        PETSC_CALL(MatSetOption(_m,MAT_KEEP_NONZERO_PATTERN,PETSC_TRUE)); // keep structure when zeroing rows
+        PETSC_CALL(MatSetOption(_m,MAT_NO_OFF_PROC_ZERO_ROWS,PETSC_TRUE)); // we only ever zero our own rows
+      }
+
     private:
 
       void enqueue_row_clear(size_type i, PetscScalar diagonal_value)
@@ -434,7 +628,7 @@ namespace Dune {
             _m.access(state);
             if (state == PetscMatrixContainer::readValues)
               {
-                PETSC_CALL(MatGetValues(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0])));
+                PETSC_CALL(MatGetValuesLocal(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0])));
               }
             _state = state;
           } else if (_state != state)
@@ -462,9 +656,11 @@ namespace Dune {
         switch (_state)
           {
           case PetscMatrixContainer::setValues:
-            PETSC_CALL(MatSetValues(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0]),INSERT_VALUES));
+            PETSC_CALL(MatSetValuesLocal(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0]),INSERT_VALUES));
+            break;
           case PetscMatrixContainer::addValues:
-            PETSC_CALL(MatSetValues(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0]),ADD_VALUES));
+            PETSC_CALL(MatSetValuesLocal(_m.base(),_M,&(_rows[0]),_N,&(_cols[0]),&(_vals[0]),ADD_VALUES));
+            break;
           default:
             break;
           }
@@ -535,16 +731,11 @@ namespace Dune {
       PetscMatrixAccessor(PetscMatrixContainer& m, const LFSV& lfsv, const LFSU& lfsu, size_type row_offset = 0, size_type col_offset = 0)
         : PetscMatrixAccessorBase(m,lfsv.localVectorSize(),lfsu.localVectorSize(),row_offset,col_offset)
       {
-        int m_offset = 0;
-        int n_offset = 0;
-        PETSC_CALL(MatGetOwnershipRange(m.base(),&m_offset,PETSC_NULL));
-        PETSC_CALL(MatGetOwnershipRangeColumn(m.base(),&n_offset,PETSC_NULL));
-        m_offset -= row_offset;
-        n_offset -= col_offset;
+        // The matrix carries a local-to-global mapping, so we can use the local indices directly.
         for (size_type i = 0; i < _M; ++i)
-          _rows[i] = m_offset + lfsv.globalIndex(i);
+          _rows[i] = lfsv.globalIndex(i) - row_offset;
         for (size_type i = 0; i < _N; ++i)
-          _cols[i] = n_offset + lfsu.globalIndex(i);
+          _cols[i] = lfsu.globalIndex(i) - col_offset;
       }
 
     };
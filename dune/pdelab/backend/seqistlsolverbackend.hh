@@ -3,6 +3,10 @@
 #ifndef DUNE_SEQISTLSOLVERBACKEND_HH
 #define DUNE_SEQISTLSOLVERBACKEND_HH
 
+#include <cassert>
+#include <memory>
+#include <vector>
+
 #include <dune/common/deprecated.hh>
 #include <dune/common/parallel/mpihelper.hh>
 
@@ -23,6 +27,8 @@
 #include <dune/pdelab/backend/solver.hh>
 #include <dune/pdelab/backend/istlvectorbackend.hh>
 #include <dune/pdelab/backend/istlmatrixbackend.hh>
+#include <dune/pdelab/backend/istl/directsolvercache.hh>
+#include <dune/pdelab/backend/istl/mixedprecision.hh>
 
 namespace Dune {
   namespace PDELab {
@@ -63,6 +69,112 @@ namespace Dune {
       GOS& gos;
     };
 
+    //! Matrix free operator applying the jacobian of a nonlinear grid operator
+    /**
+     * In contrast to OnTheFlyOperator, the jacobian is evaluated at a separate
+     * linearization point, which has to be set with setLinearizationPoint()
+     * before the operator is applied. This allows to solve the linear systems
+     * in a Newton iteration without assembling the jacobian.
+     *
+     * \note The operator stores a pointer to the linearization point.
+     */
+    template<typename X, typename Y, typename GOS>
+    class NonlinearOnTheFlyOperator : public Dune::LinearOperator<X,Y>
+    {
+    public:
+      typedef X domain_type;
+      typedef Y range_type;
+      typedef typename X::field_type field_type;
+
+      enum {category=Dune::SolverCategory::sequential};
+
+      NonlinearOnTheFlyOperator (GOS& gos_)
+        : gos(gos_)
+        , u(nullptr)
+      {}
+
+      //! Sets the point at which the jacobian is evaluated.
+      void setLinearizationPoint(const X& u_)
+      {
+        u = &u_;
+      }
+
+      virtual void apply (const X& x, Y& y) const
+      {
+        assert(u);
+        y = 0.0;
+        gos.jacobian_apply(*u,x,y);
+      }
+
+      virtual void applyscaleadd (field_type alpha, const X& x, Y& y) const
+      {
+        assert(u);
+        Y temp(y);
+        temp = 0.0;
+        gos.jacobian_apply(*u,x,temp);
+        y.axpy(alpha,temp);
+      }
+
+    private:
+      GOS& gos;
+      const X* u;
+    };
+
+    //! Sequential scalar product for ISTL vectors using the BLAS-1 kernels.
+    /**
+     * For vectors with a single level of blocking, dot products and norms are
+     * computed by the kernels in backend/common/blas1.hh on the flat storage of
+     * the vector; other vectors use the ISTL implementation.
+     */
+    template<class X>
+    class SequentialScalarProduct
+      : public Dune::ScalarProduct<X>
+    {
+
+      typedef istl::flat_vector<X> Flat;
+
+    public:
+      //! export types
+      typedef X domain_type;
+      typedef typename X::field_type field_type;
+
+      //! define the category
+      enum {category=Dune::SolverCategory::sequential};
+
+      virtual field_type dot (const X& x, const X& y)
+      {
+        return dot(x,y,Flat());
+      }
+
+      virtual double norm (const X& x)
+      {
+        return norm(x,Flat());
+      }
+
+    private:
+
+      field_type dot (const X& x, const X& y, std::true_type)
+      {
+        return blas1::dot(Flat::size(x),Flat::data(x),Flat::data(y));
+      }
+
+      field_type dot (const X& x, const X& y, std::false_type)
+      {
+        return x.dot(y);
+      }
+
+      double norm (const X& x, std::true_type)
+      {
+        return blas1::two_norm(Flat::size(x),Flat::data(x));
+      }
+
+      double norm (const X& x, std::false_type)
+      {
+        return x.two_norm();
+      }
+
+    };
+
     //==============================================================================
     // Here we add some standard linear solvers conforming to the linear solver
     // interface required to solve linear and nonlinear problems.
@@ -101,7 +213,8 @@ namespace Dune {
         Preconditioner<typename M::BaseT,
                        typename V::BaseT,
                        typename W::BaseT,1> prec(istl::raw(A), 3, 1.0);
-        Solver<typename V::BaseT> solver(opa, prec, reduction, maxiter, verbose);
+        SequentialScalarProduct<typename V::BaseT> sp;
+        Solver<typename V::BaseT> solver(opa, sp, prec, reduction, maxiter, verbose);
         Dune::InverseOperatorResult stat;
         solver.apply(istl::raw(z), istl::raw(r), stat);
         res.converged  = stat.converged;
@@ -145,7 +258,8 @@ namespace Dune {
         Dune::SeqILU0<typename M::BaseT,
                       typename V::BaseT,
                       typename W::BaseT> ilu0(istl::raw(A), 1.0);
-        Solver<typename V::BaseT> solver(opa, ilu0, reduction, maxiter, verbose);
+        SequentialScalarProduct<typename V::BaseT> sp;
+        Solver<typename V::BaseT> solver(opa, sp, ilu0, reduction, maxiter, verbose);
         Dune::InverseOperatorResult stat;
         solver.apply(istl::raw(z), istl::raw(r), stat);
         res.converged  = stat.converged;
@@ -189,7 +303,8 @@ namespace Dune {
         Dune::SeqILUn<typename M::BaseT,
                       typename V::BaseT,
                       typename W::BaseT> ilun(istl::raw(A), n_, w_);
-        Solver<typename V::BaseT> solver(opa, ilun, reduction, maxiter, verbose);
+        SequentialScalarProduct<typename V::BaseT> sp;
+        Solver<typename V::BaseT> solver(opa, sp, ilun, reduction, maxiter, verbose);
         Dune::InverseOperatorResult stat;
         solver.apply(istl::raw(z), istl::raw(r), stat);
         res.converged  = stat.converged;
@@ -206,6 +321,63 @@ namespace Dune {
       int verbose;
     };
 
+    //! Base class for sequential solvers with a single precision preconditioner.
+    /**
+     * The preconditioner is built from a float copy of the matrix, while the Krylov
+     * method runs in the precision of the assembled system. The float copy and the
+     * preconditioner are kept between calls to apply() and are only rebuilt if the
+     * (rounded) matrix values change.
+     *
+     * \tparam Factory  Factory for the single precision preconditioner, see istl::SeqILU0Factory etc.
+     * \tparam Solver   The ISTL Krylov solver.
+     */
+    template<typename Factory, template<class> class Solver>
+    class ISTLBackend_SEQ_MixedPrecision_Base
+      : public SequentialNorm, public LinearResultStorage
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] factory_ factory for the single precision preconditioner
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_MixedPrecision_Base(const Factory& factory_, unsigned maxiter_=5000, int verbose_=1)
+        : prec_cache(factory_), maxiter(maxiter_), verbose(verbose_)
+      {}
+
+      /*! \brief solve the given linear system
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename Dune::template FieldTraits<typename W::ElementType >::real_type reduction)
+      {
+        Dune::MatrixAdapter<typename M::BaseT,
+                            typename V::BaseT,
+                            typename W::BaseT> opa(istl::raw(A));
+        Dune::Preconditioner<typename V::BaseT,typename W::BaseT>& prec =
+          prec_cache.template get<typename M::BaseT,typename V::BaseT,typename W::BaseT>(istl::raw(A));
+        SequentialScalarProduct<typename V::BaseT> sp;
+        Solver<typename V::BaseT> solver(opa, sp, prec, reduction, maxiter, verbose);
+        Dune::InverseOperatorResult stat;
+        solver.apply(istl::raw(z), istl::raw(r), stat);
+        res.converged  = stat.converged;
+        res.iterations = stat.iterations;
+        res.elapsed    = stat.elapsed;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+
+    private:
+      istl::MixedPrecisionPreconditionerCache<Factory> prec_cache;
+      unsigned maxiter;
+      int verbose;
+    };
+
     //! \addtogroup PDELab_seqsolvers Sequential Solvers
     //! \{
 
@@ -378,13 +550,124 @@ namespace Dune {
       {}
     };
 
+    /**
+     * @brief Sequential conjugate gradient solver with single precision SSOR preconditioner.
+     */
+    class ISTLBackend_SEQ_CG_SSOR_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::CGSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] steps_ number of SSOR steps per preconditioner application
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_CG_SSOR_MixedPrecision (unsigned maxiter_=5000, int steps_=3, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::CGSolver>
+          (istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps_,1.0), maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential BiCGSTAB solver with single precision SSOR preconditioner.
+     */
+    class ISTLBackend_SEQ_BCGS_SSOR_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] steps_ number of SSOR steps per preconditioner application
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_BCGS_SSOR_MixedPrecision (unsigned maxiter_=5000, int steps_=3, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqRelaxationFactory<Dune::SeqSSOR>, Dune::BiCGSTABSolver>
+          (istl::SeqRelaxationFactory<Dune::SeqSSOR>(steps_,1.0), maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential conjugate gradient solver with single precision ILU0 preconditioner.
+     */
+    class ISTLBackend_SEQ_CG_ILU0_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILU0Factory, Dune::CGSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_CG_ILU0_MixedPrecision (unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILU0Factory, Dune::CGSolver>
+          (istl::SeqILU0Factory(1.0), maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential BiCGSTAB solver with single precision ILU0 preconditioner.
+     */
+    class ISTLBackend_SEQ_BCGS_ILU0_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILU0Factory, Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_BCGS_ILU0_MixedPrecision (unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILU0Factory, Dune::BiCGSTABSolver>
+          (istl::SeqILU0Factory(1.0), maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential BiCGSTAB solver with single precision ILUn preconditioner.
+     */
+    class ISTLBackend_SEQ_BCGS_ILUn_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILUnFactory, Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] n_ The number of levels to be used.
+        \param[in] w_ The relaxation factor.
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+      */
+      explicit ISTLBackend_SEQ_BCGS_ILUn_MixedPrecision (int n_, double w_=1.0, unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqILUnFactory, Dune::BiCGSTABSolver>
+          (istl::SeqILUnFactory(n_,w_), maxiter_, verbose_)
+      {}
+    };
+
 #if HAVE_SUPERLU || DOXYGEN
     /**
      * @brief Solver backend using SuperLU as a direct solver.
+     *
+     * The backend keeps the SuperLU factorisation alive between calls to apply(). The matrix
+     * is compared with a snapshot of the last factorised matrix and is only refactorised if
+     * its pattern or its values have changed, so repeatedly solving with the same operator
+     * only costs a pair of triangular solves per right hand side.
+     *
+     * \note Dune::SuperLU does not expose the symbolic phase separately, so a change of the
+     *       matrix values triggers a complete refactorisation including the column ordering.
      */
     class ISTLBackend_SEQ_SuperLU
       : public SequentialNorm, public LinearResultStorage
     {
+
+      template<typename ISTLM>
+      struct Cache
+        : public istl::SolverCacheBase
+      {
+        istl::BCRSMatrixSnapshot<ISTLM> snapshot;
+        std::shared_ptr<Dune::SuperLU<ISTLM> > solver;
+      };
+
     public:
       /*! \brief make a linear solver object
 
@@ -414,10 +697,12 @@ namespace Dune {
       template<class M, class V, class W>
       void apply(M& A, V& z, W& r, typename W::ElementType reduction)
       {
-        typedef typename M::Container ISTLM;
-        Dune::SuperLU<ISTLM> solver(istl::raw(A), verbose);
+        Dune::SuperLU<typename M::Container>& solver = factorize(istl::raw(A));
+        Timer watch;
         Dune::InverseOperatorResult stat;
         solver.apply(istl::raw(z), istl::raw(r), stat);
+        ++stats.solves;
+        stats.tsolve = watch.elapsed();
         res.converged  = stat.converged;
         res.iterations = stat.iterations;
         res.elapsed    = stat.elapsed;
@@ -425,18 +710,104 @@ namespace Dune {
         res.conv_rate  = stat.conv_rate;
       }
 
+      /*! \brief solve the given linear system for multiple right hand sides
+
+        The matrix is factorised at most once for all right hand sides.
+
+        \param[in] A the given matrix
+        \param[out] z the solution vectors to be computed
+        \param[in] r right hand sides
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, std::vector<V>& z, std::vector<W>& r, typename W::ElementType reduction)
+      {
+        assert(z.size() == r.size());
+        Dune::SuperLU<typename M::Container>& solver = factorize(istl::raw(A));
+        Timer watch;
+        Dune::InverseOperatorResult stat;
+        res.converged = true;
+        for (std::size_t i = 0; i < r.size(); ++i)
+          {
+            solver.apply(istl::raw(z[i]), istl::raw(r[i]), stat);
+            res.converged = res.converged && stat.converged;
+          }
+        stats.solves += r.size();
+        stats.tsolve = watch.elapsed();
+        res.iterations = stat.iterations;
+        res.elapsed    = stats.tsolve;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+
+      //! Returns statistics about the factorisations and solves performed so far.
+      const istl::DirectSolverStatistics& statistics() const
+      {
+        return stats;
+      }
+
+      //! Discards the cached factorisation, the next call to apply() will factorise again.
+      void reset()
+      {
+        cache.reset();
+      }
+
     private:
+
+      template<typename ISTLM>
+      Dune::SuperLU<ISTLM>& factorize(const ISTLM& mat)
+      {
+        std::shared_ptr<Cache<ISTLM> > c = std::dynamic_pointer_cast<Cache<ISTLM> >(cache);
+        if (!c)
+          {
+            c = std::make_shared<Cache<ISTLM> >();
+            cache = c;
+          }
+        if (c->snapshot.update(mat) != istl::BCRSMatrixSnapshot<ISTLM>::unchanged)
+          {
+            Timer watch;
+            if (c->solver)
+              c->solver->setMatrix(mat);
+            else
+              c->solver = std::make_shared<Dune::SuperLU<ISTLM> >(mat, verbose);
+            ++stats.numeric_factorizations;
+            stats.tnumeric = watch.elapsed();
+          }
+        return *c->solver;
+      }
+
       int verbose;
+      std::shared_ptr<istl::SolverCacheBase> cache;
+      istl::DirectSolverStatistics stats;
     };
 #endif // HAVE_SUPERLU || DOXYGEN
 
 #if HAVE_UMFPACK || DOXYGEN
     /**
      * @brief Solver backend using UMFPack as a direct solver.
+     *
+     * The backend keeps the UMFPack factorisation alive between calls to apply(). The
+     * symbolic analysis (fill-reducing ordering) is only repeated if the sparsity pattern
+     * of the matrix changes, and the numeric factorisation only if its values change.
+     * Repeatedly solving with the same operator thus only costs a pair of triangular solves
+     * per right hand side.
      */
     class ISTLBackend_SEQ_UMFPack
       : public SequentialNorm, public LinearResultStorage
     {
+
+      template<typename ISTLM>
+      struct Cache
+        : public istl::SolverCacheBase
+      {
+        explicit Cache(int verbose)
+          : factorization(verbose)
+        {}
+
+        istl::BCRSMatrixSnapshot<ISTLM> snapshot;
+        istl::UMFPackFactorization<ISTLM> factorization;
+      };
+
     public:
       /*! \brief make a linear solver object
 
@@ -466,19 +837,89 @@ namespace Dune {
       template<class M, class V, class W>
       void apply(M& A, V& z, W& r, typename W::ElementType reduction)
       {
-        typedef typename M::Container ISTLM;
-        Dune::UMFPack<ISTLM> solver(istl::raw(A), verbose);
-        Dune::InverseOperatorResult stat;
-        solver.apply(istl::raw(z), istl::raw(r), stat);
-        res.converged  = stat.converged;
-        res.iterations = stat.iterations;
-        res.elapsed    = stat.elapsed;
-        res.reduction  = stat.reduction;
-        res.conv_rate  = stat.conv_rate;
+        istl::UMFPackFactorization<typename M::Container>& factorization = factorize(istl::raw(A));
+        Timer watch;
+        factorization.solve(istl::raw(z), istl::raw(r));
+        ++stats.solves;
+        stats.tsolve = watch.elapsed();
+        res.converged  = true;
+        res.iterations = 1;
+        res.elapsed    = stats.tsolve;
+        res.reduction  = 0.0;
+        res.conv_rate  = 0.0;
+      }
+
+      /*! \brief solve the given linear system for multiple right hand sides
+
+        The matrix is factorised at most once for all right hand sides.
+
+        \param[in] A the given matrix
+        \param[out] z the solution vectors to be computed
+        \param[in] r right hand sides
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, std::vector<V>& z, std::vector<W>& r, typename W::ElementType reduction)
+      {
+        assert(z.size() == r.size());
+        istl::UMFPackFactorization<typename M::Container>& factorization = factorize(istl::raw(A));
+        Timer watch;
+        for (std::size_t i = 0; i < r.size(); ++i)
+          factorization.solve(istl::raw(z[i]), istl::raw(r[i]));
+        stats.solves += r.size();
+        stats.tsolve = watch.elapsed();
+        res.converged  = true;
+        res.iterations = 1;
+        res.elapsed    = stats.tsolve;
+        res.reduction  = 0.0;
+        res.conv_rate  = 0.0;
+      }
+
+      //! Returns statistics about the factorisations and solves performed so far.
+      const istl::DirectSolverStatistics& statistics() const
+      {
+        return stats;
+      }
+
+      //! Discards the cached factorisation, the next call to apply() will factorise again.
+      void reset()
+      {
+        cache.reset();
       }
 
     private:
+
+      template<typename ISTLM>
+      istl::UMFPackFactorization<ISTLM>& factorize(const ISTLM& mat)
+      {
+        typedef istl::BCRSMatrixSnapshot<ISTLM> Snapshot;
+        std::shared_ptr<Cache<ISTLM> > c = std::dynamic_pointer_cast<Cache<ISTLM> >(cache);
+        if (!c)
+          {
+            c = std::make_shared<Cache<ISTLM> >(verbose);
+            cache = c;
+          }
+        typename Snapshot::Change change = c->snapshot.update(mat);
+        if (change == Snapshot::pattern_changed)
+          {
+            Timer watch;
+            c->factorization.analyzePattern(mat);
+            ++stats.symbolic_factorizations;
+            stats.tsymbolic = watch.elapsed();
+          }
+        if (change != Snapshot::unchanged)
+          {
+            Timer watch;
+            c->factorization.factorize(mat);
+            ++stats.numeric_factorizations;
+            stats.tnumeric = watch.elapsed();
+          }
+        return c->factorization;
+      }
+
       int verbose;
+      std::shared_ptr<istl::SolverCacheBase> cache;
+      istl::DirectSolverStatistics stats;
     };
 #endif // HAVE_UMFPACK || DOXYGEN
 
@@ -623,7 +1064,8 @@ namespace Dune {
         watch.reset();
         Dune::InverseOperatorResult stat;
 
-        Solver<VectorType> solver(oop,*amg,reduction,maxiter,verbose);
+        SequentialScalarProduct<VectorType> sp;
+        Solver<VectorType> solver(oop,sp,*amg,reduction,maxiter,verbose);
         solver.apply(istl::raw(z),istl::raw(r),stat);
         stats.tsolve= watch.elapsed();
         res.converged  = stat.converged;
@@ -787,6 +1229,82 @@ namespace Dune {
       {}
     };
 
+
+    /**
+     * @brief Sequential Krylov solver preconditioned with an AMG hierarchy stored in single precision.
+     * @tparam GO The type of the grid operator.
+     * @tparam Smoother The smoother of the AMG.
+     * @tparam Solver The Krylov solver.
+     *
+     * In contrast to ISTLBackend_SEQ_AMG, the hierarchy is built from a float copy of the
+     * matrix and is rebuilt automatically whenever the rounded matrix values change.
+     */
+    template<class GO, template<class,class,class,int> class Smoother, template<class> class Solver>
+    class ISTLBackend_SEQ_AMG_MixedPrecision
+      : public ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqAMGFactory<Smoother>, Solver>
+    {
+      typedef typename GO::Traits::TrialGridFunctionSpace GFS;
+
+      static Dune::Amg::Parameters defaultParameters(int verbose)
+      {
+        Dune::Amg::Parameters params(15,2000);
+        params.setDefaultValuesIsotropic(GFS::Traits::GridViewType::Traits::Grid::dimension);
+        params.setDebugLevel(verbose);
+        return params;
+      }
+
+    public:
+      /**
+       * @brief Constructor
+       * @param maxiter_ The maximum number of iterations allowed.
+       * @param verbose_ The verbosity level to use.
+       */
+      ISTLBackend_SEQ_AMG_MixedPrecision(unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_MixedPrecision_Base<istl::SeqAMGFactory<Smoother>, Solver>
+          (istl::SeqAMGFactory<Smoother>(defaultParameters(verbose_)), maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential conjugate gradient solver preconditioned with a single precision AMG smoothed by SSOR
+     * @tparam GO The type of the grid operator
+     */
+    template<class GO>
+    class ISTLBackend_SEQ_CG_AMG_SSOR_MixedPrecision
+      : public ISTLBackend_SEQ_AMG_MixedPrecision<GO, Dune::SeqSSOR, Dune::CGSolver>
+    {
+
+    public:
+      /**
+       * @brief Constructor
+       * @param maxiter_ The maximum number of iterations allowed.
+       * @param verbose_ The verbosity level to use.
+       */
+      ISTLBackend_SEQ_CG_AMG_SSOR_MixedPrecision(unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_AMG_MixedPrecision<GO, Dune::SeqSSOR, Dune::CGSolver>(maxiter_, verbose_)
+      {}
+    };
+
+    /**
+     * @brief Sequential BiCGStab solver preconditioned with a single precision AMG smoothed by SSOR
+     * @tparam GO The type of the grid operator
+     */
+    template<class GO>
+    class ISTLBackend_SEQ_BCGS_AMG_SSOR_MixedPrecision
+      : public ISTLBackend_SEQ_AMG_MixedPrecision<GO, Dune::SeqSSOR, Dune::BiCGSTABSolver>
+    {
+
+    public:
+      /**
+       * @brief Constructor
+       * @param maxiter_ The maximum number of iterations allowed.
+       * @param verbose_ The verbosity level to use.
+       */
+      ISTLBackend_SEQ_BCGS_AMG_SSOR_MixedPrecision(unsigned maxiter_=5000, int verbose_=1)
+        : ISTLBackend_SEQ_AMG_MixedPrecision<GO, Dune::SeqSSOR, Dune::BiCGSTABSolver>(maxiter_, verbose_)
+      {}
+    };
+
     //! \} group Sequential Solvers
     //! \} group Backend
 
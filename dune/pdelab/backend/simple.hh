@@ -7,5 +7,7 @@
 #include <dune/pdelab/backend/simple/vector.hh>
 #include <dune/pdelab/backend/simple/matrix.hh>
 #include <dune/pdelab/backend/simple/sparse.hh>
+#include <dune/pdelab/backend/simple/sell.hh>
+#include <dune/pdelab/backend/simple/solvers.hh>
 
 #endif // DUNE_PDELAB_BACKEND_SIMPLE_HH
@@ -3,6 +3,7 @@
 #ifndef DUNE_PDELAB_BACKEND_SIMPLE_DESCRIPTORS_HH
 #define DUNE_PDELAB_BACKEND_SIMPLE_DESCRIPTORS_HH
 
+#include <cstddef>
 #include <vector>
 
 #include <dune/pdelab/ordering/orderingbase.hh>
@@ -26,6 +27,10 @@ namespace Dune {
       template<typename _RowOrdering, typename _ColOrdering>
       class SparseMatrixPattern;
 
+      template<typename GFSV, typename GFSU, template<typename> class C, typename ET, typename I,
+               std::size_t chunk_size, std::size_t sigma>
+      class SELLMatrixContainer;
+
       template<typename E>
       using default_vector = std::vector<E>;
 
@@ -131,6 +136,41 @@ namespace Dune {
       };
     };
 
+    //! Backend for sliced ELLPACK (SELL-C-sigma) matrices with SIMD-friendly storage.
+    /**
+     * \tparam Container   The container template used for the matrix storage.
+     * \tparam IndexType   The type of the stored column indices. A 32 bit type halves the
+     *                     index traffic of the matrix-vector product.
+     * \tparam chunk_size  The number of rows stored together, should be a multiple of the SIMD width.
+     * \tparam sigma       The size of the windows in which the rows are sorted by length,
+     *                     must be a multiple of chunk_size.
+     */
+    template<template<typename> class Container = simple::default_vector, typename IndexType = std::size_t,
+             std::size_t chunk_size = 8, std::size_t sigma = 256>
+    struct SimpleSELLMatrixBackend
+    {
+
+      typedef IndexType size_type;
+
+      //! The type of the pattern object passed to the GridOperator for pattern construction.
+      template<typename Matrix, typename GFSV, typename GFSU>
+      using Pattern = simple::SparseMatrixPattern<
+        OrderingBase<
+          typename GFSV::Ordering::Traits::DOFIndex,
+          typename GFSV::Ordering::Traits::ContainerIndex
+          >,
+        OrderingBase<
+          typename GFSU::Ordering::Traits::DOFIndex,
+          typename GFSU::Ordering::Traits::ContainerIndex> >;
+
+      template<typename VV, typename VU, typename E>
+      struct MatrixHelper
+      {
+        typedef simple::SELLMatrixContainer<typename VV::GridFunctionSpace,typename VU::GridFunctionSpace,
+                                            Container, E, size_type, chunk_size, sigma> type;
+      };
+    };
+
   } // namespace PDELab
 } // namespace Dune
 
@@ -0,0 +1,487 @@
+// -*- tab-width: 4; indent-tabs-mode: nil -*-
+#ifndef DUNE_PDELAB_BACKEND_SIMPLE_SELL_HH
+#define DUNE_PDELAB_BACKEND_SIMPLE_SELL_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/pdelab/backend/tags.hh>
+#include <dune/pdelab/backend/backendselector.hh>
+#include <dune/pdelab/backend/common/uncachedmatrixview.hh>
+#include <dune/pdelab/backend/simple/descriptors.hh>
+#include <dune/pdelab/backend/simple/sparse.hh>
+
+namespace Dune {
+  namespace PDELab {
+    namespace simple {
+
+      template<template<typename> class C, typename ET, typename I>
+      struct SELLMatrixData
+      {
+        typedef ET ElementType;
+        typedef I  index_type;
+        typedef std::size_t size_type;
+        std::size_t _rows;
+        std::size_t _cols;
+        std::size_t _non_zeros;
+        std::size_t _chunks;
+        //! entries, stored chunk by chunk and column-major within each chunk
+        C<ElementType> _data;
+        //! column indices, same layout as _data
+        C<index_type>  _colindex;
+        //! start of each chunk in _data, has _chunks+1 entries
+        C<index_type>  _chunkoffset;
+        //! number of nonzeros of the row stored in each slot
+        C<index_type>  _rowlength;
+        //! original row index of each slot
+        C<index_type>  _permutation;
+        //! slot of each original row
+        C<index_type>  _inverse_permutation;
+      };
+
+      /**
+         \brief Simple backend for sliced ELLPACK (SELL-C-sigma) matrices
+
+         The rows of the matrix are grouped into chunks of chunk_size rows, each
+         of which is padded to the length of its longest row and stored column-major,
+         i.e. the j-th entries of all rows in a chunk are contiguous in memory. This
+         lets the compiler vectorise the matrix-vector product across the rows of a
+         chunk. In order to keep the padding small, the rows are sorted by descending
+         length within windows of sigma rows before they are assigned to chunks.
+
+         The row permutation is purely internal: rows and columns are addressed with
+         the original indices and mv() / usmv() work on vectors in the original order.
+
+         \example
+         Consider the following 3x3 matrix with chunk_size=2 and sigma=2
+            [1, 0, 2]
+            [0, 0, 3]
+            [4, 5, 6]
+         rows 0 and 1 form the first chunk (width 2), row 2 and a padding row the
+         second one (width 3). The data would be stored as
+         data=[1 3 2 0 | 4 0 5 0 6 0]
+         indices=[0 2 2 2 | 0 0 1 0 2 0]
+         chunkoffset=[0 4 10]
+         rowlength=[2 1 3 0]
+
+         \tparam chunk_size  The number of rows per chunk, should match the SIMD width.
+         \tparam sigma       The size of the sorting windows, must be a multiple of chunk_size.
+       */
+      template<typename GFSV, typename GFSU, template<typename> class C, typename ET, typename I,
+               std::size_t chunk_size, std::size_t sigma>
+      class SELLMatrixContainer
+      {
+
+        static_assert(chunk_size > 0, "chunk_size must be positive");
+        static_assert(sigma > 0 && sigma % chunk_size == 0, "sigma must be a positive multiple of chunk_size");
+
+      public:
+
+        typedef SELLMatrixData<C,ET,I> Container;
+        typedef ET ElementType;
+
+        typedef ElementType field_type;
+        typedef typename Container::size_type size_type;
+        typedef I index_type;
+
+        typedef GFSU TrialGridFunctionSpace;
+        typedef GFSV TestGridFunctionSpace;
+
+        typedef typename GFSV::Ordering::Traits::ContainerIndex RowIndex;
+        typedef typename GFSU::Ordering::Traits::ContainerIndex ColIndex;
+
+        static const std::size_t chunkSize = chunk_size;
+        static const std::size_t sortingWindow = sigma;
+
+        template<typename RowCache, typename ColCache>
+        using LocalView = UncachedMatrixView<SELLMatrixContainer,RowCache,ColCache>;
+
+        template<typename RowCache, typename ColCache>
+        using ConstLocalView = ConstUncachedMatrixView<const SELLMatrixContainer,RowCache,ColCache>;
+
+        typedef OrderingBase<
+          typename GFSV::Ordering::Traits::DOFIndex,
+          typename GFSV::Ordering::Traits::ContainerIndex
+          > RowOrdering;
+
+        typedef OrderingBase<
+          typename GFSU::Ordering::Traits::DOFIndex,
+          typename GFSU::Ordering::Traits::ContainerIndex
+          > ColOrdering;
+
+        typedef SparseMatrixPattern<RowOrdering,ColOrdering> Pattern;
+
+        template<typename GO>
+        SELLMatrixContainer(const GO& go)
+          : _container(std::make_shared<Container>())
+        {
+          allocate_matrix(_container, go, ElementType(0));
+        }
+
+        template<typename GO>
+        SELLMatrixContainer(const GO& go, const ElementType& e)
+          : _container(std::make_shared<Container>())
+        {
+          allocate_matrix(_container, go, e);
+        }
+
+        //! Creates an SELLMatrixContainer without allocating storage.
+        explicit SELLMatrixContainer(tags::unattached_container = tags::unattached_container())
+        {}
+
+        //! Creates an SELLMatrixContainer with empty storage.
+        explicit SELLMatrixContainer(tags::attached_container)
+        : _container(std::make_shared<Container>())
+        {}
+
+        SELLMatrixContainer(const SELLMatrixContainer& rhs)
+          : _container(std::make_shared<Container>(*(rhs._container)))
+        {}
+
+        SELLMatrixContainer& operator=(const SELLMatrixContainer& rhs)
+        {
+          if (this == &rhs)
+            return *this;
+          if (attached())
+          {
+            (*_container) = (*(rhs._container));
+          }
+          else
+          {
+            _container = std::make_shared<Container>(*(rhs._container));
+          }
+          return *this;
+        }
+
+        void detach()
+        {
+          _container.reset();
+        }
+
+        void attach(std::shared_ptr<Container> container)
+        {
+          _container = container;
+        }
+
+        bool attached() const
+        {
+          return bool(_container);
+        }
+
+        const std::shared_ptr<Container>& storage() const
+        {
+          return _container;
+        }
+
+        size_type N() const
+        {
+          return _container->_rows;
+        }
+
+        size_type M() const
+        {
+          return _container->_cols;
+        }
+
+        //! Returns the number of structural nonzeros, not counting the padding.
+        size_type nonzeroes() const
+        {
+          return _container->_non_zeros;
+        }
+
+        //! Returns the number of stored entries (including the padding) per structural nonzero.
+        double fillRatio() const
+        {
+          return _container->_non_zeros > 0
+            ? double(_container->_data.size()) / _container->_non_zeros
+            : 1.0;
+        }
+
+        SELLMatrixContainer& operator=(const ElementType& e)
+        {
+          // the padding must stay zero, so we have to walk the rows here
+          if (e == ElementType(0))
+            std::fill(_container->_data.begin(),_container->_data.end(),e);
+          else
+            for (std::size_t s = 0; s < _container->_rows; ++s)
+              {
+                const std::size_t base = entry(s,0);
+                for (std::size_t j = 0; j < _container->_rowlength[s]; ++j)
+                  _container->_data[base + j*chunk_size] = e;
+              }
+          return *this;
+        }
+
+        SELLMatrixContainer& operator*=(const ElementType& e)
+        {
+          using namespace std::placeholders;
+          std::transform(_container->_data.begin(),_container->_data.end(),_container->_data.begin(),std::bind(std::multiplies<ET>(),e,_1));
+          return *this;
+        }
+
+        template<typename V>
+        void mv(const V& x, V& y) const
+        {
+          assert(y.N() == N());
+          assert(x.N() == M());
+          spmv(x,y,ElementType(1),false);
+        }
+
+        template<typename V>
+        void usmv(const ElementType alpha, const V& x, V& y) const
+        {
+          assert(y.N() == N());
+          assert(x.N() == M());
+          spmv(x,y,alpha,true);
+        }
+
+        //! Computes r = b - A x in a single sweep.
+        template<typename V>
+        void residual(const V& x, const V& b, V& r) const
+        {
+          assert(r.N() == N());
+          assert(b.N() == N());
+          assert(x.N() == M());
+          const std::size_t rows = _container->_rows;
+          const ElementType* data = data_ptr();
+          const index_type* colindex = colindex_ptr();
+          const ElementType* xp = &(x.base()[0]);
+          for (std::size_t c = 0; c < _container->_chunks; ++c)
+            {
+              ElementType accu[chunk_size];
+              chunk_product(c,data,colindex,xp,accu);
+              const std::size_t slot_end = std::min((c+1)*chunk_size,rows);
+              for (std::size_t s = c*chunk_size; s < slot_end; ++s)
+                {
+                  const std::size_t row = _container->_permutation[s];
+                  r.base()[row] = b.base()[row] - accu[s - c*chunk_size];
+                }
+            }
+        }
+
+        //! Stores the diagonal of the matrix in d, in the original row order.
+        template<typename V>
+        void diagonal(V& d) const
+        {
+          d.resize(N());
+          for (std::size_t row = 0; row < _container->_rows; ++row)
+            {
+              const std::size_t pos = find(row,row);
+              d[row] = pos != invalid() ? _container->_data[pos] : ElementType(0);
+            }
+        }
+
+        ElementType& operator()(const RowIndex& ri, const ColIndex& ci)
+        {
+          const std::size_t pos = find(ri[0],ci[0]);
+          assert(pos != invalid());
+          return _container->_data[pos];
+        }
+
+        const ElementType& operator()(const RowIndex& ri, const ColIndex& ci) const
+        {
+          const std::size_t pos = find(ri[0],ci[0]);
+          assert(pos != invalid());
+          return _container->_data[pos];
+        }
+
+        const Container& base() const
+        {
+          return *_container;
+        }
+
+        Container& base()
+        {
+          return *_container;
+        }
+
+        void flush()
+        {}
+
+        void finalize()
+        {}
+
+        void clear_row(const RowIndex& ri, const ElementType& diagonal_entry)
+        {
+          const std::size_t s = _container->_inverse_permutation[ri[0]];
+          const std::size_t base = entry(s,0);
+          for (std::size_t j = 0; j < _container->_rowlength[s]; ++j)
+            _container->_data[base + j*chunk_size] = ElementType(0);
+          (*this)(ri,ri) = diagonal_entry;
+        }
+
+      protected:
+
+        static std::size_t invalid()
+        {
+          return std::size_t(-1);
+        }
+
+        // position of the j-th entry of the row stored in slot s
+        std::size_t entry(std::size_t s, std::size_t j) const
+        {
+          return _container->_chunkoffset[s / chunk_size] + j * chunk_size + s % chunk_size;
+        }
+
+        // position of entry (row,col) in the data array, or invalid() if it is not in the pattern
+        std::size_t find(std::size_t row, std::size_t col) const
+        {
+          const std::size_t s = _container->_inverse_permutation[row];
+          const std::size_t base = entry(s,0);
+          // the columns of a row are stored in ascending order with stride chunk_size
+          std::size_t lo = 0;
+          std::size_t hi = _container->_rowlength[s];
+          while (lo < hi)
+            {
+              const std::size_t mid = (lo + hi) / 2;
+              if (std::size_t(_container->_colindex[base + mid*chunk_size]) < col)
+                lo = mid + 1;
+              else
+                hi = mid;
+            }
+          if (lo < _container->_rowlength[s] && std::size_t(_container->_colindex[base + lo*chunk_size]) == col)
+            return base + lo*chunk_size;
+          return invalid();
+        }
+
+        const ElementType* data_ptr() const
+        {
+          return _container->_data.size() > 0 ? &(_container->_data[0]) : nullptr;
+        }
+
+        const index_type* colindex_ptr() const
+        {
+          return _container->_colindex.size() > 0 ? &(_container->_colindex[0]) : nullptr;
+        }
+
+        // Computes the products of all rows in chunk c with x. The inner loop runs over
+        // the rows of the chunk, which are contiguous in memory and have a compile-time
+        // trip count, so the compiler can turn it into SIMD loads and gathers.
+        void chunk_product(std::size_t c, const ElementType* data, const index_type* colindex,
+                           const ElementType* x, ElementType (&accu)[chunk_size]) const
+        {
+          for (std::size_t l = 0; l < chunk_size; ++l)
+            accu[l] = ElementType(0);
+          const std::size_t begin = _container->_chunkoffset[c];
+          const std::size_t end = _container->_chunkoffset[c+1];
+          for (std::size_t k = begin; k < end; k += chunk_size)
+            {
+              const ElementType* a = data + k;
+              const index_type* ci = colindex + k;
+              for (std::size_t l = 0; l < chunk_size; ++l)
+                accu[l] += a[l] * x[ci[l]];
+            }
+        }
+
+        template<typename V>
+        void spmv(const V& x, V& y, const ElementType alpha, bool add) const
+        {
+          const std::size_t rows = _container->_rows;
+          const ElementType* data = data_ptr();
+          const index_type* colindex = colindex_ptr();
+          const ElementType* xp = _container->_cols > 0 ? &(x.base()[0]) : nullptr;
+          for (std::size_t c = 0; c < _container->_chunks; ++c)
+            {
+              ElementType accu[chunk_size];
+              chunk_product(c,data,colindex,xp,accu);
+              const std::size_t slot_end = std::min((c+1)*chunk_size,rows);
+              if (add)
+                for (std::size_t s = c*chunk_size; s < slot_end; ++s)
+                  y.base()[_container->_permutation[s]] += alpha * accu[s - c*chunk_size];
+              else
+                for (std::size_t s = c*chunk_size; s < slot_end; ++s)
+                  y.base()[_container->_permutation[s]] = accu[s - c*chunk_size];
+            }
+        }
+
+        template<typename GO>
+        static void allocate_matrix(std::shared_ptr<Container> & c, const GO & go, const ElementType& e)
+        {
+          Pattern pattern(go.testGridFunctionSpace().ordering(),go.trialGridFunctionSpace().ordering());
+          go.fill_pattern(pattern);
+
+          const std::size_t rows = go.testGridFunctionSpace().size();
+          c->_rows = rows;
+          c->_cols = go.trialGridFunctionSpace().size();
+          c->_chunks = (rows + chunk_size - 1) / chunk_size;
+          // the pattern is only resized on the first call to add_link()
+          pattern.resize(rows);
+
+          // sort the rows by descending length within each sorting window
+          std::vector<std::size_t> perm(rows);
+          std::iota(perm.begin(),perm.end(),0);
+          for (std::size_t w = 0; w < rows; w += sigma)
+            std::stable_sort(perm.begin() + w, perm.begin() + std::min(w + sigma,rows),
+                             [&](std::size_t a, std::size_t b) { return pattern[a].size() > pattern[b].size(); });
+
+          c->_permutation.resize(c->_chunks * chunk_size);
+          c->_inverse_permutation.resize(rows);
+          c->_rowlength.resize(c->_chunks * chunk_size);
+          c->_non_zeros = 0;
+          for (std::size_t s = 0; s < c->_chunks * chunk_size; ++s)
+            {
+              if (s < rows)
+                {
+                  c->_permutation[s] = perm[s];
+                  c->_inverse_permutation[perm[s]] = s;
+                  c->_rowlength[s] = pattern[perm[s]].size();
+                  c->_non_zeros += pattern[perm[s]].size();
+                }
+              else
+                {
+                  // padding slots of the last chunk
+                  c->_permutation[s] = 0;
+                  c->_rowlength[s] = 0;
+                }
+            }
+
+          // compute chunk offsets
+          c->_chunkoffset.resize(c->_chunks + 1);
+          c->_chunkoffset[0] = 0;
+          for (std::size_t k = 0; k < c->_chunks; ++k)
+            {
+              std::size_t width = 0;
+              for (std::size_t l = 0; l < chunk_size; ++l)
+                width = std::max(width,std::size_t(c->_rowlength[k*chunk_size + l]));
+              c->_chunkoffset[k+1] = c->_chunkoffset[k] + width * chunk_size;
+            }
+
+          // copy pattern, padding entries point to the last column of their row
+          // (or column 0) to keep the gathers in the product local and in bounds
+          c->_data.assign(c->_chunkoffset[c->_chunks],ElementType(0));
+          c->_colindex.assign(c->_chunkoffset[c->_chunks],index_type(0));
+          std::vector<std::size_t> cols;
+          for (std::size_t s = 0; s < rows; ++s)
+            {
+              const std::size_t k = s / chunk_size;
+              const std::size_t width = (c->_chunkoffset[k+1] - c->_chunkoffset[k]) / chunk_size;
+              const std::size_t base = c->_chunkoffset[k] + s % chunk_size;
+              cols.assign(pattern[perm[s]].begin(),pattern[perm[s]].end());
+              std::sort(cols.begin(),cols.end());
+              for (std::size_t j = 0; j < width; ++j)
+                {
+                  if (j < cols.size())
+                    {
+                      c->_colindex[base + j*chunk_size] = cols[j];
+                      c->_data[base + j*chunk_size] = e;
+                    }
+                  else
+                    c->_colindex[base + j*chunk_size] = cols.empty() ? 0 : cols.back();
+                }
+            }
+        }
+
+        std::shared_ptr< Container > _container;
+      };
+
+    } // namespace simple
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_SIMPLE_SELL_HH
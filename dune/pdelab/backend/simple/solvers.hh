@@ -0,0 +1,425 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_BACKEND_SIMPLE_SOLVERS_HH
+#define DUNE_PDELAB_BACKEND_SIMPLE_SOLVERS_HH
+
+#include <cmath>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <dune/common/exceptions.hh>
+#include <dune/istl/operators.hh>
+#include <dune/istl/preconditioner.hh>
+#include <dune/istl/solvercategory.hh>
+#include <dune/istl/solvers.hh>
+
+#include <dune/pdelab/backend/solver.hh>
+#include <dune/pdelab/backend/simple/sell.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! \addtogroup Backend
+    //! \ingroup PDELab
+    //! \{
+
+    namespace simple {
+
+      //! Damped Jacobi preconditioner for SELL-C-sigma matrices.
+      /**
+       * Performs a fixed number of damped Jacobi steps starting from a zero initial
+       * guess. All steps after the first one use the fused residual kernel of the matrix.
+       *
+       * \tparam M  The matrix type, a SELLMatrixContainer.
+       * \tparam X  The domain type.
+       * \tparam Y  The range type.
+       */
+      template<typename M, typename X, typename Y>
+      class SELLJacobi
+        : public Dune::Preconditioner<X,Y>
+      {
+
+      public:
+
+        typedef M matrix_type;
+        typedef X domain_type;
+        typedef Y range_type;
+        typedef typename X::field_type field_type;
+
+        enum {
+          //! \brief The category the preconditioner is part of.
+          category=Dune::SolverCategory::sequential
+        };
+
+        /*! \brief Constructor.
+
+          \param[in] A the matrix to operate on
+          \param[in] steps the number of Jacobi steps per application
+          \param[in] w the damping factor
+        */
+        SELLJacobi(const M& A, int steps, field_type w)
+          : _A(A)
+          , _steps(steps)
+          , _w(w)
+        {
+          A.diagonal(_inverse_diagonal);
+          for (auto& d : _inverse_diagonal)
+            {
+              if (d == field_type(0))
+                DUNE_THROW(Dune::MathError,"SELLJacobi: zero on the diagonal");
+              d = field_type(1) / d;
+            }
+        }
+
+        virtual void pre(X& x, Y& b)
+        {}
+
+        virtual void apply(X& v, const Y& d)
+        {
+          const std::size_t n = _inverse_diagonal.size();
+          for (std::size_t i = 0; i < n; ++i)
+            v.base()[i] = _w * _inverse_diagonal[i] * d.base()[i];
+          if (_steps < 2)
+            return;
+          if (!_r)
+            _r.reset(new Y(d));
+          for (int k = 1; k < _steps; ++k)
+            {
+              _A.residual(v,d,*_r);
+              for (std::size_t i = 0; i < n; ++i)
+                v.base()[i] += _w * _inverse_diagonal[i] * _r->base()[i];
+            }
+        }
+
+        virtual void post(X& x)
+        {}
+
+      private:
+        const M& _A;
+        const int _steps;
+        const field_type _w;
+        std::vector<field_type> _inverse_diagonal;
+        std::unique_ptr<Y> _r;
+      };
+
+      //! Chebyshev preconditioner for SELL-C-sigma matrices.
+      /**
+       * Applies a fixed Chebyshev polynomial in D^{-1} A, where D is the diagonal of A.
+       * The polynomial is tuned to the interval [lambda_max / ratio, lambda_max], with
+       * lambda_max estimated by a power iteration on D^{-1} A the first time the
+       * preconditioner is used. Apart from the matrix-vector product, the application
+       * only needs vector updates, which makes it a good fit for the SIMD matrix kernels.
+       *
+       * \tparam M  The matrix type, a SELLMatrixContainer.
+       * \tparam X  The domain type.
+       * \tparam Y  The range type.
+       */
+      template<typename M, typename X, typename Y>
+      class SELLChebyshev
+        : public Dune::Preconditioner<X,Y>
+      {
+
+      public:
+
+        typedef M matrix_type;
+        typedef X domain_type;
+        typedef Y range_type;
+        typedef typename X::field_type field_type;
+
+        enum {
+          //! \brief The category the preconditioner is part of.
+          category=Dune::SolverCategory::sequential
+        };
+
+        /*! \brief Constructor.
+
+          \param[in] A the matrix to operate on
+          \param[in] degree the degree of the Chebyshev polynomial
+          \param[in] ratio the ratio between the largest and the smallest eigenvalue targeted
+          \param[in] power_iterations the number of power iterations for estimating lambda_max
+        */
+        SELLChebyshev(const M& A, int degree, field_type ratio = 30.0, int power_iterations = 10)
+          : _A(A)
+          , _degree(degree)
+          , _ratio(ratio)
+          , _power_iterations(power_iterations)
+          , _lambda_max(0.0)
+        {
+          if (degree < 1)
+            DUNE_THROW(Dune::RangeError,"SELLChebyshev: degree must be at least 1");
+          A.diagonal(_inverse_diagonal);
+          for (auto& d : _inverse_diagonal)
+            {
+              if (d == field_type(0))
+                DUNE_THROW(Dune::MathError,"SELLChebyshev: zero on the diagonal");
+              d = field_type(1) / d;
+            }
+        }
+
+        virtual void pre(X& x, Y& b)
+        {
+          if (!_r)
+            setup(x,b);
+        }
+
+        virtual void apply(X& v, const Y& d)
+        {
+          if (!_r)
+            setup(v,d);
+          const std::size_t n = _inverse_diagonal.size();
+          const field_type lambda_min = _lambda_max / _ratio;
+          const field_type theta = 0.5 * (_lambda_max + lambda_min);
+          const field_type delta = 0.5 * (_lambda_max - lambda_min);
+          const field_type sigma = theta / delta;
+          field_type rho = 1.0 / sigma;
+          X& p = *_p;
+          for (std::size_t i = 0; i < n; ++i)
+            {
+              p.base()[i] = _inverse_diagonal[i] * d.base()[i] / theta;
+              v.base()[i] = p.base()[i];
+            }
+          for (int k = 1; k < _degree; ++k)
+            {
+              _A.residual(v,d,*_r);
+              const field_type rho_new = 1.0 / (2.0 * sigma - rho);
+              const field_type a = rho_new * rho;
+              const field_type b = 2.0 * rho_new / delta;
+              for (std::size_t i = 0; i < n; ++i)
+                {
+                  p.base()[i] = a * p.base()[i] + b * _inverse_diagonal[i] * _r->base()[i];
+                  v.base()[i] += p.base()[i];
+                }
+              rho = rho_new;
+            }
+        }
+
+        virtual void post(X& x)
+        {}
+
+        //! Returns the estimate for the largest eigenvalue of D^{-1} A (zero before the first use).
+        field_type lambdaMax() const
+        {
+          return _lambda_max;
+        }
+
+      private:
+
+        // allocates the work vectors and estimates lambda_max by a power iteration
+        void setup(const X& x, const Y& d)
+        {
+          _r.reset(new Y(d));
+          _p.reset(new X(x));
+          X& z = *_p;
+          Y& y = *_r;
+          const std::size_t n = _inverse_diagonal.size();
+          for (std::size_t i = 0; i < n; ++i)
+            z.base()[i] = 1.0 + 0.1 * (i % 7);
+          field_type lambda = 0.0;
+          for (int k = 0; k < _power_iterations; ++k)
+            {
+              const field_type z_norm = z.two_norm();
+              if (z_norm == field_type(0))
+                break;
+              _A.mv(z,y);
+              for (std::size_t i = 0; i < n; ++i)
+                y.base()[i] *= _inverse_diagonal[i];
+              const field_type y_norm = y.two_norm();
+              lambda = y_norm / z_norm;
+              if (y_norm == field_type(0))
+                break;
+              for (std::size_t i = 0; i < n; ++i)
+                z.base()[i] = y.base()[i] / y_norm;
+            }
+          // the power iteration underestimates lambda_max, so add a safety margin
+          _lambda_max = lambda > 0.0 ? 1.1 * lambda : 1.0;
+        }
+
+        const M& _A;
+        const int _degree;
+        const field_type _ratio;
+        const int _power_iterations;
+        field_type _lambda_max;
+        std::vector<field_type> _inverse_diagonal;
+        std::unique_ptr<Y> _r;
+        std::unique_ptr<X> _p;
+      };
+
+    } // namespace simple
+
+    //==============================================================================
+    // Solver backends for the SELL-C-sigma matrices of the simple backend. They
+    // conform to the linear solver interface required to solve linear and
+    // nonlinear problems.
+    //==============================================================================
+
+    template<template<class> class Solver>
+    class SimpleBackend_SELL_Jacobi_Base
+      : public SequentialNorm, public LinearResultStorage
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] steps_ the number of Jacobi steps per preconditioner application
+        \param[in] w_ the damping factor of the Jacobi steps
+      */
+      explicit SimpleBackend_SELL_Jacobi_Base(unsigned maxiter_=5000, int verbose_=1,
+                                              int steps_=1, double w_=1.0)
+        : maxiter(maxiter_), verbose(verbose_), steps(steps_), w(w_)
+      {}
+
+      /*! \brief solve the given linear system
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename W::ElementType reduction)
+      {
+        Dune::MatrixAdapter<M,V,W> opa(A);
+        simple::SELLJacobi<M,V,W> prec(A, steps, w);
+        Solver<V> solver(opa, prec, reduction, maxiter, verbose);
+        Dune::InverseOperatorResult stat;
+        solver.apply(z, r, stat);
+        res.converged  = stat.converged;
+        res.iterations = stat.iterations;
+        res.elapsed    = stat.elapsed;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+
+    private:
+      unsigned maxiter;
+      int verbose;
+      int steps;
+      double w;
+    };
+
+    template<template<class> class Solver>
+    class SimpleBackend_SELL_Chebyshev_Base
+      : public SequentialNorm, public LinearResultStorage
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] degree_ the degree of the Chebyshev polynomial
+        \param[in] ratio_ the ratio between the largest and the smallest eigenvalue targeted
+      */
+      explicit SimpleBackend_SELL_Chebyshev_Base(unsigned maxiter_=5000, int verbose_=1,
+                                                 int degree_=4, double ratio_=30.0)
+        : maxiter(maxiter_), verbose(verbose_), degree(degree_), ratio(ratio_)
+      {}
+
+      /*! \brief solve the given linear system
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename W::ElementType reduction)
+      {
+        Dune::MatrixAdapter<M,V,W> opa(A);
+        simple::SELLChebyshev<M,V,W> prec(A, degree, ratio);
+        Solver<V> solver(opa, prec, reduction, maxiter, verbose);
+        Dune::InverseOperatorResult stat;
+        solver.apply(z, r, stat);
+        res.converged  = stat.converged;
+        res.iterations = stat.iterations;
+        res.elapsed    = stat.elapsed;
+        res.reduction  = stat.reduction;
+        res.conv_rate  = stat.conv_rate;
+      }
+
+    private:
+      unsigned maxiter;
+      int verbose;
+      int degree;
+      double ratio;
+    };
+
+    //! Backend for sequential conjugate gradient solver with Jacobi preconditioner on SELL matrices.
+    class SimpleBackend_SELL_CG_Jacobi
+      : public SimpleBackend_SELL_Jacobi_Base<Dune::CGSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] steps_ the number of Jacobi steps per preconditioner application
+        \param[in] w_ the damping factor of the Jacobi steps
+      */
+      explicit SimpleBackend_SELL_CG_Jacobi(unsigned maxiter_=5000, int verbose_=1,
+                                            int steps_=1, double w_=1.0)
+        : SimpleBackend_SELL_Jacobi_Base<Dune::CGSolver>(maxiter_, verbose_, steps_, w_)
+      {}
+    };
+
+    //! Backend for sequential BiCGSTAB solver with Jacobi preconditioner on SELL matrices.
+    class SimpleBackend_SELL_BCGS_Jacobi
+      : public SimpleBackend_SELL_Jacobi_Base<Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] steps_ the number of Jacobi steps per preconditioner application
+        \param[in] w_ the damping factor of the Jacobi steps
+      */
+      explicit SimpleBackend_SELL_BCGS_Jacobi(unsigned maxiter_=5000, int verbose_=1,
+                                              int steps_=1, double w_=1.0)
+        : SimpleBackend_SELL_Jacobi_Base<Dune::BiCGSTABSolver>(maxiter_, verbose_, steps_, w_)
+      {}
+    };
+
+    //! Backend for sequential conjugate gradient solver with Chebyshev preconditioner on SELL matrices.
+    class SimpleBackend_SELL_CG_Chebyshev
+      : public SimpleBackend_SELL_Chebyshev_Base<Dune::CGSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] degree_ the degree of the Chebyshev polynomial
+        \param[in] ratio_ the ratio between the largest and the smallest eigenvalue targeted
+      */
+      explicit SimpleBackend_SELL_CG_Chebyshev(unsigned maxiter_=5000, int verbose_=1,
+                                               int degree_=4, double ratio_=30.0)
+        : SimpleBackend_SELL_Chebyshev_Base<Dune::CGSolver>(maxiter_, verbose_, degree_, ratio_)
+      {}
+    };
+
+    //! Backend for sequential BiCGSTAB solver with Chebyshev preconditioner on SELL matrices.
+    class SimpleBackend_SELL_BCGS_Chebyshev
+      : public SimpleBackend_SELL_Chebyshev_Base<Dune::BiCGSTABSolver>
+    {
+    public:
+      /*! \brief make a linear solver object
+
+        \param[in] maxiter_ maximum number of iterations to do
+        \param[in] verbose_ print messages if true
+        \param[in] degree_ the degree of the Chebyshev polynomial
+        \param[in] ratio_ the ratio between the largest and the smallest eigenvalue targeted
+      */
+      explicit SimpleBackend_SELL_BCGS_Chebyshev(unsigned maxiter_=5000, int verbose_=1,
+                                                 int degree_=4, double ratio_=30.0)
+        : SimpleBackend_SELL_Chebyshev_Base<Dune::BiCGSTABSolver>(maxiter_, verbose_, degree_, ratio_)
+      {}
+    };
+
+    //! \} group Backend
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_BACKEND_SIMPLE_SOLVERS_HH
@@ -16,6 +16,7 @@
 #include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
 #include <dune/pdelab/backend/tags.hh>
 #include <dune/pdelab/backend/backendselector.hh>
+#include <dune/pdelab/backend/common/blas1.hh>
 #include <dune/pdelab/backend/common/uncachedvectorview.hh>
 #include <dune/pdelab/backend/simple/descriptors.hh>
 
@@ -24,21 +25,6 @@ namespace Dune {
 
     namespace simple {
 
-      namespace {
-
-        // For some reason std::bind cannot directly deduce the correct version
-        // of Dune::fvmeta::abs2, so we package it into a functor to help it along.
-        template<typename K>
-        struct abs2
-        {
-          typename FieldTraits<K>::real_type operator()(const K& k) const
-          {
-            return Dune::fvmeta::abs2(k);
-          }
-        };
-
-      }
-
       template<typename GFS, typename C>
       class VectorContainer
       {
@@ -160,7 +146,11 @@ namespace Dune {
         {
           if (this == &r)
             return *this;
-          if (attached())
+          if (attached() && N() == r.N())
+            {
+              blas1::copy(N(),r._container->data(),_container->data());
+            }
+          else if (attached())
             {
               (*_container) = (*r._container);
             }
@@ -173,36 +163,32 @@ namespace Dune {
 
         VectorContainer& operator=(const E& e)
         {
-          std::fill(_container->begin(),_container->end(),e);
+          blas1::fill(N(),_container->data(),e);
           return *this;
         }
 
         VectorContainer& operator*=(const E& e)
         {
-          std::transform(_container->begin(),_container->end(),_container->begin(),
-                         std::bind(std::multiplies<E>(),e,std::placeholders::_1));
+          blas1::scale(N(),e,_container->data());
           return *this;
         }
 
 
         VectorContainer& operator+=(const E& e)
         {
-          std::transform(_container->begin(),_container->end(),_container->begin(),
-                         std::bind(std::plus<E>(),e,std::placeholders::_1));
+          blas1::shift(N(),e,_container->data());
           return *this;
         }
 
         VectorContainer& operator+=(const VectorContainer& y)
         {
-          std::transform(_container->begin(),_container->end(),y._container->begin(),
-                         _container->begin(),std::plus<E>());
+          blas1::add(N(),y._container->data(),_container->data());
           return *this;
         }
 
         VectorContainer& operator-= (const VectorContainer& y)
         {
-          std::transform(_container->begin(),_container->end(),y._container->begin(),
-                         _container->begin(),std::minus<E>());
+          blas1::subtract(N(),y._container->data(),_container->data());
           return *this;
         }
 
@@ -218,42 +204,32 @@ namespace Dune {
 
         typename Dune::template FieldTraits<E>::real_type two_norm() const
         {
-          using namespace std::placeholders;
-          typedef typename Dune::template FieldTraits<E>::real_type Real;
-          return std::sqrt(std::accumulate(_container->begin(),_container->end(),Real(0),std::bind(std::plus<Real>(),_1,std::bind(abs2<E>(),_2))));
+          return blas1::two_norm(N(),_container->data());
         }
 
         typename Dune::template FieldTraits<E>::real_type one_norm() const
         {
-          using namespace std::placeholders;
-          typedef typename Dune::template FieldTraits<E>::real_type Real;
-          return std::accumulate(_container->begin(),_container->end(),Real(0),std::bind(std::plus<Real>(),_1,std::bind(std::abs<E>,_2)));
+          return blas1::one_norm(N(),_container->data());
         }
 
         typename Dune::template FieldTraits<E>::real_type infinity_norm() const
         {
-          if (_container->size() == 0)
-            return 0;
-          using namespace std::placeholders;
-          typedef typename Dune::template FieldTraits<E>::real_type Real;
-          return *std::max_element(_container->begin(),_container->end(),std::bind(std::less<Real>(),std::bind(std::abs<E>,_1),std::bind(std::abs<E>,_2)));
+          return blas1::infinity_norm(N(),_container->data());
         }
 
         E operator*(const VectorContainer& y) const
         {
-          return std::inner_product(_container->begin(),_container->end(),y._container->begin(),E(0));
+          return blas1::dotT(N(),_container->data(),y._container->data());
         }
 
         E dot(const VectorContainer& y) const
         {
-          return std::inner_product(_container->begin(),_container->end(),y._container->begin(),E(0),std::plus<E>(),Dune::dot<E,E>);
+          return blas1::dot(N(),_container->data(),y._container->data());
         }
 
         VectorContainer& axpy(const E& a, const VectorContainer& y)
         {
-          using namespace std::placeholders;
-          std::transform(_container->begin(),_container->end(),y._container->begin(),
-                         _container->begin(),std::bind(std::plus<E>(),_1,std::bind(std::multiplies<E>(),a,_2)));
+          blas1::axpy(N(),a,y._container->data(),_container->data());
           return *this;
         }
 
@@ -50,6 +50,16 @@ namespace Dune {
       : public OrderingError
     {};
 
+    //! A non-zero value was added to a matrix entry outside of the sparsity pattern.
+    class MatrixPatternError
+      : public Exception
+    {};
+
+    //! A checkpoint file could not be accessed or does not match the function space.
+    class CheckpointError
+      : public Exception
+    {};
+
   } // namespace PDELab
 } // namespace Dune
 
@@ -0,0 +1,183 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_COMMON_FIXEDCAPACITYVECTOR_HH
+#define DUNE_PDELAB_COMMON_FIXEDCAPACITYVECTOR_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! A std::vector-like container with a capacity fixed at compile time.
+    /**
+     * FixedCapacityVector stores its entries in an embedded array, so creating and
+     * resizing it never allocates memory. It supports the subset of the std::vector
+     * interface that is used for the storage of local vectors and matrices.
+     *
+     * The storage is aligned to 16 bytes. Stronger alignment is not requested on purpose,
+     * as the container is embedded in objects that are allocated with operator new,
+     * which does not respect extended alignment before C++17.
+     *
+     * \tparam T        The type of the entries.
+     * \tparam capacity The maximum number of entries.
+     */
+    template<typename T, std::size_t capacity_>
+    class FixedCapacityVector
+    {
+
+    public:
+
+      typedef T value_type;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef T& reference;
+      typedef const T& const_reference;
+      typedef T* pointer;
+      typedef const T* const_pointer;
+      typedef T* iterator;
+      typedef const T* const_iterator;
+
+      //! The maximum number of entries.
+      static const size_type static_capacity = capacity_;
+
+      FixedCapacityVector()
+        : _size(0)
+      {}
+
+      explicit FixedCapacityVector(size_type n)
+        : _size(0)
+      {
+        resize(n);
+      }
+
+      FixedCapacityVector(size_type n, const T& value)
+        : _size(0)
+      {
+        assign(n,value);
+      }
+
+      FixedCapacityVector(const FixedCapacityVector& other)
+        : _size(other._size)
+      {
+        std::copy(other.begin(),other.end(),begin());
+      }
+
+      FixedCapacityVector& operator=(const FixedCapacityVector& other)
+      {
+        _size = other._size;
+        std::copy(other.begin(),other.end(),begin());
+        return *this;
+      }
+
+      size_type size() const
+      {
+        return _size;
+      }
+
+      bool empty() const
+      {
+        return _size == 0;
+      }
+
+      static size_type capacity()
+      {
+        return capacity_;
+      }
+
+      static size_type max_size()
+      {
+        return capacity_;
+      }
+
+      //! Changes the size; new entries are value-initialized.
+      void resize(size_type n)
+      {
+        resize(n,T());
+      }
+
+      //! Changes the size; new entries are initialized with value.
+      void resize(size_type n, const T& value)
+      {
+        assert(n <= capacity_);
+        if (n > _size)
+          std::fill(_data + _size,_data + n,value);
+        _size = n;
+      }
+
+      //! Changes the size and assigns value to all entries.
+      void assign(size_type n, const T& value)
+      {
+        assert(n <= capacity_);
+        _size = n;
+        std::fill(_data,_data + n,value);
+      }
+
+      void clear()
+      {
+        _size = 0;
+      }
+
+      void push_back(const T& value)
+      {
+        assert(_size < capacity_);
+        _data[_size++] = value;
+      }
+
+      reference operator[](size_type i)
+      {
+        assert(i < _size);
+        return _data[i];
+      }
+
+      const_reference operator[](size_type i) const
+      {
+        assert(i < _size);
+        return _data[i];
+      }
+
+      pointer data()
+      {
+        return _data;
+      }
+
+      const_pointer data() const
+      {
+        return _data;
+      }
+
+      iterator begin()
+      {
+        return _data;
+      }
+
+      const_iterator begin() const
+      {
+        return _data;
+      }
+
+      iterator end()
+      {
+        return _data + _size;
+      }
+
+      const_iterator end() const
+      {
+        return _data + _size;
+      }
+
+    private:
+
+      alignas(16) T _data[capacity_];
+      size_type _size;
+
+    };
+
+    template<typename T, std::size_t capacity_>
+    const typename FixedCapacityVector<T,capacity_>::size_type FixedCapacityVector<T,capacity_>::static_capacity;
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_COMMON_FIXEDCAPACITYVECTOR_HH
@@ -0,0 +1,103 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_COMMON_WORKSPACE_HH
+#define DUNE_PDELAB_COMMON_WORKSPACE_HH
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! A set of containers that is kept between calls of a solver.
+    /**
+     * Time stepping schemes and nonlinear solvers need temporary vectors and
+     * matrices for the stages, residuals and corrections of every step.
+     * Creating them anew in every step allocates the full size of the problem
+     * each time, and the operating system has to map fresh pages on their
+     * first access. A Workspace creates its containers on first request and
+     * returns the same objects in later steps.
+     *
+     * Containers are created from a source object, the function space for
+     * vectors or the grid operator for matrices, and identified by a slot
+     * number. Together with the source, the caller passes a revision that
+     * changes whenever the layout of the containers changes, usually the
+     * revision() of the function spaces involved. When a container is
+     * requested with a different source object or revision than before, e.g.
+     * after the grid function space has been updated to an adapted grid, all
+     * containers are dropped and created again. This also catches a changed
+     * matrix pattern if the number of DOFs stays the same. The contents of a
+     * container are not preserved between requests in any meaningful way;
+     * callers have to initialize them.
+     *
+     * \tparam C The container type.
+     */
+    template<typename C>
+    class Workspace
+    {
+
+    public:
+
+      typedef C Container;
+      typedef std::size_t size_type;
+
+      //! Creates an empty workspace.
+      Workspace()
+        : _source(nullptr)
+        , _revision(0)
+        , _allocations(0)
+      {}
+
+      //! Returns the container in the given slot, creating it from source if necessary.
+      /**
+       * \param slot     The number of the container.
+       * \param source   The object the container is constructed from.
+       * \param revision The revision of the source; a change drops all containers.
+       */
+      template<typename Source>
+      C& get(size_type slot, const Source& source, std::size_t revision)
+      {
+        if (static_cast<const void*>(&source) != _source || revision != _revision)
+          {
+            _containers.clear();
+            _source = &source;
+            _revision = revision;
+          }
+        if (slot >= _containers.size())
+          _containers.resize(slot + 1);
+        if (!_containers[slot])
+          {
+            _containers[slot] = std::make_shared<C>(source);
+            ++_allocations;
+          }
+        return *_containers[slot];
+      }
+
+      //! Releases all containers.
+      void clear()
+      {
+        _containers.clear();
+        _source = nullptr;
+        _revision = 0;
+      }
+
+      //! The number of containers that have been created so far.
+      size_type allocations() const
+      {
+        return _allocations;
+      }
+
+    private:
+
+      const void* _source;
+      std::size_t _revision;
+      size_type _allocations;
+      std::vector<std::shared_ptr<C> > _containers;
+
+    };
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_COMMON_WORKSPACE_HH
@@ -4,6 +4,8 @@
 #ifndef DUNE_PDELAB_CONSTRAINTS_COMMON_CONSTRAINTS_HH
 #define DUNE_PDELAB_CONSTRAINTS_COMMON_CONSTRAINTS_HH
 
+#include<vector>
+
 #include<dune/common/exceptions.hh>
 #include<dune/common/float_cmp.hh>
 
@@ -642,6 +644,9 @@ namespace Dune {
 
         }
 
+        // build the compressed representation used during assembly
+        cg.finalize();
+
         // print result
         if(verbose){
           std::cout << "constraints:" << std::endl;
@@ -767,6 +772,12 @@ namespace Dune {
                               typename XG::ElementType x,
                               XG& xg)
     {
+      if (cg.finalized())
+        {
+          for (typename CG::size_type r = 0; r < cg.rowCount(); ++r)
+            xg[cg.rowIndex(r)] = x;
+          return;
+        }
       typedef typename CG::const_iterator global_col_iterator;
       for (global_col_iterator cit=cg.begin(); cit!=cg.end(); ++cit)
         xg[cit->first] = x;
@@ -810,6 +821,13 @@ namespace Dune {
     bool check_constrained_dofs(const CG& cg, typename XG::ElementType x,
                                 XG& xg, const Cmp& cmp = Cmp())
     {
+      if (cg.finalized())
+        {
+          for (typename CG::size_type r = 0; r < cg.rowCount(); ++r)
+            if(cmp.ne(xg[cg.rowIndex(r)], x))
+              return false;
+          return true;
+        }
       typedef typename CG::const_iterator global_col_iterator;
       for (global_col_iterator cit=cg.begin(); cit!=cg.end(); ++cit)
         if(cmp.ne(xg[cit->first], x))
@@ -875,6 +893,20 @@ namespace Dune {
     template<typename CG, typename XG>
     void constrain_residual (const CG& cg, XG& xg)
     {
+      if (cg.finalized())
+        {
+          typedef typename CG::size_type size_type;
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            for (size_type k = cg.rowBegin(r); k < cg.rowEnd(r); ++k)
+              xg[cg.entryIndex(k)] += cg.entryWeight(k) * xg[cg.rowIndex(r)];
+
+          // extra loop because constrained dofs might have contributions
+          // to constrained dofs
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            xg[cg.rowIndex(r)] = typename XG::ElementType(0);
+          return;
+        }
+
       typedef typename CG::const_iterator global_col_iterator;
       typedef typename CG::value_type::second_type::const_iterator global_row_iterator;
 
@@ -910,6 +942,12 @@ namespace Dune {
     template<typename CG, typename XG>
     void copy_constrained_dofs (const CG& cg, const XG& xgin, XG& xgout)
     {
+      if (cg.finalized())
+        {
+          for (typename CG::size_type r = 0; r < cg.rowCount(); ++r)
+            xgout[cg.rowIndex(r)] = xgin[cg.rowIndex(r)];
+          return;
+        }
       typedef typename CG::const_iterator global_col_iterator;
       for (global_col_iterator cit=cg.begin(); cit!=cg.end(); ++cit)
         {
@@ -936,6 +974,19 @@ namespace Dune {
     template<typename CG, typename XG>
     void set_nonconstrained_dofs (const CG& cg, typename XG::ElementType x, XG& xg)
     {
+      if (cg.finalized())
+        {
+          // only save the constrained values instead of copying the whole vector
+          typedef typename CG::size_type size_type;
+          std::vector<typename XG::ElementType> constrained(cg.rowCount());
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            constrained[r] = xg[cg.rowIndex(r)];
+          xg = x;
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            xg[cg.rowIndex(r)] = constrained[r];
+          return;
+        }
+
       // FIXME: This is horribly inefficient!
       XG tmp(xg);
       xg = x;
@@ -969,6 +1020,18 @@ namespace Dune {
     template<typename CG, typename XG>
     void copy_nonconstrained_dofs (const CG& cg, const XG& xgin, XG& xgout)
     {
+      if (cg.finalized())
+        {
+          typedef typename CG::size_type size_type;
+          std::vector<typename XG::ElementType> constrained(cg.rowCount());
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            constrained[r] = xgout[cg.rowIndex(r)];
+          xgout = xgin;
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            xgout[cg.rowIndex(r)] = constrained[r];
+          return;
+        }
+
       // FIXME: This is horribly inefficient!
       XG tmp(xgin);
       copy_constrained_dofs(cg,xgout,tmp);
@@ -1002,6 +1065,20 @@ namespace Dune {
     template<typename CG, typename XG>
     void set_shifted_dofs (const CG& cg, typename XG::ElementType x, XG& xg)
     {
+      if (cg.finalized())
+        {
+          typedef typename CG::size_type size_type;
+          std::vector<typename XG::ElementType> dirichlet(cg.rowCount());
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            if (cg.isDirichletRow(r))
+              dirichlet[r] = xg[cg.rowIndex(r)];
+          xg = x;
+          for (size_type r = 0; r < cg.rowCount(); ++r)
+            if (cg.isDirichletRow(r))
+              xg[cg.rowIndex(r)] = dirichlet[r];
+          return;
+        }
+
       // FIXME: This is horribly inefficient!
 
       XG tmp(xg);
@@ -3,7 +3,12 @@
 #ifndef DUNE_PDELAB_GRIDFUNCTIONSPACE_CONSTRAINTSTRANSFORMATION_HH
 #define DUNE_PDELAB_GRIDFUNCTIONSPACE_CONSTRAINTSTRANSFORMATION_HH
 
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <dune/common/tuples.hh>
 
@@ -14,7 +19,62 @@ namespace Dune {
     //! \ingroup PDELab
     //! \{
 
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // Strict weak ordering on container indices that sorts by the outermost
+      // block index first, so that the constrained rows end up in storage order.
+      struct container_index_less
+      {
+        template<typename CI>
+        bool operator()(const CI& a, const CI& b) const
+        {
+          const std::size_t na = a.size();
+          const std::size_t nb = b.size();
+          for (std::size_t k = 0; k < std::min(na,nb); ++k)
+            {
+              if (a[na-1-k] < b[nb-1-k])
+                return true;
+              if (b[nb-1-k] < a[na-1-k])
+                return false;
+            }
+          return na < nb;
+        }
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
     //! \brief a class holding transformation for constrained spaces
+    /**
+     * The constraints are collected in a map from each constrained container index to a
+     * map of the container indices it contributes to. Once all constraints have been
+     * imported, finalize() builds a compressed, immutable copy of this information, which
+     * is used for all lookups during assembly:
+     *
+     * - The constrained rows, sorted by container index, with their entries stored in
+     *   compressed row (CSR) format.
+     * - A flag for every outermost block of the container that tells whether the block
+     *   contains a constrained DOF at all. Looking up an unconstrained DOF thus does not
+     *   require any search in the vast majority of cases.
+     *
+     * The constraints assembly calls finalize() automatically. Every modification of the map
+     * through operator[](), insert(), emplace(), erase() or clear() discards the compressed
+     * representation, and the assembly falls back to the map until finalize() is called
+     * again. Modifying a row through an iterator obtained from the map is not detected;
+     * call finalize() yourself after doing so.
+     *
+     * By default, the map is kept next to the compressed copy. finalize(true) releases
+     * the memory of the map instead, which roughly halves the memory footprint of the
+     * constraints. Afterwards, the map itself is empty: the assemblers and the functions
+     * in constraints.hh, which use the compressed representation, still see all
+     * constraints, but code that iterates over the map directly (e.g. the overlapping
+     * ISTL solver backends) does not. The first modification through operator[](),
+     * insert(), emplace(), erase() or import_local_transformation() rebuilds the map from
+     * the compressed representation.
+     */
     template<typename DI, typename CI, typename F>
     class ConstraintsTransformation
       : public std::unordered_map<CI,std::unordered_map<CI,F> >
@@ -27,6 +87,11 @@ namespace Dune {
       typedef F ElementType;
       typedef F Field;
 
+      typedef std::size_t size_type;
+
+      //! Value returned by findRow() for container indices that are not constrained.
+      static const size_type npos = size_type(-1);
+
       class LocalTransformation
         : public std::unordered_map<DI,std::unordered_map<DI,F> >
       {
@@ -59,17 +124,70 @@ namespace Dune {
 
       ConstraintsTransformation()
         : _contains_non_dirichlet_constraints(false)
+        , _finalized(false)
+        , _maps_released(false)
       {}
 
       void clear()
       {
         BaseT::clear();
         _contains_non_dirichlet_constraints = false;
+        _maps_released = false;
+        clearCompressed();
+      }
+
+      //! Accesses a row of the map and discards the compressed representation.
+      template<typename K>
+      RowType& operator[](K&& key)
+      {
+        restoreMaps();
+        _finalized = false;
+        return BaseT::operator[](std::forward<K>(key));
+      }
+
+      //! Inserts into the map and discards the compressed representation.
+      template<typename... Args>
+      auto insert(Args&&... args)
+        -> decltype(std::declval<BaseT&>().insert(std::forward<Args>(args)...))
+      {
+        restoreMaps();
+        _finalized = false;
+        return BaseT::insert(std::forward<Args>(args)...);
+      }
+
+      //! Inserts into the map and discards the compressed representation.
+      void insert(std::initializer_list<typename BaseT::value_type> values)
+      {
+        restoreMaps();
+        _finalized = false;
+        BaseT::insert(values);
+      }
+
+      //! Inserts into the map and discards the compressed representation.
+      template<typename... Args>
+      std::pair<typename BaseT::iterator,bool> emplace(Args&&... args)
+      {
+        restoreMaps();
+        _finalized = false;
+        return BaseT::emplace(std::forward<Args>(args)...);
+      }
+
+      //! Erases from the map and discards the compressed representation.
+      template<typename... Args>
+      auto erase(Args&&... args)
+        -> decltype(std::declval<BaseT&>().erase(std::forward<Args>(args)...))
+      {
+        restoreMaps();
+        _finalized = false;
+        return BaseT::erase(std::forward<Args>(args)...);
       }
 
       template<typename IndexCache>
       void import_local_transformation(const LocalTransformation& local_transformation, const IndexCache& index_cache)
       {
+        restoreMaps();
+        _finalized = false;
+
         typedef typename IndexCache::ContainerIndex ContainerIndex;
         typedef typename ConstraintsTransformation::iterator GlobalConstraintIterator;
         typedef typename ConstraintsTransformation::mapped_type GlobalConstraint;
@@ -119,12 +237,166 @@ namespace Dune {
         return _contains_non_dirichlet_constraints;
       }
 
+      //! Builds the compressed representation of the constraints.
+      /**
+       * \param release_maps If true, the memory of the map is released once the
+       *                     compressed representation has been built (see the
+       *                     class documentation).
+       */
+      void finalize(bool release_maps = false)
+      {
+        restoreMaps();
+        clearCompressed();
+
+        _rows.reserve(this->size());
+        for (typename BaseT::const_iterator it = this->begin(); it != this->end(); ++it)
+          _rows.push_back(it->first);
+        std::sort(_rows.begin(),_rows.end(),impl::container_index_less());
+
+        _row_offsets.resize(_rows.size() + 1);
+        _row_offsets[0] = 0;
+        size_type block_count = 0;
+        for (size_type r = 0; r < _rows.size(); ++r)
+          {
+            const RowType& row = this->find(_rows[r])->second;
+            _row_offsets[r+1] = _row_offsets[r] + row.size();
+            block_count = std::max(block_count,size_type(_rows[r].back()) + 1);
+          }
+
+        _entry_indices.reserve(_row_offsets.back());
+        _entry_weights.reserve(_row_offsets.back());
+        for (size_type r = 0; r < _rows.size(); ++r)
+          {
+            const RowType& row = this->find(_rows[r])->second;
+            const size_type begin = _entry_indices.size();
+            for (typename RowType::const_iterator it = row.begin(); it != row.end(); ++it)
+              _entry_indices.push_back(it->first);
+            std::sort(_entry_indices.begin() + begin,_entry_indices.end(),impl::container_index_less());
+            for (size_type k = begin; k < _entry_indices.size(); ++k)
+              _entry_weights.push_back(row.find(_entry_indices[k])->second);
+          }
+
+        _block_flags.assign(block_count,0);
+        for (size_type r = 0; r < _rows.size(); ++r)
+          _block_flags[_rows[r].back()] = 1;
+
+        _finalized = true;
+
+        if (release_maps)
+          {
+            // swap with an empty map, clear() would keep the bucket array
+            BaseT().swap(*this);
+            _maps_released = true;
+          }
+      }
+
+      //! Returns whether finalize(true) has released the map.
+      bool mapsReleased() const
+      {
+        return _maps_released;
+      }
+
+      //! Returns whether the compressed representation is available and up to date.
+      bool finalized() const
+      {
+        return _finalized;
+      }
+
+      //! Returns the number of constrained rows in the compressed representation.
+      size_type rowCount() const
+      {
+        return _rows.size();
+      }
+
+      //! Returns the position of ci in the compressed representation, or npos if ci is not constrained.
+      size_type findRow(const CI& ci) const
+      {
+        const size_type block = ci.back();
+        if (block >= _block_flags.size() || !_block_flags[block])
+          return npos;
+        typename std::vector<CI>::const_iterator it =
+          std::lower_bound(_rows.begin(),_rows.end(),ci,impl::container_index_less());
+        if (it == _rows.end() || !(*it == ci))
+          return npos;
+        return it - _rows.begin();
+      }
+
+      //! Returns the container index of the constrained row r.
+      const CI& rowIndex(size_type r) const
+      {
+        return _rows[r];
+      }
+
+      //! Returns whether the constrained row r is a Dirichlet constraint.
+      bool isDirichletRow(size_type r) const
+      {
+        return _row_offsets[r] == _row_offsets[r+1];
+      }
+
+      //! Returns the position of the first entry of row r.
+      size_type rowBegin(size_type r) const
+      {
+        return _row_offsets[r];
+      }
+
+      //! Returns the position one past the last entry of row r.
+      size_type rowEnd(size_type r) const
+      {
+        return _row_offsets[r+1];
+      }
+
+      //! Returns the container index of entry k.
+      const CI& entryIndex(size_type k) const
+      {
+        return _entry_indices[k];
+      }
+
+      //! Returns the weight of entry k.
+      const F& entryWeight(size_type k) const
+      {
+        return _entry_weights[k];
+      }
+
     private:
 
+      // rebuilds the map from the compressed representation after finalize(true)
+      void restoreMaps()
+      {
+        if (!_maps_released)
+          return;
+        _maps_released = false;
+        for (size_type r = 0; r < _rows.size(); ++r)
+          {
+            RowType& row = BaseT::operator[](_rows[r]);
+            for (size_type k = _row_offsets[r]; k < _row_offsets[r+1]; ++k)
+              row[_entry_indices[k]] = _entry_weights[k];
+          }
+      }
+
+      void clearCompressed()
+      {
+        _finalized = false;
+        _rows.clear();
+        _row_offsets.clear();
+        _entry_indices.clear();
+        _entry_weights.clear();
+        _block_flags.clear();
+      }
+
       bool _contains_non_dirichlet_constraints;
+      bool _finalized;
+      bool _maps_released;
+      std::vector<CI> _rows;
+      std::vector<size_type> _row_offsets;
+      std::vector<CI> _entry_indices;
+      std::vector<F> _entry_weights;
+      std::vector<unsigned char> _block_flags;
 
     };
 
+    template<typename DI, typename CI, typename F>
+    const typename ConstraintsTransformation<DI,CI,F>::size_type ConstraintsTransformation<DI,CI,F>::npos;
+
     class EmptyTransformation : public ConstraintsTransformation<char,char,char>
     {
 
@@ -135,6 +407,19 @@ namespace Dune {
         return false;
       }
 
+      void finalize(bool release_maps = false)
+      {}
+
+      bool mapsReleased() const
+      {
+        return false;
+      }
+
+      bool finalized() const
+      {
+        return false;
+      }
+
     };
 
    //! \} group GridFunctionSpace
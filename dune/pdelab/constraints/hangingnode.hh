@@ -360,9 +360,17 @@ namespace Dune {
         typedef typename Intersection::Geometry FaceGeometry;
         typedef typename FaceGeometry::ctype DT;
 
+        // nothing to do on conforming grids
+        if(! manager.hasHangingNodes())
+          return;
+
         const CellEntityPointer e = ig.inside();
         const CellEntityPointer f = ig.outside();
 
+        // the faces of cells without hanging nodes are not constrained
+        if(! manager.hasHangingNodes(*e) && ! manager.hasHangingNodes(*f))
+          return;
+
         const Dune::ReferenceElement<DT,dimension>& refelem_e
           = Dune::ReferenceElements<DT,dimension>::general(e->type());
         const Dune::ReferenceElement<DT,dimension>& refelem_f
@@ -4,9 +4,15 @@
 #ifndef HANGINGNODEMANAGER_HH
 #define HANGINGNODEMANAGER_HH
 
+#include<algorithm>
+#include<limits>
+#include<utility>
+#include<vector>
+
 #include<dune/grid/common/grid.hh>
 #include<dune/grid/common/mcmgmapper.hh>
 #include<dune/common/float_cmp.hh>
+#include<dune/common/timer.hh>
 
 #include"../common/geometrywrapper.hh"
 
@@ -59,6 +65,36 @@ namespace Dune {
 
       std::vector<NodeInfo> node_info;
 
+      // whether a cell contains at least one hanging node, indexed by cell_mapper
+      std::vector<bool> cell_has_hanging_nodes;
+
+    public:
+
+      //! Statistics of the last call to analyzeView()
+      struct AnalysisStatistics
+      {
+        //! Number of leaf cells
+        std::size_t cells;
+        //! Number of leaf vertices
+        std::size_t vertices;
+        //! Number of hanging nodes
+        std::size_t hanging_nodes;
+        //! Number of cells containing at least one hanging node
+        std::size_t cells_with_hanging_nodes;
+        //! Number of cells whose faces were analyzed, i.e. the new cells and their neighbours
+        std::size_t reanalyzed_cells;
+        //! Wall time of the analysis in seconds
+        double elapsed;
+
+        AnalysisStatistics() : cells(0), vertices(0), hanging_nodes(0),
+                               cells_with_hanging_nodes(0), reanalyzed_cells(0), elapsed(0.0)
+        {}
+      };
+
+    private:
+
+      AnalysisStatistics analysis_statistics;
+
     public:
 
       class NodeState
@@ -98,41 +134,199 @@ namespace Dune {
       const BoundaryFunction & boundaryFunction;
       CellMapper cell_mapper;
 
+    private:
+
+      typedef typename Grid::LocalIdSet LocalIdSet;
+      typedef typename LocalIdSet::IdType CellId;
+
+      // Result of the face analysis of a cell. It only depends on the cell and
+      // its neighbours, so it is kept for all cells that still exist after an
+      // adaptation and whose neighbours did not change.
+      struct CellAnalysis
+      {
+        // minimum level of the cells touching each vertex across a face
+        unsigned short touching_level[1 << dim];
+        // Dirichlet flag of the last boundary face containing each vertex, -1 if there is none
+        signed char boundary[1 << dim];
+      };
+
+      // face analyses of the leaf cells, indexed by cell_mapper
+      std::vector<CellAnalysis> cell_analysis;
+
+      // local ids of the leaf cells with their index into cell_analysis, sorted by id
+      typedef std::pair<CellId,IndexType> CellIdIndex;
+      std::vector<CellIdIndex> cell_ids;
+
+      struct CellIdLess
+      {
+        bool operator()(const CellIdIndex & a, const CellIdIndex & b) const
+        {
+          return a.first < b.first;
+        }
+      };
+
+      // analyzes the faces of the cell e and flags its neighbours in neighbours
+      void analyzeFaces(const GridView & gv, const Cell & e, CellAnalysis & analysis,
+                        std::vector<char> & neighbours) const
+      {
+        const Dune::ReferenceElement<double,dim> &
+          reference_element =
+          Dune::ReferenceElements<double,dim>::general(e.type());
+
+        std::fill(analysis.touching_level,analysis.touching_level + (1 << dim),
+                  std::numeric_limits<unsigned short>::max());
+        std::fill(analysis.boundary,analysis.boundary + (1 << dim),-1);
+
+        unsigned int intersection_index = 0;
+        IntersectionIterator fit = gv.ibegin(e);
+        IntersectionIterator efit = gv.iend(e);
+        typedef typename IntersectionIterator::Intersection Intersection;
+
+        // Loop over faces
+        for(;fit!=efit;++fit,++intersection_index){
+
+          const Dune::ReferenceElement<double,dim-1> &
+            reference_face_element =
+            Dune::ReferenceElements<double,dim-1>::general(fit->geometry().type());
+
+          const int eLocalIndex =  fit->indexInInside();
+          const unsigned short e_level = e.level();
+
+          // number of vertices on the face
+          const int e_v_size = reference_element.size(eLocalIndex,1,dim);
+
+          if((*fit).boundary()) {
+
+            // loop over vertices on the face
+            for(int i=0; i<e_v_size;++i){
+              const int e_v_index = reference_element.subEntity(eLocalIndex,1,i,dim);
+
+              const FacePoint facelocal_position = reference_face_element.position(i,dim-1);
+
+              analysis.boundary[e_v_index] =
+                boundaryFunction.isDirichlet(IntersectionGeometry<Intersection>(*fit,intersection_index),facelocal_position);
+              analysis.touching_level[e_v_index] = std::min(analysis.touching_level[e_v_index],e_level);
+            }
+
+            // We are done here - the remaining tests are only required for neighbor intersections
+            continue;
+          }
+
+          const CellEntityPointer outside = fit->outside();
+          neighbours[cell_mapper.map(*outside)] = 1;
+
+          const unsigned short f_level = outside->level();
+
+          // a conforming face has no hanging nodes
+          if(fit->conforming())
+            continue;
+
+          // so far no support for initially non conforming grids
+          assert(e_level != f_level);
+
+          // this check needs to be performed on the element containing
+          // the hanging node only
+          if(e_level < f_level)
+            continue;
+
+          // loop over vertices on the face
+          for(int i=0; i<e_v_size;++i){
+            const int e_v_index = reference_element.subEntity(eLocalIndex,1,i,dim);
+            analysis.touching_level[e_v_index] = std::min(analysis.touching_level[e_v_index],f_level);
+          }
+
+        } // end of loop over faces
+      }
+
     public:
 
+      //! Analyzes the leaf grid view after the grid has been adapted.
+      /**
+       * The face analysis of a cell is kept across calls in a vector indexed by the
+       * leaf index of the cell. It is only redone for the cells that did not exist in
+       * the last analysis, i.e. the cells created by refining or coarsening the marked
+       * cells, and for their neighbours: cells that have been removed by an adaptation
+       * are covered by new cells, so all cells whose neighbourhood changed are
+       * neighbours of new cells. The analyses of the remaining cells are moved to their
+       * new leaf index by looking up their local id in a sorted array of the ids of the
+       * last analysis. The per-vertex information is then assembled from the face
+       * analyses in one sweep over the cells, as the vertex indices change with every
+       * adaptation.
+       */
       void analyzeView()
       {
+        Dune::Timer timer;
         cell_mapper.update();
-        const typename GridView::IndexSet& indexSet = grid.leafGridView().indexSet();
-
-        node_info = std::vector<NodeInfo>(indexSet.size(dim));
-
         const GridView & gv = grid.leafGridView();
+        const typename GridView::IndexSet& indexSet = gv.indexSet();
+        const LocalIdSet & idSet = grid.localIdSet();
+
+        analysis_statistics = AnalysisStatistics();
 
         Iterator it = gv.template begin<0>();
         Iterator eit = gv.template end<0>();
 
-        // loop over all codim<0> leaf elements of the partially refined grid
+        // move the face analyses of all cells that still exist to their new index
+        // and analyze the new ones
+        const std::size_t cells = cell_mapper.size();
+        std::vector<CellAnalysis> previous_analysis(cells);
+        previous_analysis.swap(cell_analysis);
+        std::vector<CellIdIndex> previous_ids;
+        previous_ids.swap(cell_ids);
+        cell_ids.reserve(cells);
+        std::vector<char> is_new(cells,0);
+        std::vector<char> neighbours(cells,0);
         for(;it!=eit;++it){
+          const IndexType index = cell_mapper.map(*it);
+          const CellIdIndex key(idSet.id(*it),index);
+          cell_ids.push_back(key);
+          typename std::vector<CellIdIndex>::const_iterator previous =
+            std::lower_bound(previous_ids.begin(),previous_ids.end(),key,CellIdLess());
+          if(previous != previous_ids.end() && previous->first == key.first)
+            cell_analysis[index] = previous_analysis[previous->second];
+          else{
+            analyzeFaces(gv,*it,cell_analysis[index],neighbours);
+            is_new[index] = 1;
+            ++analysis_statistics.reanalyzed_cells;
+          }
+        }
+        std::vector<CellAnalysis>().swap(previous_analysis);
+        std::vector<CellIdIndex>().swap(previous_ids);
+        std::sort(cell_ids.begin(),cell_ids.end(),CellIdLess());
+
+        // reuse the storage of the previous analysis
+        node_info.assign(indexSet.size(dim),NodeInfo());
+
+        // loop over all codim<0> leaf elements of the partially refined grid
+        std::vector<char> unused(cells,0);
+        for(it = gv.template begin<0>();it!=eit;++it){
 
-          const Dune::ReferenceElement<double,dim> &
-            reference_element =
-            Dune::ReferenceElements<double,dim>::general(it->geometry().type());
+          const IndexType index = cell_mapper.map(*it);
+          CellAnalysis & analysis = cell_analysis[index];
 
+          // the neighbourhood of this cell has changed
+          if(neighbours[index] && !is_new[index]){
+            analyzeFaces(gv,*it,analysis,unused);
+            ++analysis_statistics.reanalyzed_cells;
+          }
 
           // level of this element
           const unsigned short level = it->level();
 
           // number of vertices in this element
-          const IndexType v_size = reference_element.size(dim);
+          const IndexType v_size =
+            Dune::ReferenceElements<double,dim>::general(it->type()).size(dim);
 
-          // update minimum_level and maximum_level for vertices in this
-          // cell
+          // update minimum_level, maximum_level and minimum_touching_level
+          // for vertices in this cell
           // loop over all vertices of the element
           for(IndexType i=0; i<v_size; ++i){
             const IndexType v_globalindex = indexSet.subIndex(*it,i,dim);
             NodeInfo& ni = node_info[v_globalindex];
             ni.addLevel(level);
+            ni.addTouchingLevel(analysis.touching_level[i]);
+            if(analysis.boundary[i] >= 0)
+              ni.is_boundary = analysis.boundary[i];
 
             if(verbosity>10){
               // This will produce a lot of output on the screen!
@@ -147,80 +341,58 @@ namespace Dune {
 
           }
 
-          // Now we still have to update minimum_touching_level for this
-          // cell
-
-          unsigned int intersection_index = 0;
-          IntersectionIterator fit = gv.ibegin(*it);
-          IntersectionIterator efit = gv.iend(*it);
-          typedef typename IntersectionIterator::Intersection Intersection;
-
-          // Loop over faces
-          for(;fit!=efit;++fit,++intersection_index){
-
-            const Dune::ReferenceElement<double,dim-1> &
-              reference_face_element =
-              Dune::ReferenceElements<double,dim-1>::general(fit->geometry().type());
-
-            const int eLocalIndex =  fit->indexInInside();
-            const int e_level = fit->inside()->level();
-
-            // number of vertices on the face
-            const int e_v_size = reference_element.size(eLocalIndex,1,dim);
-
-            if((*fit).boundary()) {
-
-              // loop over vertices on the face
-              for(int i=0; i<e_v_size;++i){
-                const int e_v_index = reference_element.subEntity(eLocalIndex,1,i,dim);
-                const IndexType v_globalindex = indexSet.subIndex(*it,e_v_index,dim);
-
-                const FacePoint facelocal_position = reference_face_element.position(i,dim-1);
-
-                /*
-                  typename BoundaryFunction::Traits::RangeType boundary_value;
-                  boundaryFunction.evaluate(IntersectionGeometry<Intersection>(*fit,intersection_index),
-                  facelocal_position,boundary_value);
-                  if(boundary_value)
-                  node_info[v_globalindex].is_boundary=true;
-                  else
-                  node_info[v_globalindex].is_boundary=false;
-                */
+        }
 
-                NodeInfo& ni = node_info[v_globalindex];
-                ni.is_boundary = boundaryFunction.isDirichlet(IntersectionGeometry<Intersection>(*fit,intersection_index),facelocal_position);
-                ni.addTouchingLevel(e_level);
+        // Find the cells containing hanging nodes, so that the
+        // constraints assembly can skip all other cells without
+        // querying their vertices.
+        analysis_statistics.cells = cell_mapper.size();
+        analysis_statistics.vertices = node_info.size();
+        for(std::size_t i=0; i<node_info.size(); ++i)
+          if(node_info[i].minimum_touching_level < node_info[i].minimum_level)
+            ++analysis_statistics.hanging_nodes;
+
+        cell_has_hanging_nodes.assign(cell_mapper.size(),false);
+        if(analysis_statistics.hanging_nodes > 0){
+          for(it = gv.template begin<0>(); it!=eit; ++it){
+            const IndexType v_size =
+              Dune::ReferenceElements<double,dim>::general(it->type()).size(dim);
+            for(IndexType i=0; i<v_size; ++i){
+              const NodeInfo & v_info = node_info[indexSet.subIndex(*it,i,dim)];
+              if(v_info.minimum_touching_level < v_info.minimum_level){
+                cell_has_hanging_nodes[cell_mapper.map(*it)] = true;
+                ++analysis_statistics.cells_with_hanging_nodes;
+                break;
               }
-
-              // We are done here - the remaining tests are only required for neighbor intersections
-              continue;
             }
+          }
+        }
 
-            const int f_level = fit->outside()->level();
-
-            // a conforming face has no hanging nodes
-            if(fit->conforming())
-              continue;
-
-            // so far no support for initially non conforming grids
-            assert(e_level != f_level);
-
-            // this check needs to be performed on the element containing
-            // the hanging node only
-            if(e_level < f_level)
-              continue;
-
-            // loop over vertices on the face
-            for(int i=0; i<e_v_size;++i){
-              const int e_v_index = reference_element.subEntity(eLocalIndex,1,i,dim);
-              const IndexType v_globalindex = indexSet.subIndex(*it,e_v_index,dim);
+        analysis_statistics.elapsed = timer.elapsed();
+        if(verbosity)
+          std::cout << "Hanging node analysis: " << analysis_statistics.hanging_nodes
+                    << " hanging nodes in " << analysis_statistics.cells_with_hanging_nodes
+                    << " of " << analysis_statistics.cells << " cells, "
+                    << analysis_statistics.reanalyzed_cells << " cells reanalyzed ("
+                    << analysis_statistics.elapsed << "s)" << std::endl;
+      }
 
-              node_info[v_globalindex].addTouchingLevel(f_level);
-            }
+      //! Returns the statistics of the last analysis of the leaf grid view
+      const AnalysisStatistics & statistics() const
+      {
+        return analysis_statistics;
+      }
 
-          } // end of loop over faces
+      //! Returns true if the leaf grid view contains any hanging nodes
+      bool hasHangingNodes() const
+      {
+        return analysis_statistics.hanging_nodes > 0;
+      }
 
-        }
+      //! Returns true if one of the vertices of e is a hanging node
+      bool hasHangingNodes(const Cell& e) const
+      {
+        return cell_has_hanging_nodes[cell_mapper.map(e)];
       }
 
       HangingNodeManager(Grid & _grid, const BoundaryFunction & _boundaryFunction)
@@ -4,6 +4,9 @@
 #ifndef DUNE_PDELAB_FINITELEMENTMAP_HH
 #define DUNE_PDELAB_FINITELEMENTMAP_HH
 
+#include <cstddef>
+#include <type_traits>
+
 #include <dune/common/deprecated.hh>
 #include <dune/pdelab/common/exceptions.hh>
 
@@ -102,6 +105,18 @@ namespace Dune {
       const Imp& asImp () const {return static_cast<const Imp &>(*this);}
     };
 
+    //! \brief compile time upper bound for the local number of DOFs of a FiniteElementMap.
+    /**
+     * The default value 0 means that the bound is only known at run time via
+     * maxLocalSize(). FiniteElementMaps whose local size is determined by their
+     * template parameters specialize this trait, which allows the assemblers to
+     * use local containers with a fixed capacity instead of heap allocated ones.
+     */
+    template<typename FEM>
+    struct FiniteElementMapStaticMaxLocalSize
+      : public std::integral_constant<std::size_t,0>
+    {};
+
     //! simple implementation where all entities have the same finite element
     template<class Imp>
     class SimpleLocalFiniteElementMap :
@@ -3,7 +3,9 @@
 
 #include<iostream>
 #include<algorithm>
+#include<cmath>
 #include<memory>
+#include<type_traits>
 
 #include<dune/common/fvector.hh>
 #include<dune/common/fmatrix.hh>
@@ -245,7 +247,7 @@ namespace Dune {
     // Traits classes to group Pk and Qk specifics
     //=====================================================
     enum BasisType {
-      Pk, Qk
+      Pk, Qk, PkDubiner
     };
 
     template <BasisType basisType>
@@ -282,6 +284,12 @@ namespace Dune {
       }
     };
 
+    //! The Dubiner basis spans P_k with the same numbering of the polynomials by their degree.
+    template <>
+    struct BasisTraits<BasisType::PkDubiner>
+      : public BasisTraits<BasisType::Pk>
+    {};
+
     template <>
     struct BasisTraits<BasisType::Qk>
     {
@@ -502,12 +510,39 @@ namespace Dune {
      * where
      *       beta_jr = alpha_jr-1 if r=s and alpha_jr else.
      *
+     * On the cube, the basis obtained this way is the tensor product of the
+     * L_2(0,1) orthonormal Legendre polynomials in every direction, as
+     * \f$ \prod_s L_{\alpha_s}(x_s) \f$ only contains monomials \f$ x^\beta \f$
+     * with \f$ \beta \leq \alpha \f$, which precede \f$ x^\alpha \f$ in both the
+     * Pk and the Qk ordering. In this case no coefficients are computed; the basis
+     * is evaluated from the three-term recurrence of the Legendre polynomials
+     * with O(d k) operations for the one-dimensional factors and O(d n) for the
+     * products. On the simplex, the coefficients are still computed by the
+     * Gram-Schmidt procedure and the basis is evaluated in monomial form with
+     * O(n^2) operations per point; only the monomials are evaluated from tables
+     * of the powers of the coordinates.
+     *
+     * With basisType = BasisType::PkDubiner, the simplex uses the Dubiner basis
+     * instead, which is L_2 orthonormal and spans P_l for every l <= k as well,
+     * but is a different basis than the one obtained by Gram-Schmidt, so
+     * coefficient vectors are not interchangeable. With the collapsed
+     * coordinates of the reference simplex it is a product of Jacobi polynomials,
+     * \f[
+     *     \phi_\alpha(x) = c_\alpha \prod_{s=0}^{d-1} u_s^{\alpha_s}
+     *                      P_{\alpha_s}^{(2(\alpha_0+\dots+\alpha_{s-1})+s,0)}\left(\frac{2x_s-u_s}{u_s}\right),
+     *     \qquad u_s = 1 - x_{s+1} - \dots - x_{d-1},
+     * \f]
+     * whose factors are evaluated without division by their three-term
+     * recurrences with O(d k^2) operations, so no coefficients are computed at
+     * construction and evaluation costs O(d k^2 + d n) per point. On the cube,
+     * BasisType::PkDubiner is the same as BasisType::Pk.
+     *
      *  \tparam FieldType               Type to represent coefficients after computation.
      *  \tparam k                       The polynomial degreee.
      *  \tparam d                       The space dimension.
      *  \tparam GeometryType::BasicType The reference element
      *  \tparam ComputationFieldType    Type to do computations with. Might be high precission.
-     *  \tparam basisType               Type of the polynomial basis. eiter Pk or Qk
+     *  \tparam basisType               Type of the polynomial basis. either Pk, Qk or PkDubiner
      */
     template<typename FieldType, int k, int d, Dune::GeometryType::BasicType bt, typename ComputationFieldType=FieldType, BasisType basisType = BasisType::Pk>
     class OrthonormalPolynomialBasis
@@ -518,12 +553,24 @@ namespace Dune {
       typedef Dune::FieldMatrix<FieldType,n,n> LowprecMat;
       typedef Dune::FieldMatrix<ComputationFieldType,n,n> HighprecMat;
 
+      //! Whether the basis is evaluated as a tensor product of Legendre polynomials.
+      static const bool is_cube = (bt == Dune::GeometryType::cube);
+
+      //! Whether the basis is the Dubiner basis, evaluated by recurrences of Jacobi polynomials.
+      static const bool is_dubiner = (bt == Dune::GeometryType::simplex && basisType == BasisType::PkDubiner);
+
+    private:
+      enum { legendre_evaluation, monomial_evaluation, dubiner_evaluation };
+      typedef std::integral_constant<int,
+                                     is_cube ? legendre_evaluation
+                                     : is_dubiner ? dubiner_evaluation
+                                     : monomial_evaluation> Evaluation;
+
+    public:
+
       // construct orthonormal basis
       OrthonormalPolynomialBasis ()
-        : coeffs(new LowprecMat)
       {
-        for (int i=0; i<d; ++i)
-          gradcoeffs[i].reset(new LowprecMat());
         // compute index to multiindex map
         for (int i=0; i<n; i++)
           {
@@ -532,16 +579,22 @@ namespace Dune {
             //std::cout << "i=" << i << " alpha_i=" << alpha[i] << std::endl;
           }
 
-        orthonormalize();
+        // the tensor product basis on the cube and the Dubiner basis are known in closed form
+        if (is_dubiner)
+          dubiner_scaling();
+        else if (!is_cube)
+          {
+            coeffs.reset(new LowprecMat);
+            for (int i=0; i<d; ++i)
+              gradcoeffs[i].reset(new LowprecMat());
+            orthonormalize();
+          }
       }
 
       // construct orthonormal basis from an other basis
       template<class LFE>
       OrthonormalPolynomialBasis (const LFE & lfe)
-        : coeffs(new LowprecMat)
       {
-        for (int i=0; i<d; ++i)
-          gradcoeffs[i].reset(new LowprecMat());
         // compute index to multiindex map
         for (int i=0; i<n; i++)
           {
@@ -550,7 +603,16 @@ namespace Dune {
             //std::cout << "i=" << i << " alpha_i=" << alpha[i] << std::endl;
           }
 
-        orthonormalize();
+        // the tensor product basis on the cube and the Dubiner basis are known in closed form
+        if (is_dubiner)
+          dubiner_scaling();
+        else if (!is_cube)
+          {
+            coeffs.reset(new LowprecMat);
+            for (int i=0; i<d; ++i)
+              gradcoeffs[i].reset(new LowprecMat());
+            orthonormalize();
+          }
       }
 
       // return dimension of P_l
@@ -563,28 +625,14 @@ namespace Dune {
       template<typename Point, typename Result>
       void evaluateFunction (const Point& x, Result& r) const
       {
-        std::fill(r.begin(),r.end(),0.0);
-        for (int j=0; j<n; ++j)
-          {
-            const FieldType monomial_value = MonomialEvaluate<FieldType,d-1>::compute(x,*alpha[j]);
-            for (int i=j; i<n; ++i)
-              r[i] += (*coeffs)[i][j] * monomial_value;
-          }
+        evaluateFunction(Evaluation(),n,x,r);
       }
 
       // evaluate all basis polynomials at given point
       template<typename Point, typename Result>
       void evaluateJacobian (const Point& x, Result& r) const
       {
-        std::fill(r.begin(),r.end(),0.0);
-
-        for (int j=0; j<n; ++j)
-          {
-            const FieldType monomial_value = MonomialEvaluate<FieldType,d-1>::compute(x,*alpha[j]);
-            for (int i=j; i<n; ++i)
-              for (int s=0; s<d; ++s)
-                r[i][0][s] += (*gradcoeffs[s])[i][j]*monomial_value;
-          }
+        evaluateJacobian(Evaluation(),n,x,r);
       }
 
       // evaluate all basis polynomials at given point up to order l <= k
@@ -593,39 +641,276 @@ namespace Dune {
       {
         if (l>k)
           DUNE_THROW(Dune::RangeError,"l>k in OrthonormalPolynomialBasis::evaluateFunction");
+        evaluateFunction(Evaluation(),Traits::size(l,d),x,r);
+      }
+
+      // evaluate all basis polynomials at given point
+      template<typename Point, typename Result>
+      void evaluateJacobian (int l, const Point& x, Result& r) const
+      {
+        if (l>k)
+          DUNE_THROW(Dune::RangeError,"l>k in OrthonormalPolynomialBasis::evaluateFunction");
+        evaluateJacobian(Evaluation(),Traits::size(l,d),x,r);
+      }
+
+    private:
+
+      // values of the L_2(0,1) orthonormal Legendre polynomials of degree 0..k in every direction
+      template<typename Point>
+      static void legendre (const Point& x, FieldType (&p)[d][k+1])
+      {
+        for (int s=0; s<d; s++)
+          {
+            const FieldType t = 2.0*x[s]-1.0;
+            p[s][0] = 1.0;
+            for (int m=0; m<k; m++)
+              {
+                const FieldType previous = m>0 ? p[s][m-1] : FieldType(0.0);
+                p[s][m+1] = ((2*m+1)*t*p[s][m] - m*previous)/(m+1);
+              }
+            for (int m=1; m<=k; m++)
+              p[s][m] *= std::sqrt(FieldType(2*m+1));
+          }
+      }
+
+      // values and derivatives of the L_2(0,1) orthonormal Legendre polynomials
+      template<typename Point>
+      static void legendre (const Point& x, FieldType (&p)[d][k+1], FieldType (&dp)[d][k+1])
+      {
+        for (int s=0; s<d; s++)
+          {
+            const FieldType t = 2.0*x[s]-1.0;
+            p[s][0] = 1.0;
+            dp[s][0] = 0.0;
+            for (int m=0; m<k; m++)
+              {
+                const FieldType previous = m>0 ? p[s][m-1] : FieldType(0.0);
+                const FieldType dprevious = m>0 ? dp[s][m-1] : FieldType(0.0);
+                p[s][m+1] = ((2*m+1)*t*p[s][m] - m*previous)/(m+1);
+                dp[s][m+1] = dprevious + (2*m+1)*p[s][m];
+              }
+            // scale and transform the derivative from t = 2x-1 to x
+            for (int m=1; m<=k; m++)
+              {
+                const FieldType scale = std::sqrt(FieldType(2*m+1));
+                p[s][m] *= scale;
+                dp[s][m] *= 2.0*scale;
+              }
+          }
+      }
+
+      // values of the first size monomials
+      template<typename Point>
+      void monomials (int size, const Point& x, FieldType* m) const
+      {
+        FieldType powers[d][k+1];
+        for (int s=0; s<d; s++)
+          {
+            powers[s][0] = 1.0;
+            for (int e=1; e<=k; e++)
+              powers[s][e] = powers[s][e-1]*x[s];
+          }
+        for (int j=0; j<size; j++)
+          {
+            m[j] = powers[0][(*alpha[j])[0]];
+            for (int s=1; s<d; s++)
+              m[j] *= powers[s][(*alpha[j])[s]];
+          }
+      }
+
+      // tensor product of Legendre polynomials on the cube
+      template<typename Point, typename Result>
+      void evaluateFunction (std::integral_constant<int,legendre_evaluation>, int size, const Point& x, Result& r) const
+      {
+        FieldType p[d][k+1];
+        legendre(x,p);
+        for (int i=0; i<size; i++)
+          {
+            const MultiIndex<d>& a = *alpha[i];
+            FieldType value = p[0][a[0]];
+            for (int s=1; s<d; s++)
+              value *= p[s][a[s]];
+            r[i] = value;
+          }
+      }
 
-        for (int i=0; i<Traits::size(l,d); i++)
+      template<typename Point, typename Result>
+      void evaluateJacobian (std::integral_constant<int,legendre_evaluation>, int size, const Point& x, Result& r) const
+      {
+        FieldType p[d][k+1];
+        FieldType dp[d][k+1];
+        legendre(x,p,dp);
+        for (int i=0; i<size; i++)
+          {
+            const MultiIndex<d>& a = *alpha[i];
+            for (int s=0; s<d; s++)
+              {
+                FieldType value = dp[s][a[s]];
+                for (int t=0; t<d; t++)
+                  if (t!=s)
+                    value *= p[t][a[t]];
+                r[i][0][s] = value;
+              }
+          }
+      }
+
+      // monomial representation on the simplex
+      template<typename Point, typename Result>
+      void evaluateFunction (std::integral_constant<int,monomial_evaluation>, int size, const Point& x, Result& r) const
+      {
+        FieldType m[n];
+        monomials(size,x,m);
+        for (int i=0; i<size; i++)
           {
             FieldType sum(0.0);
             for (int j=0; j<=i; j++)
-              sum = sum + (*coeffs)[i][j]*MonomialEvaluate<FieldType,d-1>::compute(x,*alpha[j]);
+              sum += (*coeffs)[i][j]*m[j];
             r[i] = sum;
           }
       }
 
-      // evaluate all basis polynomials at given point
       template<typename Point, typename Result>
-      void evaluateJacobian (int l, const Point& x, Result& r) const
+      void evaluateJacobian (std::integral_constant<int,monomial_evaluation>, int size, const Point& x, Result& r) const
       {
-        if (l>k)
-          DUNE_THROW(Dune::RangeError,"l>k in OrthonormalPolynomialBasis::evaluateFunction");
+        FieldType m[n];
+        monomials(size,x,m);
+        for (int i=0; i<size; i++)
+          for (int s=0; s<d; s++)
+            {
+              FieldType sum(0.0);
+              for (int j=0; j<=i; j++)
+                sum += (*gradcoeffs[s])[i][j]*m[j];
+              r[i][0][s] = sum;
+            }
+      }
+
+      // u^m P_m^{(a,0)}((2x-u)/u) for m = 0..degree and, if px is not null, its
+      // derivatives with respect to x and u, by the three-term recurrence of the
+      // Jacobi polynomials multiplied by u^m
+      static void scaled_jacobi (FieldType x, FieldType u, int a, int degree,
+                                 FieldType* p, FieldType* px, FieldType* pu)
+      {
+        p[0] = 1.0;
+        if (px)
+          {
+            px[0] = 0.0;
+            pu[0] = 0.0;
+          }
+        if (degree==0)
+          return;
+        p[1] = FieldType(a+2)*x - u;
+        if (px)
+          {
+            px[1] = a+2;
+            pu[1] = -1.0;
+          }
+        for (int m=2; m<=degree; m++)
+          {
+            const FieldType c = FieldType(2*m*(m+a))*FieldType(2*m+a-2);
+            const FieldType A = FieldType((2*m+a-1)*(2*m+a))*FieldType(2*m+a-2);
+            const FieldType B = FieldType(2*m+a-1)*FieldType(a*a);
+            const FieldType C = FieldType(2*(m+a-1)*(m-1))*FieldType(2*m+a);
+            const FieldType t = A*(2.0*x-u) + B*u;
+            p[m] = (t*p[m-1] - C*u*u*p[m-2])/c;
+            if (px)
+              {
+                px[m] = (2.0*A*p[m-1] + t*px[m-1] - C*u*u*px[m-2])/c;
+                pu[m] = ((B-A)*p[m-1] + t*pu[m-1] - C*u*(2.0*p[m-2] + u*pu[m-2]))/c;
+              }
+          }
+      }
+
+      // factors of the Dubiner basis: p[s][S][m] = u_s^m P_m^{(2S+s,0)}((2x_s-u_s)/u_s)
+      // for all partial degree sums S of the previous directions
+      template<typename Point>
+      static void dubiner_factors (const Point& x, FieldType (&p)[d][k+1][k+1],
+                                   FieldType (*px)[k+1][k+1], FieldType (*pu)[k+1][k+1])
+      {
+        FieldType u(1.0);
+        for (int s=d-1; s>=0; s--)
+          {
+            for (int S=0; S<=(s>0 ? k : 0); S++)
+              scaled_jacobi(x[s],u,2*S+s,k-S,p[s][S],
+                            px ? px[s][S] : nullptr,pu ? pu[s][S] : nullptr);
+            u -= x[s];
+          }
+      }
 
-        for (int i=0; i<Traits::size(l,d); i++)
+      // normalization of the Dubiner basis, the squared L_2 norm of the product of
+      // the factors is 1/prod_s (2(alpha_0+...+alpha_s)+s+1)
+      void dubiner_scaling ()
+      {
+        for (int i=0; i<n; i++)
           {
-            FieldType sum[d];
+            int S = 0;
+            FieldType norm2(1.0);
             for (int s=0; s<d; s++)
               {
-                sum[s] = 0.0;
-                for (int j=0; j<=i; j++)
-                  sum[s] += (*gradcoeffs[s])[i][j]*MonomialEvaluate<FieldType,d-1>::compute(x,*alpha[j]);
+                S += (*alpha[i])[s];
+                norm2 *= FieldType(2*S+s+1);
+              }
+            scaling[i] = std::sqrt(norm2);
+          }
+      }
+
+      // Dubiner basis on the simplex
+      template<typename Point, typename Result>
+      void evaluateFunction (std::integral_constant<int,dubiner_evaluation>, int size, const Point& x, Result& r) const
+      {
+        FieldType p[d][k+1][k+1];
+        dubiner_factors(x,p,nullptr,nullptr);
+        for (int i=0; i<size; i++)
+          {
+            const MultiIndex<d>& a = *alpha[i];
+            FieldType value = scaling[i];
+            int S = 0;
+            for (int s=0; s<d; s++)
+              {
+                value *= p[s][S][a[s]];
+                S += a[s];
+              }
+            r[i] = value;
+          }
+      }
+
+      template<typename Point, typename Result>
+      void evaluateJacobian (std::integral_constant<int,dubiner_evaluation>, int size, const Point& x, Result& r) const
+      {
+        FieldType p[d][k+1][k+1];
+        FieldType px[d][k+1][k+1];
+        FieldType pu[d][k+1][k+1];
+        dubiner_factors(x,p,px,pu);
+        for (int i=0; i<size; i++)
+          {
+            const MultiIndex<d>& a = *alpha[i];
+            FieldType f[d], fx[d], fu[d];
+            int S = 0;
+            for (int s=0; s<d; s++)
+              {
+                f[s] = p[s][S][a[s]];
+                fx[s] = px[s][S][a[s]];
+                fu[s] = pu[s][S][a[s]];
+                S += a[s];
+              }
+            for (int t=0; t<d; t++)
+              r[i][0][t] = 0.0;
+            for (int s=0; s<d; s++)
+              {
+                FieldType others = scaling[i];
+                for (int q=0; q<d; q++)
+                  if (q!=s)
+                    others *= f[q];
+                // factor s depends on x_s directly and on x_t, t>s, through u_s
+                r[i][0][s] += others*fx[s];
+                for (int t=s+1; t<d; t++)
+                  r[i][0][t] -= others*fu[s];
               }
-            for (int s=0; s<d; s++) r[i][0][s] = sum[s];
           }
       }
 
-    private:
       // store multiindices and coefficients on heap
       Dune::array<std::shared_ptr<MultiIndex<d> >,n> alpha; // store index to multiindex map
+      Dune::array<FieldType,n> scaling; // normalization of the Dubiner basis
       std::shared_ptr<LowprecMat> coeffs; // coefficients with respect to monomials
       Dune::array<std::shared_ptr<LowprecMat>,d > gradcoeffs; // coefficients of gradient
 
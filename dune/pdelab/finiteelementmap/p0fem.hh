@@ -44,6 +44,15 @@ namespace Dune {
 
     };
 
+#ifndef DOXYGEN
+
+    template<class D, class R, int d>
+    struct FiniteElementMapStaticMaxLocalSize<P0LocalFiniteElementMap<D,R,d> >
+      : public std::integral_constant<std::size_t,1>
+    {};
+
+#endif // DOXYGEN
+
   }
 }
 
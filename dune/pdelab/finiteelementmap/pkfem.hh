@@ -3,6 +3,8 @@
 #define DUNE_PDELAB_FINITEELEMENTMAP_PKFEM_HH
 
 #include <algorithm>
+#include <cstddef>
+#include <type_traits>
 
 #include <dune/common/deprecated.hh>
 #include <dune/common/array.hh>
@@ -262,6 +264,17 @@ namespace Dune {
         {}
       };
 
+      //! The number of shape functions of a Pk element of order k in dimension d.
+      template<unsigned int k, unsigned int d>
+      struct PkSize
+        : public std::integral_constant<std::size_t,PkSize<k,d-1>::value * (k+d) / d>
+      {};
+
+      template<unsigned int k>
+      struct PkSize<k,0>
+        : public std::integral_constant<std::size_t,1>
+      {};
+
 #endif // DOXYGEN
 
 
@@ -287,6 +300,14 @@ namespace Dune {
 
     };
 
+#ifndef DOXYGEN
+
+    template<typename GV, typename D, typename R, unsigned int k, unsigned int d>
+    struct FiniteElementMapStaticMaxLocalSize<PkLocalFiniteElementMap<GV,D,R,k,d> >
+      : public std::integral_constant<std::size_t,fem::PkSize<k,GV::dimension>::value>
+    {};
+
+#endif // DOXYGEN
 
   }
 }
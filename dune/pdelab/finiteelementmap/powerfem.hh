@@ -78,6 +78,15 @@ namespace Dune {
     const typename PowerFiniteElementMap<BackendFEM, dimR>::Factory
     PowerFiniteElementMap<BackendFEM, dimR>::factory = Factory();
 
+#ifndef DOXYGEN
+
+    template<class BackendFEM, std::size_t dimR>
+    struct FiniteElementMapStaticMaxLocalSize<PowerFiniteElementMap<BackendFEM, dimR> >
+      : public std::integral_constant<std::size_t,dimR * FiniteElementMapStaticMaxLocalSize<BackendFEM>::value>
+    {};
+
+#endif // DOXYGEN
+
   } // namespace PDELab
 } // namespace Dune
 
@@ -730,6 +730,15 @@ namespace Dune {
 
     };
 
+#ifndef DOXYGEN
+
+    template<class D, class R, int k, int d>
+    struct FiniteElementMapStaticMaxLocalSize<QkDGLocalFiniteElementMap<D,R,k,d> >
+      : public std::integral_constant<std::size_t,Dune::QkStuff::QkSize<k,d>::value>
+    {};
+
+#endif // DOXYGEN
+
     //! wrap up element from local functions
     //! \ingroup FiniteElementMap
     template<class D, class R, int k, int d>
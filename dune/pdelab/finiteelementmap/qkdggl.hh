@@ -245,6 +245,51 @@ namespace Dune
       }
     };
 
+    /** \brief Tensor product data for collocated Gauss-Lobatto (spectral element) schemes.
+
+        value is true if LB is a nodal basis at the tensor product Gauss-Lobatto
+        points, i.e. if a Gauss-Lobatto rule with one point per node integrates
+        with a diagonal mass matrix and the basis functions need not be evaluated
+        at the quadrature points. data() returns the 1D nodes and weights on
+        [0,1] and the 1D differentiation matrix D[a*(k+1)+b] = l_b'(x_a). The
+        nodes are numbered like the basis, direction 0 running fastest.
+     */
+    template<class LB>
+    struct GaussLobattoCollocation
+    {
+      enum { value = false };
+
+      template<class R>
+      static void data (std::vector<R>& nodes, std::vector<R>& weights, std::vector<R>& derivatives)
+      {
+        DUNE_THROW(Dune::NotImplemented,"local basis is not a Gauss-Lobatto Lagrange basis");
+      }
+    };
+
+    template<class D, class R, int k, int d>
+    struct GaussLobattoCollocation<QkGLLocalBasis<D,R,k,d> >
+    {
+      enum { value = (k > 0) };
+
+      template<class RF>
+      static void data (std::vector<RF>& nodes, std::vector<RF>& weights, std::vector<RF>& derivatives)
+      {
+        if (k < 1)
+          DUNE_THROW(Dune::NotImplemented,"Gauss-Lobatto collocation needs polynomial degree k >= 1");
+        GaussLobattoLagrangePolynomials<D,R,k> poly;
+        nodes.resize(k+1);
+        weights.resize(k+1);
+        derivatives.resize((k+1)*(k+1));
+        for (int a=0; a<=k; a++)
+          {
+            nodes[a] = poly.x(a);
+            weights[a] = poly.w(a);
+            for (int b=0; b<=k; b++)
+              derivatives[a*(k+1)+b] = poly.dp(b,poly.x(a));
+          }
+      }
+    };
+
   }
 
   /** \todo Please doc me !
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 
+#include <dune/common/power.hh>
 #include <dune/localfunctions/lagrange/qk.hh>
 #include <dune/pdelab/finiteelementmap/finiteelementmap.hh>
 
@@ -57,6 +58,15 @@ namespace Dune {
 
     };
 
+#ifndef DOXYGEN
+
+    template<typename GV, typename D, typename R, std::size_t k>
+    struct FiniteElementMapStaticMaxLocalSize<QkLocalFiniteElementMap<GV,D,R,k> >
+      : public std::integral_constant<std::size_t,StaticPower<k+1,GV::dimension>::power>
+    {};
+
+#endif // DOXYGEN
+
   }
 }
 
@@ -3,6 +3,7 @@
 #define DUNE_PDELAB_VARIABLEMONOMFEM_HH
 
 #include <memory>
+#include <utility>
 
 #include <dune/geometry/type.hh>
 
@@ -10,29 +11,20 @@
 #include <dune/localfunctions/monomial.hh>
 #include <dune/common/array.hh>
 #include "finiteelementmap.hh"
+#include "variableorderdispatch.hh"
 
 namespace Dune {
   namespace PDELab {
 
     namespace {
-      template<class D, class R, int d, int p>
-      struct InitVariableMonomLocalFiniteElementMap
-      {
-        template<typename C>
-        static void init(C & c, GeometryType gt)
-        {
-          typedef Dune::MonomialLocalFiniteElement<D,R,d,p> LFE;
-          typedef typename C::value_type ptr;
-          c[p] = ptr(new LocalFiniteElementVirtualImp<LFE>(LFE(gt)));
-
-          InitVariableMonomLocalFiniteElementMap<D,R,d,p-1>::init(c,gt);
-        }
-      };
       template<class D, class R, int d>
-      struct InitVariableMonomLocalFiniteElementMap<D,R,d,-1>
+      struct VariableMonomFamily
       {
-        template<typename C>
-          static void init(C &, GeometryType) {}
+        template<int p>
+        struct Order
+        {
+          typedef Dune::MonomialLocalFiniteElement<D,R,d,p> type;
+        };
       };
     }
 
@@ -45,21 +37,23 @@ namespace Dune {
         typename MonomialLocalFiniteElement<D,R,d,0>::Traits::LocalBasisType::Traits,0>::Traits T;
       //! Type of finite element from local functions
       typedef LocalFiniteElementVirtualInterface<T> FiniteElementType;
+      //! Finite elements of all orders as their concrete types
+      typedef impl::FixedOrderFiniteElements<VariableMonomFamily<D,R,d>,maxP> FixedOrderFiniteElements;
     public:
       typedef FiniteElementMapTraits<FiniteElementType> Traits;
 
       /** Construct a VariableMonomLocalFiniteElementMap for GeometryType Dune::cube */
       VariableMonomLocalFiniteElementMap (const M & m, unsigned int defaultP) :
-        gt_(Dune::GeometryType::cube,d), mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP)
+        gt_(Dune::GeometryType::cube,d), mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP), fixedOrderFiniteElements_(gt_)
       {
-        InitVariableMonomLocalFiniteElementMap<D,R,d,maxP>::init(finiteElements_, gt_);
+        impl::make_virtual_finite_elements(finiteElements_,fixedOrderFiniteElements_,maxP);
       }
 
       /** Construct a VariableMonomLocalFiniteElementMap for a given GeometryType gt */
       VariableMonomLocalFiniteElementMap (const M & m, Dune::GeometryType gt, unsigned int defaultP) :
-        gt_(gt), mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP)
+        gt_(gt), mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP), fixedOrderFiniteElements_(gt_)
       {
-        InitVariableMonomLocalFiniteElementMap<D,R,d,maxP>::init(finiteElements_, gt_);
+        impl::make_virtual_finite_elements(finiteElements_,fixedOrderFiniteElements_,maxP);
       }
 
       //! \brief get local basis functions for entity
@@ -83,6 +77,25 @@ namespace Dune {
         return *(finiteElements_[defaultP_]);
       }
 
+      //! \brief call f with the finite element of the given polynomial order as its concrete type
+      /**
+       * f is called with a const reference to the MonomialLocalFiniteElement of order p.
+       * Kernels that are templated on the finite element type are thus instantiated
+       * once per order and evaluate the basis without virtual function calls.
+       */
+      template<typename F>
+      void dispatchOrder (unsigned int p, F&& f) const
+      {
+        fixedOrderFiniteElements_.dispatch(p,std::forward<F>(f));
+      }
+
+      //! \brief call f with the finite element of the entity as its concrete type
+      template<class EntityType, typename F>
+      void dispatch (const EntityType& e, F&& f) const
+      {
+        dispatchOrder(getOrder(e),std::forward<F>(f));
+      }
+
       template<class EntityType>
       void setOrder (const EntityType& e, unsigned int p)
       {
@@ -120,6 +133,7 @@ namespace Dune {
       const M & mapper_;
       std::vector<unsigned char> polOrder_;
       unsigned int defaultP_;
+      FixedOrderFiniteElements fixedOrderFiniteElements_;
       Dune::array< std::shared_ptr<FiniteElementType>, maxP+1 > finiteElements_;
     };
 
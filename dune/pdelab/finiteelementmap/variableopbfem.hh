@@ -3,12 +3,14 @@
 #define DUNE_PDELAB_VARIABLEOPBFEM_HH
 
 #include <memory>
+#include <utility>
 
 #include <dune/geometry/type.hh>
 
 #include <dune/localfunctions/common/virtualwrappers.hh>
 #include <dune/common/array.hh>
 #include <dune/pdelab/finiteelementmap/finiteelementmap.hh>
+#include <dune/pdelab/finiteelementmap/variableorderdispatch.hh>
 #include <dune/pdelab/finiteelementmap/l2orthonormal.hh>
 #include <dune/pdelab/finiteelementmap/monomfem.hh>
 
@@ -16,24 +18,14 @@ namespace Dune {
   namespace PDELab {
 
     namespace {
-      template<class D, class R, int d, int p, Dune::GeometryType::BasicType bt, typename ComputationFieldType>
-      struct InitVariableOPBLocalFiniteElementMap
-      {
-        template<typename C>
-        static void init(C & c)
-        {
-          typedef Dune::OPBLocalFiniteElement<D,R,p,d,bt,ComputationFieldType> LFE;
-          typedef typename C::value_type ptr;
-          c[p] = ptr(new LocalFiniteElementVirtualImp<LFE>);
-
-          InitVariableOPBLocalFiniteElementMap<D,R,d,p-1,bt,ComputationFieldType>::init(c);
-        }
-      };
       template<class D, class R, int d, Dune::GeometryType::BasicType bt, typename ComputationFieldType>
-      struct InitVariableOPBLocalFiniteElementMap<D,R,d,-1,bt,ComputationFieldType>
+      struct VariableOPBFamily
       {
-        template<typename C>
-        static void init(C & c) {}
+        template<int p>
+        struct Order
+        {
+          typedef Dune::OPBLocalFiniteElement<D,R,p,d,bt,ComputationFieldType> type;
+        };
       };
     }
 
@@ -46,13 +38,15 @@ namespace Dune {
         typename MonomLocalFiniteElement<D,R,d,0>::Traits::LocalBasisType::Traits,0>::Traits T;
       //! Type of finite element from local functions
       typedef LocalFiniteElementVirtualInterface<T> FiniteElementType;
+      //! Finite elements of all orders as their concrete types
+      typedef impl::FixedOrderFiniteElements<VariableOPBFamily<D,R,d,bt,ComputationFieldType>,maxP> FixedOrderFiniteElements;
     public:
       typedef FiniteElementMapTraits<FiniteElementType> Traits;
 
       VariableOPBLocalFiniteElementMap (const M & m, unsigned int defaultP) :
         mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP)
       {
-        InitVariableOPBLocalFiniteElementMap<D,R,d,maxP,bt,ComputationFieldType>::init(finiteElements_);
+        impl::make_virtual_finite_elements(finiteElements_,fixedOrderFiniteElements_,maxP);
       }
 
       //! \brief get local basis functions for entity
@@ -74,6 +68,25 @@ namespace Dune {
         return *(finiteElements_[defaultP_]);
       }
 
+      //! \brief call f with the finite element of the given polynomial order as its concrete type
+      /**
+       * f is called with a const reference to the OPBLocalFiniteElement of order p.
+       * Kernels that are templated on the finite element type are thus instantiated
+       * once per order and evaluate the basis without virtual function calls.
+       */
+      template<typename F>
+      void dispatchOrder (unsigned int p, F&& f) const
+      {
+        fixedOrderFiniteElements_.dispatch(p,std::forward<F>(f));
+      }
+
+      //! \brief call f with the finite element of the entity as its concrete type
+      template<class EntityType, typename F>
+      void dispatch (const EntityType& e, F&& f) const
+      {
+        dispatchOrder(getOrder(e),std::forward<F>(f));
+      }
+
       template<class EntityType>
       void setOrder (const EntityType& e, unsigned int p)
       {
@@ -110,6 +123,7 @@ namespace Dune {
       const M & mapper_;
       std::vector<unsigned char> polOrder_;
       unsigned int defaultP_;
+      FixedOrderFiniteElements fixedOrderFiniteElements_;
       Dune::array< std::shared_ptr<FiniteElementType>, maxP+1 > finiteElements_;
     };
 
@@ -0,0 +1,166 @@
+// -*- tab-width: 4; indent-tabs-mode: nil -*-
+#ifndef DUNE_PDELAB_FINITEELEMENTMAP_VARIABLEORDERDISPATCH_HH
+#define DUNE_PDELAB_FINITEELEMENTMAP_VARIABLEORDERDISPATCH_HH
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <dune/common/exceptions.hh>
+#include <dune/localfunctions/common/virtualwrappers.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      template<typename Family, int p>
+      class FixedOrderFiniteElements;
+
+      // Whether the arguments of a constructor call are a single FixedOrderFiniteElements
+      // of Family, i.e. the call is a copy, which must not be handled by the variadic
+      // constructor that passes its arguments on to the finite elements.
+      template<typename Family, typename... Args>
+      struct is_fixed_order_finite_elements
+        : public std::false_type
+      {};
+
+      template<typename Family, typename Arg>
+      struct is_fixed_order_finite_elements<Family,Arg>
+        : public std::is_base_of<FixedOrderFiniteElements<Family,-1>,typename std::decay<Arg>::type>
+      {};
+
+      // Stores the finite elements of the orders 0,...,p of a family as their
+      // concrete types. Family::Order<q>::type is the finite element of order q;
+      // the constructor arguments are passed on to the elements of all orders.
+      template<typename Family, int p>
+      class FixedOrderFiniteElements
+        : public FixedOrderFiniteElements<Family,p-1>
+      {
+        typedef FixedOrderFiniteElements<Family,p-1> Base;
+
+      public:
+
+        typedef typename Family::template Order<p>::type FiniteElement;
+
+        template<typename... Args,
+                 typename = typename std::enable_if<!is_fixed_order_finite_elements<Family,Args...>::value>::type>
+        explicit FixedOrderFiniteElements(const Args&... args)
+          : Base(args...)
+          , _fe(args...)
+        {}
+
+        // calls f with the finite element of order q
+        template<typename F>
+        void dispatch(unsigned int q, F&& f) const
+        {
+          if (q == p)
+            f(_fe);
+          else
+            Base::dispatch(q,std::forward<F>(f));
+        }
+
+      private:
+
+        FiniteElement _fe;
+
+      };
+
+      template<typename Family>
+      class FixedOrderFiniteElements<Family,-1>
+      {
+
+      public:
+
+        template<typename... Args,
+                 typename = typename std::enable_if<!is_fixed_order_finite_elements<Family,Args...>::value>::type>
+        explicit FixedOrderFiniteElements(const Args&... args)
+        {}
+
+        template<typename F>
+        void dispatch(unsigned int q, F&& f) const
+        {
+          DUNE_THROW(Exception,"polynomial order " << q << " exceeds the maximum order of the finite element map");
+        }
+
+      };
+
+      // Wraps a finite element into the virtual interface and stores it in c[p].
+      template<typename C>
+      struct MakeVirtualFiniteElement
+      {
+        MakeVirtualFiniteElement(C& c_, unsigned int p_)
+          : c(c_), p(p_)
+        {}
+
+        template<typename FE>
+        void operator()(const FE& fe) const
+        {
+          typedef typename C::value_type ptr;
+          c[p] = ptr(new LocalFiniteElementVirtualImp<FE>(fe));
+        }
+
+        C& c;
+        unsigned int p;
+      };
+
+      // Fills c[0],...,c[maxP] with the virtual wrappers of the elements in fes.
+      template<typename C, typename FEs>
+      void make_virtual_finite_elements(C& c, const FEs& fes, unsigned int maxP)
+      {
+        for (unsigned int p = 0; p <= maxP; ++p)
+          fes.dispatch(p,MakeVirtualFiniteElement<C>(c,p));
+      }
+
+      // Accepts any finite element, used to detect a dispatch() method.
+      struct AnyFiniteElementFunctor
+      {
+        template<typename FE>
+        void operator()(const FE& fe) const
+        {}
+      };
+
+      // Whether the finite element map FEM provides dispatch(e,f) for entities of type Entity.
+      template<typename FEM, typename Entity>
+      struct has_finite_element_dispatch
+      {
+        template<typename T>
+        static std::true_type test(decltype(std::declval<const T&>().dispatch(std::declval<const Entity&>(),AnyFiniteElementFunctor()))*);
+
+        template<typename T>
+        static std::false_type test(...);
+
+        static const bool value = decltype(test<FEM>(0))::value;
+      };
+
+      template<typename FEM, typename Entity, typename FE, typename F>
+      void dispatch_finite_element(const FEM& fem, const Entity& e, const FE& fe, F&& f, std::true_type)
+      {
+        fem.dispatch(e,std::forward<F>(f));
+      }
+
+      template<typename FEM, typename Entity, typename FE, typename F>
+      void dispatch_finite_element(const FEM& fem, const Entity& e, const FE& fe, F&& f, std::false_type)
+      {
+        f(fe);
+      }
+
+      // Calls f with the finite element of e as its concrete type if fem provides
+      // dispatch(), and with fe, the finite element returned by fem.find(e), otherwise.
+      template<typename FEM, typename Entity, typename FE, typename F>
+      void dispatch_finite_element(const FEM& fem, const Entity& e, const FE& fe, F&& f)
+      {
+        dispatch_finite_element(fem,e,fe,std::forward<F>(f),
+                                std::integral_constant<bool,has_finite_element_dispatch<FEM,Entity>::value>());
+      }
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_FINITEELEMENTMAP_VARIABLEORDERDISPATCH_HH
@@ -3,36 +3,28 @@
 #define DUNE_PDELAB_VARIABLEQKDGFEM_HH
 
 #include <memory>
+#include <utility>
 
 #include <dune/geometry/type.hh>
 
 #include <dune/localfunctions/common/virtualwrappers.hh>
 #include <dune/common/array.hh>
 #include "finiteelementmap.hh"
+#include "variableorderdispatch.hh"
 #include "qkdg.hh"
 
 namespace Dune {
   namespace PDELab {
 
     namespace {
-      template<class D, class R, int d, int p>
-      struct InitVariableQkDGLocalFiniteElementMap
-      {
-        template<typename C>
-        static void init(C & c)
-        {
-          typedef Dune::QkDGLocalFiniteElement<D,R,p,d> LFE;
-          typedef typename C::value_type ptr;
-          c[p] = ptr(new LocalFiniteElementVirtualImp<LFE>(LFE()));
-
-          InitVariableQkDGLocalFiniteElementMap<D,R,d,p-1>::init(c);
-        }
-      };
       template<class D, class R, int d>
-      struct InitVariableQkDGLocalFiniteElementMap<D,R,d,-1>
+      struct VariableQkDGFamily
       {
-        template<typename C>
-        static void init(C & c) {}
+        template<int p>
+        struct Order
+        {
+          typedef Dune::QkDGLocalFiniteElement<D,R,p,d> type;
+        };
       };
     }
 
@@ -45,13 +37,15 @@ namespace Dune {
       typename QkDGLocalFiniteElement<D,R,0,d>::Traits::LocalBasisType::Traits,0>::Traits T;
       //! Type of finite element from local functions
       typedef LocalFiniteElementVirtualInterface<T> FiniteElementType;
+      //! Finite elements of all orders as their concrete types
+      typedef impl::FixedOrderFiniteElements<VariableQkDGFamily<D,R,d>,maxP> FixedOrderFiniteElements;
     public:
       typedef FiniteElementMapTraits<FiniteElementType> Traits;
 
       VariableQkDGLocalFiniteElementMap (const M & m, unsigned int defaultP) :
         mapper_(m), polOrder_(mapper_.size(), defaultP), defaultP_(defaultP)
       {
-        InitVariableQkDGLocalFiniteElementMap<D,R,d,maxP>::init(finiteElements_);
+        impl::make_virtual_finite_elements(finiteElements_,fixedOrderFiniteElements_,maxP);
       }
 
       //! \brief get local basis functions for entity
@@ -73,6 +67,25 @@ namespace Dune {
         return *(finiteElements_[defaultP_]);
       }
 
+      //! \brief call f with the finite element of the given polynomial order as its concrete type
+      /**
+       * f is called with a const reference to the QkDGLocalFiniteElement of order p.
+       * Kernels that are templated on the finite element type are thus instantiated
+       * once per order and evaluate the basis without virtual function calls.
+       */
+      template<typename F>
+      void dispatchOrder (unsigned int p, F&& f) const
+      {
+        fixedOrderFiniteElements_.dispatch(p,std::forward<F>(f));
+      }
+
+      //! \brief call f with the finite element of the entity as its concrete type
+      template<class EntityType, typename F>
+      void dispatch (const EntityType& e, F&& f) const
+      {
+        dispatchOrder(getOrder(e),std::forward<F>(f));
+      }
+
       template<class EntityType>
       void setOrder (const EntityType& e, unsigned int p)
       {
@@ -109,6 +122,7 @@ namespace Dune {
       const M & mapper_;
       std::vector<unsigned char> polOrder_;
       unsigned int defaultP_;
+      FixedOrderFiniteElements fixedOrderFiniteElements_;
       Dune::array< std::shared_ptr<FiniteElementType>, maxP+1 > finiteElements_;
     };
 
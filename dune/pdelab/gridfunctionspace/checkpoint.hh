@@ -0,0 +1,346 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_GRIDFUNCTIONSPACE_CHECKPOINT_HH
+#define DUNE_PDELAB_GRIDFUNCTIONSPACE_CHECKPOINT_HH
+
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <dune/pdelab/backend/istl/tags.hh>
+#include <dune/pdelab/backend/istl/utility.hh>
+#include <dune/pdelab/common/exceptions.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! \addtogroup GridFunctionSpace
+    //! \ingroup PDELab
+    //! \{
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // The fixed size header at the start of every checkpoint file.
+      struct CheckpointHeader
+      {
+        char magic[8];
+        unsigned int version;
+        unsigned int value_size;
+        unsigned long long ordering_size;
+        unsigned long long block_count;
+        unsigned long long entries;
+        unsigned long long layout_hash;
+        int rank;
+        int ranks;
+      };
+
+      // 64 bit FNV-1a hash
+      class CheckpointHash
+      {
+
+      public:
+
+        CheckpointHash()
+          : _hash(14695981039346656037ull)
+        {}
+
+        void add(unsigned long long v)
+        {
+          for (int i = 0; i < 8; ++i, v >>= 8)
+            {
+              _hash ^= (v & 0xff);
+              _hash *= 1099511628211ull;
+            }
+        }
+
+        unsigned long long value() const
+        {
+          return _hash;
+        }
+
+      private:
+
+        unsigned long long _hash;
+
+      };
+
+      // Functors that transfer a contiguous range of vector entries.
+      class CheckpointWriter
+      {
+
+      public:
+
+        CheckpointWriter(std::ostream& stream)
+          : _stream(stream)
+        {}
+
+        template<typename E>
+        void operator()(const E* data, std::size_t n)
+        {
+          _stream.write(reinterpret_cast<const char*>(data),n * sizeof(E));
+        }
+
+      private:
+
+        std::ostream& _stream;
+
+      };
+
+      class CheckpointReader
+      {
+
+      public:
+
+        CheckpointReader(std::istream& stream)
+          : _stream(stream)
+        {}
+
+        template<typename E>
+        void operator()(E* data, std::size_t n)
+        {
+          _stream.read(reinterpret_cast<char*>(data),n * sizeof(E));
+        }
+
+      private:
+
+        std::istream& _stream;
+
+      };
+
+      class CheckpointCounter
+      {
+
+      public:
+
+        CheckpointCounter()
+          : _entries(0)
+        {}
+
+        template<typename E>
+        void operator()(const E* data, std::size_t n)
+        {
+          _entries += n;
+        }
+
+        std::size_t entries() const
+        {
+          return _entries;
+        }
+
+      private:
+
+        std::size_t _entries;
+
+      };
+
+      // A BlockVector of FieldVectors stores its entries contiguously, so it
+      // is transferred in a single chunk.
+      template<typename V, typename IO>
+      void checkpoint_transfer(istl::tags::field_vector, V& v, IO& io)
+      {
+        typedef typename V::block_type Block;
+        static_assert(sizeof(Block) == Block::dimension * sizeof(typename Block::field_type),
+                      "FieldVector blocks are not stored contiguously");
+        if (v.N() > 0)
+          io(&v[0][0],v.N() * Block::dimension);
+      }
+
+      // Nested BlockVectors are transferred block by block.
+      template<typename V, typename IO>
+      void checkpoint_transfer(istl::tags::block_vector, V& v, IO& io)
+      {
+        typedef typename V::block_type Block;
+        typedef typename istl::tags::container<typename Block::block_type>::type BlockTag;
+        for (std::size_t i = 0; i < v.N(); ++i)
+          checkpoint_transfer(BlockTag(),v[i],io);
+      }
+
+      template<typename V, typename IO>
+      void checkpoint_transfer(V& v, IO& io)
+      {
+        typedef typename istl::tags::container<typename V::block_type>::type Tag;
+        checkpoint_transfer(Tag(),v,io);
+      }
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    //! Binary checkpoints of DOF vectors of a GridFunctionSpace.
+    /**
+     * DOFVectorCheckpoint writes the raw entries of ISTL backend vectors to one
+     * file per MPI rank, preceded by a small header that records the size and
+     * block count of the ordering, the number of ranks and a hash of the DOF
+     * layout. The hash is computed from the container indices of all local
+     * function spaces in grid traversal order, so it changes whenever the grid,
+     * the partitioning or the ordering changes. Restoring a vector therefore
+     * does not require any interpolation: the entries are read directly into
+     * the vector storage (in a single read for vectors with one level of
+     * blocking), after the header has been checked against the current space.
+     *
+     * Computing the layout hash requires a grid traversal, so the object should
+     * be kept around between checkpoints; call update() after the grid or the
+     * function space has changed.
+     *
+     * \note The files store the entries in the native binary representation and
+     *       can only be read on machines with the same byte order.
+     *
+     * \tparam GFS The GridFunctionSpace.
+     */
+    template<typename GFS>
+    class DOFVectorCheckpoint
+    {
+
+      typedef typename GFS::Traits::GridViewType GV;
+
+    public:
+
+      //! Creates a checkpoint helper for gfs and computes its layout hash.
+      explicit DOFVectorCheckpoint(const GFS& gfs)
+        : _gfs(gfs)
+        , _layout_hash(0)
+      {
+        update();
+      }
+
+      //! Recomputes the layout hash after a change of the grid or the function space.
+      void update()
+      {
+        typedef LocalFunctionSpace<GFS> LFS;
+        typedef LFSIndexCache<LFS> LFSCache;
+        typedef typename GV::Traits::template Codim<0>::Iterator ElementIterator;
+
+        LFS lfs(_gfs);
+        LFSCache lfs_cache(lfs);
+
+        const GV& gv = _gfs.gridView();
+        impl::CheckpointHash hash;
+        hash.add(_gfs.ordering().size());
+        hash.add(_gfs.ordering().blockCount());
+        hash.add(gv.size(0));
+
+        for (ElementIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+          {
+            lfs.bind(*it);
+            lfs_cache.update();
+            hash.add(gv.indexSet().index(*it));
+            hash.add(lfs_cache.size());
+            for (std::size_t i = 0; i < lfs_cache.size(); ++i)
+              {
+                const typename LFSCache::CI& ci = lfs_cache.containerIndex(i);
+                for (std::size_t k = 0; k < ci.size(); ++k)
+                  hash.add(ci[k]);
+              }
+          }
+
+        _layout_hash = hash.value();
+      }
+
+      //! Returns the hash of the DOF layout stored in the checkpoint headers.
+      unsigned long long layoutHash() const
+      {
+        return _layout_hash;
+      }
+
+      //! Returns the name of the file of the calling rank for the given base name.
+      std::string fileName(const std::string& basename) const
+      {
+        std::ostringstream s;
+        s << basename << ".p" << _gfs.gridView().comm().rank() << ".ckpt";
+        return s.str();
+      }
+
+      //! Writes v to the checkpoint file of the calling rank.
+      template<typename V>
+      void write(const std::string& basename, const V& v) const
+      {
+        const std::string name = fileName(basename);
+        std::ofstream stream(name.c_str(),std::ios::binary | std::ios::trunc);
+        if (!stream)
+          DUNE_THROW(CheckpointError,"could not open checkpoint file " << name << " for writing");
+
+        impl::CheckpointHeader header = makeHeader(v);
+        stream.write(reinterpret_cast<const char*>(&header),sizeof(header));
+        impl::CheckpointWriter writer(stream);
+        impl::checkpoint_transfer(istl::raw(v),writer);
+
+        stream.flush();
+        if (!stream)
+          DUNE_THROW(CheckpointError,"error while writing checkpoint file " << name);
+      }
+
+      //! Restores v from the checkpoint file of the calling rank.
+      /**
+       * \throws CheckpointError if the file does not exist or was written for a
+       *         different function space, partitioning or vector type.
+       */
+      template<typename V>
+      void read(const std::string& basename, V& v) const
+      {
+        const std::string name = fileName(basename);
+        std::ifstream stream(name.c_str(),std::ios::binary);
+        if (!stream)
+          DUNE_THROW(CheckpointError,"could not open checkpoint file " << name << " for reading");
+
+        impl::CheckpointHeader header;
+        stream.read(reinterpret_cast<char*>(&header),sizeof(header));
+        if (!stream)
+          DUNE_THROW(CheckpointError,"could not read header of checkpoint file " << name);
+
+        const impl::CheckpointHeader expected = makeHeader(v);
+        if (std::memcmp(header.magic,expected.magic,sizeof(header.magic)) != 0 ||
+            header.version != expected.version)
+          DUNE_THROW(CheckpointError,name << " is not a checkpoint file of a supported version");
+        if (header.value_size != expected.value_size || header.entries != expected.entries)
+          DUNE_THROW(CheckpointError,"checkpoint file " << name << " was written for a different vector type");
+        if (header.rank != expected.rank || header.ranks != expected.ranks)
+          DUNE_THROW(CheckpointError,"checkpoint file " << name << " was written for a different partitioning");
+        if (header.ordering_size != expected.ordering_size ||
+            header.block_count != expected.block_count ||
+            header.layout_hash != expected.layout_hash)
+          DUNE_THROW(CheckpointError,"checkpoint file " << name << " does not match the DOF layout of the function space");
+
+        impl::CheckpointReader reader(stream);
+        impl::checkpoint_transfer(istl::raw(v),reader);
+        if (!stream)
+          DUNE_THROW(CheckpointError,"checkpoint file " << name << " is truncated");
+      }
+
+    private:
+
+      template<typename V>
+      impl::CheckpointHeader makeHeader(const V& v) const
+      {
+        impl::CheckpointHeader header;
+        std::memset(&header,0,sizeof(header));
+        std::memcpy(header.magic,"PDLBCKPT",sizeof(header.magic));
+        header.version = 1;
+        header.value_size = sizeof(typename V::ElementType);
+        header.ordering_size = _gfs.ordering().size();
+        header.block_count = _gfs.ordering().blockCount();
+        impl::CheckpointCounter counter;
+        impl::checkpoint_transfer(istl::raw(v),counter);
+        header.entries = counter.entries();
+        header.layout_hash = _layout_hash;
+        header.rank = _gfs.gridView().comm().rank();
+        header.ranks = _gfs.gridView().comm().size();
+        return header;
+      }
+
+      const GFS& _gfs;
+      unsigned long long _layout_hash;
+
+    };
+
+    //! \} group GridFunctionSpace
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_GRIDFUNCTIONSPACE_CHECKPOINT_HH
@@ -3,6 +3,8 @@
 #ifndef DUNE_PDELAB_GRIDFUNCTIONSPACE_GRIDFUNCTIONSPACEBASE_HH
 #define DUNE_PDELAB_GRIDFUNCTIONSPACE_GRIDFUNCTIONSPACEBASE_HH
 
+#include <cstddef>
+
 #include <dune/typetree/visitor.hh>
 #include <dune/typetree/traversal.hh>
 
@@ -66,6 +68,7 @@ namespace Dune {
           , _is_root_space(true)
           , _initialized(false)
           , _size_available(true)
+          , _revision(0)
         {}
 
         size_type _size;
@@ -75,6 +78,7 @@ namespace Dune {
         bool _is_root_space;
         bool _initialized;
         bool _size_available;
+        std::size_t _revision;
 
       };
 
@@ -101,6 +105,7 @@ namespace Dune {
               data._max_local_size = _max_local_size;
               data._size_available = ordering.update_gfs_data_size(data._size,data._block_count);
               data.setPartitionSet(ordering);
+              ++data._revision;
             }
         }
 
@@ -253,6 +258,18 @@ namespace Dune {
         return _is_root_space;
       }
 
+      //! Returns the number of times the DOF ordering of this space has been updated.
+      /**
+       * The revision changes whenever the space is updated, e.g. after grid
+       * adaptation, so it tells whether containers or patterns created for
+       * this space before are still valid, even if the number of DOFs stays
+       * the same.
+       */
+      std::size_t revision() const
+      {
+        return _revision;
+      }
+
     protected:
 
       template<typename Ordering>
@@ -291,6 +308,7 @@ namespace Dune {
       using BaseT::_is_root_space;
       using BaseT::_initialized;
       using BaseT::_size_available;
+      using BaseT::_revision;
 
     };
 
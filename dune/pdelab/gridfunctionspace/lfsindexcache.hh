@@ -292,6 +292,8 @@ namespace Dune {
         , _container_indices(lfs.maxSize())
         , _dof_flags(lfs.maxSize(),0)
         , _constraints_iterators(lfs.maxSize())
+        , _constraint_rows(lfs.maxSize())
+        , _touches_constraints(true)
         , _inverse_cache_built(false)
         , _gfs_constraints(constraints)
       {
@@ -322,8 +324,11 @@ namespace Dune {
           > index_mapper(_lfs._dof_indices->begin(),_container_indices.begin(),leaf_sizes.begin(),_lfs.subSpaceDepth());
         TypeTree::applyToTree(_lfs.gridFunctionSpace().ordering(),index_mapper);
 
-        if (_enable_constraints_caching)
+        if (_enable_constraints_caching && _gfs_constraints.finalized())
+          update_compressed_constraints();
+        else if (_enable_constraints_caching)
           {
+            _touches_constraints = false;
             _constraints.resize(0);
             std::vector<std::pair<size_type,typename C::const_iterator> > non_dirichlet_constrained_dofs;
             size_type constraint_entry_count = 0;
@@ -337,6 +342,7 @@ namespace Dune {
                     continue;
                   }
 
+                _touches_constraints = true;
                 if (cit->second.size() == 0)
                   {
                     _dof_flags[i] = DOF_CONSTRAINED | DOF_DIRICHLET;
@@ -403,6 +409,17 @@ namespace Dune {
         return _dof_flags[i] & DOF_DIRICHLET;
       }
 
+      //! Returns whether any DOF of the current cell is constrained.
+      /**
+       * Assemblers can use this to skip the constraints handling for the (usually
+       * vast majority of) cells that do not touch any constrained DOFs. If constraints
+       * caching is disabled, this conservatively returns true.
+       */
+      bool touchesConstraints() const
+      {
+        return _touches_constraints;
+      }
+
       ConstraintsIterator constraintsBegin(size_type i) const
       {
         assert(isConstrained(i));
@@ -453,6 +470,58 @@ namespace Dune {
 
     private:
 
+      // Fills the constraints cache from the compressed representation of the global
+      // constraints. Unconstrained DOFs are almost always rejected by the per-block flags
+      // of the constraints container, so clean cells do not need any searching.
+      void update_compressed_constraints()
+      {
+        _touches_constraints = false;
+        _constraints.resize(0);
+        size_type constraint_entry_count = 0;
+        for (size_type i = 0; i < _lfs.size(); ++i)
+          {
+            const size_type r = _gfs_constraints.findRow(_container_indices[i]);
+            if (r == C::npos)
+              {
+                _dof_flags[i] = DOF_NONCONSTRAINED;
+                continue;
+              }
+
+            _touches_constraints = true;
+            if (_gfs_constraints.isDirichletRow(r))
+              _dof_flags[i] = DOF_CONSTRAINED | DOF_DIRICHLET;
+            else
+              {
+                _dof_flags[i] = DOF_CONSTRAINED;
+                constraint_entry_count += _gfs_constraints.rowEnd(r) - _gfs_constraints.rowBegin(r);
+              }
+            _constraint_rows[i] = r;
+          }
+
+        if (!_touches_constraints)
+          return;
+
+        // the entries are copied in a second pass, as resizing _constraints invalidates the iterators
+        _constraints.resize(constraint_entry_count);
+        typename ConstraintsVector::iterator eit = _constraints.begin();
+        for (size_type i = 0; i < _lfs.size(); ++i)
+          {
+            if (!(_dof_flags[i] & DOF_CONSTRAINED))
+              continue;
+            _constraints_iterators[i].first = eit;
+            if (!(_dof_flags[i] & DOF_DIRICHLET))
+              {
+                const size_type r = _constraint_rows[i];
+                for (size_type k = _gfs_constraints.rowBegin(r); k < _gfs_constraints.rowEnd(r); ++k, ++eit)
+                  {
+                    eit->first = &(_gfs_constraints.entryIndex(k));
+                    eit->second = _gfs_constraints.entryWeight(k);
+                  }
+              }
+            _constraints_iterators[i].second = eit;
+          }
+      }
+
       struct sort_container_indices
       {
         template<typename T>
@@ -522,6 +591,8 @@ namespace Dune {
       CIVector _container_indices;
       std::vector<unsigned char> _dof_flags;
       std::vector<std::pair<ConstraintsIterator,ConstraintsIterator> > _constraints_iterators;
+      std::vector<size_type> _constraint_rows;
+      bool _touches_constraints;
       mutable CIMap _container_index_map;
       ConstraintsVector _constraints;
       mutable array<size_type,LFS::CHILDREN> _offsets;
@@ -642,6 +713,11 @@ namespace Dune {
         return false;
       }
 
+      bool touchesConstraints() const
+      {
+        return false;
+      }
+
       ConstraintsIterator constraintsBegin(size_type i) const
       {
         return _constraints.begin();
@@ -726,12 +802,14 @@ namespace Dune {
         : _lfs(lfs)
         , _dof_flags(lfs.maxSize())
         , _constraints_iterators(lfs.maxSize())
+        , _touches_constraints(false)
         , _gfs_constraints(constraints)
       {
       }
 
       void update()
       {
+        _touches_constraints = false;
         _constraints.resize(0);
         std::vector<std::pair<size_type,typename C::const_iterator> > non_dirichlet_constrained_dofs;
         size_type constraint_entry_count = 0;
@@ -745,6 +823,7 @@ namespace Dune {
                 continue;
               }
 
+            _touches_constraints = true;
             if (cit->second.size() == 0)
               {
                 _dof_flags[i] = DOF_CONSTRAINED | DOF_DIRICHLET;
@@ -802,6 +881,12 @@ namespace Dune {
         return _dof_flags[i] & DOF_DIRICHLET;
       }
 
+      //! Returns whether any DOF of the current cell is constrained.
+      bool touchesConstraints() const
+      {
+        return _touches_constraints;
+      }
+
       ConstraintsIterator constraintsBegin(size_type i) const
       {
         assert(isConstrained(i));
@@ -830,6 +915,7 @@ namespace Dune {
       CIVector _container_indices;
       std::vector<unsigned char> _dof_flags;
       std::vector<std::pair<ConstraintsIterator,ConstraintsIterator> > _constraints_iterators;
+      bool _touches_constraints;
       mutable CIMap _container_index_map;
       ConstraintsVector _constraints;
 
@@ -915,6 +1001,11 @@ namespace Dune {
         return false;
       }
 
+      bool touchesConstraints() const
+      {
+        return false;
+      }
+
       ConstraintsIterator constraintsBegin(size_type i) const
       {
         return _constraints.begin();
@@ -14,6 +14,7 @@
 
 #include <dune/typetree/typetree.hh>
 
+#include <dune/pdelab/finiteelementmap/variableorderdispatch.hh>
 #include <dune/pdelab/gridfunctionspace/tags.hh>
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
 
@@ -586,39 +587,18 @@ namespace Dune {
       }
 
       //! Calculates the multiindices associated with the given entity.
+      /**
+       * If the finite element map provides dispatch(e,f) (e.g. the variable order
+       * maps), the local keys are read from the finite element of e as its concrete
+       * type instead of through the virtual interface returned by find().
+       */
       template<typename Entity, typename DOFIndexIterator>
       void dofIndices(const Entity& e, DOFIndexIterator it, DOFIndexIterator endit)
       {
-        // get layout of entity
-        const typename FESwitch::Coefficients &coeffs =
-          FESwitch::coefficients(*pfe);
-
-        typedef typename GFS::Traits::GridViewType GV;
-        GV gv = this->gridFunctionSpace().gridView();
-
-        const Dune::ReferenceElement<double,GV::Grid::dimension>& refEl =
-          Dune::ReferenceElements<double,GV::Grid::dimension>::general(this->pfe->type());
-
-        for (std::size_t i = 0; i < std::size_t(coeffs.size()); ++i, ++it)
-          {
-            // get geometry type of subentity
-            Dune::GeometryType gt = refEl.type(coeffs.localKey(i).subEntity(),
-                                              coeffs.localKey(i).codim());
-
-            // evaluate consecutive index of subentity
-            typename GV::IndexSet::IndexType index = gv.indexSet().subIndex(e,
-                                                                            coeffs.localKey(i).subEntity(),
-                                                                            coeffs.localKey(i).codim());
-
-            // store data
-            GFS::Ordering::Traits::DOFIndexAccessor::store(*it,gt,index,coeffs.localKey(i).index());
-
-            // make sure we don't write past the end of the iterator range
-            assert(it != endit);
-          }
+        impl::dispatch_finite_element(this->pgfs->finiteElementMap(),e,*pfe,
+                                      DOFIndicesFromFiniteElement<Entity,DOFIndexIterator>(*this,e,it,endit));
       }
 
-
       template<typename GC, typename LC>
       void insert_constraints (const LC& lc, GC& gc) const
       {
@@ -649,6 +629,56 @@ namespace Dune {
 
       //    private:
       typename FESwitch::Store pfe;
+
+    private:
+
+      // calculates the multiindices of the entity e from the local keys of the finite element fe
+      template<typename Entity, typename DOFIndexIterator>
+      struct DOFIndicesFromFiniteElement
+      {
+        template<typename FE>
+        void operator()(const FE& fe) const
+        {
+          // global finite elements only provide coefficients()
+          const typename FiniteElementInterfaceSwitch<FE>::Coefficients& coeffs =
+            FiniteElementInterfaceSwitch<FE>::coefficients(fe);
+
+          typedef typename GFS::Traits::GridViewType GV;
+          GV gv = node.gridFunctionSpace().gridView();
+
+          const Dune::ReferenceElement<double,GV::Grid::dimension>& refEl =
+            Dune::ReferenceElements<double,GV::Grid::dimension>::general(fe.type());
+
+          DOFIndexIterator it = begin;
+          for (std::size_t i = 0; i < std::size_t(coeffs.size()); ++i, ++it)
+            {
+              // get geometry type of subentity
+              Dune::GeometryType gt = refEl.type(coeffs.localKey(i).subEntity(),
+                                                coeffs.localKey(i).codim());
+
+              // evaluate consecutive index of subentity
+              typename GV::IndexSet::IndexType index = gv.indexSet().subIndex(e,
+                                                                              coeffs.localKey(i).subEntity(),
+                                                                              coeffs.localKey(i).codim());
+
+              // store data
+              GFS::Ordering::Traits::DOFIndexAccessor::store(*it,gt,index,coeffs.localKey(i).index());
+
+              // make sure we don't write past the end of the iterator range
+              assert(it != end);
+            }
+        }
+
+        DOFIndicesFromFiniteElement(const LeafLocalFunctionSpaceNode& node_, const Entity& e_,
+                                    DOFIndexIterator begin_, DOFIndexIterator end_)
+          : node(node_), e(e_), begin(begin_), end(end_)
+        {}
+
+        const LeafLocalFunctionSpaceNode& node;
+        const Entity& e;
+        DOFIndexIterator begin;
+        DOFIndexIterator end;
+      };
     };
 
     // Register LeafGFS -> LocalFunctionSpace transformation
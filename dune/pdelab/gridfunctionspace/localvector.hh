@@ -5,7 +5,10 @@
 
 #include <vector>
 #include <algorithm>
+#include <cstddef>
 #include <functional>
+#include <type_traits>
+#include <dune/pdelab/common/fixedcapacityvector.hh>
 #include <dune/pdelab/gridfunctionspace/localfunctionspacetags.hh>
 
 /** \file
@@ -21,6 +24,39 @@ namespace Dune {
      * \{
      */
 
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      template<std::size_t>
+      struct local_capacity_void
+      {
+        typedef void type;
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    //! The compile time capacity of the local vector or view C.
+    /**
+     * This is C::static_capacity, or 0 (i.e. dynamically sized) for containers
+     * that do not export it, e.g. user-supplied local containers.
+     */
+    template<typename C, typename = void>
+    struct LocalVectorStaticCapacity
+      : public std::integral_constant<std::size_t,0>
+    {};
+
+#ifndef DOXYGEN
+
+    template<typename C>
+    struct LocalVectorStaticCapacity<C,typename impl::local_capacity_void<C::static_capacity>::type>
+      : public std::integral_constant<std::size_t,C::static_capacity>
+    {};
+
+#endif // DOXYGEN
+
     //! An accumulate-only view on a local vector that automatically takes into account an accumulation weight.
     template<typename C>
     class WeightedVectorAccumulationView
@@ -39,6 +75,9 @@ namespace Dune {
       //! The type of the weight applied when accumulating contributions.
       typedef typename Container::weight_type weight_type;
 
+      //! The compile time capacity of the underlying LocalVector, 0 if it is dynamic.
+      static const std::size_t static_capacity = LocalVectorStaticCapacity<Container>::value;
+
       //! \brief Export this type for uniform handling of the containers
       //!        themselves and their views.
       typedef WeightedVectorAccumulationView WeightedAccumulationView;
@@ -163,17 +202,30 @@ namespace Dune {
      * by specifying a non-default LFSFlavorTag, the container will also assert that a LocalFunctionSpace
      * of the matching kind (trial or test space) is used to access its content.
      *
+     * If the maximum size of the vector is known at compile time, it can be passed as
+     * capacity. The entries are then stored in a FixedCapacityVector embedded in the
+     * LocalVector instead of a std::vector, which avoids heap allocations when copying
+     * the vector and gives loops over the entries a constant upper bound.
+     *
      * \tparam T            The type of values to store in the vector.
      * \tparam LFSFlavorTag Tag type for differentiating between trial and test space vectors.
      * \tparam W            The type of weight applied in a WeightedAccumulationView.
+     * \tparam capacity     The maximum size of the vector or 0 if it is only known at run time.
      */
-    template<typename T, typename LFSFlavorTag = AnySpaceTag, typename W = T>
+    template<typename T, typename LFSFlavorTag = AnySpaceTag, typename W = T, std::size_t capacity = 0>
     class LocalVector
     {
     public:
 
       //! The type of the underlying storage container.
-      typedef std::vector<T> BaseContainer;
+      typedef typename std::conditional<
+        capacity == 0,
+        std::vector<T>,
+        FixedCapacityVector<T,capacity>
+        >::type BaseContainer;
+
+      //! The compile time capacity of this container, 0 if it is dynamic.
+      static const std::size_t static_capacity = capacity;
 
       //! The value type of this container.
       typedef typename BaseContainer::value_type  value_type;
@@ -292,14 +344,20 @@ namespace Dune {
     };
 
 
+    template<typename C>
+    const std::size_t WeightedVectorAccumulationView<C>::static_capacity;
+
+    template<typename T, typename Tag, typename W, std::size_t capacity>
+    const std::size_t LocalVector<T,Tag,W,capacity>::static_capacity;
+
     template<typename C>
     C& accessBaseContainer(C& c)
     {
       return c;
     }
 
-    template<typename T, typename Tag, typename W>
-    typename LocalVector<T,Tag,W>::BaseContainer& accessBaseContainer(LocalVector<T,Tag,W>& c)
+    template<typename T, typename Tag, typename W, std::size_t n>
+    typename LocalVector<T,Tag,W,n>::BaseContainer& accessBaseContainer(LocalVector<T,Tag,W,n>& c)
     {
       return c.base();
     }
@@ -317,8 +375,8 @@ namespace Dune {
       return c;
     }
 
-    template<typename T, typename Tag, typename W>
-    const typename LocalVector<T,Tag,W>::BaseContainer& accessBaseContainer(const LocalVector<T,Tag,W>& c)
+    template<typename T, typename Tag, typename W, std::size_t n>
+    const typename LocalVector<T,Tag,W,n>::BaseContainer& accessBaseContainer(const LocalVector<T,Tag,W,n>& c)
     {
       return c.base();
     }
@@ -0,0 +1,151 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#ifndef DUNE_PDELAB_GRIDFUNCTIONSPACE_STATICLOCALSIZE_HH
+#define DUNE_PDELAB_GRIDFUNCTIONSPACE_STATICLOCALSIZE_HH
+
+#include <cstddef>
+#include <type_traits>
+
+#include <dune/typetree/accumulate_static.hh>
+
+#include <dune/pdelab/finiteelementmap/finiteelementmap.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! \addtogroup GridFunctionSpace
+    //! \ingroup PDELab
+    //! \{
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      template<typename T>
+      struct static_local_size_void
+      {
+        typedef void type;
+      };
+
+      // leaves without a finite element map (e.g. proxies) have an unknown size
+      template<typename Node, typename = void>
+      struct leaf_static_max_local_size
+        : public std::integral_constant<std::size_t,0>
+      {};
+
+      template<typename Node>
+      struct leaf_static_max_local_size<
+        Node,
+        typename static_local_size_void<typename Node::Traits::FiniteElementMapType>::type
+        >
+        : public FiniteElementMapStaticMaxLocalSize<typename Node::Traits::FiniteElementMapType>
+      {};
+
+      struct accumulate_static_leaf_size
+      {
+
+        typedef std::size_t result_type;
+
+        template<typename Node, typename TreePath>
+        struct doVisit
+        {
+          static const bool value = Node::isLeaf;
+        };
+
+        template<typename Node, typename TreePath>
+        struct visit
+        {
+          static const std::size_t result = leaf_static_max_local_size<Node>::value;
+        };
+
+      };
+
+      struct detect_dynamic_leaf_size
+      {
+
+        typedef std::size_t result_type;
+
+        template<typename Node, typename TreePath>
+        struct doVisit
+        {
+          static const bool value = Node::isLeaf;
+        };
+
+        template<typename Node, typename TreePath>
+        struct visit
+        {
+          static const std::size_t result = leaf_static_max_local_size<Node>::value == 0 ? 1 : 0;
+        };
+
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    //! Compile time upper bound for the size of a LocalFunctionSpace of GFS.
+    /**
+     * This is the sum of FiniteElementMapStaticMaxLocalSize over all leaves of GFS.
+     * If any of the leaves does not provide a compile time bound, the value is 0.
+     */
+    template<typename GFS>
+    struct StaticMaxLocalSize
+      : public std::integral_constant<
+          std::size_t,
+          TypeTree::AccumulateValue<GFS,
+                                    impl::detect_dynamic_leaf_size,
+                                    TypeTree::max<std::size_t>,
+                                    0
+                                    >::result
+          ? 0
+          : TypeTree::AccumulateValue<GFS,
+                                      impl::accumulate_static_leaf_size,
+                                      TypeTree::plus<std::size_t>,
+                                      0
+                                      >::result
+          >
+    {};
+
+    //! Capacities of the local containers used by the assemblers for the given spaces.
+    /**
+     * The capacities are the StaticMaxLocalSize of the trial and test spaces, or 0
+     * (i.e. dynamically sized containers) if the bounds are unknown or the containers
+     * would exceed max_entries entries. The limit keeps the local assembler engines,
+     * which embed their local containers, at a reasonable size; it means that the
+     * local matrices of larger spaces, e.g. Q2 vector-valued spaces in 3D with 81 x 81
+     * entries, still use dynamic storage.
+     *
+     * \note The capacities only determine the storage of the containers. Their size and
+     *       the loops of the local operators still follow the sizes of the local function
+     *       spaces at runtime.
+     */
+    template<typename GFSU, typename GFSV>
+    struct StaticLocalContainerCapacity
+    {
+      //! The maximum number of entries of a container with fixed capacity.
+      static const std::size_t max_entries = 1024;
+
+      //! The capacity of local vectors on the trial space.
+      static const std::size_t trial =
+        StaticMaxLocalSize<GFSU>::value <= max_entries ? StaticMaxLocalSize<GFSU>::value : 0;
+
+      //! The capacity of local vectors on the test space.
+      static const std::size_t test =
+        StaticMaxLocalSize<GFSV>::value <= max_entries ? StaticMaxLocalSize<GFSV>::value : 0;
+
+      //! The row capacity of local matrices coupling test and trial space.
+      static const std::size_t rows =
+        test * trial <= max_entries ? test : 0;
+
+      //! The column capacity of local matrices coupling test and trial space.
+      static const std::size_t cols =
+        test * trial <= max_entries ? trial : 0;
+    };
+
+    //! \} group GridFunctionSpace
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_GRIDFUNCTIONSPACE_STATICLOCALSIZE_HH
@@ -249,6 +249,20 @@ namespace Dune{
         >::type
       forwardtransform(X & x, const bool postrestrict = false) const
       {
+        if (pconstraintsv->finalized())
+          {
+            typedef typename CV::size_type size_type;
+            const CV& cv = *pconstraintsv;
+            for (size_type r = 0; r < cv.rowCount(); ++r)
+              for (size_type k = cv.rowBegin(r); k < cv.rowEnd(r); ++k)
+                x[cv.entryIndex(k)] += cv.entryWeight(k) * x[cv.rowIndex(r)];
+
+            if(postrestrict)
+              for (size_type r = 0; r < cv.rowCount(); ++r)
+                x[cv.rowIndex(r)]=0.;
+            return;
+          }
+
         typedef typename CV::const_iterator global_col_iterator;
         for (global_col_iterator cit=pconstraintsv->begin(); cit!=pconstraintsv->end(); ++cit){
           typedef typename global_col_iterator::value_type::first_type GlobalIndex;
@@ -300,6 +314,20 @@ namespace Dune{
         >::type
       backtransform(X & x, const bool prerestrict = false) const
       {
+        if (pconstraintsv->finalized())
+          {
+            typedef typename CV::size_type size_type;
+            const CV& cv = *pconstraintsv;
+            for (size_type r = 0; r < cv.rowCount(); ++r)
+              {
+                if(prerestrict)
+                  x[cv.rowIndex(r)] = 0.;
+                for (size_type k = cv.rowBegin(r); k < cv.rowEnd(r); ++k)
+                  x[cv.rowIndex(r)] += cv.entryWeight(k) * x[cv.entryIndex(k)];
+              }
+            return;
+          }
+
         typedef typename CV::const_iterator global_col_iterator;
         for (global_col_iterator cit=pconstraintsv->begin(); cit!=pconstraintsv->end(); ++cit){
           typedef typename global_col_iterator::value_type::first_type GlobalIndex;
@@ -382,10 +410,23 @@ namespace Dune{
         const LFSUIndexCache& lfsu_indices = global_container_view.colIndexCache();
 
         if (lfsv_indices.constraintsCachingEnabled() && lfsu_indices.constraintsCachingEnabled())
-          if (symmetric_mode)
-            etadd_symmetric(local_container,global_container_view);
-          else
-            etadd(local_container,global_container_view);
+          {
+            if (!lfsv_indices.touchesConstraints() && !lfsu_indices.touchesConstraints())
+              {
+                // the cell does not touch any constrained DOFs, so we can skip
+                // the constraints handling altogether
+                for (auto it = local_container.begin(); it != local_container.end(); ++it)
+                  {
+                    if (*it == 0.0)
+                      continue;
+                    global_container_view.add(it.row(),it.col(),*it);
+                  }
+              }
+            else if (symmetric_mode)
+              etadd_symmetric(local_container,global_container_view);
+            else
+              etadd(local_container,global_container_view);
+          }
         else
           {
 
@@ -658,6 +699,12 @@ namespace Dune{
       template<typename GFSV, typename GC, typename C>
       void set_trivial_rows(const GFSV& gfsv, GC& globalcontainer, const C& c) const
       {
+        if (c.finalized())
+          {
+            for (typename C::size_type r = 0; r < c.rowCount(); ++r)
+              globalcontainer.clear_row(c.rowIndex(r),1);
+            return;
+          }
         typedef typename C::const_iterator global_row_iterator;
         for (global_row_iterator cit = c.begin(); cit != c.end(); ++cit)
           globalcontainer.clear_row(cit->first,1);
@@ -35,6 +35,10 @@ namespace Dune {
            */
           typedef std::vector<T> BaseContainer;
 
+          //! Diagonal matrices are always dynamically sized.
+          static const std::size_t static_row_capacity = 0;
+          static const std::size_t static_col_capacity = 0;
+
           //! The value type of this container.
           typedef typename BaseContainer::value_type  value_type;
 
@@ -289,6 +293,12 @@ namespace Dune {
           size_type _rows, _cols;
      };
 
+    template<typename T, typename W>
+    const std::size_t DiagonalLocalMatrix<T,W>::static_row_capacity;
+
+    template<typename T, typename W>
+    const std::size_t DiagonalLocalMatrix<T,W>::static_col_capacity;
+
     /**
      * \} group PDELab
      */
@@ -4,8 +4,13 @@
 #ifndef DUNE_PDELAB_GRIDOPERATOR_COMMON_LOCALMATRIX_HH
 #define DUNE_PDELAB_GRIDOPERATOR_COMMON_LOCALMATRIX_HH
 
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
 #include <dune/common/iteratorfacades.hh>
 
+#include <dune/pdelab/common/fixedcapacityvector.hh>
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
 
 namespace Dune {
@@ -16,6 +21,36 @@ namespace Dune {
      * \{
      */
 
+    //! The compile time row capacity of the local matrix or view C.
+    /**
+     * This is C::static_row_capacity, or 0 (i.e. dynamically sized) for containers
+     * that do not export it, e.g. user-supplied local containers.
+     */
+    template<typename C, typename = void>
+    struct LocalMatrixStaticRowCapacity
+      : public std::integral_constant<std::size_t,0>
+    {};
+
+    //! The compile time column capacity of the local matrix or view C, 0 if C does not export it.
+    template<typename C, typename = void>
+    struct LocalMatrixStaticColCapacity
+      : public std::integral_constant<std::size_t,0>
+    {};
+
+#ifndef DOXYGEN
+
+    template<typename C>
+    struct LocalMatrixStaticRowCapacity<C,typename impl::local_capacity_void<C::static_row_capacity>::type>
+      : public std::integral_constant<std::size_t,C::static_row_capacity>
+    {};
+
+    template<typename C>
+    struct LocalMatrixStaticColCapacity<C,typename impl::local_capacity_void<C::static_col_capacity>::type>
+      : public std::integral_constant<std::size_t,C::static_col_capacity>
+    {};
+
+#endif // DOXYGEN
+
     //! An accumulate-only view on a local matrix that automatically takes into account an accumulation weight.
     template<typename C>
     class WeightedMatrixAccumulationView
@@ -38,6 +73,12 @@ namespace Dune {
       //! The type of the weight applied when accumulating contributions.
       typedef typename C::weight_type weight_type;
 
+      //! The compile time row capacity of the underlying container, 0 if it is dynamic.
+      static const std::size_t static_row_capacity = LocalMatrixStaticRowCapacity<C>::value;
+
+      //! The compile time column capacity of the underlying container, 0 if it is dynamic.
+      static const std::size_t static_col_capacity = LocalMatrixStaticColCapacity<C>::value;
+
       //! \brief Export this type for uniform handling of the containers
       //!        themselves and their views.
       typedef WeightedMatrixAccumulationView WeightedAccumulationView;
@@ -178,9 +219,15 @@ namespace Dune {
      * contain tags indicating whether they are trial or test spaces, the access methods will also assert that the
      * first space is a test space and the second space is a trial space.
      *
+     * If upper bounds for the numbers of rows and columns are known at compile time, they
+     * can be passed as row_capacity and col_capacity. The entries are then stored in a
+     * FixedCapacityVector embedded in the LocalMatrix.
+     *
      * \tparam T            The type of values to store in the matrix.
      * \tparam W            The type of weight applied in a WeightedAccumulationView.
-     */	template<typename T, typename W = T>
+     * \tparam row_capacity The maximum number of rows or 0 if it is only known at run time.
+     * \tparam col_capacity The maximum number of columns or 0 if it is only known at run time.
+     */	template<typename T, typename W = T, std::size_t row_capacity = 0, std::size_t col_capacity = 0>
      class LocalMatrix
         {
         public:
@@ -189,7 +236,17 @@ namespace Dune {
           /**
            * \warning This is not a matrix-like container anymore, but a std::vector-like one!
            */
-          typedef std::vector<T> BaseContainer;
+          typedef typename std::conditional<
+            row_capacity == 0 || col_capacity == 0,
+            std::vector<T>,
+            FixedCapacityVector<T,row_capacity*col_capacity>
+            >::type BaseContainer;
+
+          //! The compile time row capacity of this matrix, 0 if it is dynamic.
+          static const std::size_t static_row_capacity = (col_capacity == 0 ? 0 : row_capacity);
+
+          //! The compile time column capacity of this matrix, 0 if it is dynamic.
+          static const std::size_t static_col_capacity = (row_capacity == 0 ? 0 : col_capacity);
 
           //! The value type of this container.
           typedef typename BaseContainer::value_type  value_type;
@@ -448,12 +505,24 @@ namespace Dune {
 
         private:
 
-          std::vector<T> _container;
+          BaseContainer _container;
           size_type _rows, _cols;
      };
 
-    template<class Stream, class T, class W>
-    Stream &operator<<(Stream &stream, const LocalMatrix<T,W> &m) {
+    template<typename C>
+    const std::size_t WeightedMatrixAccumulationView<C>::static_row_capacity;
+
+    template<typename C>
+    const std::size_t WeightedMatrixAccumulationView<C>::static_col_capacity;
+
+    template<typename T, typename W, std::size_t row_capacity, std::size_t col_capacity>
+    const std::size_t LocalMatrix<T,W,row_capacity,col_capacity>::static_row_capacity;
+
+    template<typename T, typename W, std::size_t row_capacity, std::size_t col_capacity>
+    const std::size_t LocalMatrix<T,W,row_capacity,col_capacity>::static_col_capacity;
+
+    template<class Stream, class T, class W, std::size_t r, std::size_t c>
+    Stream &operator<<(Stream &stream, const LocalMatrix<T,W,r,c> &m) {
       for(int r = 0; r < m.nrows(); ++r) {
         if(m.ncols() >= 1)
           stream << m.getEntry(r, 0);
@@ -3,6 +3,7 @@
 
 #include <dune/pdelab/constraints/common/constraints.hh>
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
+#include <dune/pdelab/gridfunctionspace/staticlocalsize.hh>
 #include <dune/pdelab/gridoperator/common/localmatrix.hh>
 #include <dune/pdelab/gridoperator/common/diagonallocalmatrix.hh>
 #include <dune/pdelab/gridoperator/common/assemblerutilities.hh>
@@ -288,14 +289,17 @@ namespace Dune{
       typedef Dune::PDELab::TrialSpaceTag LocalTrialSpaceTag;
       typedef Dune::PDELab::TestSpaceTag LocalTestSpaceTag;
 
-      typedef Dune::PDELab::LocalVector<SolutionElement, LocalTrialSpaceTag> SolutionVector;
+      //! Fixed capacities of the local containers if the local sizes are known at compile time
+      typedef Dune::PDELab::StaticLocalContainerCapacity<GFSU,GFSV> LocalCapacity;
+
+      typedef Dune::PDELab::LocalVector<SolutionElement, LocalTrialSpaceTag, SolutionElement, LocalCapacity::trial> SolutionVector;
       typedef typename std::conditional<
         std::is_base_of<
           lop::DiagonalJacobian,
           LOP
           >::value,
         Dune::PDELab::DiagonalLocalMatrix<JacobianElement>,
-        Dune::PDELab::LocalMatrix<JacobianElement>
+        Dune::PDELab::LocalMatrix<JacobianElement, JacobianElement, LocalCapacity::rows, LocalCapacity::cols>
         >::type JacobianMatrix;
 
       SolutionVector xl;
@@ -7,6 +7,8 @@
 #include <dune/pdelab/gridoperator/default/patternengine.hh>
 #include <dune/pdelab/gridoperator/default/jacobianengine.hh>
 #include <dune/pdelab/gridoperator/default/jacobianapplyengine.hh>
+#include <dune/pdelab/gridoperator/default/nonlinearjacobianapplyengine.hh>
+#include <dune/pdelab/gridoperator/default/residualjacobianengine.hh>
 #include <dune/pdelab/gridoperator/common/assemblerutilities.hh>
 #include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
 
@@ -85,17 +87,22 @@ namespace Dune{
       typedef DefaultLocalResidualAssemblerEngine<DefaultLocalAssembler> LocalResidualAssemblerEngine;
       typedef DefaultLocalJacobianAssemblerEngine<DefaultLocalAssembler> LocalJacobianAssemblerEngine;
       typedef DefaultLocalJacobianApplyAssemblerEngine<DefaultLocalAssembler> LocalJacobianApplyAssemblerEngine;
+      typedef DefaultLocalNonlinearJacobianApplyAssemblerEngine<DefaultLocalAssembler> LocalNonlinearJacobianApplyAssemblerEngine;
+      typedef DefaultLocalResidualJacobianAssemblerEngine<DefaultLocalAssembler> LocalResidualJacobianAssemblerEngine;
 
       friend class DefaultLocalPatternAssemblerEngine<DefaultLocalAssembler>;
       friend class DefaultLocalResidualAssemblerEngine<DefaultLocalAssembler>;
       friend class DefaultLocalJacobianAssemblerEngine<DefaultLocalAssembler>;
       friend class DefaultLocalJacobianApplyAssemblerEngine<DefaultLocalAssembler>;
+      friend class DefaultLocalNonlinearJacobianApplyAssemblerEngine<DefaultLocalAssembler>;
+      friend class DefaultLocalResidualJacobianAssemblerEngine<DefaultLocalAssembler>;
       //! @}
 
       //! Constructor with empty constraints
       DefaultLocalAssembler (LOP & lop_, shared_ptr<typename GO::BorderDOFExchanger> border_dof_exchanger)
         : lop(lop_),  weight(1.0), doPreProcessing(true), doPostProcessing(true),
           pattern_engine(*this,border_dof_exchanger), residual_engine(*this), jacobian_engine(*this), jacobian_apply_engine(*this)
+        , nonlinear_jacobian_apply_engine(*this), residual_jacobian_engine(*this)
         , _reconstruct_border_entries(isNonOverlapping)
       {}
 
@@ -105,6 +112,7 @@ namespace Dune{
         : Base(cu_, cv_),
           lop(lop_),  weight(1.0), doPreProcessing(true), doPostProcessing(true),
           pattern_engine(*this,border_dof_exchanger), residual_engine(*this), jacobian_engine(*this), jacobian_apply_engine(*this)
+        , nonlinear_jacobian_apply_engine(*this), residual_jacobian_engine(*this)
         , _reconstruct_border_entries(isNonOverlapping)
       {}
 
@@ -176,6 +184,28 @@ namespace Dune{
         return jacobian_apply_engine;
       }
 
+      //! Returns a reference to the requested engine. This engine is
+      //! completely configured and ready to use.
+      LocalNonlinearJacobianApplyAssemblerEngine & localNonlinearJacobianApplyAssemblerEngine
+      (typename Traits::Residual & r, const typename Traits::Solution & x, const typename Traits::Solution & z)
+      {
+        nonlinear_jacobian_apply_engine.setResidual(r);
+        nonlinear_jacobian_apply_engine.setLinearizationPoint(x);
+        nonlinear_jacobian_apply_engine.setSolution(z);
+        return nonlinear_jacobian_apply_engine;
+      }
+
+      //! Returns a reference to the requested engine. This engine is
+      //! completely configured and ready to use.
+      LocalResidualJacobianAssemblerEngine & localResidualJacobianAssemblerEngine
+      (typename Traits::Residual & r, typename Traits::Jacobian & a, const typename Traits::Solution & x)
+      {
+        residual_jacobian_engine.setResidual(r);
+        residual_jacobian_engine.setJacobian(a);
+        residual_jacobian_engine.setSolution(x);
+        return residual_jacobian_engine;
+      }
+
       //! @}
 
       //! \brief Query methods for the assembler engines. Theses methods
@@ -237,6 +267,8 @@ namespace Dune{
       LocalResidualAssemblerEngine residual_engine;
       LocalJacobianAssemblerEngine jacobian_engine;
       LocalJacobianApplyAssemblerEngine jacobian_apply_engine;
+      LocalNonlinearJacobianApplyAssemblerEngine nonlinear_jacobian_apply_engine;
+      LocalResidualJacobianAssemblerEngine residual_jacobian_engine;
       //! @}
 
       bool _reconstruct_border_entries;
@@ -0,0 +1,246 @@
+#ifndef DUNE_PDELAB_DEFAULT_NONLINEARJACOBIANAPPLYENGINE_HH
+#define DUNE_PDELAB_DEFAULT_NONLINEARJACOBIANAPPLYENGINE_HH
+
+#include <dune/pdelab/gridoperator/default/jacobianapplyengine.hh>
+#include <dune/pdelab/localoperator/callswitch.hh>
+
+namespace Dune{
+  namespace PDELab{
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // Calls the jacobian_apply_*() methods of a local operator for a
+      // linearization point x and a direction z. Linear local operators
+      // only get z, as their jacobian does not depend on x.
+      template<bool linear>
+      struct JacobianApplyAtLinearizationPoint
+      {
+
+        template<bool doIt, typename LOP, typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void volume(const LOP& lop, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_volume(lop,eg,lfsu,z,lfsv,y);
+        }
+
+        template<bool doIt, typename LOP, typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void volume_post_skeleton(const LOP& lop, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_volume_post_skeleton(lop,eg,lfsu,z,lfsv,y);
+        }
+
+        template<bool doIt, typename LOP, typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void skeleton(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+                             const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+                             Y& y_s, Y& y_n)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_skeleton(lop,ig,lfsu_s,z_s,lfsv_s,lfsu_n,z_n,lfsv_n,y_s,y_n);
+        }
+
+        template<bool doIt, typename LOP, typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void boundary(const LOP& lop, const IG& ig, const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s, Y& y_s)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_boundary(lop,ig,lfsu_s,z_s,lfsv_s,y_s);
+        }
+
+      };
+
+      template<>
+      struct JacobianApplyAtLinearizationPoint<false>
+      {
+
+        template<bool doIt, typename LOP, typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void volume(const LOP& lop, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_volume(lop,eg,lfsu,x,z,lfsv,y);
+        }
+
+        template<bool doIt, typename LOP, typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void volume_post_skeleton(const LOP& lop, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_volume_post_skeleton(lop,eg,lfsu,x,z,lfsv,y);
+        }
+
+        template<bool doIt, typename LOP, typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void skeleton(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+                             const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+                             Y& y_s, Y& y_n)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_skeleton(lop,ig,lfsu_s,x_s,z_s,lfsv_s,lfsu_n,x_n,z_n,lfsv_n,y_s,y_n);
+        }
+
+        template<bool doIt, typename LOP, typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+        static void boundary(const LOP& lop, const IG& ig, const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s, Y& y_s)
+        {
+          LocalAssemblerCallSwitch<LOP,doIt>::jacobian_apply_boundary(lop,ig,lfsu_s,x_s,z_s,lfsv_s,y_s);
+        }
+
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    /**
+       \brief The local assembler engine for DUNE grids which
+       assembles the local application of the Jacobian, evaluated
+       at a linearization point, to a given vector
+
+       The vector set with setSolution() is the one the Jacobian is
+       applied to, the point at which the Jacobian is evaluated is set
+       with setLinearizationPoint(). Local operators which are not
+       linear (see LocalOperatorDefaultFlags::isLinear) have to
+       implement the jacobian_apply_*() methods taking both vectors.
+
+       \tparam LA The local assembler
+
+    */
+    template<typename LA>
+    class DefaultLocalNonlinearJacobianApplyAssemblerEngine
+      : public DefaultLocalJacobianApplyAssemblerEngine<LA>
+    {
+
+      typedef DefaultLocalJacobianApplyAssemblerEngine<LA> BaseT;
+
+      using BaseT::local_assembler;
+      using BaseT::lop;
+      using BaseT::xl;
+      using BaseT::xn;
+      using BaseT::rl_view;
+      using BaseT::rn_view;
+
+    public:
+
+      //! The type of the wrapping local assembler
+      typedef LA LocalAssembler;
+
+      //! The type of the local operator
+      typedef typename LA::LocalOperator LOP;
+
+      //! The type of the solution vector
+      typedef typename BaseT::Solution Solution;
+
+      typedef typename BaseT::SolutionView SolutionView;
+
+      /**
+         \brief Constructor
+
+         \param [in] local_assembler_ The local assembler object which
+         creates this engine
+      */
+      DefaultLocalNonlinearJacobianApplyAssemblerEngine(const LocalAssembler & local_assembler_)
+        : BaseT(local_assembler_)
+      {}
+
+      //! Set the linearization point. Should be called prior to
+      //! assembling.
+      void setLinearizationPoint(const Solution & linearization_point_){
+        global_ul_view.attach(linearization_point_);
+        global_un_view.attach(linearization_point_);
+      }
+
+      //! Called immediately after binding of local function space in
+      //! global assembler.
+      //! @{
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void onBindLFSUV(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        BaseT::onBindLFSUV(eg,lfsu_cache,lfsv_cache);
+        global_ul_view.bind(lfsu_cache);
+        ul.resize(lfsu_cache.size());
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onBindLFSUVInside(const IG & ig, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        BaseT::onBindLFSUVInside(ig,lfsu_cache,lfsv_cache);
+        global_ul_view.bind(lfsu_cache);
+        ul.resize(lfsu_cache.size());
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onBindLFSUVOutside(const IG & ig,
+                              const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        BaseT::onBindLFSUVOutside(ig,lfsu_s_cache,lfsv_s_cache,lfsu_n_cache,lfsv_n_cache);
+        global_un_view.bind(lfsu_n_cache);
+        un.resize(lfsu_n_cache.size());
+      }
+      //! @}
+
+      //! Methods for loading of the local function's coefficients
+      //! @{
+      template<typename LFSUC>
+      void loadCoefficientsLFSUInside(const LFSUC & lfsu_s_cache){
+        BaseT::loadCoefficientsLFSUInside(lfsu_s_cache);
+        global_ul_view.read(ul);
+      }
+      template<typename LFSUC>
+      void loadCoefficientsLFSUOutside(const LFSUC & lfsu_n_cache){
+        BaseT::loadCoefficientsLFSUOutside(lfsu_n_cache);
+        global_un_view.read(un);
+      }
+      //! @}
+
+      //! Assembling methods
+      //! @{
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolume(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        impl::JacobianApplyAtLinearizationPoint<LOP::isLinear>::template volume<LOP::doAlphaVolume>
+          (lop,eg,lfsu_cache.localFunctionSpace(),ul,xl,lfsv_cache.localFunctionSpace(),rl_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVSkeleton(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        rn_view.setWeight(local_assembler.weight);
+        impl::JacobianApplyAtLinearizationPoint<LOP::isLinear>::template skeleton<LOP::doAlphaSkeleton>
+          (lop,ig,
+           lfsu_s_cache.localFunctionSpace(),ul,xl,lfsv_s_cache.localFunctionSpace(),
+           lfsu_n_cache.localFunctionSpace(),un,xn,lfsv_n_cache.localFunctionSpace(),
+           rl_view,rn_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVBoundary(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        impl::JacobianApplyAtLinearizationPoint<LOP::isLinear>::template boundary<LOP::doAlphaBoundary>
+          (lop,ig,lfsu_s_cache.localFunctionSpace(),ul,xl,lfsv_s_cache.localFunctionSpace(),rl_view);
+      }
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolumePostSkeleton(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        impl::JacobianApplyAtLinearizationPoint<LOP::isLinear>::template volume_post_skeleton<LOP::doAlphaVolumePostSkeleton>
+          (lop,eg,lfsu_cache.localFunctionSpace(),ul,xl,lfsv_cache.localFunctionSpace(),rl_view);
+      }
+
+      //! @}
+
+    private:
+
+      //! Views of the linearization point
+      SolutionView global_ul_view;
+      SolutionView global_un_view;
+
+      typedef typename BaseT::SolutionVector SolutionVector;
+
+      //! Inside local linearization point
+      SolutionVector ul;
+      //! Outside local linearization point
+      SolutionVector un;
+
+    }; // End of class DefaultLocalNonlinearJacobianApplyAssemblerEngine
+
+  }
+}
+#endif
@@ -2,6 +2,7 @@
 #define DUNE_PDELAB_DEFAULT_RESIDUALENGINE_HH
 
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
+#include <dune/pdelab/gridfunctionspace/staticlocalsize.hh>
 #include <dune/pdelab/gridoperator/common/assemblerutilities.hh>
 #include <dune/pdelab/gridoperator/common/localassemblerenginebase.hh>
 #include <dune/pdelab/constraints/common/constraints.hh>
@@ -319,7 +320,7 @@ namespace Dune{
 
       //! @}
 
-    private:
+    protected:
       //! Reference to the wrapping local assembler object which
       //! constructed this engine
       const LocalAssembler & local_assembler;
@@ -340,8 +341,11 @@ namespace Dune{
       typedef Dune::PDELab::TrialSpaceTag LocalTrialSpaceTag;
       typedef Dune::PDELab::TestSpaceTag LocalTestSpaceTag;
 
-      typedef Dune::PDELab::LocalVector<SolutionElement, LocalTrialSpaceTag> SolutionVector;
-      typedef Dune::PDELab::LocalVector<ResidualElement, LocalTestSpaceTag> ResidualVector;
+      //! Fixed capacities of the local containers if the local sizes are known at compile time
+      typedef Dune::PDELab::StaticLocalContainerCapacity<GFSU,GFSV> LocalCapacity;
+
+      typedef Dune::PDELab::LocalVector<SolutionElement, LocalTrialSpaceTag, SolutionElement, LocalCapacity::trial> SolutionVector;
+      typedef Dune::PDELab::LocalVector<ResidualElement, LocalTestSpaceTag, ResidualElement, LocalCapacity::test> ResidualVector;
 
       //! Inside local coefficients
       SolutionVector xl;
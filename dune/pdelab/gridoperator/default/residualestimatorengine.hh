@@ -0,0 +1,252 @@
+#ifndef DUNE_PDELAB_DEFAULT_RESIDUALESTIMATORENGINE_HH
+#define DUNE_PDELAB_DEFAULT_RESIDUALESTIMATORENGINE_HH
+
+#include <dune/pdelab/common/elementmapper.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/localvector.hh>
+#include <dune/pdelab/gridoperator/default/residualengine.hh>
+#include <dune/pdelab/localoperator/callswitch.hh>
+
+namespace Dune{
+  namespace PDELab{
+
+    /**
+       \brief The local assembler engine for DUNE grids which
+       assembles the residual vector and an element-wise error
+       estimator in the same grid traversal
+
+       In addition to the residual, the alpha_*() methods of the
+       estimator local operator ELOP are evaluated for the trial
+       space of the grid operator and a test space EGFS with a single
+       DOF per cell, e.g. a P0 space. The estimator reuses the local
+       coefficients loaded for the residual, so estimating the error
+       does not require a separate grid traversal.
+
+       Every intersection is passed to the estimator exactly once
+       (unless ELOP::doSkeletonTwoSided is set), independent of
+       whether the residual local operator visits skeletons from both
+       sides.
+
+       \tparam LA   The local assembler
+       \tparam ELOP The estimator local operator
+       \tparam EGFS The grid function space of the estimate
+       \tparam EV   The vector type of the estimate
+
+    */
+    template<typename LA, typename ELOP, typename EGFS, typename EV>
+    class DefaultLocalResidualEstimatorAssemblerEngine
+      : public DefaultLocalResidualAssemblerEngine<LA>
+    {
+
+      typedef DefaultLocalResidualAssemblerEngine<LA> BaseT;
+
+      using BaseT::xl;
+      using BaseT::xn;
+
+    public:
+
+      //! The type of the wrapping local assembler
+      typedef LA LocalAssembler;
+
+      //! The type of the local operator
+      typedef typename LA::LocalOperator LOP;
+
+      //! The type of the estimator local operator
+      typedef ELOP EstimatorLocalOperator;
+
+      //! The type of the estimate vector
+      typedef EV Estimate;
+      typedef typename Estimate::ElementType EstimateElement;
+
+      //! The local function spaces of the estimate
+      typedef LocalFunctionSpace<EGFS, TestSpaceTag> LFSE;
+      typedef LFSIndexCache<LFSE> LFSECache;
+
+      typedef typename Estimate::template LocalView<LFSECache> EstimateView;
+
+      typedef typename EGFS::Traits::GridViewType GV;
+
+      /**
+         \brief Constructor
+
+         \param [in] local_assembler_ The local assembler object which
+         creates this engine
+         \param [in] elop_ The estimator local operator
+         \param [in] egfs_ The grid function space of the estimate
+      */
+      DefaultLocalResidualEstimatorAssemblerEngine(const LocalAssembler & local_assembler_,
+                                                   const ELOP & elop_,
+                                                   const EGFS & egfs_)
+        : BaseT(local_assembler_),
+          elop(elop_),
+          lfse(egfs_),
+          lfsen(egfs_),
+          lfse_cache(lfse),
+          lfsen_cache(lfsen),
+          cell_mapper(egfs_.gridView()),
+          el_view(el,1.0),
+          en_view(en,1.0)
+      {}
+
+      //! Query methods for the global grid assembler
+      //! @{
+      bool requireSkeleton() const
+      { return BaseT::requireSkeleton() || ELOP::doAlphaSkeleton; }
+      bool requireSkeletonTwoSided() const
+      { return BaseT::requireSkeletonTwoSided() || ELOP::doSkeletonTwoSided; }
+      bool requireUVVolume() const
+      { return BaseT::requireUVVolume() || ELOP::doAlphaVolume; }
+      bool requireUVSkeleton() const
+      { return BaseT::requireUVSkeleton() || ELOP::doAlphaSkeleton; }
+      bool requireUVBoundary() const
+      { return BaseT::requireUVBoundary() || ELOP::doAlphaBoundary; }
+      bool requireUVVolumePostSkeleton() const
+      { return BaseT::requireUVVolumePostSkeleton() || ELOP::doAlphaVolumePostSkeleton; }
+      //! @}
+
+      //! Set current estimate vector. Should be called prior to
+      //! assembling.
+      void setEstimate(Estimate & estimate_){
+        global_el_view.attach(estimate_);
+        global_en_view.attach(estimate_);
+      }
+
+      //! Called immediately after binding of local function space in
+      //! global assembler.
+      //! @{
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void onBindLFSUV(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        BaseT::onBindLFSUV(eg,lfsu_cache,lfsv_cache);
+        lfse.bind(eg.entity());
+        lfse_cache.update();
+        global_el_view.bind(lfse_cache);
+        el.assign(lfse_cache.size(),0.0);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onBindLFSUVOutside(const IG & ig,
+                              const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        BaseT::onBindLFSUVOutside(ig,lfsu_s_cache,lfsv_s_cache,lfsu_n_cache,lfsv_n_cache);
+        lfsen.bind(*(ig.outside()));
+        lfsen_cache.update();
+        global_en_view.bind(lfsen_cache);
+        en.assign(lfsen_cache.size(),0.0);
+      }
+      //! @}
+
+      //! Called when the local function space is about to be rebound or
+      //! discarded
+      //! @{
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void onUnbindLFSUV(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        global_el_view.add(el);
+        global_el_view.commit();
+        BaseT::onUnbindLFSUV(eg,lfsu_cache,lfsv_cache);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onUnbindLFSUVOutside(const IG & ig,
+                                const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                                const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        global_en_view.add(en);
+        global_en_view.commit();
+        BaseT::onUnbindLFSUVOutside(ig,lfsu_s_cache,lfsv_s_cache,lfsu_n_cache,lfsv_n_cache);
+      }
+      //! @}
+
+      //! Assembling methods
+      //! @{
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolume(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        BaseT::assembleUVVolume(eg,lfsu_cache,lfsv_cache);
+        Dune::PDELab::LocalAssemblerCallSwitch<ELOP,ELOP::doAlphaVolume>::
+          alpha_volume(elop,eg,lfsu_cache.localFunctionSpace(),xl,lfse,el_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVSkeleton(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        if (LOP::doSkeletonTwoSided || firstVisit(ig))
+          BaseT::assembleUVSkeleton(ig,lfsu_s_cache,lfsv_s_cache,lfsu_n_cache,lfsv_n_cache);
+        if (ELOP::doSkeletonTwoSided || firstVisit(ig))
+          Dune::PDELab::LocalAssemblerCallSwitch<ELOP,ELOP::doAlphaSkeleton>::
+            alpha_skeleton(elop,ig,
+                           lfsu_s_cache.localFunctionSpace(),xl,lfse,
+                           lfsu_n_cache.localFunctionSpace(),xn,lfsen,
+                           el_view,en_view);
+      }
+
+      template<typename IG, typename LFSVC>
+      void assembleVSkeleton(const IG & ig, const LFSVC & lfsv_s_cache, const LFSVC & lfsv_n_cache)
+      {
+        if (LOP::doSkeletonTwoSided || firstVisit(ig))
+          BaseT::assembleVSkeleton(ig,lfsv_s_cache,lfsv_n_cache);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVBoundary(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache)
+      {
+        BaseT::assembleUVBoundary(ig,lfsu_s_cache,lfsv_s_cache);
+        Dune::PDELab::LocalAssemblerCallSwitch<ELOP,ELOP::doAlphaBoundary>::
+          alpha_boundary(elop,ig,lfsu_s_cache.localFunctionSpace(),xl,lfse,el_view);
+      }
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolumePostSkeleton(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        BaseT::assembleUVVolumePostSkeleton(eg,lfsu_cache,lfsv_cache);
+        Dune::PDELab::LocalAssemblerCallSwitch<ELOP,ELOP::doAlphaVolumePostSkeleton>::
+          alpha_volume_post_skeleton(elop,eg,lfsu_cache.localFunctionSpace(),xl,lfse,el_view);
+      }
+
+      //! @}
+
+    private:
+
+      //! Whether the intersection is visited from the cell the global
+      //! assembler uses for one-sided skeleton integration
+      template<typename IG>
+      bool firstVisit(const IG & ig) const
+      {
+        return cell_mapper.map(*(ig.inside())) > cell_mapper.map(*(ig.outside()));
+      }
+
+      //! Reference to the estimator local operator
+      const ELOP & elop;
+
+      //! The local function spaces of the estimate and their caches
+      LFSE lfse;
+      LFSE lfsen;
+      LFSECache lfse_cache;
+      LFSECache lfsen_cache;
+
+      //! Maps cells to the ids used by the global assembler
+      ElementMapper<GV> cell_mapper;
+
+      //! Views of the current estimate vector
+      EstimateView global_el_view;
+      EstimateView global_en_view;
+
+      typedef Dune::PDELab::LocalVector<EstimateElement, TestSpaceTag, EstimateElement> EstimateVector;
+
+      //! Inside local estimate
+      EstimateVector el;
+      //! Outside local estimate
+      EstimateVector en;
+      //! Inside local estimate view
+      typename EstimateVector::WeightedAccumulationView el_view;
+      //! Outside local estimate view
+      typename EstimateVector::WeightedAccumulationView en_view;
+
+    }; // End of class DefaultLocalResidualEstimatorAssemblerEngine
+
+  }
+}
+#endif
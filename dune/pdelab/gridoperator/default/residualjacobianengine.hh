@@ -0,0 +1,545 @@
+#ifndef DUNE_PDELAB_DEFAULT_RESIDUALJACOBIANENGINE_HH
+#define DUNE_PDELAB_DEFAULT_RESIDUALJACOBIANENGINE_HH
+
+#include <type_traits>
+
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/gridfunctionspace/localvector.hh>
+#include <dune/pdelab/gridfunctionspace/staticlocalsize.hh>
+#include <dune/pdelab/gridoperator/common/localmatrix.hh>
+#include <dune/pdelab/gridoperator/common/diagonallocalmatrix.hh>
+#include <dune/pdelab/gridoperator/common/assemblerutilities.hh>
+#include <dune/pdelab/gridoperator/common/localassemblerenginebase.hh>
+#include <dune/pdelab/localoperator/callswitch.hh>
+#include <dune/pdelab/localoperator/flags.hh>
+
+namespace Dune{
+  namespace PDELab{
+
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // Calls the joint alpha_and_jacobian_*() methods of local operators
+      // derived from lop::AlphaAndJacobian and the separate alpha_*() and
+      // jacobian_*() methods otherwise.
+      template<typename LOP, bool doIt,
+               bool joint = std::is_base_of<lop::AlphaAndJacobian,LOP>::value>
+      struct AlphaAndJacobianCallSwitch
+      {
+        template<typename EG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void volume(const LOP& lop, const EG& eg,
+                           const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                           R& r, M& mat)
+        {}
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void skeleton(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             const LFSU& lfsu_n, const X& x_n, const LFSV& lfsv_n,
+                             R& r_s, R& r_n,
+                             M& mat_ss, M& mat_sn, M& mat_ns, M& mat_nn)
+        {}
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void boundary(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             R& r_s, M& mat_ss)
+        {}
+      };
+
+      template<typename LOP>
+      struct AlphaAndJacobianCallSwitch<LOP,true,false>
+      {
+        template<typename EG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void volume(const LOP& lop, const EG& eg,
+                           const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                           R& r, M& mat)
+        {
+          lop.alpha_volume(eg,lfsu,x,lfsv,r);
+          lop.jacobian_volume(eg,lfsu,x,lfsv,mat);
+        }
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void skeleton(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             const LFSU& lfsu_n, const X& x_n, const LFSV& lfsv_n,
+                             R& r_s, R& r_n,
+                             M& mat_ss, M& mat_sn, M& mat_ns, M& mat_nn)
+        {
+          lop.alpha_skeleton(ig,lfsu_s,x_s,lfsv_s,lfsu_n,x_n,lfsv_n,r_s,r_n);
+          lop.jacobian_skeleton(ig,lfsu_s,x_s,lfsv_s,lfsu_n,x_n,lfsv_n,mat_ss,mat_sn,mat_ns,mat_nn);
+        }
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void boundary(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             R& r_s, M& mat_ss)
+        {
+          lop.alpha_boundary(ig,lfsu_s,x_s,lfsv_s,r_s);
+          lop.jacobian_boundary(ig,lfsu_s,x_s,lfsv_s,mat_ss);
+        }
+      };
+
+      template<typename LOP>
+      struct AlphaAndJacobianCallSwitch<LOP,true,true>
+      {
+        template<typename EG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void volume(const LOP& lop, const EG& eg,
+                           const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                           R& r, M& mat)
+        {
+          lop.alpha_and_jacobian_volume(eg,lfsu,x,lfsv,r,mat);
+        }
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void skeleton(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             const LFSU& lfsu_n, const X& x_n, const LFSV& lfsv_n,
+                             R& r_s, R& r_n,
+                             M& mat_ss, M& mat_sn, M& mat_ns, M& mat_nn)
+        {
+          lop.alpha_and_jacobian_skeleton(ig,lfsu_s,x_s,lfsv_s,lfsu_n,x_n,lfsv_n,
+                                          r_s,r_n,mat_ss,mat_sn,mat_ns,mat_nn);
+        }
+
+        template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+        static void boundary(const LOP& lop, const IG& ig,
+                             const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                             R& r_s, M& mat_ss)
+        {
+          lop.alpha_and_jacobian_boundary(ig,lfsu_s,x_s,lfsv_s,r_s,mat_ss);
+        }
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
+    /**
+       \brief The local assembler engine for DUNE grids which
+       assembles the residual vector and the jacobian matrix in a
+       single sweep
+
+       Compared to separate calls to the residual and the jacobian
+       engine, this engine binds the local function spaces, updates
+       the index caches and loads the local coefficients only once per
+       element and intersection. Local operators deriving from
+       lop::AlphaAndJacobian can additionally share work between the
+       residual and the jacobian within their alpha_and_jacobian_*()
+       methods.
+
+       \tparam LA The local assembler
+
+    */
+    template<typename LA>
+    class DefaultLocalResidualJacobianAssemblerEngine
+      : public LocalAssemblerEngineBase
+    {
+    public:
+
+      template<typename TrialConstraintsContainer, typename TestConstraintsContainer>
+      bool needsConstraintsCaching(const TrialConstraintsContainer& cu, const TestConstraintsContainer& cv)
+      {
+        return cu.containsNonDirichletConstraints() || cv.containsNonDirichletConstraints();
+      }
+
+      //! The type of the wrapping local assembler
+      typedef LA LocalAssembler;
+
+      //! The type of the local operator
+      typedef typename LA::LocalOperator LOP;
+
+      //! The local function spaces
+      typedef typename LA::LFSU LFSU;
+      typedef typename LA::LFSUCache LFSUCache;
+      typedef typename LFSU::Traits::GridFunctionSpace GFSU;
+      typedef typename LA::LFSV LFSV;
+      typedef typename LA::LFSVCache LFSVCache;
+      typedef typename LFSV::Traits::GridFunctionSpace GFSV;
+
+      //! The type of the residual vector
+      typedef typename LA::Traits::Residual Residual;
+      typedef typename Residual::ElementType ResidualElement;
+      typedef typename Residual::template LocalView<LFSVCache> ResidualView;
+
+      //! The type of the jacobian matrix
+      typedef typename LA::Traits::Jacobian Jacobian;
+      typedef typename Jacobian::ElementType JacobianElement;
+      typedef typename Jacobian::template LocalView<LFSVCache,LFSUCache> JacobianView;
+
+      //! The type of the solution vector
+      typedef typename LA::Traits::Solution Solution;
+      typedef typename Solution::ElementType SolutionElement;
+      typedef typename Solution::template ConstLocalView<LFSUCache> SolutionView;
+
+      /**
+         \brief Constructor
+
+         \param [in] local_assembler_ The local assembler object which
+         creates this engine
+      */
+      DefaultLocalResidualJacobianAssemblerEngine(const LocalAssembler & local_assembler_)
+        : local_assembler(local_assembler_), lop(local_assembler_.lop),
+          rl_view(rl,1.0),
+          rn_view(rn,1.0),
+          al_view(al,1.0),
+          al_sn_view(al_sn,1.0),
+          al_ns_view(al_ns,1.0),
+          al_nn_view(al_nn,1.0)
+      {}
+
+      //! Query methods for the global grid assembler
+      //! @{
+      bool requireSkeleton() const
+      { return ( local_assembler.doAlphaSkeleton() || local_assembler.doLambdaSkeleton() ); }
+      bool requireSkeletonTwoSided() const
+      { return local_assembler.doSkeletonTwoSided(); }
+      bool requireUVVolume() const
+      { return local_assembler.doAlphaVolume(); }
+      bool requireVVolume() const
+      { return local_assembler.doLambdaVolume(); }
+      bool requireUVSkeleton() const
+      { return local_assembler.doAlphaSkeleton(); }
+      bool requireVSkeleton() const
+      { return local_assembler.doLambdaSkeleton(); }
+      bool requireUVBoundary() const
+      { return local_assembler.doAlphaBoundary(); }
+      bool requireVBoundary() const
+      { return local_assembler.doLambdaBoundary(); }
+      bool requireUVVolumePostSkeleton() const
+      { return local_assembler.doAlphaVolumePostSkeleton(); }
+      bool requireVVolumePostSkeleton() const
+      { return local_assembler.doLambdaVolumePostSkeleton(); }
+      //! @}
+
+      //! Public access to the wrapping local assembler
+      const LocalAssembler & localAssembler() const { return local_assembler; }
+
+      //! Trial space constraints
+      const typename LocalAssembler::Traits::TrialGridFunctionSpaceConstraints& trialConstraints() const
+      {
+        return localAssembler().trialConstraints();
+      }
+
+      //! Test space constraints
+      const typename LocalAssembler::Traits::TestGridFunctionSpaceConstraints& testConstraints() const
+      {
+        return localAssembler().testConstraints();
+      }
+
+      //! Set current residual vector. Should be called prior to
+      //! assembling.
+      void setResidual(Residual & residual_){
+        global_rl_view.attach(residual_);
+        global_rn_view.attach(residual_);
+      }
+
+      //! Set current jacobian matrix. Should be called prior to
+      //! assembling.
+      void setJacobian(Jacobian & jacobian_){
+        global_a_ss_view.attach(jacobian_);
+        global_a_sn_view.attach(jacobian_);
+        global_a_ns_view.attach(jacobian_);
+        global_a_nn_view.attach(jacobian_);
+      }
+
+      //! Set current solution vector. Should be called prior to
+      //! assembling.
+      void setSolution(const Solution & solution_){
+        global_s_s_view.attach(solution_);
+        global_s_n_view.attach(solution_);
+      }
+
+      //! Called immediately after binding of local function space in
+      //! global assembler.
+      //! @{
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void onBindLFSUV(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        global_s_s_view.bind(lfsu_cache);
+        xl.resize(lfsu_cache.size());
+        global_a_ss_view.bind(lfsv_cache,lfsu_cache);
+        al.assign(lfsv_cache.size(),lfsu_cache.size(),0.0);
+      }
+
+      template<typename EG, typename LFSVC>
+      void onBindLFSV(const EG & eg, const LFSVC & lfsv_cache){
+        global_rl_view.bind(lfsv_cache);
+        rl.assign(lfsv_cache.size(),0.0);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onBindLFSUVOutside(const IG & ig,
+                              const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        global_s_n_view.bind(lfsu_n_cache);
+        xn.resize(lfsu_n_cache.size());
+        global_a_sn_view.bind(lfsv_s_cache,lfsu_n_cache);
+        al_sn.assign(lfsv_s_cache.size(),lfsu_n_cache.size(),0.0);
+        global_a_ns_view.bind(lfsv_n_cache,lfsu_s_cache);
+        al_ns.assign(lfsv_n_cache.size(),lfsu_s_cache.size(),0.0);
+        global_a_nn_view.bind(lfsv_n_cache,lfsu_n_cache);
+        al_nn.assign(lfsv_n_cache.size(),lfsu_n_cache.size(),0.0);
+      }
+
+      template<typename IG, typename LFSVC>
+      void onBindLFSVOutside(const IG & ig,
+                             const LFSVC & lfsv_s_cache,
+                             const LFSVC & lfsv_n_cache)
+      {
+        global_rn_view.bind(lfsv_n_cache);
+        rn.assign(lfsv_n_cache.size(),0.0);
+      }
+
+      //! @}
+
+      //! Called when the local function space is about to be rebound or
+      //! discarded
+      //! @{
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void onUnbindLFSUV(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache){
+        local_assembler.scatter_jacobian(al,global_a_ss_view,false);
+      }
+
+      template<typename EG, typename LFSVC>
+      void onUnbindLFSV(const EG & eg, const LFSVC & lfsv_cache){
+        global_rl_view.add(rl);
+        global_rl_view.commit();
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void onUnbindLFSUVOutside(const IG & ig,
+                                const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                                const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        local_assembler.scatter_jacobian(al_sn,global_a_sn_view,false);
+        local_assembler.scatter_jacobian(al_ns,global_a_ns_view,false);
+        local_assembler.scatter_jacobian(al_nn,global_a_nn_view,false);
+      }
+
+      template<typename IG, typename LFSVC>
+      void onUnbindLFSVOutside(const IG & ig,
+                               const LFSVC & lfsv_s_cache,
+                               const LFSVC & lfsv_n_cache)
+      {
+        global_rn_view.add(rn);
+        global_rn_view.commit();
+      }
+      //! @}
+
+      //! Methods for loading of the local function's coefficients
+      //! @{
+      template<typename LFSUC>
+      void loadCoefficientsLFSUInside(const LFSUC & lfsu_cache){
+        global_s_s_view.read(xl);
+      }
+      template<typename LFSUC>
+      void loadCoefficientsLFSUOutside(const LFSUC & lfsu_n_cache){
+        global_s_n_view.read(xn);
+      }
+      template<typename LFSUC>
+      void loadCoefficientsLFSUCoupling(const LFSUC & lfsu_c_cache)
+      {DUNE_THROW(Dune::NotImplemented,"No coupling lfsu_cache available for ");}
+      //! @}
+
+      //! Notifier functions, called immediately before and after assembling
+      //! @{
+      void postAssembly(const GFSU& gfsu, const GFSV& gfsv){
+        Residual& residual = global_rl_view.container();
+        Jacobian& jacobian = global_a_ss_view.container();
+        global_s_s_view.detach();
+        global_s_n_view.detach();
+        global_rl_view.detach();
+        global_rn_view.detach();
+        global_a_ss_view.detach();
+        global_a_sn_view.detach();
+        global_a_ns_view.detach();
+        global_a_nn_view.detach();
+
+        if(local_assembler.doPostProcessing){
+          Dune::PDELab::constrain_residual(*(local_assembler.pconstraintsv),residual);
+          local_assembler.handle_dirichlet_constraints(gfsv,jacobian);
+        }
+      }
+      //! @}
+
+      //! Assembling methods
+      //! @{
+
+      /** Assemble on a given cell without function spaces.
+
+          \return If true, the assembling for this cell is assumed to
+          be complete and the assembler continues with the next grid
+          cell.
+       */
+      template<typename EG>
+      bool assembleCell(const EG & eg)
+      {
+        return LocalAssembler::isNonOverlapping && eg.entity().partitionType() != Dune::InteriorEntity;
+      }
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolume(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        al_view.setWeight(local_assembler.weight);
+        impl::AlphaAndJacobianCallSwitch<LOP,LOP::doAlphaVolume>::
+          volume(lop,eg,lfsu_cache.localFunctionSpace(),xl,lfsv_cache.localFunctionSpace(),rl_view,al_view);
+      }
+
+      template<typename EG, typename LFSVC>
+      void assembleVVolume(const EG & eg, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doLambdaVolume>::
+          lambda_volume(lop,eg,lfsv_cache.localFunctionSpace(),rl_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVSkeleton(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                              const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        rn_view.setWeight(local_assembler.weight);
+        al_view.setWeight(local_assembler.weight);
+        al_sn_view.setWeight(local_assembler.weight);
+        al_ns_view.setWeight(local_assembler.weight);
+        al_nn_view.setWeight(local_assembler.weight);
+        impl::AlphaAndJacobianCallSwitch<LOP,LOP::doAlphaSkeleton>::
+          skeleton(lop,ig,
+                   lfsu_s_cache.localFunctionSpace(),xl,lfsv_s_cache.localFunctionSpace(),
+                   lfsu_n_cache.localFunctionSpace(),xn,lfsv_n_cache.localFunctionSpace(),
+                   rl_view,rn_view,al_view,al_sn_view,al_ns_view,al_nn_view);
+      }
+
+      template<typename IG, typename LFSVC>
+      void assembleVSkeleton(const IG & ig, const LFSVC & lfsv_s_cache, const LFSVC & lfsv_n_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        rn_view.setWeight(local_assembler.weight);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doLambdaSkeleton>::
+          lambda_skeleton(lop, ig, lfsv_s_cache.localFunctionSpace(), lfsv_n_cache.localFunctionSpace(), rl_view, rn_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      void assembleUVBoundary(const IG & ig, const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        al_view.setWeight(local_assembler.weight);
+        impl::AlphaAndJacobianCallSwitch<LOP,LOP::doAlphaBoundary>::
+          boundary(lop,ig,lfsu_s_cache.localFunctionSpace(),xl,lfsv_s_cache.localFunctionSpace(),rl_view,al_view);
+      }
+
+      template<typename IG, typename LFSVC>
+      void assembleVBoundary(const IG & ig, const LFSVC & lfsv_s_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doLambdaBoundary>::
+          lambda_boundary(lop,ig,lfsv_s_cache.localFunctionSpace(),rl_view);
+      }
+
+      template<typename IG, typename LFSUC, typename LFSVC>
+      static void assembleUVEnrichedCoupling(const IG & ig,
+                                             const LFSUC & lfsu_s_cache, const LFSVC & lfsv_s_cache,
+                                             const LFSUC & lfsu_n_cache, const LFSVC & lfsv_n_cache,
+                                             const LFSUC & lfsu_coupling_cache, const LFSVC & lfsv_coupling_cache)
+      {DUNE_THROW(Dune::NotImplemented,"Assembling of coupling spaces is not implemented for ");}
+
+      template<typename IG, typename LFSVC>
+      static void assembleVEnrichedCoupling(const IG & ig,
+                                            const LFSVC & lfsv_s_cache,
+                                            const LFSVC & lfsv_n_cache,
+                                            const LFSVC & lfsv_coupling_cache)
+      {DUNE_THROW(Dune::NotImplemented,"Assembling of coupling spaces is not implemented for ");}
+
+      template<typename EG, typename LFSUC, typename LFSVC>
+      void assembleUVVolumePostSkeleton(const EG & eg, const LFSUC & lfsu_cache, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        al_view.setWeight(local_assembler.weight);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doAlphaVolumePostSkeleton>::
+          alpha_volume_post_skeleton(lop,eg,lfsu_cache.localFunctionSpace(),xl,lfsv_cache.localFunctionSpace(),rl_view);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doAlphaVolumePostSkeleton>::
+          jacobian_volume_post_skeleton(lop,eg,lfsu_cache.localFunctionSpace(),xl,lfsv_cache.localFunctionSpace(),al_view);
+      }
+
+      template<typename EG, typename LFSVC>
+      void assembleVVolumePostSkeleton(const EG & eg, const LFSVC & lfsv_cache)
+      {
+        rl_view.setWeight(local_assembler.weight);
+        Dune::PDELab::LocalAssemblerCallSwitch<LOP,LOP::doLambdaVolumePostSkeleton>::
+          lambda_volume_post_skeleton(lop,eg,lfsv_cache.localFunctionSpace(),rl_view);
+      }
+
+      //! @}
+
+    private:
+      //! Reference to the wrapping local assembler object which
+      //! constructed this engine
+      const LocalAssembler & local_assembler;
+
+      //! Reference to the local operator
+      const LOP & lop;
+
+      //! Pointer to the current solution vector for which to assemble
+      SolutionView global_s_s_view;
+      SolutionView global_s_n_view;
+
+      //! Pointer to the current residual vector in which to assemble
+      ResidualView global_rl_view;
+      ResidualView global_rn_view;
+
+      //! Pointer to the current jacobian matrix in which to assemble
+      JacobianView global_a_ss_view;
+      JacobianView global_a_sn_view;
+      JacobianView global_a_ns_view;
+      JacobianView global_a_nn_view;
+
+      //! The local vectors and matrices as required for assembling
+      //! @{
+      typedef Dune::PDELab::TrialSpaceTag LocalTrialSpaceTag;
+      typedef Dune::PDELab::TestSpaceTag LocalTestSpaceTag;
+
+      //! Fixed capacities of the local containers if the local sizes are known at compile time
+      typedef Dune::PDELab::StaticLocalContainerCapacity<GFSU,GFSV> LocalCapacity;
+
+      typedef Dune::PDELab::LocalVector<SolutionElement, LocalTrialSpaceTag, SolutionElement, LocalCapacity::trial> SolutionVector;
+      typedef Dune::PDELab::LocalVector<ResidualElement, LocalTestSpaceTag, ResidualElement, LocalCapacity::test> ResidualVector;
+      typedef typename std::conditional<
+        std::is_base_of<
+          lop::DiagonalJacobian,
+          LOP
+          >::value,
+        Dune::PDELab::DiagonalLocalMatrix<JacobianElement>,
+        Dune::PDELab::LocalMatrix<JacobianElement, JacobianElement, LocalCapacity::rows, LocalCapacity::cols>
+        >::type JacobianMatrix;
+
+      //! Inside local coefficients
+      SolutionVector xl;
+      //! Outside local coefficients
+      SolutionVector xn;
+      //! Inside local residual
+      ResidualVector rl;
+      //! Outside local residual
+      ResidualVector rn;
+
+      JacobianMatrix al;
+      JacobianMatrix al_sn;
+      JacobianMatrix al_ns;
+      JacobianMatrix al_nn;
+
+      typename ResidualVector::WeightedAccumulationView rl_view;
+      typename ResidualVector::WeightedAccumulationView rn_view;
+
+      typename JacobianMatrix::WeightedAccumulationView al_view;
+      typename JacobianMatrix::WeightedAccumulationView al_sn_view;
+      typename JacobianMatrix::WeightedAccumulationView al_ns_view;
+      typename JacobianMatrix::WeightedAccumulationView al_nn_view;
+      //! @}
+
+    }; // End of class DefaultLocalResidualJacobianAssemblerEngine
+
+  }
+}
+#endif
@@ -8,6 +8,7 @@
 #include <dune/pdelab/gridoperator/common/gridoperatorutilities.hh>
 #include <dune/pdelab/gridoperator/default/assembler.hh>
 #include <dune/pdelab/gridoperator/default/localassembler.hh>
+#include <dune/pdelab/gridoperator/default/residualestimatorengine.hh>
 
 namespace Dune{
   namespace PDELab{
@@ -175,6 +176,36 @@ namespace Dune{
         global_assembler.assemble(jacobian_engine);
       }
 
+      //! Assemble residual and jacobian in a single grid traversal
+      /**
+       * This is equivalent to calling residual() and jacobian() with the
+       * same x, but visits every element and intersection only once.
+       */
+      void residual_and_jacobian(const Domain & x, Range & r, Jacobian & a) const {
+        typedef typename LocalAssembler::LocalResidualJacobianAssemblerEngine ResidualJacobianEngine;
+        ResidualJacobianEngine & residual_jacobian_engine = local_assembler.localResidualJacobianAssemblerEngine(r,a,x);
+        global_assembler.assemble(residual_jacobian_engine);
+      }
+
+      //! Assemble residual and an element-wise error estimate in a single grid traversal
+      /**
+       * In addition to the residual, the alpha_*() methods of the estimator
+       * local operator elop are evaluated with the local coefficients of x
+       * and the test space egfs, which is expected to have a single DOF per
+       * cell (e.g. a P0 space). The result is accumulated into eta, giving
+       * the same values as residual() of a separate GridOperator from the
+       * trial space to egfs with elop as local operator.
+       */
+      template<typename ELOP, typename EGFS, typename EV>
+      void residual_and_estimate(const Domain & x, Range & r, const ELOP & elop, const EGFS & egfs, EV & eta) const {
+        typedef DefaultLocalResidualEstimatorAssemblerEngine<LocalAssembler,ELOP,EGFS,EV> ResidualEstimatorEngine;
+        ResidualEstimatorEngine residual_estimator_engine(local_assembler,elop,egfs);
+        residual_estimator_engine.setResidual(r);
+        residual_estimator_engine.setSolution(x);
+        residual_estimator_engine.setEstimate(eta);
+        global_assembler.assemble(residual_estimator_engine);
+      }
+
       //! Apply jacobian matrix without explicitly assembling it
       void jacobian_apply(const Domain & x, Range & r) const {
         typedef typename LocalAssembler::LocalJacobianApplyAssemblerEngine JacobianApplyEngine;
@@ -182,6 +213,20 @@ namespace Dune{
         global_assembler.assemble(jacobian_apply_engine);
       }
 
+      //! Apply the jacobian matrix evaluated at x to z without explicitly assembling it
+      /**
+       * In contrast to jacobian_apply(x,r), which is only meaningful for linear
+       * problems, this computes r += J(x) z also for nonlinear local operators.
+       * These have to implement the jacobian_apply_*() methods taking both the
+       * linearization point and the direction (see LocalOperatorInterface).
+       */
+      void jacobian_apply(const Domain & x, const Domain & z, Range & r) const {
+        typedef typename LocalAssembler::LocalNonlinearJacobianApplyAssemblerEngine NonlinearJacobianApplyEngine;
+        NonlinearJacobianApplyEngine & nonlinear_jacobian_apply_engine =
+          local_assembler.localNonlinearJacobianApplyAssemblerEngine(r,x,z);
+        global_assembler.assemble(nonlinear_jacobian_apply_engine);
+      }
+
       void make_consistent(Jacobian& a) const {
         dof_exchanger->accumulateBorderEntries(*this,a);
       }
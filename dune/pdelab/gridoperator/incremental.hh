@@ -0,0 +1,541 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_GRIDOPERATOR_INCREMENTAL_HH
+#define DUNE_PDELAB_GRIDOPERATOR_INCREMENTAL_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <dune/pdelab/common/elementmapper.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    /** \addtogroup GridOperator
+     *  \{
+     */
+
+    //! Local assembler engine that restricts another engine to a subset of the cells.
+    /**
+     * All calls are forwarded to the wrapped engine, except that assembleCell()
+     * reports the cells that are not selected as complete, so the global
+     * assembler skips them together with their intersections. Faces are
+     * still visited according to the usual rules of the assembler, i.e. a
+     * one-sided skeleton term is only evaluated if the cell that owns the
+     * face is selected.
+     *
+     * \tparam LAE The wrapped local assembler engine.
+     * \tparam GV  The grid view of the trial space.
+     */
+    template<typename LAE, typename GV>
+    class CellFilterLocalAssemblerEngine
+    {
+
+    public:
+
+      typedef typename LAE::Traits Traits;
+
+      /**
+       * \param engine The wrapped engine.
+       * \param cells  Non-zero for every cell (by its ElementMapper index) that is assembled.
+       * \param mapper The element mapper the cell flags refer to.
+       */
+      CellFilterLocalAssemblerEngine(LAE& engine, const std::vector<char>& cells, const ElementMapper<GV>& mapper)
+        : _engine(engine)
+        , _cells(cells)
+        , _mapper(mapper)
+      {}
+
+      template<typename TrialConstraintsContainer, typename TestConstraintsContainer>
+      bool needsConstraintsCaching(const TrialConstraintsContainer& cu, const TestConstraintsContainer& cv)
+      {
+        return _engine.needsConstraintsCaching(cu,cv);
+      }
+
+      //! Query methods for the global grid assembler
+      //! @{
+      bool requireSkeleton() const { return _engine.requireSkeleton(); }
+      bool requireSkeletonTwoSided() const { return _engine.requireSkeletonTwoSided(); }
+      bool requireUVVolume() const { return _engine.requireUVVolume(); }
+      bool requireVVolume() const { return _engine.requireVVolume(); }
+      bool requireUVSkeleton() const { return _engine.requireUVSkeleton(); }
+      bool requireVSkeleton() const { return _engine.requireVSkeleton(); }
+      bool requireUVBoundary() const { return _engine.requireUVBoundary(); }
+      bool requireVBoundary() const { return _engine.requireVBoundary(); }
+      bool requireUVProcessor() const { return _engine.requireUVProcessor(); }
+      bool requireVProcessor() const { return _engine.requireVProcessor(); }
+      bool requireUVEnrichedCoupling() const { return _engine.requireUVEnrichedCoupling(); }
+      bool requireVEnrichedCoupling() const { return _engine.requireVEnrichedCoupling(); }
+      bool requireUVVolumePostSkeleton() const { return _engine.requireUVVolumePostSkeleton(); }
+      bool requireVVolumePostSkeleton() const { return _engine.requireVVolumePostSkeleton(); }
+      //! @}
+
+      //! Notifications of the global assembler
+      //! @{
+      void preAssembly()
+      {
+        _engine.preAssembly();
+      }
+
+      template<typename GFSU, typename GFSV>
+      void postAssembly(const GFSU& gfsu, const GFSV& gfsv)
+      {
+        _engine.postAssembly(gfsu,gfsv);
+      }
+
+      template<typename EG, typename LFSU, typename LFSV>
+      void onBindLFSUV(const EG& eg, const LFSU& lfsu, const LFSV& lfsv)
+      {
+        _engine.onBindLFSUV(eg,lfsu,lfsv);
+      }
+
+      template<typename EG, typename LFSV>
+      void onBindLFSV(const EG& eg, const LFSV& lfsv)
+      {
+        _engine.onBindLFSV(eg,lfsv);
+      }
+
+      template<typename IG, typename LFSU_S, typename LFSV_S, typename LFSU_N, typename LFSV_N>
+      void onBindLFSUVOutside(const IG& ig,
+                              const LFSU_S& lfsu_s, const LFSV_S& lfsv_s,
+                              const LFSU_N& lfsu_n, const LFSV_N& lfsv_n)
+      {
+        _engine.onBindLFSUVOutside(ig,lfsu_s,lfsv_s,lfsu_n,lfsv_n);
+      }
+
+      template<typename IG, typename LFSV_S, typename LFSV_N>
+      void onBindLFSVOutside(const IG& ig, const LFSV_S& lfsv_s, const LFSV_N& lfsv_n)
+      {
+        _engine.onBindLFSVOutside(ig,lfsv_s,lfsv_n);
+      }
+
+      template<typename EG, typename LFSU, typename LFSV>
+      void onUnbindLFSUV(const EG& eg, const LFSU& lfsu, const LFSV& lfsv)
+      {
+        _engine.onUnbindLFSUV(eg,lfsu,lfsv);
+      }
+
+      template<typename EG, typename LFSV>
+      void onUnbindLFSV(const EG& eg, const LFSV& lfsv)
+      {
+        _engine.onUnbindLFSV(eg,lfsv);
+      }
+
+      template<typename IG, typename LFSU_S, typename LFSV_S, typename LFSU_N, typename LFSV_N>
+      void onUnbindLFSUVOutside(const IG& ig,
+                                const LFSU_S& lfsu_s, const LFSV_S& lfsv_s,
+                                const LFSU_N& lfsu_n, const LFSV_N& lfsv_n)
+      {
+        _engine.onUnbindLFSUVOutside(ig,lfsu_s,lfsv_s,lfsu_n,lfsv_n);
+      }
+
+      template<typename IG, typename LFSV_S, typename LFSV_N>
+      void onUnbindLFSVOutside(const IG& ig, const LFSV_S& lfsv_s, const LFSV_N& lfsv_n)
+      {
+        _engine.onUnbindLFSVOutside(ig,lfsv_s,lfsv_n);
+      }
+
+      template<typename LFSU>
+      void loadCoefficientsLFSUInside(const LFSU& lfsu_s)
+      {
+        _engine.loadCoefficientsLFSUInside(lfsu_s);
+      }
+
+      template<typename LFSU>
+      void loadCoefficientsLFSUOutside(const LFSU& lfsu_n)
+      {
+        _engine.loadCoefficientsLFSUOutside(lfsu_n);
+      }
+      //! @}
+
+      //! Assembling methods
+      //! @{
+
+      //! Skips all cells that are not selected.
+      template<typename EG>
+      bool assembleCell(const EG& eg)
+      {
+        return !_cells[_mapper.map(eg.entity())] || _engine.assembleCell(eg);
+      }
+
+      template<typename EG, typename LFSU, typename LFSV>
+      void assembleUVVolume(const EG& eg, const LFSU& lfsu, const LFSV& lfsv)
+      {
+        _engine.assembleUVVolume(eg,lfsu,lfsv);
+      }
+
+      template<typename EG, typename LFSV>
+      void assembleVVolume(const EG& eg, const LFSV& lfsv)
+      {
+        _engine.assembleVVolume(eg,lfsv);
+      }
+
+      template<typename IG, typename LFSU_S, typename LFSV_S, typename LFSU_N, typename LFSV_N>
+      void assembleUVSkeleton(const IG& ig, const LFSU_S& lfsu_s, const LFSV_S& lfsv_s,
+                              const LFSU_N& lfsu_n, const LFSV_N& lfsv_n)
+      {
+        _engine.assembleUVSkeleton(ig,lfsu_s,lfsv_s,lfsu_n,lfsv_n);
+      }
+
+      template<typename IG, typename LFSV_S, typename LFSV_N>
+      void assembleVSkeleton(const IG& ig, const LFSV_S& lfsv_s, const LFSV_N& lfsv_n)
+      {
+        _engine.assembleVSkeleton(ig,lfsv_s,lfsv_n);
+      }
+
+      template<typename IG, typename LFSU_S, typename LFSV_S>
+      void assembleUVBoundary(const IG& ig, const LFSU_S& lfsu_s, const LFSV_S& lfsv_s)
+      {
+        _engine.assembleUVBoundary(ig,lfsu_s,lfsv_s);
+      }
+
+      template<typename IG, typename LFSV_S>
+      void assembleVBoundary(const IG& ig, const LFSV_S& lfsv_s)
+      {
+        _engine.assembleVBoundary(ig,lfsv_s);
+      }
+
+      template<typename IG, typename LFSU_S, typename LFSV_S>
+      void assembleUVProcessor(const IG& ig, const LFSU_S& lfsu_s, const LFSV_S& lfsv_s)
+      {
+        _engine.assembleUVProcessor(ig,lfsu_s,lfsv_s);
+      }
+
+      template<typename IG, typename LFSV_S>
+      void assembleVProcessor(const IG& ig, const LFSV_S& lfsv_s)
+      {
+        _engine.assembleVProcessor(ig,lfsv_s);
+      }
+
+      template<typename EG, typename LFSU, typename LFSV>
+      void assembleUVVolumePostSkeleton(const EG& eg, const LFSU& lfsu, const LFSV& lfsv)
+      {
+        _engine.assembleUVVolumePostSkeleton(eg,lfsu,lfsv);
+      }
+
+      template<typename EG, typename LFSV>
+      void assembleVVolumePostSkeleton(const EG& eg, const LFSV& lfsv)
+      {
+        _engine.assembleVVolumePostSkeleton(eg,lfsv);
+      }
+      //! @}
+
+    private:
+
+      LAE& _engine;
+      const std::vector<char>& _cells;
+      const ElementMapper<GV>& _mapper;
+
+    };
+
+    //! Incremental residual and jacobian assembly for localized changes of the solution.
+    /**
+     * Keeps the residual and the jacobian of a GridOperator together with the
+     * coefficient vector they were assembled for. When residual() or
+     * jacobian() is called with a new coefficient vector, only the cells
+     * whose trial space contains a changed DOF and their face neighbours are
+     * processed: their contributions are assembled once with weight -1 for
+     * the old coefficients and once with weight 1 for the new ones, which
+     * replaces the stale local contributions in the cached container. This
+     * is exact because every volume, skeleton and boundary term that depends
+     * on a changed DOF is owned by one of these cells, while all other terms
+     * of the processed cells cancel.
+     *
+     * The changed DOFs are found by comparing the coefficient vector with the
+     * stored one. Alternatively, they can be announced with markDirty(), in
+     * which case the comparison is skipped and all other coefficients must
+     * be unchanged. The local operators are only evaluated on the processed
+     * cells; the grid is still traversed, but the other cells are skipped
+     * before their local function spaces are bound.
+     *
+     * \code
+     * IncrementalGridOperator<GO> igo(go);
+     * const GO::Traits::Range& r = igo.residual(x);  // full assembly
+     * x[i] += 1.0;
+     * igo.markDirty(i);                              // optional
+     * igo.residual(x);                               // only cells around DOF i
+     * \endcode
+     *
+     * \note The wrapped grid operator must have weight 1, i.e. it must not
+     *       be part of a OneStepGridOperator. Since the cached containers are
+     *       updated by differences, rounding errors accumulate over many
+     *       updates; invalidate() forces a complete assembly. The operator
+     *       is intended for sequential computations.
+     *
+     * \tparam GO The GridOperator.
+     */
+    template<typename GO>
+    class IncrementalGridOperator
+    {
+
+      typedef typename GO::Traits::TrialGridFunctionSpace GFSU;
+      typedef typename GFSU::Traits::GridViewType GV;
+      typedef typename GV::template Codim<0>::Iterator ElementIterator;
+      typedef typename GV::IntersectionIterator IntersectionIterator;
+      typedef LocalFunctionSpace<GFSU,TrialSpaceTag> LFSU;
+      typedef LFSIndexCache<LFSU> LFSUCache;
+
+    public:
+
+      typedef typename GO::Traits::Domain Domain;
+      typedef typename GO::Traits::Range Range;
+      typedef typename GO::Traits::Jacobian Jacobian;
+      typedef typename LFSUCache::ContainerIndex ContainerIndex;
+      typedef std::size_t size_type;
+
+      explicit IncrementalGridOperator(const GO& go)
+        : _go(go)
+        , _residual(go.testGridFunctionSpace(),go.trialGridFunctionSpace())
+        , _jacobian(go,go.trialGridFunctionSpace())
+        , _processed(0)
+      {
+        update();
+      }
+
+      //! Rebuilds the DOF-to-cell map after the grid or the function space has changed.
+      void update()
+      {
+        const GV& gv = _go.trialGridFunctionSpace().gridView();
+        _mapper = std::make_shared<ElementMapper<GV> >(gv);
+        _marked.assign(gv.size(0),0);
+        _marked_list.clear();
+
+        LFSU lfsu(_go.trialGridFunctionSpace());
+        LFSUCache lfsu_cache(lfsu);
+
+        // (DOF, cell) pairs and the face neighbours of each cell
+        std::vector<std::pair<ContainerIndex,size_type> > incidence;
+        std::vector<size_type> neighbor_count(gv.size(0),0);
+        std::vector<std::pair<size_type,size_type> > neighbor_pairs;
+        for (ElementIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+          {
+            const size_type cell = _mapper->map(*it);
+            lfsu.bind(*it);
+            lfsu_cache.update();
+            for (size_type i = 0; i < lfsu.size(); ++i)
+              incidence.push_back(std::make_pair(lfsu_cache.containerIndex(i),cell));
+
+            for (IntersectionIterator iit = gv.ibegin(*it); iit != gv.iend(*it); ++iit)
+              if (iit->neighbor())
+                neighbor_pairs.push_back(std::make_pair(cell,size_type(_mapper->map(*(iit->outside())))));
+          }
+
+        std::sort(incidence.begin(),incidence.end());
+        incidence.erase(std::unique(incidence.begin(),incidence.end()),incidence.end());
+        _dofs.clear();
+        _dof_offsets.clear();
+        _dof_cells.clear();
+        for (size_type k = 0; k < incidence.size(); ++k)
+          {
+            if (_dofs.empty() || !(_dofs.back() == incidence[k].first))
+              {
+                _dofs.push_back(incidence[k].first);
+                _dof_offsets.push_back(k);
+              }
+            _dof_cells.push_back(incidence[k].second);
+          }
+        _dof_offsets.push_back(incidence.size());
+
+        std::sort(neighbor_pairs.begin(),neighbor_pairs.end());
+        _neighbor_offsets.assign(gv.size(0)+1,0);
+        _neighbors.resize(neighbor_pairs.size());
+        for (size_type k = 0; k < neighbor_pairs.size(); ++k)
+          {
+            ++_neighbor_offsets[neighbor_pairs[k].first+1];
+            _neighbors[k] = neighbor_pairs[k].second;
+          }
+        for (size_type c = 0; c < size_type(gv.size(0)); ++c)
+          _neighbor_offsets[c+1] += _neighbor_offsets[c];
+
+        invalidate();
+      }
+
+      //! Discards the cached containers, the next call assembles them completely.
+      void invalidate()
+      {
+        _residual.valid = false;
+        _jacobian.valid = false;
+        _residual.dirty.clear();
+        _jacobian.dirty.clear();
+      }
+
+      //! Announces that the coefficient with container index i will change.
+      /**
+       * If any DOFs have been marked before the next call of residual() or
+       * jacobian(), only these are assumed to have changed, which avoids
+       * comparing the complete coefficient vector.
+       */
+      void markDirty(const ContainerIndex& i)
+      {
+        _residual.dirty.push_back(i);
+        _jacobian.dirty.push_back(i);
+      }
+
+      //! Returns the residual of x, reassembling only the cells affected by changed DOFs.
+      const Range& residual(const Domain& x)
+      {
+        refresh(_residual,x);
+        return _residual.container;
+      }
+
+      //! Returns the jacobian at x, reassembling only the cells affected by changed DOFs.
+      const Jacobian& jacobian(const Domain& x)
+      {
+        refresh(_jacobian,x);
+        return _jacobian.container;
+      }
+
+      //! Number of cells whose local operators were evaluated by the last call.
+      size_type processedCells() const
+      {
+        return _processed;
+      }
+
+      //! The wrapped grid operator.
+      const GO& gridOperator() const
+      {
+        return _go;
+      }
+
+    private:
+
+      template<typename C>
+      struct Cache
+      {
+        template<typename Arg>
+        Cache(const Arg& arg, const GFSU& gfsu)
+          : container(arg)
+          , x(gfsu,0.0)
+          , valid(false)
+        {}
+
+        C container;
+        Domain x;                             // coefficients the container belongs to
+        bool valid;
+        std::vector<ContainerIndex> dirty;    // DOFs announced by markDirty()
+      };
+
+      template<typename C>
+      void refresh(Cache<C>& cache, const Domain& x)
+      {
+        if (!cache.valid)
+          {
+            cache.container = 0.0;
+            assemble(cache.container,x,false);
+            cache.x = x;
+            cache.valid = true;
+            cache.dirty.clear();
+            _processed = _marked.size();
+            return;
+          }
+
+        // changed DOFs, given by their position in _dofs
+        std::vector<size_type> changed;
+        if (!cache.dirty.empty())
+          {
+            for (size_type k = 0; k < cache.dirty.size(); ++k)
+              {
+                const typename std::vector<ContainerIndex>::const_iterator it =
+                  std::lower_bound(_dofs.begin(),_dofs.end(),cache.dirty[k]);
+                if (it != _dofs.end() && *it == cache.dirty[k])
+                  changed.push_back(it - _dofs.begin());
+              }
+            cache.dirty.clear();
+          }
+        else
+          for (size_type p = 0; p < _dofs.size(); ++p)
+            if (x[_dofs[p]] != cache.x[_dofs[p]])
+              changed.push_back(p);
+
+        _processed = 0;
+        if (changed.empty())
+          return;
+
+        // cells containing a changed DOF and their face neighbours
+        for (size_type k = 0; k < changed.size(); ++k)
+          for (size_type j = _dof_offsets[changed[k]]; j < _dof_offsets[changed[k]+1]; ++j)
+            {
+              const size_type cell = _dof_cells[j];
+              mark(cell);
+              for (size_type l = _neighbor_offsets[cell]; l < _neighbor_offsets[cell+1]; ++l)
+                mark(_neighbors[l]);
+            }
+        _processed = _marked_list.size();
+
+        // replace the old contributions of these cells by the new ones
+        _go.localAssembler().setWeight(-1.0);
+        assemble(cache.container,cache.x,true);
+        _go.localAssembler().setWeight(1.0);
+        assemble(cache.container,x,true);
+        for (size_type k = 0; k < changed.size(); ++k)
+          cache.x[_dofs[changed[k]]] = x[_dofs[changed[k]]];
+
+        for (size_type k = 0; k < _marked_list.size(); ++k)
+          _marked[_marked_list[k]] = 0;
+        _marked_list.clear();
+      }
+
+      void mark(size_type cell)
+      {
+        if (_marked[cell])
+          return;
+        _marked[cell] = 1;
+        _marked_list.push_back(cell);
+      }
+
+      void assemble(Range& r, const Domain& x, bool filtered)
+      {
+        typedef typename GO::LocalAssembler::LocalResidualAssemblerEngine Engine;
+        Engine& engine = _go.localAssembler().localResidualAssemblerEngine(r,x);
+        if (!filtered)
+          _go.assembler().assemble(engine);
+        else
+          {
+            CellFilterLocalAssemblerEngine<Engine,GV> filter(engine,_marked,*_mapper);
+            _go.assembler().assemble(filter);
+          }
+      }
+
+      void assemble(Jacobian& a, const Domain& x, bool filtered)
+      {
+        typedef typename GO::LocalAssembler::LocalJacobianAssemblerEngine Engine;
+        Engine& engine = _go.localAssembler().localJacobianAssemblerEngine(a,x);
+        if (!filtered)
+          _go.assembler().assemble(engine);
+        else
+          {
+            CellFilterLocalAssemblerEngine<Engine,GV> filter(engine,_marked,*_mapper);
+            _go.assembler().assemble(filter);
+          }
+      }
+
+      const GO& _go;
+      std::shared_ptr<ElementMapper<GV> > _mapper;
+
+      // sorted trial DOFs, the cells containing each of them and the face neighbours of each cell
+      std::vector<ContainerIndex> _dofs;
+      std::vector<size_type> _dof_offsets;
+      std::vector<size_type> _dof_cells;
+      std::vector<size_type> _neighbor_offsets;
+      std::vector<size_type> _neighbors;
+
+      std::vector<char> _marked;
+      std::vector<size_type> _marked_list;
+
+      Cache<Range> _residual;
+      Cache<Jacobian> _jacobian;
+      size_type _processed;
+
+    };
+
+    //! \} group GridOperator
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_GRIDOPERATOR_INCREMENTAL_HH
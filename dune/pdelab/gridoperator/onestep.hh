@@ -165,6 +165,23 @@ namespace Dune{
         //printmatrix(std::cout,a.base(),"global stiffness matrix","row",9,1);
       }
 
+      //! Apply the jacobian matrix evaluated at x to z without explicitly assembling it
+      /**
+       * Computes r += J(x) z for the jacobian of the current stage, i.e. with the
+       * same weights of the temporal and spatial parts as jacobian(). The local
+       * operators of both subordinate grid operators have to implement the
+       * jacobian_apply_*() methods taking both the linearization point and the
+       * direction.
+       */
+      void jacobian_apply(const Domain & x, const Domain & z, Range & r) const {
+        if(!implicit){DUNE_THROW(Dune::Exception,"This function should not be called in explicit mode");}
+
+        typedef typename LocalAssembler::LocalNonlinearJacobianApplyAssemblerEngine NonlinearJacobianApplyEngine;
+        NonlinearJacobianApplyEngine & nonlinear_jacobian_apply_engine =
+          local_assembler.localNonlinearJacobianApplyAssemblerEngine(r,x,z);
+        global_assembler.assemble(nonlinear_jacobian_apply_engine);
+      }
+
       //! Assemble jacobian and residual simultaneously for explicit treatment
       void explicit_jacobian_residual(unsigned int stage, const std::vector<Domain*> & x,
                                       Jacobian & a, Range & r1, Range & r0)
@@ -6,6 +6,7 @@
 #include <dune/pdelab/gridoperator/onestep/residualengine.hh>
 #include <dune/pdelab/gridoperator/onestep/patternengine.hh>
 #include <dune/pdelab/gridoperator/onestep/jacobianengine.hh>
+#include <dune/pdelab/gridoperator/onestep/nonlinearjacobianapplyengine.hh>
 #include <dune/pdelab/gridoperator/onestep/prestageengine.hh>
 #include <dune/pdelab/gridoperator/onestep/jacobianresidualengine.hh>
 
@@ -51,6 +52,7 @@ namespace Dune{
       typedef OneStepLocalPreStageAssemblerEngine<OneStepLocalAssembler> LocalPreStageAssemblerEngine;
       typedef OneStepLocalResidualAssemblerEngine<OneStepLocalAssembler> LocalResidualAssemblerEngine;
       typedef OneStepLocalJacobianAssemblerEngine<OneStepLocalAssembler> LocalJacobianAssemblerEngine;
+      typedef OneStepLocalNonlinearJacobianApplyAssemblerEngine<OneStepLocalAssembler> LocalNonlinearJacobianApplyAssemblerEngine;
 
       typedef typename LA1::LocalPatternAssemblerEngine LocalExplicitPatternAssemblerEngine;
       typedef OneStepExplicitLocalJacobianResidualAssemblerEngine<OneStepLocalAssembler>
@@ -60,6 +62,7 @@ namespace Dune{
       friend class OneStepLocalPreStageAssemblerEngine<OneStepLocalAssembler>;
       friend class OneStepLocalResidualAssemblerEngine<OneStepLocalAssembler>;
       friend class OneStepLocalJacobianAssemblerEngine<OneStepLocalAssembler>;
+      friend class OneStepLocalNonlinearJacobianApplyAssemblerEngine<OneStepLocalAssembler>;
       friend class OneStepExplicitLocalJacobianResidualAssemblerEngine<OneStepLocalAssembler>;
       //! @}
 
@@ -95,6 +98,7 @@ namespace Dune{
           const_residual(const_residual_),
           time(0.0), dt_mode(MultiplyOperator0ByDT), stage(0),
           pattern_engine(*this), prestage_engine(*this), residual_engine(*this), jacobian_engine(*this),
+          nonlinear_jacobian_apply_engine(*this),
           explicit_jacobian_residual_engine(*this)
       { static_checks(); }
 
@@ -203,6 +207,17 @@ namespace Dune{
         return jacobian_engine;
       }
 
+      //! Returns a reference to the requested engine. This engine is
+      //! completely configured and ready to use.
+      LocalNonlinearJacobianApplyAssemblerEngine & localNonlinearJacobianApplyAssemblerEngine
+      (typename Traits::Residual & r, const typename Traits::Solution & x, const typename Traits::Solution & z)
+      {
+        nonlinear_jacobian_apply_engine.setLinearizationPoint(x);
+        nonlinear_jacobian_apply_engine.setSolution(z);
+        nonlinear_jacobian_apply_engine.setResidual(r);
+        return nonlinear_jacobian_apply_engine;
+      }
+
       //! Returns a reference to the requested engine. This engine is
       //! completely configured and ready to use.
       LocalExplicitPatternAssemblerEngine & localExplicitPatternAssemblerEngine
@@ -283,6 +298,7 @@ namespace Dune{
       LocalPreStageAssemblerEngine prestage_engine;
       LocalResidualAssemblerEngine residual_engine;
       LocalJacobianAssemblerEngine jacobian_engine;
+      LocalNonlinearJacobianApplyAssemblerEngine nonlinear_jacobian_apply_engine;
       LocalExplicitJacobianResidualAssemblerEngine explicit_jacobian_residual_engine;
       //! @}
     };
@@ -0,0 +1,155 @@
+#ifndef DUNE_ONE_STEP_NONLINEARJACOBIANAPPLYENGINE_HH
+#define DUNE_ONE_STEP_NONLINEARJACOBIANAPPLYENGINE_HH
+
+#include <dune/pdelab/gridoperator/onestep/enginebase.hh>
+#include <cmath>
+
+namespace Dune{
+  namespace PDELab{
+
+    /**
+       \brief The local assembler engine for one step methods which
+       applies the jacobian evaluated at a linearization point to a
+       vector without assembling it
+
+       \tparam LA The local one step assembler
+
+    */
+    template<typename OSLA>
+    class OneStepLocalNonlinearJacobianApplyAssemblerEngine
+      : public OneStepLocalAssemblerEngineBase<OSLA,
+                                               typename OSLA::LocalAssemblerDT0::LocalNonlinearJacobianApplyAssemblerEngine,
+                                               typename OSLA::LocalAssemblerDT1::LocalNonlinearJacobianApplyAssemblerEngine
+                                               >
+    {
+
+      typedef OneStepLocalAssemblerEngineBase<OSLA,
+                                              typename OSLA::LocalAssemblerDT0::LocalNonlinearJacobianApplyAssemblerEngine,
+                                              typename OSLA::LocalAssemblerDT1::LocalNonlinearJacobianApplyAssemblerEngine
+                                              > BaseT;
+
+      using BaseT::la;
+      using BaseT::lae0;
+      using BaseT::lae1;
+      using BaseT::implicit;
+      using BaseT::setLocalAssemblerEngineDT0;
+      using BaseT::setLocalAssemblerEngineDT1;
+    public:
+      //! The type of the wrapping local assembler
+      typedef OSLA LocalAssembler;
+
+      typedef typename OSLA::LocalAssemblerDT0 LocalAssemblerDT0;
+      typedef typename OSLA::LocalAssemblerDT1 LocalAssemblerDT1;
+
+      //! The type of the residual vector
+      typedef typename OSLA::Traits::Residual Residual;
+
+      //! The type of the solution vector
+      typedef typename OSLA::Traits::Solution Solution;
+
+      //! The type for real numbers
+      typedef typename OSLA::Real Real;
+
+      /**
+         \brief Constructor
+
+         \param [in] local_assembler_ The local assembler object which
+         creates this engine
+      */
+      OneStepLocalNonlinearJacobianApplyAssemblerEngine(const LocalAssembler & local_assembler_)
+        : BaseT(local_assembler_),
+          invalid_residual(static_cast<Residual*>(0)),
+          invalid_solution(static_cast<Solution*>(0)),
+          residual(invalid_residual),
+          linearization_point(invalid_solution), solution(invalid_solution)
+      {}
+
+      //! Set the point at which the jacobian is evaluated. Must be
+      //! called before setResidual().
+      void setLinearizationPoint(const Solution & linearization_point_){
+        linearization_point = &linearization_point_;
+      }
+
+      //! Set the vector the jacobian is applied to. Must be called
+      //! before setResidual().
+      void setSolution(const Solution & solution_){
+        solution = &solution_;
+      }
+
+      //! Set the vector to which the result is added. Should be called
+      //! prior to assembling.
+      void setResidual(Residual & residual_){
+        residual = &residual_;
+
+        assert(linearization_point != invalid_solution);
+        assert(solution != invalid_solution);
+
+        // Initialize the engines of the two wrapped local assemblers
+        setLocalAssemblerEngineDT0
+          (la.la0.localNonlinearJacobianApplyAssemblerEngine(*residual,*linearization_point,*solution));
+        setLocalAssemblerEngineDT1
+          (la.la1.localNonlinearJacobianApplyAssemblerEngine(*residual,*linearization_point,*solution));
+      }
+
+      //! When multiple engines are combined in one assembling
+      //! procedure, this method allows to reset the weights which may
+      //! have been changed by the other engines.
+      void setWeights(){
+        la.la0.setWeight(b_rr * la.dt_factor0);
+        la.la1.setWeight(la.dt_factor1);
+      }
+
+      //! Notifier functions, called immediately before and after assembling
+      //! @{
+      void preAssembly()
+      {
+        lae0->preAssembly();
+        lae1->preAssembly();
+
+        // Extract the coefficients of the time step scheme
+        b_rr = la.osp_method->b(la.stage,la.stage);
+        d_r = la.osp_method->d(la.stage);
+
+        // Here we only want to know whether this stage is implicit
+        implicit = std::abs(b_rr) > 1e-6;
+
+        // prepare local operators for stage
+        la.la0.setTime(la.time + d_r * la.dt);
+        la.la1.setTime(la.time + d_r * la.dt);
+
+        setWeights();
+      }
+
+      template<typename GFSU, typename GFSV>
+      void postAssembly(const GFSU& gfsu, const GFSV& gfsv){
+        lae0->postAssembly(gfsu,gfsv);
+        lae1->postAssembly(gfsu,gfsv);
+      }
+      //! @}
+
+    private:
+
+      //! Default value indicating an invalid residual pointer
+      Residual * const invalid_residual;
+
+      //! Default value indicating an invalid solution pointer
+      Solution * const invalid_solution;
+
+      //! Pointer to the vector to which the result is added
+      Residual * residual;
+
+      //! Pointer to the point at which the jacobian is evaluated
+      const Solution * linearization_point;
+
+      //! Pointer to the vector the jacobian is applied to
+      const Solution * solution;
+
+      //! Coefficients of time stepping scheme
+      Real b_rr, d_r;
+
+    }; // End of class OneStepLocalNonlinearJacobianApplyAssemblerEngine
+
+  }
+}
+
+#endif
@@ -0,0 +1,1153 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+#ifndef DUNE_PDELAB_INSTATIONARY_LINEARHYPERBOLICDG_HH
+#define DUNE_PDELAB_INSTATIONARY_LINEARHYPERBOLICDG_HH
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/dynmatrix.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/pdelab/backend/solver.hh>
+#include <dune/pdelab/common/elementmapper.hh>
+#include <dune/pdelab/finiteelementmap/qkdggl.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+#include <dune/pdelab/gridoperator/common/assemblerutilities.hh>
+#include <dune/pdelab/gridoperator/common/timesteppingparameterinterface.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    /**
+     *  @addtogroup OneStepMethod
+     *  @{
+     */
+
+    template<typename Engine>
+    class LinearHyperbolicDGMassOperator;
+
+    //! Matrix-free explicit DG discretization of a linear hyperbolic system
+    /**
+     * Discretizes M du/dt + A u = 0 for a system
+     * \f[ \partial_t u + \sum_j \partial_j (A_j u) + S u = q \f]
+     * with upwind fluxes, in the same way as DGLinearAcousticsSpatialOperator
+     * and DGMaxwellSpatialOperator combined with their temporal operators.
+     * Instead of going through the generic assemblers, all data that does
+     * not depend on the solution is computed once in update():
+     *
+     * - the local mass matrix, its inverse and the derivative operators
+     *   \f$ G^j_{kp} = \int_T \partial_j\phi_k \phi_p \f$ of every cell,
+     * - the flux matrices A_j and S of every cell,
+     * - the flux projectors A_plus and A_minus, the quadrature weights and
+     *   the basis functions at the quadrature points of every face.
+     *
+     * Each evaluation of the spatial operator is a single sweep over the
+     * cells that applies the volume terms of a cell together with the faces
+     * it owns, working on a cell-wise copy of the coefficients. No matrix is
+     * assembled, the block diagonal mass matrix is inverted cell by cell.
+     *
+     * The class provides the part of the interface of OneStepGridOperator
+     * used by ExplicitOneStepMethod and CFLTimeController, so it can replace
+     * the instationary grid operator of an explicit scheme:
+     * \code
+     * typedef LinearHyperbolicDGOperator<GFS,LinearAcousticsSystem<Param> > IGOS;
+     * IGOS igos(gfs,system);
+     * LinearHyperbolicDGMassSolver ls;
+     * CFLTimeController<double,IGOS> tc(0.9,igos);
+     * ExplicitOneStepMethod<double,IGOS,LinearHyperbolicDGMassSolver,V,V,
+     *                       CFLTimeController<double,IGOS> > osm(method,igos,ls,tc);
+     * \endcode
+     * update() has to be called whenever the grid, the function space or the
+     * coefficients of the system change.
+     *
+     * For QkDGGL spaces, passing gaussLobattoCollocation to the constructor
+     * selects a spectral element variant: all integrals are evaluated with
+     * the Gauss-Lobatto rule at the nodes of the basis. The mass matrix
+     * becomes diagonal and is stored as one value per node, the solution is
+     * read directly from the nodal coefficients and the volume terms apply
+     * the 1D differentiation matrix direction by direction. Each evaluation
+     * then costs O(k+1) operations per DOF instead of O((k+1)^d), and no
+     * local matrix is inverted. The nodal quadrature is not exact for the
+     * mass matrix, so the results differ from exactQuadrature by the usual
+     * mass lumping error. All cells have to use the same degree k >= 1 and
+     * the grid has to be conforming.
+     *
+     * \note The space must be a power space with System::m identical scalar
+     *       DG components (Galerkin method). The operator only supports
+     *       sequential computations, update() throws Dune::NotImplemented
+     *       for grid views on several processes or with processor boundaries.
+     *
+     * \tparam GFS    The grid function space.
+     * \tparam System Description of the system, e.g. LinearAcousticsSystem or
+     *                MaxwellSystem. It provides the flux matrices of a cell,
+     *                the flux projectors of interior and boundary faces, the
+     *                boundary state, the source term and the maximal wave speed.
+     */
+    template<typename GFS, typename System>
+    class LinearHyperbolicDGOperator
+    {
+
+      typedef typename GFS::Traits::GridViewType GV;
+      typedef typename GV::template Codim<0>::Iterator ElementIterator;
+      typedef typename GV::IntersectionIterator IntersectionIterator;
+      typedef typename GV::Intersection Intersection;
+      typedef typename GV::template Codim<0>::Entity Element;
+
+      typedef LocalFunctionSpace<GFS> LFS;
+      typedef LFSIndexCache<LFS> LFSCache;
+      typedef typename LFS::template Child<0>::Type ChildLFS;
+      typedef typename ChildLFS::Traits::FiniteElementType::Traits::LocalBasisType LocalBasis;
+      typedef typename LocalBasis::Traits::RangeType RangeType;
+      typedef typename LocalBasis::Traits::JacobianType JacobianType;
+
+      enum { dim = GV::dimension };
+      enum { m = System::m };
+
+      static_assert(int(System::dim) == int(dim),
+                    "dimension of the system does not match the grid");
+      static_assert(int(GFS::CHILDREN) == int(m),
+                    "LinearHyperbolicDGOperator needs a power space with System::m components");
+
+    public:
+
+      typedef typename System::RF Real;
+      typedef typename System::DF DF;
+      typedef typename System::Matrix Matrix;
+      typedef typename System::State State;
+      typedef typename LFSCache::ContainerIndex ContainerIndex;
+      typedef std::size_t size_type;
+
+      typedef GFS TrialGridFunctionSpace;
+      typedef GFS TestGridFunctionSpace;
+
+      //! The "matrix" ExplicitOneStepMethod passes to the linear solver.
+      template<typename E>
+      struct MatrixContainer
+      {
+        typedef LinearHyperbolicDGMassOperator<LinearHyperbolicDGOperator> Type;
+      };
+
+      //! How the cell and face integrals are evaluated.
+      enum Integration {
+        //! Quadrature of order 2k + overintegration, dense local mass matrices.
+        exactQuadrature,
+        //! Spectral element collocation at the Gauss-Lobatto nodes of a QkDGGL space.
+        gaussLobattoCollocation
+      };
+
+      LinearHyperbolicDGOperator(const GFS& gfs, System& system, int overintegration = 0)
+        : _gfs(gfs)
+        , _system(system)
+        , _integration(exactQuadrature)
+        , _overintegration(overintegration)
+        , _method(0)
+        , _time(0.0)
+        , _dt(0.0)
+        , _cfl_dt(std::numeric_limits<Real>::max())
+        , _gl_size(0)
+      {
+        update();
+      }
+
+      LinearHyperbolicDGOperator(const GFS& gfs, System& system, Integration integration, int overintegration = 0)
+        : _gfs(gfs)
+        , _system(system)
+        , _integration(integration)
+        , _overintegration(overintegration)
+        , _method(0)
+        , _time(0.0)
+        , _dt(0.0)
+        , _cfl_dt(std::numeric_limits<Real>::max())
+        , _gl_size(0)
+      {
+        update();
+      }
+
+      //! Returns how the integrals are evaluated.
+      Integration integration() const
+      {
+        return _integration;
+      }
+
+      //! Get the trial grid function space
+      const GFS& trialGridFunctionSpace() const
+      {
+        return _gfs;
+      }
+
+      //! Get the test grid function space
+      const GFS& testGridFunctionSpace() const
+      {
+        return _gfs;
+      }
+
+      /** \brief Recomputes all cell and face data.
+       *
+       * \throws Dune::NotImplemented if the grid view is distributed over
+       *         several processes or has processor boundaries.
+       */
+      void update()
+      {
+        const GV& gv = _gfs.gridView();
+        if (gv.comm().size() > 1)
+          DUNE_THROW(Dune::NotImplemented,"LinearHyperbolicDGOperator does not support parallel grid views");
+        ElementMapper<GV> cell_mapper(gv);
+
+        _cells.assign(gv.size(0),Cell());
+        _faces.clear();
+        _boundary_faces.clear();
+        _indices.clear();
+        _matrices.clear();
+        _tables.clear();
+        _face_nodes.clear();
+        _face_positions.clear();
+
+        const bool collocation = _integration == gaussLobattoCollocation;
+        if (collocation)
+          setupCollocation();
+
+        LFS lfs(_gfs), lfsn(_gfs);
+        LFSCache lfs_cache(lfs);
+
+        size_type max_size = 0;
+        Real cfl_dt = std::numeric_limits<Real>::max();
+
+        for (ElementIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+          {
+            const size_type ids = cell_mapper.map(*it);
+            Cell& cell = _cells[ids];
+
+            lfs.bind(*it);
+            lfs_cache.update();
+
+            const LocalBasis& basis = lfs.child(0).finiteElement().localBasis();
+            const size_type n = lfs.child(0).size();
+            const int order = basis.order();
+            max_size = std::max(max_size,n);
+
+            // DOF indices in the cell-wise layout [component][basis function]
+            cell.size = n;
+            cell.offset = _indices.size();
+            for (size_type l = 0; l < size_type(m); ++l)
+              for (size_type p = 0; p < n; ++p)
+                _indices.push_back(lfs_cache.containerIndex(lfs.child(l).localIndex(p)));
+
+            if (collocation)
+              {
+                if (n != _nodes.size())
+                  DUNE_THROW(Dune::Exception,"Gauss-Lobatto collocation needs the same polynomial degree on all cells");
+                collocationVolumeData(*it,cell);
+              }
+            else
+              quadratureVolumeData(*it,basis,cell);
+
+            _system.fluxMatrices(*it,cell.flux,cell.reaction);
+            cell.has_reaction = cell.reaction.frobenius_norm() > 0.0;
+
+            // faces: each interior face is owned by the cell with the larger index
+            cell.face_begin = _faces.size();
+            cell.boundary_begin = _boundary_faces.size();
+            Real max_face_volume = 0.0;
+            unsigned int intersection_index = 0;
+            for (IntersectionIterator iit = gv.ibegin(*it); iit != gv.iend(*it); ++iit, ++intersection_index)
+              {
+                max_face_volume = std::max(max_face_volume,Real(iit->geometry().volume()));
+                const FieldVector<DF,dim> n_F = iit->centerUnitOuterNormal();
+
+                switch (IntersectionType::get(*iit))
+                  {
+                  case IntersectionType::skeleton:
+                  case IntersectionType::periodic:
+                    {
+                      const size_type idn = cell_mapper.map(*(iit->outside()));
+                      if (ids <= idn)
+                        break;
+
+                      Face face;
+                      face.inside = ids;
+                      face.outside = idn;
+                      _system.skeletonProjectors(*it,*(iit->outside()),n_F,face.A_plus,face.A_minus);
+                      if (collocation)
+                        collocationSkeletonData(*iit,face);
+                      else
+                        {
+                          lfsn.bind(*(iit->outside()));
+                          quadratureSkeletonData(*iit,basis,lfsn.child(0).finiteElement().localBasis(),face);
+                        }
+                      _faces.push_back(face);
+                      break;
+                    }
+
+                  case IntersectionType::boundary:
+                    {
+                      BoundaryFace face;
+                      face.intersection_index = intersection_index;
+                      _system.boundaryProjectors(*it,n_F,face.A_plus,face.A_minus);
+                      if (collocation)
+                        collocationBoundaryData(*iit,face);
+                      else
+                        quadratureBoundaryData(*iit,basis,face);
+                      _boundary_faces.push_back(face);
+                      break;
+                    }
+
+                  default:
+                    DUNE_THROW(Dune::NotImplemented,"LinearHyperbolicDGOperator does not support processor boundaries");
+                  }
+              }
+            cell.face_end = _faces.size();
+            cell.boundary_end = _boundary_faces.size();
+
+            // time step restriction h / (lambda (2k+1))
+            const Real speed = _system.maxSpeed(*it);
+            if (speed > 0.0 && max_face_volume > 0.0)
+              cfl_dt = std::min(cfl_dt,Real(it->geometry().volume()/max_face_volume/(speed*(2*order+1))));
+          }
+
+        _cfl_dt = cfl_dt;
+
+        _u.resize(_indices.size());
+        _r.resize(_indices.size());
+        _tmp.resize(dim*max_size);
+      }
+
+      //! Prepares a time step of the given method.
+      void preStep(const TimeSteppingParameterInterface<Real>& method, Real time, Real dt)
+      {
+        if (method.implicit())
+          DUNE_THROW(Dune::Exception,"LinearHyperbolicDGOperator only supports explicit methods");
+        _method = &method;
+        _time = time;
+        _dt = dt;
+      }
+
+      //! to be called once at the end of each stage
+      void postStage()
+      {}
+
+      //! to be called once at the end of each time step
+      void postStep()
+      {}
+
+      //! Largest stable time step h / (lambda (2k+1)), minimized over all cells.
+      Real suggestTimestep(Real dt) const
+      {
+        return _cfl_dt;
+      }
+
+      //! Assembles the explicit stage system D x_stage = r1 + dt r0.
+      /**
+       * As in OneStepGridOperator, r1 receives the mass terms
+       * \f$ \sum_{s<r} a_{rs} M x_s \f$ and r0 the spatial terms
+       * \f$ \sum_{s<r} b_{rs} A(x_s) \f$, each evaluated at the time of stage s.
+       * D is set to \f$ -a_{rr} M \f$.
+       */
+      template<typename X, typename R>
+      void explicit_jacobian_residual(unsigned int stage, const std::vector<X*>& x,
+                                      LinearHyperbolicDGMassOperator<LinearHyperbolicDGOperator>& D,
+                                      R& r1, R& r0)
+      {
+        if (!_method)
+          DUNE_THROW(Dune::Exception,"preStep() has to be called before assembling a stage");
+
+        for (unsigned int s = 0; s < stage; ++s)
+          {
+            const Real a = _method->a(stage,s);
+            const Real b = _method->b(stage,s);
+            if (a == 0.0 && b == 0.0)
+              continue;
+
+            gather(*x[s],_u);
+            if (b != 0.0)
+              {
+                std::fill(_r.begin(),_r.end(),0.0);
+                applySpatial(_time+_method->d(s)*_dt);
+                scatter(b,r0);
+              }
+            if (a != 0.0)
+              {
+                std::fill(_r.begin(),_r.end(),0.0);
+                applyMass();
+                scatter(a,r1);
+              }
+          }
+
+        D.setWeight(-_method->a(stage,stage));
+      }
+
+      //! Adds A(x) at the given time to r.
+      template<typename X, typename R>
+      void residual(Real time, const X& x, R& r)
+      {
+        gather(x,_u);
+        std::fill(_r.begin(),_r.end(),0.0);
+        applySpatial(time);
+        scatter(1.0,r);
+      }
+
+      //! Solves weight * M x = b.
+      template<typename X, typename B>
+      void solveMass(Real weight, X& x, const B& b) const
+      {
+        gather(b,_u);
+        for (typename std::vector<Cell>::const_iterator cit = _cells.begin(); cit != _cells.end(); ++cit)
+          {
+            const size_type n = cit->size;
+            if (_integration == gaussLobattoCollocation)
+              {
+                // lumped mass matrix
+                const Real* mass = &_matrices[cit->matrices];
+                for (size_type l = 0; l < size_type(m); ++l)
+                  for (size_type k = 0; k < n; ++k)
+                    _r[cit->offset + l*n + k] = _u[cit->offset + l*n + k]/(weight*mass[k]);
+                continue;
+              }
+            const Real* inverse = &_matrices[cit->matrices] + n*n;
+            for (size_type l = 0; l < size_type(m); ++l)
+              {
+                const Real* b_l = &_u[cit->offset + l*n];
+                Real* x_l = &_r[cit->offset + l*n];
+                for (size_type k = 0; k < n; ++k)
+                  {
+                    Real sum = 0.0;
+                    for (size_type p = 0; p < n; ++p)
+                      sum += inverse[k*n+p]*b_l[p];
+                    x_l[k] = sum/weight;
+                  }
+              }
+          }
+        for (size_type i = 0; i < _indices.size(); ++i)
+          x[_indices[i]] = _r[i];
+      }
+
+    private:
+
+      struct Cell
+      {
+        Cell()
+          : size(0), offset(0), matrices(0), table(0), quadrature_size(0), intorder(0)
+          , has_reaction(false), face_begin(0), face_end(0), boundary_begin(0), boundary_end(0)
+        {}
+
+        size_type size;            // basis functions per component
+        size_type offset;          // first entry in the cell-wise layout
+        size_type matrices;        // mass matrix, its inverse and the derivative operators,
+                                   // or lumped mass and metric terms for collocation
+        size_type table;           // weighted basis functions at the quadrature points
+        size_type quadrature_size;
+        int intorder;
+        array<Matrix,dim> flux;
+        Matrix reaction;
+        bool has_reaction;
+        size_type face_begin, face_end;
+        size_type boundary_begin, boundary_end;
+      };
+
+      struct Face
+      {
+        size_type inside, outside;
+        size_type quadrature_size;
+        size_type table;           // weights, inside and outside basis functions
+        size_type nodes;           // pairs of inside and outside nodes for collocation
+        Matrix A_plus, A_minus;
+      };
+
+      struct BoundaryFace
+      {
+        unsigned int intersection_index;
+        int intorder;
+        size_type quadrature_size;
+        size_type table;           // weights and inside basis functions
+        size_type nodes;           // inside nodes for collocation
+        size_type positions;       // face-local positions of the nodes for collocation
+        Matrix A_plus, A_minus;
+      };
+
+      void quadratureVolumeData(const Element& e, const LocalBasis& basis, Cell& cell)
+      {
+        const size_type n = basis.size();
+        const typename Element::Geometry geo = e.geometry();
+        cell.intorder = _overintegration+2*int(basis.order());
+        const QuadratureRule<DF,dim>& rule = QuadratureRules<DF,dim>::rule(e.type(),cell.intorder);
+        cell.quadrature_size = rule.size();
+        cell.matrices = _matrices.size();
+        _matrices.resize(_matrices.size() + (2+dim)*n*n,0.0);
+        cell.table = _tables.size();
+        _tables.resize(_tables.size() + rule.size()*n);
+
+        // mass matrix, derivative operators and weighted basis functions
+        Real* mass = &_matrices[cell.matrices];
+        Real* derivatives = mass + 2*n*n;
+        Real* weighted_phi = &_tables[cell.table];
+        std::vector<RangeType> phi;
+        std::vector<JacobianType> js;
+        std::vector<FieldVector<Real,dim> > gradphi(n);
+        for (size_type q = 0; q < rule.size(); ++q)
+          {
+            basis.evaluateFunction(rule[q].position(),phi);
+            basis.evaluateJacobian(rule[q].position(),js);
+            const typename Element::Geometry::JacobianInverseTransposed
+              jac = geo.jacobianInverseTransposed(rule[q].position());
+            for (size_type k = 0; k < n; ++k)
+              jac.mv(js[k][0],gradphi[k]);
+
+            const Real factor = rule[q].weight() * geo.integrationElement(rule[q].position());
+            for (size_type k = 0; k < n; ++k)
+              {
+                weighted_phi[q*n+k] = factor*phi[k];
+                for (size_type p = 0; p < n; ++p)
+                  {
+                    mass[k*n+p] += factor*phi[k]*phi[p];
+                    for (int j = 0; j < dim; ++j)
+                      derivatives[(j*n+k)*n+p] += factor*gradphi[k][j]*phi[p];
+                  }
+              }
+          }
+
+        DynamicMatrix<Real> inverse(n,n);
+        for (size_type k = 0; k < n; ++k)
+          for (size_type p = 0; p < n; ++p)
+            inverse[k][p] = mass[k*n+p];
+        inverse.invert();
+        for (size_type k = 0; k < n; ++k)
+          for (size_type p = 0; p < n; ++p)
+            mass[n*n+k*n+p] = inverse[k][p];
+      }
+
+      void quadratureSkeletonData(const Intersection& is, const LocalBasis& basis_s,
+                                  const LocalBasis& basis_n, Face& face)
+      {
+        const size_type n_s = basis_s.size();
+        const size_type n_n = basis_n.size();
+        const int intorder = _overintegration+1+2*int(std::max(basis_s.order(),basis_n.order()));
+        const QuadratureRule<DF,dim-1>& face_rule =
+          QuadratureRules<DF,dim-1>::rule(is.geometry().type(),intorder);
+        face.quadrature_size = face_rule.size();
+        face.table = _tables.size();
+
+        _tables.resize(_tables.size() + face_rule.size()*(1+n_s+n_n));
+        Real* weights = &_tables[face.table];
+        Real* phi_s_table = weights + face_rule.size();
+        Real* phi_n_table = phi_s_table + face_rule.size()*n_s;
+        std::vector<RangeType> phi_s, phi_n;
+        for (size_type q = 0; q < face_rule.size(); ++q)
+          {
+            basis_s.evaluateFunction(is.geometryInInside().global(face_rule[q].position()),phi_s);
+            basis_n.evaluateFunction(is.geometryInOutside().global(face_rule[q].position()),phi_n);
+            weights[q] = face_rule[q].weight() * is.geometry().integrationElement(face_rule[q].position());
+            for (size_type k = 0; k < n_s; ++k)
+              phi_s_table[q*n_s+k] = phi_s[k];
+            for (size_type k = 0; k < n_n; ++k)
+              phi_n_table[q*n_n+k] = phi_n[k];
+          }
+      }
+
+      void quadratureBoundaryData(const Intersection& is, const LocalBasis& basis, BoundaryFace& face)
+      {
+        const size_type n = basis.size();
+        face.intorder = _overintegration+1+2*int(basis.order());
+        const QuadratureRule<DF,dim-1>& face_rule =
+          QuadratureRules<DF,dim-1>::rule(is.geometry().type(),face.intorder);
+        face.quadrature_size = face_rule.size();
+        face.table = _tables.size();
+
+        _tables.resize(_tables.size() + face_rule.size()*(1+n));
+        Real* weights = &_tables[face.table];
+        Real* phi_s_table = weights + face_rule.size();
+        std::vector<RangeType> phi;
+        for (size_type q = 0; q < face_rule.size(); ++q)
+          {
+            basis.evaluateFunction(is.geometryInInside().global(face_rule[q].position()),phi);
+            weights[q] = face_rule[q].weight() * is.geometry().integrationElement(face_rule[q].position());
+            for (size_type k = 0; k < n; ++k)
+              phi_s_table[q*n+k] = phi[k];
+          }
+      }
+
+      // 1D Gauss-Lobatto data and the tensor product nodes on the reference cube
+      void setupCollocation()
+      {
+        typedef QkStuff::GaussLobattoCollocation<LocalBasis> Collocation;
+        if (!Collocation::value)
+          DUNE_THROW(Dune::NotImplemented,"Gauss-Lobatto collocation needs a QkDGGL space of degree k >= 1");
+
+        std::vector<Real> nodes;
+        Collocation::data(nodes,_gl_weights,_gl_derivatives);
+        _gl_size = nodes.size();
+
+        size_type size = 1;
+        for (int j = 0; j < dim; ++j)
+          {
+            _strides[j] = size;
+            size *= _gl_size;
+          }
+        _nodes.resize(size);
+        for (size_type q = 0; q < size; ++q)
+          for (int j = 0; j < dim; ++j)
+            _nodes[q][j] = nodes[(q/_strides[j])%_gl_size];
+      }
+
+      // product of the 1D weights of node q, leaving out direction skip
+      Real nodeWeight(size_type q, int skip = -1) const
+      {
+        Real weight = 1.0;
+        for (int j = 0; j < dim; ++j)
+          if (j != skip)
+            weight *= _gl_weights[(q/_strides[j])%_gl_size];
+        return weight;
+      }
+
+      void collocationVolumeData(const Element& e, Cell& cell)
+      {
+        const size_type n = _nodes.size();
+        const typename Element::Geometry geo = e.geometry();
+        cell.quadrature_size = n;
+        cell.matrices = _matrices.size();
+        _matrices.resize(_matrices.size() + n*(1+dim*dim));
+
+        // lumped mass w_q |J_q| and metric terms w_q |J_q| J_q^{-T}
+        Real* mass = &_matrices[cell.matrices];
+        Real* metric = mass + n;
+        for (size_type q = 0; q < n; ++q)
+          {
+            const Real factor = nodeWeight(q) * geo.integrationElement(_nodes[q]);
+            const typename Element::Geometry::JacobianInverseTransposed
+              jac = geo.jacobianInverseTransposed(_nodes[q]);
+            mass[q] = factor;
+            for (int j = 0; j < dim; ++j)
+              for (int d = 0; d < dim; ++d)
+                metric[(q*dim+j)*dim+d] = factor*jac[j][d];
+          }
+      }
+
+      // Collects the nodes of the cell on the face together with their face weights.
+      // For interior faces, the matching node of the outside cell is stored after each
+      // inside node, for boundary faces the face-local position of the node.
+      void collocationFaceData(const Intersection& is, bool boundary,
+                               size_type& quadrature_size, size_type& table, size_type& nodes)
+      {
+        const DF tolerance = 1e-8;
+        const int face = is.indexInInside();
+        const int dir = face/2;
+        const DF side = face%2;
+
+        table = _tables.size();
+        nodes = _face_nodes.size();
+        for (size_type q = 0; q < _nodes.size(); ++q)
+          {
+            if (std::abs(_nodes[q][dir] - side) > tolerance)
+              continue;
+
+            const FieldVector<DF,dim-1> x = is.geometryInInside().local(_nodes[q]);
+            _tables.push_back(nodeWeight(q,dir) * is.geometry().integrationElement(x));
+            _face_nodes.push_back(q);
+            if (boundary)
+              {
+                _face_positions.push_back(x);
+                continue;
+              }
+
+            const FieldVector<DF,dim> x_n = is.geometryInOutside().global(x);
+            size_type p = 0;
+            while (p < _nodes.size())
+              {
+                FieldVector<DF,dim> distance(_nodes[p]);
+                distance -= x_n;
+                if (distance.infinity_norm() < tolerance)
+                  break;
+                ++p;
+              }
+            if (p == _nodes.size())
+              DUNE_THROW(Dune::Exception,"Gauss-Lobatto collocation needs matching nodes on both sides of a face");
+            _face_nodes.push_back(p);
+          }
+        quadrature_size = _tables.size() - table;
+      }
+
+      void collocationSkeletonData(const Intersection& is, Face& face)
+      {
+        collocationFaceData(is,false,face.quadrature_size,face.table,face.nodes);
+      }
+
+      void collocationBoundaryData(const Intersection& is, BoundaryFace& face)
+      {
+        face.intorder = 0;
+        face.positions = _face_positions.size();
+        collocationFaceData(is,true,face.quadrature_size,face.table,face.nodes);
+      }
+
+      template<typename X>
+      void gather(const X& x, std::vector<Real>& u) const
+      {
+        for (size_type i = 0; i < _indices.size(); ++i)
+          u[i] = x[_indices[i]];
+      }
+
+      template<typename R>
+      void scatter(Real weight, R& r) const
+      {
+        for (size_type i = 0; i < _indices.size(); ++i)
+          r[_indices[i]] += weight*_r[i];
+      }
+
+      // _r += M _u
+      void applyMass()
+      {
+        if (_integration == gaussLobattoCollocation)
+          {
+            for (typename std::vector<Cell>::const_iterator cit = _cells.begin(); cit != _cells.end(); ++cit)
+              {
+                const Real* mass = &_matrices[cit->matrices];
+                for (size_type l = 0; l < size_type(m); ++l)
+                  for (size_type k = 0; k < cit->size; ++k)
+                    _r[cit->offset + l*cit->size + k] += mass[k]*_u[cit->offset + l*cit->size + k];
+              }
+            return;
+          }
+        for (typename std::vector<Cell>::const_iterator cit = _cells.begin(); cit != _cells.end(); ++cit)
+          for (size_type l = 0; l < size_type(m); ++l)
+            multiply(&_matrices[cit->matrices],cit->size,
+                     &_u[cit->offset + l*cit->size],&_r[cit->offset + l*cit->size],1.0);
+      }
+
+      // _r += A(_u), fused sweep over the cells and the faces they own
+      void applySpatial(Real time)
+      {
+        _system.setTime(time);
+
+        const bool collocation = _integration == gaussLobattoCollocation;
+        const GV& gv = _gfs.gridView();
+        ElementMapper<GV> cell_mapper(gv);
+        for (ElementIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+          {
+            const Cell& cell = _cells[cell_mapper.map(*it)];
+            if (collocation)
+              collocationVolume(*it,cell);
+            else
+              volume(*it,cell);
+
+            for (size_type f = cell.face_begin; f != cell.face_end; ++f)
+              if (collocation)
+                collocationSkeleton(_faces[f]);
+              else
+                skeleton(_faces[f]);
+
+            if (cell.boundary_begin == cell.boundary_end)
+              continue;
+            size_type f = cell.boundary_begin;
+            unsigned int intersection_index = 0;
+            for (IntersectionIterator iit = gv.ibegin(*it);
+                 iit != gv.iend(*it) && f != cell.boundary_end; ++iit, ++intersection_index)
+              if (_boundary_faces[f].intersection_index == intersection_index)
+                {
+                  if (collocation)
+                    collocationBoundary(*iit,cell,_boundary_faces[f++]);
+                  else
+                    boundary(*iit,cell,_boundary_faces[f++]);
+                }
+          }
+      }
+
+      // y += factor * mat x for a dense n x n matrix
+      static void multiply(const Real* mat, size_type n, const Real* x, Real* y, Real factor)
+      {
+        for (size_type k = 0; k < n; ++k)
+          {
+            Real sum = 0.0;
+            for (size_type p = 0; p < n; ++p)
+              sum += mat[k*n+p]*x[p];
+            y[k] += factor*sum;
+          }
+      }
+
+      void volume(const Element& e, const Cell& cell)
+      {
+        const size_type n = cell.size;
+        const Real* u = &_u[cell.offset];
+        Real* r = &_r[cell.offset];
+        const Real* mass = &_matrices[cell.matrices];
+        const Real* derivatives = mass + 2*n*n;
+
+        // - int F(u) : grad v = - sum_j G^j (A_j u)
+        for (int j = 0; j < dim; ++j)
+          for (size_type i = 0; i < size_type(m); ++i)
+            {
+              bool nonzero = false;
+              std::fill(_tmp.begin(),_tmp.begin()+n,0.0);
+              for (size_type l = 0; l < size_type(m); ++l)
+                if (cell.flux[j][i][l] != 0.0)
+                  {
+                    nonzero = true;
+                    for (size_type p = 0; p < n; ++p)
+                      _tmp[p] += cell.flux[j][i][l]*u[l*n+p];
+                  }
+              if (nonzero)
+                multiply(derivatives + j*n*n,n,&_tmp[0],r + i*n,-1.0);
+            }
+
+        // reaction term
+        if (cell.has_reaction)
+          for (size_type i = 0; i < size_type(m); ++i)
+            {
+              std::fill(_tmp.begin(),_tmp.begin()+n,0.0);
+              for (size_type l = 0; l < size_type(m); ++l)
+                if (cell.reaction[i][l] != 0.0)
+                  for (size_type p = 0; p < n; ++p)
+                    _tmp[p] += cell.reaction[i][l]*u[l*n+p];
+              multiply(mass,n,&_tmp[0],r + i*n,1.0);
+            }
+
+        // source term
+        const QuadratureRule<DF,dim>& rule = QuadratureRules<DF,dim>::rule(e.type(),cell.intorder);
+        const Real* weighted_phi = &_tables[cell.table];
+        for (size_type q = 0; q < cell.quadrature_size; ++q)
+          {
+            const State source = _system.source(e,rule[q].position());
+            for (size_type i = 0; i < size_type(m); ++i)
+              if (source[i] != 0.0)
+                for (size_type k = 0; k < n; ++k)
+                  r[i*n+k] -= source[i]*weighted_phi[q*n+k];
+          }
+      }
+
+      void skeleton(const Face& face)
+      {
+        const Cell& inside = _cells[face.inside];
+        const Cell& outside = _cells[face.outside];
+        const size_type n_s = inside.size;
+        const size_type n_n = outside.size;
+        const Real* u_s = &_u[inside.offset];
+        const Real* u_n = &_u[outside.offset];
+        Real* r_s = &_r[inside.offset];
+        Real* r_n = &_r[outside.offset];
+
+        const Real* weights = &_tables[face.table];
+        const Real* phi_s = weights + face.quadrature_size;
+        const Real* phi_n = phi_s + face.quadrature_size*n_s;
+
+        State state_s, state_n, f;
+        for (size_type q = 0; q < face.quadrature_size; ++q, phi_s += n_s, phi_n += n_n)
+          {
+            for (size_type l = 0; l < size_type(m); ++l)
+              {
+                state_s[l] = 0.0;
+                for (size_type p = 0; p < n_s; ++p)
+                  state_s[l] += u_s[l*n_s+p]*phi_s[p];
+                state_n[l] = 0.0;
+                for (size_type p = 0; p < n_n; ++p)
+                  state_n[l] += u_n[l*n_n+p]*phi_n[p];
+              }
+
+            face.A_plus.mv(state_s,f);
+            face.A_minus.umv(state_n,f);
+            f *= weights[q];
+
+            for (size_type i = 0; i < size_type(m); ++i)
+              {
+                for (size_type k = 0; k < n_s; ++k)
+                  r_s[i*n_s+k] += f[i]*phi_s[k];
+                for (size_type k = 0; k < n_n; ++k)
+                  r_n[i*n_n+k] -= f[i]*phi_n[k];
+              }
+          }
+      }
+
+      void boundary(const Intersection& is, const Cell& cell, const BoundaryFace& face)
+      {
+        const size_type n = cell.size;
+        const Real* u_s = &_u[cell.offset];
+        Real* r_s = &_r[cell.offset];
+
+        const QuadratureRule<DF,dim-1>& rule =
+          QuadratureRules<DF,dim-1>::rule(is.geometry().type(),face.intorder);
+        const Real* weights = &_tables[face.table];
+        const Real* phi_s = weights + face.quadrature_size;
+
+        State state_s, f;
+        for (size_type q = 0; q < face.quadrature_size; ++q, phi_s += n)
+          {
+            for (size_type l = 0; l < size_type(m); ++l)
+              {
+                state_s[l] = 0.0;
+                for (size_type p = 0; p < n; ++p)
+                  state_s[l] += u_s[l*n+p]*phi_s[p];
+              }
+            const State state_n = _system.boundaryState(is,rule[q].position(),state_s);
+
+            face.A_plus.mv(state_s,f);
+            face.A_minus.umv(state_n,f);
+            f *= weights[q];
+
+            for (size_type i = 0; i < size_type(m); ++i)
+              for (size_type k = 0; k < n; ++k)
+                r_s[i*n+k] += f[i]*phi_s[k];
+          }
+      }
+
+      // Volume terms at the Gauss-Lobatto nodes: the solution is read directly
+      // from the nodal coefficients and the gradients of the test functions
+      // are applied with the 1D differentiation matrix.
+      void collocationVolume(const Element& e, const Cell& cell)
+      {
+        const size_type n = cell.size;
+        const size_type k1 = _gl_size;
+        const Real* u = &_u[cell.offset];
+        Real* r = &_r[cell.offset];
+        const Real* mass = &_matrices[cell.matrices];
+        const Real* metric = mass + n;
+        Real* fhat = &_tmp[0];
+
+        // - int F(u) : grad v, with the flux transformed to reference directions
+        for (size_type i = 0; i < size_type(m); ++i)
+          {
+            bool nonzero = false;
+            for (int j = 0; j < dim; ++j)
+              for (size_type l = 0; l < size_type(m); ++l)
+                nonzero = nonzero || cell.flux[j][i][l] != 0.0;
+            if (!nonzero)
+              continue;
+
+            for (size_type q = 0; q < n; ++q)
+              {
+                Real flux[dim];
+                for (int j = 0; j < dim; ++j)
+                  {
+                    flux[j] = 0.0;
+                    for (size_type l = 0; l < size_type(m); ++l)
+                      flux[j] += cell.flux[j][i][l]*u[l*n+q];
+                  }
+                for (int d = 0; d < dim; ++d)
+                  {
+                    Real sum = 0.0;
+                    for (int j = 0; j < dim; ++j)
+                      sum += metric[(q*dim+j)*dim+d]*flux[j];
+                    fhat[d*n+q] = sum;
+                  }
+              }
+
+            for (int d = 0; d < dim; ++d)
+              {
+                const size_type stride = _strides[d];
+                const Real* fhat_d = fhat + d*n;
+                for (size_type k = 0; k < n; ++k)
+                  {
+                    const size_type a_k = (k/stride)%k1;
+                    const size_type line = k - a_k*stride;
+                    Real sum = 0.0;
+                    for (size_type a = 0; a < k1; ++a)
+                      sum += _gl_derivatives[a*k1+a_k]*fhat_d[line+a*stride];
+                    r[i*n+k] -= sum;
+                  }
+              }
+          }
+
+        // reaction term
+        if (cell.has_reaction)
+          for (size_type i = 0; i < size_type(m); ++i)
+            for (size_type l = 0; l < size_type(m); ++l)
+              if (cell.reaction[i][l] != 0.0)
+                for (size_type q = 0; q < n; ++q)
+                  r[i*n+q] += cell.reaction[i][l]*mass[q]*u[l*n+q];
+
+        // source term
+        for (size_type q = 0; q < n; ++q)
+          {
+            const State source = _system.source(e,_nodes[q]);
+            for (size_type i = 0; i < size_type(m); ++i)
+              r[i*n+q] -= source[i]*mass[q];
+          }
+      }
+
+      void collocationSkeleton(const Face& face)
+      {
+        const Cell& inside = _cells[face.inside];
+        const Cell& outside = _cells[face.outside];
+        const size_type n = inside.size;
+        const Real* u_s = &_u[inside.offset];
+        const Real* u_n = &_u[outside.offset];
+        Real* r_s = &_r[inside.offset];
+        Real* r_n = &_r[outside.offset];
+
+        const Real* weights = &_tables[face.table];
+        const size_type* nodes = &_face_nodes[face.nodes];
+
+        State state_s, state_n, f;
+        for (size_type q = 0; q < face.quadrature_size; ++q, nodes += 2)
+          {
+            const size_type s = nodes[0];
+            const size_type t = nodes[1];
+            for (size_type l = 0; l < size_type(m); ++l)
+              {
+                state_s[l] = u_s[l*n+s];
+                state_n[l] = u_n[l*n+t];
+              }
+
+            face.A_plus.mv(state_s,f);
+            face.A_minus.umv(state_n,f);
+            f *= weights[q];
+
+            for (size_type i = 0; i < size_type(m); ++i)
+              {
+                r_s[i*n+s] += f[i];
+                r_n[i*n+t] -= f[i];
+              }
+          }
+      }
+
+      void collocationBoundary(const Intersection& is, const Cell& cell, const BoundaryFace& face)
+      {
+        const size_type n = cell.size;
+        const Real* u_s = &_u[cell.offset];
+        Real* r_s = &_r[cell.offset];
+
+        const Real* weights = &_tables[face.table];
+        const size_type* nodes = &_face_nodes[face.nodes];
+        const FieldVector<DF,dim-1>* positions = &_face_positions[face.positions];
+
+        State state_s, f;
+        for (size_type q = 0; q < face.quadrature_size; ++q)
+          {
+            const size_type s = nodes[q];
+            for (size_type l = 0; l < size_type(m); ++l)
+              state_s[l] = u_s[l*n+s];
+            const State state_n = _system.boundaryState(is,positions[q],state_s);
+
+            face.A_plus.mv(state_s,f);
+            face.A_minus.umv(state_n,f);
+            f *= weights[q];
+
+            for (size_type i = 0; i < size_type(m); ++i)
+              r_s[i*n+s] += f[i];
+          }
+      }
+
+      const GFS& _gfs;
+      System& _system;
+      Integration _integration;
+      int _overintegration;
+
+      const TimeSteppingParameterInterface<Real>* _method;
+      Real _time;
+      Real _dt;
+      Real _cfl_dt;
+
+      std::vector<Cell> _cells;
+      std::vector<Face> _faces;
+      std::vector<BoundaryFace> _boundary_faces;
+      std::vector<ContainerIndex> _indices;
+      std::vector<Real> _matrices;
+      std::vector<Real> _tables;
+
+      // Gauss-Lobatto collocation: 1D weights and differentiation matrix,
+      // reference nodes of a cell and node data of the faces
+      size_type _gl_size;
+      array<size_type,dim> _strides;
+      std::vector<Real> _gl_weights;
+      std::vector<Real> _gl_derivatives;
+      std::vector<FieldVector<DF,dim> > _nodes;
+      std::vector<size_type> _face_nodes;
+      std::vector<FieldVector<DF,dim-1> > _face_positions;
+
+      // cell-wise coefficients and residual, scratch space of one cell
+      mutable std::vector<Real> _u;
+      mutable std::vector<Real> _r;
+      std::vector<Real> _tmp;
+
+    };
+
+    //! The block diagonal matrix D = weight * M of a LinearHyperbolicDGOperator.
+    /**
+     * Only stores the weight; the inverse mass matrices are kept by the
+     * operator. Assigning a scalar resets the weight, which is how
+     * ExplicitOneStepMethod clears the matrix before each stage.
+     */
+    template<typename Engine>
+    class LinearHyperbolicDGMassOperator
+    {
+
+    public:
+
+      typedef typename Engine::Real Real;
+
+      explicit LinearHyperbolicDGMassOperator(const Engine& engine)
+        : _engine(engine)
+        , _weight(0.0)
+      {}
+
+      LinearHyperbolicDGMassOperator& operator=(Real weight)
+      {
+        _weight = weight;
+        return *this;
+      }
+
+      Real weight() const
+      {
+        return _weight;
+      }
+
+      void setWeight(Real weight)
+      {
+        _weight = weight;
+      }
+
+      //! Solves D x = b.
+      template<typename X, typename B>
+      void solve(X& x, const B& b) const
+      {
+        if (_weight == 0.0)
+          DUNE_THROW(Dune::Exception,"LinearHyperbolicDGMassOperator: matrix is zero");
+        _engine.solveMass(_weight,x,b);
+      }
+
+    private:
+
+      const Engine& _engine;
+      Real _weight;
+
+    };
+
+    //! "Linear solver" for ExplicitOneStepMethod with a LinearHyperbolicDGOperator.
+    /**
+     * Applies the precomputed inverse of the block diagonal mass matrix.
+     */
+    class LinearHyperbolicDGMassSolver
+      : public LinearResultStorage
+    {
+
+    public:
+
+      /*! \brief solve the given linear system
+
+        \param[in] A the given matrix
+        \param[out] z the solution vector to be computed
+        \param[in] r right hand side
+        \param[in] reduction to be achieved
+      */
+      template<class M, class V, class W>
+      void apply(M& A, V& z, W& r, typename W::ElementType reduction)
+      {
+        A.solve(z,r);
+        res.converged  = true;
+        res.iterations = 1;
+        res.elapsed    = 0.0;
+        res.reduction  = reduction;
+        res.conv_rate  = reduction;
+      }
+
+    };
+
+    //! @} group OneStepMethod
+
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_INSTATIONARY_LINEARHYPERBOLICDG_HH
@@ -17,6 +17,7 @@
 #include <dune/common/ios_state.hh>
 
 #include <dune/pdelab/common/logtag.hh>
+#include <dune/pdelab/common/workspace.hh>
 #include <dune/pdelab/gridoperator/common/timesteppingparameterinterface.hh>
 
 namespace Dune {
@@ -909,7 +910,7 @@ namespace Dune {
             else
               {
                 // intermediate step
-                x.push_back(new TrlV(igos.trialGridFunctionSpace()));
+                x.push_back(&stage(r));
                 if (r>1)
                   *(x[r]) = *(x[r-1]); // use result of last stage as initial guess
                 else
@@ -945,9 +946,6 @@ namespace Dune {
             igos.postStage();
           }
 
-        // delete intermediate steps
-        for (unsigned i=1; i<method->s(); ++i) delete x[i];
-
         // step cleanup
         igos.postStep();
 
@@ -1049,7 +1047,7 @@ namespace Dune {
             else
               {
                 // intermediate step
-                x.push_back(new TrlV(igos.trialGridFunctionSpace()));
+                x.push_back(&stage(r));
               }
 
             // set boundary conditions and initial value
@@ -1084,9 +1082,6 @@ namespace Dune {
             igos.postStage();
           }
 
-        // delete intermediate steps
-        for (unsigned i=1; i<method->s(); ++i) delete x[i];
-
         // step cleanup
         igos.postStep();
 
@@ -1120,13 +1115,26 @@ namespace Dune {
         return dt;
       }
 
+      //! the intermediate stage vectors, which are kept between steps
+      const Workspace<TrlV>& stageWorkspace () const
+      {
+        return stages;
+      }
+
     private:
+      // vector for the intermediate stage r
+      TrlV& stage (unsigned r)
+      {
+        return stages.get(r-1,igos.trialGridFunctionSpace(),igos.trialGridFunctionSpace().revision());
+      }
+
       const TimeSteppingParameterInterface<T> *method;
       IGOS& igos;
       PDESOLVER& pdesolver;
       int verbosityLevel;
       int step;
       Result res;
+      Workspace<TrlV> stages;
     };
 
     //! Do one step of an explicit time-stepping scheme
@@ -1246,7 +1254,9 @@ namespace Dune {
         if(verbosityLevel>=4)
           std::cout << mytag << "Creating residual vectors alpha and beta..."
                     << std::endl;
-        TstV alpha(igos.testGridFunctionSpace()), beta(igos.testGridFunctionSpace()); // split residual vectors
+        // split residual vectors
+        TstV& alpha = residuals.get(0,igos.testGridFunctionSpace(),igos.testGridFunctionSpace().revision());
+        TstV& beta = residuals.get(1,igos.testGridFunctionSpace(),igos.testGridFunctionSpace().revision());
         if(verbosityLevel>=4)
           std::cout << mytag
                     << "Creating residual vectors alpha and beta... done."
@@ -1305,7 +1315,7 @@ namespace Dune {
             else
               {
                 // intermediate step
-                x.push_back(new TrlV(igos.trialGridFunctionSpace()));
+                x.push_back(&stage(r));
                 if (r>1)
                   *(x[r]) = *(x[r-1]); // use result of last stage as initial guess
                 else
@@ -1393,9 +1403,6 @@ namespace Dune {
               std::cout << stagetag << "Finished." << std::endl;
           }
 
-        // delete intermediate steps
-        for(unsigned i=1; i<method->s(); ++i) delete x[i];
-
         // step cleanup
         if (verbosityLevel>=4)
           std::cout << mytag << "Cleanup..." << std::endl;
@@ -1407,8 +1414,26 @@ namespace Dune {
         return dt;
       }
 
+      //! the intermediate stage vectors, which are kept between steps
+      const Workspace<TrlV>& stageWorkspace () const
+      {
+        return stages;
+      }
+
+      //! the residual vectors alpha and beta, which are kept between steps
+      const Workspace<TstV>& residualWorkspace () const
+      {
+        return residuals;
+      }
+
     private:
 
+      // vector for the intermediate stage r
+      TrlV& stage (unsigned r)
+      {
+        return stages.get(r-1,igos.trialGridFunctionSpace(),igos.trialGridFunctionSpace().revision());
+      }
+
       //! dummy default limiter
       class DefaultLimiter
       {
@@ -1430,6 +1455,8 @@ namespace Dune {
       M D;
       TimeControllerInterface<T> *tc;
       bool allocated;
+      Workspace<TrlV> stages;
+      Workspace<TstV> residuals;
     };
 
     class FilenameHelper
@@ -97,6 +97,27 @@ namespace Dune {
         Y& y_s)
       {
       }
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_volume (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+      {
+      }
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_volume_post_skeleton (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+      {
+      }
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_skeleton (const LA& la, const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n)
+      {
+      }
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_boundary (const LA& la, const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s)
+      {
+      }
       template<typename EG, typename LFSU, typename X, typename LFSV, typename M>
       static void jacobian_volume (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, M & mat)
       {
@@ -227,6 +248,31 @@ namespace Dune {
       {
         la.jacobian_apply_boundary(ig,lfsu_s,x_s,lfsv_s,y_s);
       }
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_volume (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+      {
+        la.jacobian_apply_volume(eg,lfsu,x,z,lfsv,y);
+      }
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_volume_post_skeleton (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv, Y& y)
+      {
+        la.jacobian_apply_volume_post_skeleton(eg,lfsu,x,z,lfsv,y);
+      }
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_skeleton (const LA& la, const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n)
+      {
+        la.jacobian_apply_skeleton(ig,lfsu_s,x_s,z_s,lfsv_s,lfsu_n,x_n,z_n,lfsv_n,y_s,y_n);
+      }
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV, typename Y>
+      static void jacobian_apply_boundary (const LA& la, const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s)
+      {
+        la.jacobian_apply_boundary(ig,lfsu_s,x_s,z_s,lfsv_s,y_s);
+      }
 
       template<typename EG, typename LFSU, typename X, typename LFSV, typename M>
       static void jacobian_volume (const LA& la, const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, M & mat)
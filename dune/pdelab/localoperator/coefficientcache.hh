@@ -0,0 +1,152 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_LOCALOPERATOR_COEFFICIENTCACHE_HH
+#define DUNE_PDELAB_LOCALOPERATOR_COEFFICIENTCACHE_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <dune/common/fvector.hh>
+
+#include <dune/pdelab/common/elementmapper.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! \addtogroup LocalOperator
+    //! \ingroup PDELab
+    //! \{
+
+    //! Values of a coefficient function at the points of each cell where it has been evaluated.
+    /**
+     * The values are stored in flat arrays with the same number of slots for
+     * every cell, indexed by the ElementMapper index of the cell. A slot is
+     * identified by the local coordinate of the point, which is compared
+     * exactly: local operators evaluate their parameters at the points of
+     * fixed quadrature rules, so the same coordinates occur again in every
+     * assembly. Lookups start after the slot of the previous hit, so visiting
+     * the points of a cell in the same order as before costs one comparison
+     * per lookup. The number of slots per cell is doubled whenever a cell
+     * runs out of slots.
+     *
+     * For coefficients that are constant on each cell, cellwise mode stores a
+     * single value per cell and ignores the coordinate.
+     *
+     * \note The cache has to be recreated after the grid has been modified.
+     *
+     * \tparam GV    The grid view.
+     * \tparam Value The type of the coefficient values.
+     */
+    template<typename GV, typename Value>
+    class CoefficientCache
+    {
+
+    public:
+
+      typedef typename GV::template Codim<0>::Entity Element;
+      typedef FieldVector<typename GV::ctype,GV::dimension> Coordinate;
+      typedef std::size_t size_type;
+
+      CoefficientCache(const GV& gv, bool cellwise = false)
+        : _mapper(gv)
+        , _cells(gv.size(0))
+        , _cellwise(cellwise)
+        , _capacity(1)
+        , _count(_cells,0)
+        , _cursor(_cells,0)
+        , _positions(_cells)
+        , _values(_cells)
+      {}
+
+      //! Returns the stored value of cell e at local coordinate x, or 0 if there is none.
+      const Value* find(const Element& e, const Coordinate& x) const
+      {
+        const size_type cell = _mapper.map(e);
+        const size_type count = _count[cell];
+        if (count == 0)
+          return 0;
+        const size_type base = cell*_capacity;
+        if (_cellwise)
+          return &_values[base];
+
+        size_type k = _cursor[cell];
+        for (size_type i = 0; i < count; ++i)
+          {
+            k = k+1 < count ? k+1 : 0;
+            if (_positions[base+k] == x)
+              {
+                _cursor[cell] = k;
+                return &_values[base+k];
+              }
+          }
+        return 0;
+      }
+
+      //! Stores the value of cell e at local coordinate x and returns the stored copy.
+      const Value& insert(const Element& e, const Coordinate& x, const Value& value)
+      {
+        const size_type cell = _mapper.map(e);
+        if (_count[cell] == _capacity)
+          grow();
+        const size_type k = _count[cell]++;
+        const size_type slot = cell*_capacity + k;
+        _positions[slot] = x;
+        _values[slot] = value;
+        _cursor[cell] = k;
+        return _values[slot];
+      }
+
+      //! Discards all stored values.
+      void clear()
+      {
+        std::fill(_count.begin(),_count.end(),0);
+        std::fill(_cursor.begin(),_cursor.end(),0);
+      }
+
+      //! Whether a single value is stored per cell.
+      bool cellwise() const
+      {
+        return _cellwise;
+      }
+
+      //! Number of slots per cell.
+      size_type capacity() const
+      {
+        return _capacity;
+      }
+
+    private:
+
+      void grow()
+      {
+        const size_type capacity = 2*_capacity;
+        std::vector<Coordinate> positions(_cells*capacity);
+        std::vector<Value> values(_cells*capacity);
+        for (size_type cell = 0; cell < _cells; ++cell)
+          for (size_type k = 0; k < _count[cell]; ++k)
+            {
+              positions[cell*capacity+k] = _positions[cell*_capacity+k];
+              values[cell*capacity+k] = _values[cell*_capacity+k];
+            }
+        _positions.swap(positions);
+        _values.swap(values);
+        _capacity = capacity;
+      }
+
+      ElementMapper<GV> _mapper;
+      size_type _cells;
+      bool _cellwise;
+      size_type _capacity;
+      std::vector<size_type> _count;
+      mutable std::vector<size_type> _cursor;
+      std::vector<Coordinate> _positions;
+      std::vector<Value> _values;
+
+    };
+
+    //! \} group LocalOperator
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_LOCALOPERATOR_COEFFICIENTCACHE_HH
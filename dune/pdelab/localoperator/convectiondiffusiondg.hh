@@ -11,6 +11,7 @@
 #include<dune/pdelab/localoperator/idefault.hh>
 #include<dune/pdelab/localoperator/defaultimp.hh>
 #include<dune/pdelab/finiteelement/localbasiscache.hh>
+#include<dune/pdelab/finiteelementmap/variableorderdispatch.hh>
 
 #include"convectiondiffusionparameter.hh"
 
@@ -101,95 +102,12 @@ namespace Dune {
       template<typename EG, typename LFSU, typename X, typename LFSV, typename R>
       void alpha_volume (const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, R& r) const
       {
-        // domain and range field type
-        typedef typename LFSU::Traits::FiniteElementType::
-          Traits::LocalBasisType::Traits::DomainFieldType DF;
-        typedef typename LFSU::Traits::FiniteElementType::
-          Traits::LocalBasisType::Traits::RangeFieldType RF;
-        typedef typename LFSU::Traits::FiniteElementType::
-          Traits::LocalBasisType::Traits::JacobianType JacobianType;
-        typedef typename LFSU::Traits::FiniteElementType::
-          Traits::LocalBasisType::Traits::RangeType RangeType;
-        typedef typename LFSU::Traits::SizeType size_type;
-
-        // dimensions
-        const int dim = EG::Geometry::dimension;
-        const int order = std::max(lfsu.finiteElement().localBasis().order(),
-            lfsv.finiteElement().localBasis().order());
-        const int intorder = intorderadd + quadrature_factor * order;
-
-        // select quadrature rule
-        Dune::GeometryType gt = eg.geometry().type();
-        const Dune::QuadratureRule<DF,dim>& rule = Dune::QuadratureRules<DF,dim>::rule(gt,intorder);
-
-        // evaluate diffusion tensor at cell center, assume it is constant over elements
-        typename T::Traits::PermTensorType A;
-        Dune::FieldVector<DF,dim> localcenter = Dune::ReferenceElements<DF,dim>::general(gt).position(0,0);
-        A = param.A(eg.entity(),localcenter);
-
-        // transformation
-        typename EG::Geometry::JacobianInverseTransposed jac;
-
-        // loop over quadrature points
-        for (typename Dune::QuadratureRule<DF,dim>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
-          {
-            // evaluate basis functions
-#if USECACHE==0
-            std::vector<RangeType> phi(lfsu.size());
-            lfsu.finiteElement().localBasis().evaluateFunction(it->position(),phi);
-            std::vector<RangeType> psi(lfsv.size());
-            lfsv.finiteElement().localBasis().evaluateFunction(it->position(),psi);
-#else
-            const std::vector<RangeType>& phi = cache[order].evaluateFunction(it->position(),lfsu.finiteElement().localBasis());
-            const std::vector<RangeType>& psi = cache[order].evaluateFunction(it->position(),lfsv.finiteElement().localBasis());
-#endif
-
-            // evaluate u
-            RF u=0.0;
-            for (size_type i=0; i<lfsu.size(); i++)
-              u += x(lfsu,i)*phi[i];
-
-            // evaluate gradient of basis functions
-#if USECACHE==0
-            std::vector<JacobianType> js(lfsu.size());
-            lfsu.finiteElement().localBasis().evaluateJacobian(it->position(),js);
-            std::vector<JacobianType> js_v(lfsv.size());
-            lfsv.finiteElement().localBasis().evaluateJacobian(it->position(),js_v);
-#else
-            const std::vector<JacobianType>& js = cache[order].evaluateJacobian(it->position(),lfsu.finiteElement().localBasis());
-            const std::vector<JacobianType>& js_v = cache[order].evaluateJacobian(it->position(),lfsv.finiteElement().localBasis());
-#endif
-
-            // transform gradients of shape functions to real element
-            jac = eg.geometry().jacobianInverseTransposed(it->position());
-            std::vector<Dune::FieldVector<RF,dim> > gradphi(lfsu.size());
-            for (size_type i=0; i<lfsu.size(); i++)
-              jac.mv(js[i][0],gradphi[i]);
-
-            std::vector<Dune::FieldVector<RF,dim> > gradpsi(lfsv.size());
-            for (size_type i=0; i<lfsv.size(); i++)
-              jac.mv(js_v[i][0],gradpsi[i]);
-
-            // compute gradient of u
-            Dune::FieldVector<RF,dim> gradu(0.0);
-            for (size_type i=0; i<lfsu.size(); i++)
-              gradu.axpy(x(lfsu,i),gradphi[i]);
-
-            // compute A * gradient of u
-            Dune::FieldVector<RF,dim> Agradu(0.0);
-            A.umv(gradu,Agradu);
-
-            // evaluate velocity field
-            typename T::Traits::RangeType b = param.b(eg.entity(),it->position());
-
-            // evaluate reaction term
-            typename T::Traits::RangeFieldType c = param.c(eg.entity(),it->position());
-
-            // integrate (A grad u - bu)*grad phi_i + a*u*phi_i
-            RF factor = it->weight() * eg.geometry().integrationElement(it->position());
-            for (size_type i=0; i<lfsv.size(); i++)
-              r.accumulate(lfsv,i,( Agradu*gradpsi[i] - u*(b*gradpsi[i]) + c*u*psi[i] )*factor);
-          }
+        // finite element maps with dispatch(), e.g. the variable order maps, pass the
+        // finite element of the cell as its concrete type, so the kernel evaluates the
+        // basis without virtual calls
+        impl::dispatch_finite_element(lfsu.gridFunctionSpace().finiteElementMap(),eg.entity(),
+                                      lfsu.finiteElement(),
+                                      AlphaVolumeKernel<EG,LFSU,X,LFSV,R>(*this,eg,lfsu,x,lfsv,r));
       }
 
       // jacobian of volume term
@@ -1072,6 +990,161 @@ namespace Dune {
       Real alpha, beta;
       int intorderadd;
       int quadrature_factor;
+      // volume integral with the trial finite element fe, which is either the finite
+      // element of lfsu or the same element as its concrete type
+      template<typename FE, typename EG, typename LFSU, typename X, typename LFSV, typename R>
+      void alpha_volume_kernel (const FE& fe, const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, R& r) const
+      {
+        // domain and range field type
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::DomainFieldType DF;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeFieldType RF;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::JacobianType JacobianType;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeType RangeType;
+        typedef typename LFSU::Traits::SizeType size_type;
+
+        // dimensions
+        const int dim = EG::Geometry::dimension;
+        const int order = std::max(lfsu.finiteElement().localBasis().order(),
+            lfsv.finiteElement().localBasis().order());
+        const int intorder = intorderadd + quadrature_factor * order;
+
+        // select quadrature rule
+        Dune::GeometryType gt = eg.geometry().type();
+        const Dune::QuadratureRule<DF,dim>& rule = Dune::QuadratureRules<DF,dim>::rule(gt,intorder);
+
+        // evaluate diffusion tensor at cell center, assume it is constant over elements
+        typename T::Traits::PermTensorType A;
+        Dune::FieldVector<DF,dim> localcenter = Dune::ReferenceElements<DF,dim>::general(gt).position(0,0);
+        A = param.A(eg.entity(),localcenter);
+
+        // transformation
+        typename EG::Geometry::JacobianInverseTransposed jac;
+
+#if USECACHE!=0
+        std::vector<RangeType> phi_buffer;
+        std::vector<JacobianType> js_buffer;
+#endif
+
+        // loop over quadrature points
+        for (typename Dune::QuadratureRule<DF,dim>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
+          {
+            // evaluate basis functions
+#if USECACHE==0
+            std::vector<RangeType> phi(lfsu.size());
+            fe.localBasis().evaluateFunction(it->position(),phi);
+            std::vector<RangeType> psi(lfsv.size());
+            lfsv.finiteElement().localBasis().evaluateFunction(it->position(),psi);
+#else
+            // like the cache, this assumes the same basis for trial and test functions
+            const std::vector<RangeType>& phi = functionValues(fe,order,it->position(),phi_buffer);
+            const std::vector<RangeType>& psi = phi;
+#endif
+
+            // evaluate u
+            RF u=0.0;
+            for (size_type i=0; i<lfsu.size(); i++)
+              u += x(lfsu,i)*phi[i];
+
+            // evaluate gradient of basis functions
+#if USECACHE==0
+            std::vector<JacobianType> js(lfsu.size());
+            fe.localBasis().evaluateJacobian(it->position(),js);
+            std::vector<JacobianType> js_v(lfsv.size());
+            lfsv.finiteElement().localBasis().evaluateJacobian(it->position(),js_v);
+#else
+            const std::vector<JacobianType>& js = jacobianValues(fe,order,it->position(),js_buffer);
+            const std::vector<JacobianType>& js_v = js;
+#endif
+
+            // transform gradients of shape functions to real element
+            jac = eg.geometry().jacobianInverseTransposed(it->position());
+            std::vector<Dune::FieldVector<RF,dim> > gradphi(lfsu.size());
+            for (size_type i=0; i<lfsu.size(); i++)
+              jac.mv(js[i][0],gradphi[i]);
+
+            std::vector<Dune::FieldVector<RF,dim> > gradpsi(lfsv.size());
+            for (size_type i=0; i<lfsv.size(); i++)
+              jac.mv(js_v[i][0],gradpsi[i]);
+
+            // compute gradient of u
+            Dune::FieldVector<RF,dim> gradu(0.0);
+            for (size_type i=0; i<lfsu.size(); i++)
+              gradu.axpy(x(lfsu,i),gradphi[i]);
+
+            // compute A * gradient of u
+            Dune::FieldVector<RF,dim> Agradu(0.0);
+            A.umv(gradu,Agradu);
+
+            // evaluate velocity field
+            typename T::Traits::RangeType b = param.b(eg.entity(),it->position());
+
+            // evaluate reaction term
+            typename T::Traits::RangeFieldType c = param.c(eg.entity(),it->position());
+
+            // integrate (A grad u - bu)*grad phi_i + a*u*phi_i
+            RF factor = it->weight() * eg.geometry().integrationElement(it->position());
+            for (size_type i=0; i<lfsv.size(); i++)
+              r.accumulate(lfsv,i,( Agradu*gradpsi[i] - u*(b*gradpsi[i]) + c*u*psi[i] )*factor);
+          }
+      }
+
+      // calls alpha_volume_kernel() with the finite element passed by the dispatch
+      template<typename EG, typename LFSU, typename X, typename LFSV, typename R>
+      struct AlphaVolumeKernel
+      {
+        AlphaVolumeKernel (const ConvectionDiffusionDG& lop_, const EG& eg_, const LFSU& lfsu_,
+                           const X& x_, const LFSV& lfsv_, R& r_)
+          : lop(lop_), eg(eg_), lfsu(lfsu_), x(x_), lfsv(lfsv_), r(r_)
+        {}
+
+        template<typename FE>
+        void operator() (const FE& fe) const
+        {
+          lop.alpha_volume_kernel(fe,eg,lfsu,x,lfsv,r);
+        }
+
+        const ConvectionDiffusionDG& lop;
+        const EG& eg;
+        const LFSU& lfsu;
+        const X& x;
+        const LFSV& lfsv;
+        R& r;
+      };
+
+      // basis function values and jacobians at x: the finite elements of the map are
+      // evaluated through the cache, dispatched finite elements directly into buffer
+      template<typename FE, typename D, typename V>
+      const V& functionValues (const FE& fe, int order, const D& x, V& buffer) const
+      {
+        fe.localBasis().evaluateFunction(x,buffer);
+        return buffer;
+      }
+
+      template<typename D, typename V>
+      const V& functionValues (const typename FiniteElementMap::Traits::FiniteElementType& fe,
+                               int order, const D& x, V& buffer) const
+      {
+        return cache[order].evaluateFunction(x,fe.localBasis());
+      }
+
+      template<typename FE, typename D, typename V>
+      const V& jacobianValues (const FE& fe, int order, const D& x, V& buffer) const
+      {
+        fe.localBasis().evaluateJacobian(x,buffer);
+        return buffer;
+      }
+
+      template<typename D, typename V>
+      const V& jacobianValues (const typename FiniteElementMap::Traits::FiniteElementType& fe,
+                               int order, const D& x, V& buffer) const
+      {
+        return cache[order].evaluateJacobian(x,fe.localBasis());
+      }
+
       Real theta;
       typedef typename FiniteElementMap::Traits::FiniteElementType::Traits::LocalBasisType LocalBasisType;
 
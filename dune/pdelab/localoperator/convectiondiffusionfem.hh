@@ -39,11 +39,10 @@ namespace Dune {
     class ConvectionDiffusionFEM :
       public Dune::PDELab::NumericalJacobianApplyVolume<ConvectionDiffusionFEM<T,FiniteElementMap> >,
       public Dune::PDELab::NumericalJacobianApplyBoundary<ConvectionDiffusionFEM<T,FiniteElementMap> >,
-      public Dune::PDELab::NumericalJacobianVolume<ConvectionDiffusionFEM<T,FiniteElementMap> >,
-      public Dune::PDELab::NumericalJacobianBoundary<ConvectionDiffusionFEM<T,FiniteElementMap> >,
       public Dune::PDELab::FullVolumePattern,
       public Dune::PDELab::LocalOperatorDefaultFlags,
-      public Dune::PDELab::InstationaryLocalOperatorDefaultMethods<typename T::Traits::RangeFieldType>
+      public Dune::PDELab::InstationaryLocalOperatorDefaultMethods<typename T::Traits::RangeFieldType>,
+      public Dune::PDELab::lop::AlphaAndJacobian
     {
     public:
       // pattern assembly flags
@@ -198,6 +197,82 @@ namespace Dune {
           }
       }
 
+      // volume integral and its jacobian, sharing the evaluations at the quadrature points
+      template<typename EG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+      void alpha_and_jacobian_volume (const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                                      R& r, M& mat) const
+      {
+        // domain and range field type
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::DomainFieldType DF;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeFieldType RF;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::JacobianType JacobianType;
+        typedef typename LFSU::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeType RangeType;
+        typedef typename LFSU::Traits::SizeType size_type;
+
+        // dimensions
+        const int dim = EG::Geometry::dimension;
+
+        // select quadrature rule
+        Dune::GeometryType gt = eg.geometry().type();
+        const int intorder = intorderadd+2*lfsu.finiteElement().localBasis().order();
+        const Dune::QuadratureRule<DF,dim>& rule = Dune::QuadratureRules<DF,dim>::rule(gt,intorder);
+
+        // evaluate diffusion tensor at cell center, assume it is constant over elements
+        typename T::Traits::PermTensorType tensor;
+        Dune::FieldVector<DF,dim> localcenter = Dune::ReferenceElements<DF,dim>::general(gt).position(0,0);
+        tensor = param.A(eg.entity(),localcenter);
+
+        std::vector<Dune::FieldVector<RF,dim> > gradphi(lfsu.size());
+        std::vector<Dune::FieldVector<RF,dim> > Agradphi(lfsu.size());
+
+        // loop over quadrature points
+        for (typename Dune::QuadratureRule<DF,dim>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
+          {
+            // evaluate basis functions and their gradients (we assume Galerkin method lfsu=lfsv)
+            const std::vector<RangeType>& phi = cache.evaluateFunction(it->position(),lfsu.finiteElement().localBasis());
+            const std::vector<JacobianType>& js = cache.evaluateJacobian(it->position(),lfsu.finiteElement().localBasis());
+
+            // transform gradients of shape functions to real element
+            const typename EG::Geometry::JacobianInverseTransposed jac =
+              eg.geometry().jacobianInverseTransposed(it->position());
+            for (size_type i=0; i<lfsu.size(); i++)
+              {
+                jac.mv(js[i][0],gradphi[i]);
+                tensor.mv(gradphi[i],Agradphi[i]);
+              }
+
+            // evaluate u and A * gradient of u
+            RF u=0.0;
+            Dune::FieldVector<RF,dim> Agradu(0.0);
+            for (size_type i=0; i<lfsu.size(); i++)
+              {
+                u += x(lfsu,i)*phi[i];
+                Agradu.axpy(x(lfsu,i),Agradphi[i]);
+              }
+
+            // evaluate velocity field, sink term and source term
+            typename T::Traits::RangeType b = param.b(eg.entity(),it->position());
+            typename T::Traits::RangeFieldType c = param.c(eg.entity(),it->position());
+            typename T::Traits::RangeFieldType f = param.f(eg.entity(),it->position());
+
+            RF factor = it->weight() * eg.geometry().integrationElement(it->position());
+            for (size_type i=0; i<lfsu.size(); i++)
+              {
+                // integrate (A grad u)*grad phi_i - u b*grad phi_i + c*u*phi_i
+                const RF bgradphi = b*gradphi[i];
+                r.accumulate(lfsu,i,( Agradu*gradphi[i] - u*bgradphi + (c*u-f)*phi[i] )*factor);
+
+                // integrate (A grad phi_j)*grad phi_i - phi_j b*grad phi_i + c*phi_j*phi_i
+                for (size_type j=0; j<lfsu.size(); j++)
+                  mat.accumulate(lfsu,i,lfsu,j,( Agradphi[j]*gradphi[i]-phi[j]*bgradphi+c*phi[j]*phi[i] )*factor);
+              }
+          }
+      }
+
       // boundary integral
       template<typename IG, typename LFSU, typename X, typename LFSV, typename R>
       void alpha_boundary (const IG& ig,
@@ -330,6 +405,85 @@ namespace Dune {
           }
       }
 
+      // boundary integral and its jacobian, sharing the evaluations at the quadrature points
+      template<typename IG, typename LFSU, typename X, typename LFSV, typename R, typename M>
+      void alpha_and_jacobian_boundary (const IG& ig,
+                                        const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+                                        R& r_s, M& mat_s) const
+      {
+        // domain and range field type
+        typedef typename LFSV::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::DomainFieldType DF;
+        typedef typename LFSV::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeFieldType RF;
+        typedef typename LFSV::Traits::FiniteElementType::
+          Traits::LocalBasisType::Traits::RangeType RangeType;
+
+        typedef typename LFSV::Traits::SizeType size_type;
+
+        // dimensions
+        const int dim = IG::dimension;
+
+        // evaluate boundary condition type
+        Dune::GeometryType gtface = ig.geometryInInside().type();
+        Dune::FieldVector<DF,dim-1> facecenterlocal = Dune::ReferenceElements<DF,dim-1>::general(gtface).position(0,0);
+        ConvectionDiffusionBoundaryConditions::Type bctype;
+        bctype = param.bctype(ig.intersection(),facecenterlocal);
+
+        // skip rest if we are on Dirichlet boundary
+        if (bctype==ConvectionDiffusionBoundaryConditions::Dirichlet) return;
+
+        // select quadrature rule
+        const int intorder = intorderadd+2*lfsu_s.finiteElement().localBasis().order();
+        const Dune::QuadratureRule<DF,dim-1>& rule = Dune::QuadratureRules<DF,dim-1>::rule(gtface,intorder);
+
+        // loop over quadrature points and integrate normal flux
+        for (typename Dune::QuadratureRule<DF,dim-1>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
+          {
+            // position of quadrature point in local coordinates of element
+            Dune::FieldVector<DF,dim> local = ig.geometryInInside().global(it->position());
+
+            // evaluate shape functions (assume Galerkin method)
+            const std::vector<RangeType>& phi = cache.evaluateFunction(local,lfsu_s.finiteElement().localBasis());
+
+            RF factor = it->weight()*ig.geometry().integrationElement(it->position());
+
+            if (bctype==ConvectionDiffusionBoundaryConditions::Neumann)
+              {
+                // evaluate flux boundary condition
+                typename T::Traits::RangeFieldType j = param.j(ig.intersection(),it->position());
+
+                // integrate j, there is no jacobian contribution
+                for (size_type i=0; i<lfsu_s.size(); i++)
+                  r_s.accumulate(lfsu_s,i,j*phi[i]*factor);
+              }
+
+            if (bctype==ConvectionDiffusionBoundaryConditions::Outflow)
+              {
+                // evaluate u
+                RF u=0.0;
+                for (size_type i=0; i<lfsu_s.size(); i++)
+                  u += x_s(lfsu_s,i)*phi[i];
+
+                // evaluate velocity field and outer unit normal
+                typename T::Traits::RangeType b = param.b(*(ig.inside()),local);
+                const Dune::FieldVector<DF,dim> n = ig.unitOuterNormal(it->position());
+                const RF bn = b*n;
+
+                // evaluate outflow boundary condition
+                typename T::Traits::RangeFieldType o = param.o(ig.intersection(),it->position());
+
+                // integrate o and the derivative of the outflow term
+                for (size_type i=0; i<lfsu_s.size(); i++)
+                  {
+                    r_s.accumulate(lfsu_s,i,( bn*u + o)*phi[i]*factor);
+                    for (size_type j=0; j<lfsu_s.size(); j++)
+                      mat_s.accumulate(lfsu_s,i,lfsu_s,j,bn*phi[j]*phi[i]*factor);
+                  }
+              }
+          }
+      }
+
 
       //! set time in parameter class
       void setTime (double t)
@@ -353,6 +507,11 @@ namespace Dune {
      * of the cell indicator \eta_T is stored. To compute the global
      * error estimate sum up all values and take the square root.
      *
+     * Instead of setting up a separate grid operator, the estimate can
+     * be computed during the residual evaluation of the discretization
+     * with GridOperator::residual_and_estimate(), which reuses the
+     * traversal and the local coefficients of the solution.
+     *
      * Assumptions and limitations:
      * - Assumes that LFSU is P_k/Q_k finite element space
      *   and LFSV is a P_0 finite element space (one value per cell).
@@ -14,6 +14,7 @@
 #include<dune/pdelab/common/functionutilities.hh>
 #include<dune/pdelab/constraints/common/constraintsparameters.hh>
 
+#include"coefficientcache.hh"
 #include"diffusionparam.hh"
 
 namespace Dune {
@@ -156,6 +157,156 @@ namespace Dune {
     };
 
 
+    /** \brief Parameter class that stores the coefficients of another parameter class
+     *
+     * Wraps a model of the convection-diffusion parameter interface and
+     * evaluates the coefficients A, b, c and f only once per cell and local
+     * coordinate; later calls at the same point return the stored value.
+     * This pays off when the coefficients are expensive to evaluate (table
+     * lookups, geostatistical fields, ...) and the operator is assembled
+     * repeatedly, e.g. in every Newton iteration or time step. Coefficients
+     * that are constant on each cell can be selected in the constructor; they
+     * are evaluated once per cell, at the first point requested.
+     *
+     * The stored values are discarded by invalidate() and, unless the
+     * coefficients are declared time independent, whenever setTime() is
+     * called with a new time. The boundary condition methods are forwarded
+     * unchanged.
+     *
+     * \note The coefficients must depend on the cell and the local coordinate
+     *       only. The cache has to be recreated after the grid has been
+     *       modified.
+     *
+     * \tparam T model of ConvectionDiffusionParameterInterface
+     */
+    template<typename T>
+    class ConvectionDiffusionParameterCache
+    {
+      typedef ConvectionDiffusionBoundaryConditions::Type BCType;
+
+    public:
+      typedef typename T::Traits Traits;
+
+      //! Coefficients that are constant on each cell.
+      enum Cellwise { diffusion = 1, velocity = 2, reaction = 4, source = 8 };
+
+      /** \brief Constructor
+       *
+       * \param gv             the grid view of the operator
+       * \param param          the wrapped parameter object
+       * \param cellwise       bitwise or of the coefficients that are constant on each cell
+       * \param time_dependent whether a new time invalidates the stored values
+       */
+      ConvectionDiffusionParameterCache (const typename Traits::GridViewType& gv, T& param,
+                                         unsigned int cellwise = 0, bool time_dependent = true)
+        : _param(param)
+        , _time_dependent(time_dependent)
+        , _time_set(false)
+        , _time(0.0)
+        , _A(gv,cellwise & diffusion)
+        , _b(gv,cellwise & velocity)
+        , _c(gv,cellwise & reaction)
+        , _f(gv,cellwise & source)
+      {}
+
+      //! tensor diffusion coefficient
+      typename Traits::PermTensorType
+      A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const typename Traits::PermTensorType* value = _A.find(e,x);
+        return value ? *value : _A.insert(e,x,_param.A(e,x));
+      }
+
+      //! velocity field
+      typename Traits::RangeType
+      b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const typename Traits::RangeType* value = _b.find(e,x);
+        return value ? *value : _b.insert(e,x,_param.b(e,x));
+      }
+
+      //! sink term
+      typename Traits::RangeFieldType
+      c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const typename Traits::RangeFieldType* value = _c.find(e,x);
+        return value ? *value : _c.insert(e,x,_param.c(e,x));
+      }
+
+      //! source term
+      typename Traits::RangeFieldType
+      f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const typename Traits::RangeFieldType* value = _f.find(e,x);
+        return value ? *value : _f.insert(e,x,_param.f(e,x));
+      }
+
+      //! boundary condition type function
+      BCType
+      bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+      {
+        return _param.bctype(is,x);
+      }
+
+      //! Dirichlet boundary condition value
+      typename Traits::RangeFieldType
+      g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        return _param.g(e,x);
+      }
+
+      //! Neumann boundary condition
+      typename Traits::RangeFieldType
+      j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+      {
+        return _param.j(is,x);
+      }
+
+      //! outflow boundary condition
+      typename Traits::RangeFieldType
+      o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+      {
+        return _param.o(is,x);
+      }
+
+      //! set time, discarding the stored values if the time has changed
+      template<typename TT>
+      void setTime (TT t)
+      {
+        if (_time_dependent && (!_time_set || t != _time))
+          invalidate();
+        _time_set = true;
+        _time = t;
+        _param.setTime(t);
+      }
+
+      //! discard all stored values
+      void invalidate ()
+      {
+        _A.clear();
+        _b.clear();
+        _c.clear();
+        _f.clear();
+      }
+
+      //! the wrapped parameter object
+      T& param () const
+      {
+        return _param;
+      }
+
+    private:
+      T& _param;
+      bool _time_dependent;
+      bool _time_set;
+      double _time;
+      mutable CoefficientCache<typename Traits::GridViewType,typename Traits::PermTensorType> _A;
+      mutable CoefficientCache<typename Traits::GridViewType,typename Traits::RangeType> _b;
+      mutable CoefficientCache<typename Traits::GridViewType,typename Traits::RangeFieldType> _c;
+      mutable CoefficientCache<typename Traits::GridViewType,typename Traits::RangeFieldType> _f;
+    };
+
+
     /*! Adapter that extracts boundary condition type function from parameter class
 
       \tparam T  model of ConvectionDiffusionParameterInterface
@@ -3,7 +3,9 @@
 #ifndef DUNE_PDELAB_LOCALOPERATOR_DEFAULTIMP_HH
 #define DUNE_PDELAB_LOCALOPERATOR_DEFAULTIMP_HH
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
@@ -16,6 +18,31 @@ namespace Dune {
     //! \ingroup LocalOperator
     //! \{
 
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // largest absolute value of the local coefficients of x on lfs
+      template<typename LFS, typename X>
+      typename X::value_type local_max_abs(const LFS& lfs, const X& x)
+      {
+        typename X::value_type r(0);
+        for (std::size_t i = 0; i < lfs.size(); ++i)
+          r = std::max(r,typename X::value_type(std::abs(x(lfs,i))));
+        return r;
+      }
+
+      // step size for a finite difference at x in direction z, 0 if z vanishes
+      template<typename D>
+      D directional_difference_step(double epsilon, D x_max, D z_max)
+      {
+        return z_max > D(0) ? D(epsilon*(1.0+x_max)/z_max) : D(0);
+      }
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
     ////////////////////////////////////////////////////////////////////////
     //
     //  Numerical implementation of jacobian_*() in terms of alpha_*()
@@ -50,7 +77,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Jacobian::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type,LocalMatrixStaticRowCapacity<Jacobian>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m=lfsv.size();
@@ -114,7 +141,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Jacobian::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type,LocalMatrixStaticRowCapacity<Jacobian>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m=lfsv.size();
@@ -177,7 +204,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Jacobian::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type,LocalMatrixStaticRowCapacity<Jacobian>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m_s=lfsv_s.size();
@@ -269,7 +296,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Jacobian::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Jacobian::weight_type,LocalMatrixStaticRowCapacity<Jacobian>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m_s=lfsv_s.size();
@@ -339,7 +366,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Y::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m=lfsv.size();
@@ -365,6 +392,47 @@ namespace Dune {
         }
       }
 
+      //! apply local jacobian of the volume term, evaluated at x, to z
+      /**
+       * Uses a single finite difference of alpha_volume() in direction z
+       * instead of one per local degree of freedom.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        typedef typename X::value_type D;
+        typedef typename Y::value_type R;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
+        typedef typename ResidualVector::WeightedAccumulationView ResidualView;
+
+        const int m=lfsv.size();
+        const int n=lfsu.size();
+
+        const D delta = impl::directional_difference_step(epsilon,
+                                                          impl::local_max_abs(lfsu,x),
+                                                          D(impl::local_max_abs(lfsu,z)));
+        if (delta == D(0))
+          return;
+
+        X u(x);
+        for (int j=0; j<n; j++)
+          u(lfsu,j) += delta*z(lfsu,j);
+
+        // Notice that in general lfsv.size() != y.size()
+        ResidualVector down(y.size()),up(y.size());
+        ResidualView downview = down.weightedAccumulationView(y.weight());
+        ResidualView upview = up.weightedAccumulationView(y.weight());
+
+        asImp().alpha_volume(eg,lfsu,x,lfsv,downview);
+        asImp().alpha_volume(eg,lfsu,u,lfsv,upview);
+        for (int i=0; i<m; i++)
+          y.rawAccumulate(lfsv,i,(up(lfsv,i)-down(lfsv,i))/delta);
+      }
+
     private:
       const double epsilon; // problem: this depends on data type R!
       Imp& asImp () { return static_cast<Imp &> (*this); }
@@ -402,7 +470,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Y::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m=lfsv.size();
@@ -428,6 +496,47 @@ namespace Dune {
         }
       }
 
+      //! apply local jacobian of the volume term (post skeleton part), evaluated at x, to z
+      /**
+       * Uses a single finite difference of alpha_volume_post_skeleton() in direction z
+       * instead of one per local degree of freedom.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_volume_post_skeleton
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        typedef typename X::value_type D;
+        typedef typename Y::value_type R;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
+        typedef typename ResidualVector::WeightedAccumulationView ResidualView;
+
+        const int m=lfsv.size();
+        const int n=lfsu.size();
+
+        const D delta = impl::directional_difference_step(epsilon,
+                                                          impl::local_max_abs(lfsu,x),
+                                                          D(impl::local_max_abs(lfsu,z)));
+        if (delta == D(0))
+          return;
+
+        X u(x);
+        for (int j=0; j<n; j++)
+          u(lfsu,j) += delta*z(lfsu,j);
+
+        // Notice that in general lfsv.size() != y.size()
+        ResidualVector down(y.size()),up(y.size());
+        ResidualView downview = down.weightedAccumulationView(y.weight());
+        ResidualView upview = up.weightedAccumulationView(y.weight());
+
+        asImp().alpha_volume_post_skeleton(eg,lfsu,x,lfsv,downview);
+        asImp().alpha_volume_post_skeleton(eg,lfsu,u,lfsv,upview);
+        for (int i=0; i<m; i++)
+          y.rawAccumulate(lfsv,i,(up(lfsv,i)-down(lfsv,i))/delta);
+      }
+
     private:
       const double epsilon; // problem: this depends on data type R!
       Imp& asImp () {return static_cast<Imp &> (*this);}
@@ -464,7 +573,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Y::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m_s=lfsv_s.size();
@@ -521,6 +630,62 @@ namespace Dune {
         }
       }
 
+      //! apply local jacobian of the skeleton term, evaluated at x, to z
+      /**
+       * Uses a single finite difference of alpha_skeleton() in direction
+       * (z_s,z_n) instead of one per local degree of freedom.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n) const
+      {
+        typedef typename X::value_type D;
+        typedef typename Y::value_type R;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
+        typedef typename ResidualVector::WeightedAccumulationView ResidualView;
+
+        const int m_s=lfsv_s.size();
+        const int m_n=lfsv_n.size();
+        const int n_s=lfsu_s.size();
+        const int n_n=lfsu_n.size();
+
+        const D delta = impl::directional_difference_step(
+          epsilon,
+          std::max(impl::local_max_abs(lfsu_s,x_s),impl::local_max_abs(lfsu_n,x_n)),
+          D(std::max(impl::local_max_abs(lfsu_s,z_s),impl::local_max_abs(lfsu_n,z_n))));
+        if (delta == D(0))
+          return;
+
+        X u_s(x_s);
+        X u_n(x_n);
+        for (int j=0; j<n_s; j++)
+          u_s(lfsu_s,j) += delta*z_s(lfsu_s,j);
+        for (int j=0; j<n_n; j++)
+          u_n(lfsu_n,j) += delta*z_n(lfsu_n,j);
+
+        // Notice that in general lfsv_s.size() != y_s.size()
+        ResidualVector down_s(y_s.size()),up_s(y_s.size());
+        ResidualView downview_s = down_s.weightedAccumulationView(1.0);
+        ResidualView upview_s = up_s.weightedAccumulationView(1.0);
+
+        ResidualVector down_n(y_n.size()),up_n(y_n.size());
+        ResidualView downview_n = down_n.weightedAccumulationView(1.0);
+        ResidualView upview_n = up_n.weightedAccumulationView(1.0);
+
+        asImp().alpha_skeleton(ig,lfsu_s,x_s,lfsv_s,lfsu_n,x_n,lfsv_n,downview_s,
+                               downview_n);
+        asImp().alpha_skeleton(ig,lfsu_s,u_s,lfsv_s,lfsu_n,u_n,lfsv_n,upview_s,
+                               upview_n);
+        for (int i=0; i<m_s; i++)
+          y_s.accumulate(lfsv_s,i,(up_s(lfsv_s,i)-down_s(lfsv_s,i))/delta);
+        for (int i=0; i<m_n; i++)
+          y_n.accumulate(lfsv_n,i,(up_n(lfsv_n,i)-down_n(lfsv_n,i))/delta);
+      }
+
     private:
       const double epsilon; // problem: this depends on data type R!
       Imp& asImp () { return static_cast<Imp &> (*this); }
@@ -556,7 +721,7 @@ namespace Dune {
       {
         typedef typename X::value_type D;
         typedef typename Y::value_type R;
-        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type> ResidualVector;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
         typedef typename ResidualVector::WeightedAccumulationView ResidualView;
 
         const int m_s=lfsv_s.size();
@@ -585,6 +750,47 @@ namespace Dune {
         }
       }
 
+      //! apply local jacobian of the boundary term, evaluated at x, to z
+      /**
+       * Uses a single finite difference of alpha_boundary() in direction z
+       * instead of one per local degree of freedom.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s) const
+      {
+        typedef typename X::value_type D;
+        typedef typename Y::value_type R;
+        typedef LocalVector<R,TestSpaceTag,typename Y::weight_type,LocalVectorStaticCapacity<Y>::value> ResidualVector;
+        typedef typename ResidualVector::WeightedAccumulationView ResidualView;
+
+        const int m_s=lfsv_s.size();
+        const int n_s=lfsu_s.size();
+
+        const D delta = impl::directional_difference_step(epsilon,
+                                                          impl::local_max_abs(lfsu_s,x_s),
+                                                          D(impl::local_max_abs(lfsu_s,z_s)));
+        if (delta == D(0))
+          return;
+
+        X u_s(x_s);
+        for (int j=0; j<n_s; j++)
+          u_s(lfsu_s,j) += delta*z_s(lfsu_s,j);
+
+        // Notice that in general lfsv_s.size() != y_s.size()
+        ResidualVector down_s(y_s.size()),up_s(y_s.size());
+        ResidualView downview_s = down_s.weightedAccumulationView(y_s.weight());
+        ResidualView upview_s = up_s.weightedAccumulationView(y_s.weight());
+
+        asImp().alpha_boundary(ig,lfsu_s,x_s,lfsv_s,downview_s);
+        asImp().alpha_boundary(ig,lfsu_s,u_s,lfsv_s,upview_s);
+        for (int i=0; i<m_s; i++)
+          y_s.rawAccumulate(lfsv_s,i,(up_s(lfsv_s,i)-down_s(lfsv_s,i))/delta);
+      }
+
     private:
       const double epsilon; // problem: this depends on data type R!
       Imp& asImp () { return static_cast<Imp &> (*this); }
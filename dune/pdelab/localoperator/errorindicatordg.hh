@@ -37,6 +37,11 @@ namespace Dune {
      * of the cell indicator \eta_T is stored. To compute the global
      * error estimate sum up all values and take the square root.
      *
+     * Instead of setting up a separate grid operator, the estimate can
+     * be computed during the residual evaluation of the discretization
+     * with GridOperator::residual_and_estimate(), which reuses the
+     * traversal and the local coefficients of the solution.
+     *
      * Assumptions and limitations:
      * - Assumes that LFSU is P_1/Q_1 finite element space
      *   and LFSV is a P_0 finite element space (one value per cell).
@@ -79,6 +79,17 @@ namespace Dune
 
             //! \brief Whether to visit the skeleton methods from both sides
             enum { /*! \hideinitializer */ doSkeletonTwoSided = false };
+            //! \brief Whether the residual is affine linear in the trial
+            //!        function.
+            /**
+             * For linear local operators the jacobian does not depend on the
+             * linearization point, so the application of the jacobian at a
+             * linearization point x to a vector z falls back to the
+             * jacobian_apply_*() methods with z only.  Nonlinear local
+             * operators have to provide the jacobian_apply_*() variants that
+             * take x and z.
+             */
+            enum { /*! \hideinitializer */ isLinear = false };
 
             //! \} Special flags
         };
@@ -98,6 +109,19 @@ namespace Dune
             struct DiagonalJacobian
             {};
 
+            //! Decorator base class for local operators that can compute residual and jacobian together.
+            /**
+             * By inheriting from this decorator class, local operators assert that
+             * they implement alpha_and_jacobian_volume(), alpha_and_jacobian_skeleton()
+             * and alpha_and_jacobian_boundary() for all of doAlphaVolume, doAlphaSkeleton
+             * and doAlphaBoundary that are set. A combined residual and jacobian assembly
+             * will then call these methods instead of the separate alpha_*() and jacobian_*()
+             * methods, which allows the local operator to evaluate coefficients, basis functions
+             * and geometry only once per quadrature point.
+             */
+            struct AlphaAndJacobian
+            {};
+
         }
 
         //! \} group LocalOperator
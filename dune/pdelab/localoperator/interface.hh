@@ -575,6 +575,106 @@ namespace Dune {
 
       //! \} Methods for the application of the jacobian
 
+      //////////////////////////////////////////////////////////////////////
+      //
+      //! \name Methods for the application of the jacobian at a linearization point
+      //! \{
+      //
+      // These methods are used by GridOperator::jacobian_apply(x,z,y).  They
+      // are only required from local operators with isLinear == false; for
+      // linear local operators the methods above are called with z instead.
+      //
+
+      //! apply an element's jacobian, evaluated at x, to z
+      /**
+       * \param eg   ElementGeometry describing the entity.
+       * \param lfsu LocalFunctionSpace of the trial GridFunctionSpace.
+       * \param x    Local position in the trial GridFunctionSpace where the
+       *             jacobian is evaluated.
+       * \param z    Local coefficients of the vector the jacobian is applied to.
+       * \param lfsv LocalFunctionSpace of the test GridFunctionSpace.
+       * \param y    Where to store the result.
+       *
+       * \note The method should not clear \c y; it should just add its
+       *       entries to it.
+       *
+       * This method is controlled by the flag \ref doAlphaVolume.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y);
+
+      //! \brief apply an element's jacobian, evaluated at x, to z after the
+      //!        intersections have been handled
+      /**
+       * The parameters are the same as for the corresponding
+       * jacobian_apply_volume().
+       *
+       * This method is controlled by the flag \ref doAlphaVolumePostSkeleton.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_volume_post_skeleton
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y);
+
+      //! apply an internal intersections's jacobians, evaluated at x, to z
+      /**
+       * \param ig     IntersectionGeometry describing the intersection.
+       * \param lfsu_s LocalFunctionSpace of the trial GridFunctionSpace in
+       *               the inside entity.
+       * \param x_s    Local linearization point in the inside entity.
+       * \param z_s    Local coefficients of the vector the jacobian is applied
+       *               to in the inside entity.
+       * \param lfsv_s LocalFunctionSpace of the test GridFunctionSpace in the
+       *               inside entity.
+       * \param lfsu_n LocalFunctionSpace of the trial GridFunctionSpace in
+       *               the outside entity.
+       * \param x_n    Local linearization point in the outside entity.
+       * \param z_n    Local coefficients of the vector the jacobian is applied
+       *               to in the outside entity.
+       * \param lfsv_n LocalFunctionSpace of the test GridFunctionSpace in the
+       *               outside entity.
+       * \param y_s    Where to store the inside entity's result.
+       * \param y_n    Where to store the outside entity's result.
+       *
+       * This method is controlled by the flag \ref doAlphaSkeleton.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n);
+
+      //! apply a boundary intersections's jacobian, evaluated at x, to z
+      /**
+       * \param ig     IntersectionGeometry describing the intersection.
+       * \param lfsu_s LocalFunctionSpace of the trial GridFunctionSpace in
+       *               the inside entity.
+       * \param x_s    Local linearization point in the inside entity.
+       * \param z_s    Local coefficients of the vector the jacobian is applied
+       *               to in the inside entity.
+       * \param lfsv_s LocalFunctionSpace of the test GridFunctionSpace in the
+       *               inside entity.
+       * \param y_s    Where to store the result.
+       *
+       * This method is controlled by the flag \ref doAlphaBoundary.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z, typename LFSV,
+               typename Y>
+      void jacobian_apply_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s);
+
+      //! \} Methods for the application of the jacobian at a linearization point
+
       //////////////////////////////////////////////////////////////////////
       //
       //! \name Methods to extract the jacobian
@@ -703,6 +803,71 @@ namespace Dune {
         LocalMatrix& mat_ss);
 
       //! \} Methods to extract the jacobian
+
+      //////////////////////////////////////////////////////////////////////
+      //
+      //! \name Methods to compute residual and jacobian together
+      //! \{
+      //
+      //! These methods are only called for local operators which derive
+      //! from lop::AlphaAndJacobian, and only by the combined residual and
+      //! jacobian assembly (GridOperator::residual_and_jacobian()).  They
+      //! must produce the same contributions as the corresponding calls to
+      //! alpha_*() and jacobian_*().
+
+      //! get an element's residual and jacobian
+      /**
+       * \param eg   ElementGeometry describing the entity.
+       * \param lfsu LocalFunctionSpace of the trial GridFunctionSpace.
+       * \param x    Local position in the trial GridFunctionSpace.
+       * \param lfsv LocalFunctionSpace of the test GridFunctionSpace.
+       * \param r    Local part of the residual.
+       * \param mat  Where to store the contribution to the jacobian.
+       *
+       * This method is controlled by the flag \ref doAlphaVolume and
+       * replaces the calls to alpha_volume() and jacobian_volume().
+       */
+      template<typename EG, typename LFSU, typename X, typename LFSV,
+               typename R, typename LocalMatrix>
+      void alpha_and_jacobian_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const LFSV& lfsv,
+        R& r, LocalMatrix& mat);
+
+      //! get an internal intersection's residual and jacobian
+      /**
+       * The parameters are the union of those of alpha_skeleton() and
+       * jacobian_skeleton().
+       *
+       * This method is controlled by the flag \ref doAlphaSkeleton and
+       * replaces the calls to alpha_skeleton() and jacobian_skeleton().
+       */
+      template<typename IG, typename LFSU, typename X, typename LFSV,
+               typename R, typename LocalMatrix>
+      void alpha_and_jacobian_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const LFSV& lfsv_n,
+        R& r_s, R& r_n,
+        LocalMatrix& mat_ss, LocalMatrix& mat_sn,
+        LocalMatrix& mat_ns, LocalMatrix& mat_nn);
+
+      //! get a boundary intersection's residual and jacobian
+      /**
+       * The parameters are the union of those of alpha_boundary() and
+       * jacobian_boundary().
+       *
+       * This method is controlled by the flag \ref doAlphaBoundary and
+       * replaces the calls to alpha_boundary() and jacobian_boundary().
+       */
+      template<typename IG, typename LFSU, typename X, typename LFSV,
+               typename R, typename LocalMatrix>
+      void alpha_and_jacobian_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const LFSV& lfsv_s,
+        R& r_s, LocalMatrix& mat_ss);
+
+      //! \} Methods to compute residual and jacobian together
     };
 
     //! \} group LocalOperatorDefaultImp
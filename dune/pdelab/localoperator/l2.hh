@@ -42,6 +42,9 @@ namespace Dune {
       // residual assembly flags
       enum { doAlphaVolume = true };
 
+      // shares quadrature data with other summands of composite operators
+      enum { usesQuadratureContext = true };
+
       L2 (int intorder_=2,double scaling=1.0)
         : intorder(intorder_)
         , _scaling(scaling)
@@ -133,6 +136,45 @@ namespace Dune {
           }
       }
 
+      // volume integral from a shared quadrature context
+      template<typename Context, typename LFSV, typename R>
+      void alpha_volume (Context& ctx, const LFSV& lfsv, R& r) const
+      {
+        typedef typename Context::RF RF;
+        typedef typename Context::size_type size_type;
+
+        ctx.bind(intorder,false);
+
+        // loop over quadrature points
+        for (std::size_t q=0; q<ctx.size(); q++)
+          {
+            // u*phi_i
+            RF factor = _scaling * ctx.weight(q);
+            for (size_type i=0; i<ctx.lfsu().size(); i++)
+              r.accumulate(lfsv,i, ctx.u(q)*ctx.phi(q,i)*factor);
+          }
+      }
+
+      // jacobian of volume term from a shared quadrature context
+      template<typename Context, typename LFSV, typename M>
+      void jacobian_volume (Context& ctx, const LFSV& lfsv, M& mat) const
+      {
+        typedef typename Context::RF RF;
+        typedef typename Context::size_type size_type;
+
+        ctx.bind(intorder,false);
+
+        // loop over quadrature points
+        for (std::size_t q=0; q<ctx.size(); q++)
+          {
+            // integrate phi_j*phi_i
+            RF factor = _scaling * ctx.weight(q);
+            for (size_type j=0; j<ctx.lfsu().size(); j++)
+              for (size_type i=0; i<ctx.lfsu().size(); i++)
+                mat.accumulate(lfsv,i,ctx.lfsu(),j, ctx.phi(q,j)*ctx.phi(q,i)*factor);
+          }
+      }
+
     private:
       int intorder;
       const double _scaling;
@@ -44,6 +44,9 @@ namespace Dune {
       // residual assembly flags
       enum { doAlphaVolume = true };
 
+      // shares quadrature data with other summands of composite operators
+      enum { usesQuadratureContext = true };
+
       /** \brief Constructor
        *
        * \param quadOrder Order of the quadrature rule used for integrating over the element
@@ -165,6 +168,72 @@ namespace Dune {
         }
       }
 
+      /** \brief Compute Laplace matrix times a given vector from a shared quadrature context
+       *
+       * Falls back to the plain alpha_volume() if lfsv does not use the
+       * finite element of the context.
+       */
+      template<typename Context, typename LFSV, typename R>
+      void alpha_volume (Context& ctx, const LFSV& lfsv, R& r) const
+      {
+        if (static_cast<const void*>(&lfsv.finiteElement()) !=
+            static_cast<const void*>(&ctx.lfsu().finiteElement()))
+          {
+            alpha_volume(ctx.entityGeometry(), ctx.lfsu(), ctx.x(), lfsv, r);
+            return;
+          }
+
+        typedef typename Context::RF RF;
+
+        ctx.bind(quadOrder_);
+
+        // loop over quadrature points
+        for (std::size_t q=0; q<ctx.size(); q++)
+        {
+          // integrate grad u * grad phi_i
+          RF factor = r.weight() * ctx.weight(q);
+          for (size_t i=0; i<lfsv.size(); i++)
+            r.rawAccumulate(lfsv,i,(ctx.gradu(q)*ctx.gradphi(q,i))*factor);
+        }
+      }
+
+      /** \brief Compute the Laplace stiffness matrix from a shared quadrature context
+       *
+       * Falls back to the plain jacobian_volume() if lfsv does not use the
+       * finite element of the context.
+       */
+      template<typename Context, typename LFSV, typename M>
+      void jacobian_volume (Context& ctx, const LFSV& lfsv, M& matrix) const
+      {
+        if (static_cast<const void*>(&lfsv.finiteElement()) !=
+            static_cast<const void*>(&ctx.lfsu().finiteElement()))
+          {
+            jacobian_volume(ctx.entityGeometry(), ctx.lfsu(), ctx.x(), lfsv, matrix);
+            return;
+          }
+
+        typedef typename Context::RF RF;
+        typedef typename Context::size_type size_type;
+
+        ctx.bind(quadOrder_);
+
+        // loop over quadrature points
+        for (std::size_t q=0; q<ctx.size(); q++)
+        {
+          // geometric weight
+          RF factor = ctx.weight(q);
+
+          for (size_type i=0; i<ctx.lfsu().size(); i++)
+          {
+            for (size_type j=0; j<lfsv.size(); j++)
+            {
+              // integrate grad u * grad phi
+              matrix.accumulate(lfsv,j,ctx.lfsu(),i, ctx.gradphi(q,i) * ctx.gradphi(q,j) * factor);
+            }
+          }
+        }
+      }
+
     protected:
       // Quadrature rule order
       unsigned int quadOrder_;
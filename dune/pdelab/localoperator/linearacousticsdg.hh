@@ -4,7 +4,9 @@
 
 #include<vector>
 
+#include<dune/common/array.hh>
 #include<dune/common/exceptions.hh>
+#include<dune/common/fmatrix.hh>
 #include<dune/common/fvector.hh>
 #include<dune/geometry/referenceelements.hh>
 #include<dune/pdelab/common/geometrywrapper.hh>
@@ -140,6 +142,136 @@ namespace Dune {
       }
     };
 
+    /** \brief Linear acoustics as a linear hyperbolic system
+
+        Provides the flux matrices and the upwind flux projectors of the
+        equations of linear acoustics. The projectors are shared with
+        DGLinearAcousticsSpatialOperator, the remaining methods implement the
+        system interface of LinearHyperbolicDGOperator.
+
+        The speed of sound is evaluated at the cell centers.
+
+        \tparam T parameter class
+    */
+    template<typename T>
+    class LinearAcousticsSystem
+    {
+    public:
+      enum { dim = T::Traits::GridViewType::dimension };
+      //! number of components of the state vector
+      enum { m = dim+1 };
+
+      typedef typename T::Traits::DomainFieldType DF;
+      typedef typename T::Traits::RangeFieldType RF;
+      typedef typename T::Traits::StateType State;
+      typedef Dune::FieldMatrix<RF,m,m> Matrix;
+      typedef typename T::Traits::ElementType Element;
+      typedef typename T::Traits::IntersectionType Intersection;
+      typedef typename T::Traits::IntersectionDomainType IntersectionDomain;
+      typedef typename T::Traits::DomainType Domain;
+
+      LinearAcousticsSystem (T& param_)
+        : param(param_)
+      {}
+
+      //! A+ = c r_+ l_+^T, the flux of the outgoing waves
+      template<typename C, typename F>
+      static void outgoingProjector (C c, const Dune::FieldVector<F,dim>& n, Dune::FieldMatrix<F,dim+1,dim+1>& A_plus)
+      {
+        Dune::FieldMatrix<F,dim+1,dim+1> RT;
+        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c,n,RT);
+        Dune::FieldVector<F,dim+1> alpha;
+        for (int i=0; i<=dim; i++) alpha[i] = RT[dim-1][i]; // row dim-1 corresponds to eigenvalue +c
+        Dune::FieldVector<F,dim+1> unit(0.0);
+        unit[dim-1] = 1.0;
+        Dune::FieldVector<F,dim+1> beta;
+        RT.solve(beta,unit);
+        for (int i=0; i<=dim; i++)
+          for (int j=0; j<=dim; j++)
+            A_plus[i][j] = c*alpha[i]*beta[j];
+      }
+
+      //! A- = -c r_- l_-^T, the flux of the incoming waves
+      template<typename C, typename F>
+      static void incomingProjector (C c, const Dune::FieldVector<F,dim>& n, Dune::FieldMatrix<F,dim+1,dim+1>& A_minus)
+      {
+        Dune::FieldMatrix<F,dim+1,dim+1> RT;
+        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c,n,RT);
+        Dune::FieldVector<F,dim+1> alpha;
+        for (int i=0; i<=dim; i++) alpha[i] = RT[dim][i]; // row dim corresponds to eigenvalue -c
+        Dune::FieldVector<F,dim+1> unit(0.0);
+        unit[dim] = 1.0;
+        Dune::FieldVector<F,dim+1> beta;
+        RT.solve(beta,unit);
+        for (int i=0; i<=dim; i++)
+          for (int j=0; j<=dim; j++)
+            A_minus[i][j] = -c*alpha[i]*beta[j];
+      }
+
+      //! speed of sound at the center of e
+      RF c (const Element& e) const
+      {
+        return param.c(e,Dune::ReferenceElements<DF,dim>::general(e.type()).position(0,0));
+      }
+
+      //! maximal wave speed in e
+      RF maxSpeed (const Element& e) const
+      {
+        return c(e);
+      }
+
+      //! flux F_j(u) = A[j] u and reaction term S u in e
+      void fluxMatrices (const Element& e, Dune::array<Matrix,dim>& A, Matrix& S) const
+      {
+        RF c2 = c(e);
+        c2 = c2*c2;
+        for (int j=0; j<dim; j++)
+          {
+            A[j] = 0.0;
+            A[j][0][j+1] = 1.0;
+            A[j][j+1][0] = c2;
+          }
+        S = 0.0;
+      }
+
+      //! numerical flux A_plus u_s + A_minus u_n on an interior face with unit outer normal n
+      void skeletonProjectors (const Element& inside, const Element& outside, const Dune::FieldVector<DF,dim>& n,
+                               Matrix& A_plus, Matrix& A_minus) const
+      {
+        outgoingProjector(c(inside),n,A_plus);
+        incomingProjector(c(outside),n,A_minus);
+      }
+
+      //! numerical flux A_plus u_s + A_minus g on a boundary face with unit outer normal n
+      void boundaryProjectors (const Element& inside, const Dune::FieldVector<DF,dim>& n,
+                               Matrix& A_plus, Matrix& A_minus) const
+      {
+        outgoingProjector(c(inside),n,A_plus);
+        incomingProjector(c(inside),n,A_minus);
+      }
+
+      //! boundary state g
+      State boundaryState (const Intersection& is, const IntersectionDomain& x, const State& u_s) const
+      {
+        return param.g(is,x,u_s);
+      }
+
+      //! right hand side q
+      State source (const Element& e, const Domain& x) const
+      {
+        return param.q(e,x);
+      }
+
+      //! set time in parameter class
+      void setTime (RF t)
+      {
+        param.setTime(t);
+      }
+
+    private:
+      T& param;
+    };
+
     /** Spatial local operator for discontinuous Galerkin method for the equations
         of linear acoustics in conservative form:
 
@@ -300,29 +432,12 @@ namespace Dune {
         RF c_n = param.c(*(ig.outside()),outside_local);
 
         // compute A+ (outgoing waves)
-        Dune::FieldMatrix<DF,dim+1,dim+1> RT;
-        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c_s,n_F,RT);
-        Dune::FieldVector<DF,dim+1> alpha;
-        for (int i=0; i<=dim; i++) alpha[i] = RT[dim-1][i]; // row dim-1 corresponds to eigenvalue +c
-        Dune::FieldVector<DF,dim+1> unit(0.0);
-        unit[dim-1] = 1.0;
-        Dune::FieldVector<DF,dim+1> beta;
-        RT.solve(beta,unit);
         Dune::FieldMatrix<DF,dim+1,dim+1> A_plus_s;
-        for (int i=0; i<=dim; i++)
-          for (int j=0; j<=dim; j++)
-            A_plus_s[i][j] = c_s*alpha[i]*beta[j];
+        LinearAcousticsSystem<T>::outgoingProjector(c_s,n_F,A_plus_s);
 
         // compute A- (incoming waves)
-        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c_n,n_F,RT);
-        for (int i=0; i<=dim; i++) alpha[i] = RT[dim][i]; // row dim corresponds to eigenvalue -c
-        unit = 0.0;
-        unit[dim] = 1.0;
-        RT.solve(beta,unit);
         Dune::FieldMatrix<DF,dim+1,dim+1> A_minus_n;
-        for (int i=0; i<=dim; i++)
-          for (int j=0; j<=dim; j++)
-            A_minus_n[i][j] = -c_n*alpha[i]*beta[j];
+        LinearAcousticsSystem<T>::incomingProjector(c_n,n_F,A_minus_n);
 
         // select quadrature rule
         const int order_s = dgspace_s.finiteElement().localBasis().order();
@@ -408,29 +523,12 @@ namespace Dune {
         RF c_s = param.c(*(ig.inside()),inside_local);
 
         // compute A+ (outgoing waves)
-        Dune::FieldMatrix<DF,dim+1,dim+1> RT;
-        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c_s,n_F,RT);
-        Dune::FieldVector<DF,dim+1> alpha;
-        for (int i=0; i<=dim; i++) alpha[i] = RT[dim-1][i]; // row dim-1 corresponds to eigenvalue +c
-        Dune::FieldVector<DF,dim+1> unit(0.0);
-        unit[dim-1] = 1.0;
-        Dune::FieldVector<DF,dim+1> beta;
-        RT.solve(beta,unit);
         Dune::FieldMatrix<DF,dim+1,dim+1> A_plus_s;
-        for (int i=0; i<=dim; i++)
-          for (int j=0; j<=dim; j++)
-            A_plus_s[i][j] = c_s*alpha[i]*beta[j];
+        LinearAcousticsSystem<T>::outgoingProjector(c_s,n_F,A_plus_s);
 
         // compute A- (incoming waves)
-        LinearAcousticsEigenvectors<dim>::eigenvectors_transposed(c_s,n_F,RT);
-        for (int i=0; i<=dim; i++) alpha[i] = RT[dim][i]; // row dim corresponds to eigenvalue -c
-        unit = 0.0;
-        unit[dim] = 1.0;
-        RT.solve(beta,unit);
         Dune::FieldMatrix<DF,dim+1,dim+1> A_minus_n;
-        for (int i=0; i<=dim; i++)
-          for (int j=0; j<=dim; j++)
-            A_minus_n[i][j] = -c_s*alpha[i]*beta[j];
+        LinearAcousticsSystem<T>::incomingProjector(c_s,n_F,A_minus_n);
 
         // select quadrature rule
         const int order_s = dgspace_s.finiteElement().localBasis().order();
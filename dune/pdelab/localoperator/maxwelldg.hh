@@ -4,7 +4,9 @@
 
 #include<vector>
 
+#include<dune/common/array.hh>
 #include<dune/common/exceptions.hh>
+#include<dune/common/fmatrix.hh>
 #include<dune/common/fvector.hh>
 
 #include <dune/geometry/referenceelements.hh>
@@ -282,6 +284,150 @@ namespace Dune {
       }
     };
 
+    /** \brief Maxwell's equations as a linear hyperbolic system
+
+        Provides the flux matrices and the upwind flux projectors of
+        Maxwell's equations for the state vector u=(D,B). The projectors are
+        shared with DGMaxwellSpatialOperator, the remaining methods implement
+        the system interface of LinearHyperbolicDGOperator.
+
+        The material parameters are evaluated at the cell centers.
+
+        \tparam T parameter class
+    */
+    template<typename T>
+    class MaxwellSystem
+    {
+    public:
+      enum { dim = T::Traits::GridViewType::dimension };
+      //! number of components of the state vector
+      enum { m = 2*dim };
+
+      typedef typename T::Traits::DomainFieldType DF;
+      typedef typename T::Traits::RangeFieldType RF;
+      typedef typename T::Traits::StateType State;
+      typedef Dune::FieldMatrix<RF,m,m> Matrix;
+      typedef typename T::Traits::ElementType Element;
+      typedef typename T::Traits::IntersectionType Intersection;
+      typedef typename T::Traits::IntersectionDomainType IntersectionDomain;
+      typedef typename T::Traits::DomainType Domain;
+
+      MaxwellSystem (T& param_)
+        : param(param_)
+      {}
+
+      //! A+ = R D+ R^-1, the flux of the outgoing waves
+      template<typename C, typename F>
+      static void outgoingProjector (C eps, C mu, const Dune::FieldVector<F,dim>& n, Dune::FieldMatrix<F,dim*2,dim*2>& Aplus)
+      {
+        Dune::FieldMatrix<F,dim*2,dim*2> R;
+        MaxwellEigenvectors<dim>::eigenvectors(eps,mu,n,R);
+        Dune::FieldMatrix<F,dim*2,dim*2> Dplus(0.0);
+        Dplus[0][0] = 1.0/sqrt(eps*mu);
+        Dplus[1][1] = 1.0/sqrt(eps*mu);
+        Aplus = R;
+        Aplus.rightmultiply(Dplus);
+        R.invert();
+        Aplus.rightmultiply(R);
+      }
+
+      //! A- = R D- R^-1, the flux of the incoming waves
+      template<typename C, typename F>
+      static void incomingProjector (C eps, C mu, const Dune::FieldVector<F,dim>& n, Dune::FieldMatrix<F,dim*2,dim*2>& Aminus)
+      {
+        Dune::FieldMatrix<F,dim*2,dim*2> R;
+        MaxwellEigenvectors<dim>::eigenvectors(eps,mu,n,R);
+        Dune::FieldMatrix<F,dim*2,dim*2> Dminus(0.0);
+        Dminus[2][2] = -1.0/sqrt(eps*mu);
+        Dminus[3][3] = -1.0/sqrt(eps*mu);
+        Aminus = R;
+        Aminus.rightmultiply(Dminus);
+        R.invert();
+        Aminus.rightmultiply(R);
+      }
+
+      //! permittivity at the center of e
+      RF eps (const Element& e) const
+      {
+        return param.eps(e,center(e));
+      }
+
+      //! permeability at the center of e
+      RF mu (const Element& e) const
+      {
+        return param.mu(e,center(e));
+      }
+
+      //! maximal wave speed in e
+      RF maxSpeed (const Element& e) const
+      {
+        return 1.0/sqrt(eps(e)*mu(e));
+      }
+
+      //! flux F_j(u) = A[j] u and reaction term S u in e
+      void fluxMatrices (const Element& e, Dune::array<Matrix,dim>& A, Matrix& S) const
+      {
+        const RF muinv = 1.0/mu(e);
+        const RF epsinv = 1.0/eps(e);
+        const RF sigma = param.sigma(e,center(e));
+
+        for (int j=0; j<dim; j++)
+          A[j] = 0.0;
+        A[1][0][5] = -muinv;  A[2][0][4] = muinv;
+        A[0][1][5] = muinv;   A[2][1][3] = -muinv;
+        A[0][2][4] = -muinv;  A[1][2][3] = muinv;
+        A[1][3][2] = epsinv;  A[2][3][1] = -epsinv;
+        A[0][4][2] = -epsinv; A[2][4][0] = epsinv;
+        A[0][5][1] = epsinv;  A[1][5][0] = -epsinv;
+
+        S = 0.0;
+        for (int i=0; i<dim; i++)
+          S[i][i] = sigma*epsinv;
+      }
+
+      //! numerical flux A_plus u_s + A_minus u_n on an interior face with unit outer normal n
+      void skeletonProjectors (const Element& inside, const Element& outside, const Dune::FieldVector<DF,dim>& n,
+                               Matrix& A_plus, Matrix& A_minus) const
+      {
+        outgoingProjector(eps(inside),mu(inside),n,A_plus);
+        incomingProjector(eps(outside),mu(outside),n,A_minus);
+      }
+
+      //! numerical flux A_plus u_s + A_minus g on a boundary face with unit outer normal n
+      void boundaryProjectors (const Element& inside, const Dune::FieldVector<DF,dim>& n,
+                               Matrix& A_plus, Matrix& A_minus) const
+      {
+        outgoingProjector(eps(inside),mu(inside),n,A_plus);
+        incomingProjector(eps(inside),mu(inside),n,A_minus);
+      }
+
+      //! boundary state g
+      State boundaryState (const Intersection& is, const IntersectionDomain& x, const State& u_s) const
+      {
+        return param.g(is,x,u_s);
+      }
+
+      //! right hand side j
+      State source (const Element& e, const Domain& x) const
+      {
+        return param.j(e,x);
+      }
+
+      //! set time in parameter class
+      void setTime (RF t)
+      {
+        param.setTime(t);
+      }
+
+    private:
+      static const Domain& center (const Element& e)
+      {
+        return Dune::ReferenceElements<DF,dim>::general(e.type()).position(0,0);
+      }
+
+      T& param;
+    };
+
     /** Spatial local operator for discontinuous Galerkin method for Maxwells Equations
 
         - \nabla \times (\mu^-1 B) + (\sigma/\epsilon) D = j
@@ -461,26 +607,12 @@ namespace Dune {
         //RF sigma_n = param.sigma(*(ig.outside()),outside_local);
 
         // compute A+ (outgoing waves)
-        Dune::FieldMatrix<DF,dim*2,dim*2> R_s;
-        MaxwellEigenvectors<dim>::eigenvectors(eps_s,mu_s,n_F,R_s);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Dplus_s(0.0);
-        Dplus_s[0][0] = 1.0/sqrt(eps_s*mu_s);
-        Dplus_s[1][1] = 1.0/sqrt(eps_s*mu_s);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Aplus_s(R_s);
-        Aplus_s.rightmultiply(Dplus_s);
-        R_s.invert();
-        Aplus_s.rightmultiply(R_s);
+        Dune::FieldMatrix<DF,dim*2,dim*2> Aplus_s;
+        MaxwellSystem<T>::outgoingProjector(eps_s,mu_s,n_F,Aplus_s);
 
         // compute A- (incoming waves)
-        Dune::FieldMatrix<DF,dim*2,dim*2> R_n;
-        MaxwellEigenvectors<dim>::eigenvectors(eps_n,mu_n,n_F,R_n);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Dminus_n(0.0);
-        Dminus_n[2][2] = -1.0/sqrt(eps_n*mu_n);
-        Dminus_n[3][3] = -1.0/sqrt(eps_n*mu_n);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Aminus_n(R_n);
-        Aminus_n.rightmultiply(Dminus_n);
-        R_n.invert();
-        Aminus_n.rightmultiply(R_n);
+        Dune::FieldMatrix<DF,dim*2,dim*2> Aminus_n;
+        MaxwellSystem<T>::incomingProjector(eps_n,mu_n,n_F,Aminus_n);
 
         // select quadrature rule
         const int order_s = dgspace_s.finiteElement().localBasis().order();
@@ -569,26 +701,12 @@ namespace Dune {
         //RF sigma_s = param.sigma(*(ig.inside()),inside_local);
 
         // compute A+ (outgoing waves)
-        Dune::FieldMatrix<DF,dim*2,dim*2> R_s;
-        MaxwellEigenvectors<dim>::eigenvectors(eps_s,mu_s,n_F,R_s);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Dplus_s(0.0);
-        Dplus_s[0][0] = 1.0/sqrt(eps_s*mu_s);
-        Dplus_s[1][1] = 1.0/sqrt(eps_s*mu_s);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Aplus_s(R_s);
-        Aplus_s.rightmultiply(Dplus_s);
-        R_s.invert();
-        Aplus_s.rightmultiply(R_s);
+        Dune::FieldMatrix<DF,dim*2,dim*2> Aplus_s;
+        MaxwellSystem<T>::outgoingProjector(eps_s,mu_s,n_F,Aplus_s);
 
         // compute A- (incoming waves)
-        Dune::FieldMatrix<DF,dim*2,dim*2> R_n;
-        MaxwellEigenvectors<dim>::eigenvectors(eps_s,mu_s,n_F,R_n);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Dminus_n(0.0);
-        Dminus_n[2][2] = -1.0/sqrt(eps_s*mu_s);
-        Dminus_n[3][3] = -1.0/sqrt(eps_s*mu_s);
-        Dune::FieldMatrix<DF,dim*2,dim*2> Aminus_n(R_n);
-        Aminus_n.rightmultiply(Dminus_n);
-        R_n.invert();
-        Aminus_n.rightmultiply(R_n);
+        Dune::FieldMatrix<DF,dim*2,dim*2> Aminus_n;
+        MaxwellSystem<T>::incomingProjector(eps_s,mu_s,n_F,Aminus_n);
 
         // select quadrature rule
         const int order_s = dgspace_s.finiteElement().localBasis().order();
@@ -0,0 +1,355 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+#ifndef DUNE_PDELAB_LOCALOPERATOR_QUADRATURECONTEXT_HH
+#define DUNE_PDELAB_LOCALOPERATOR_QUADRATURECONTEXT_HH
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include <dune/common/fmatrix.hh>
+#include <dune/common/fvector.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/localfunctions/common/interfaceswitch.hh>
+
+namespace Dune {
+  namespace PDELab {
+    //! \addtogroup LocalOperator
+    //! \ingroup PDELab
+    //! \{
+
+    /**
+     * \defgroup QuadratureContext Shared quadrature contexts
+     *
+     * Composite local operators (WeightedSumLocalOperator,
+     * InstationarySumLocalOperator, ScaledLocalOperator) forward every
+     * volume call to all of their summands. Summands that evaluate the same
+     * quadrature data (integration elements, basis functions and the
+     * solution at the quadrature points) can share it through a context
+     * object that the composite operator creates once per cell.
+     *
+     * A local operator opts in by setting
+     * \code
+     * enum { usesQuadratureContext = true };
+     * \endcode
+     * and implementing the overloads
+     * \code
+     * template<typename Context, typename LFSV, typename R>
+     * void alpha_volume (Context& ctx, const LFSV& lfsv, R& r) const;
+     * template<typename Context, typename LFSV, typename M>
+     * void jacobian_volume (Context& ctx, const LFSV& lfsv, M& mat) const;
+     * \endcode
+     * The context provides the original arguments of the call as well as the
+     * data of VolumeQuadratureContext, which is evaluated by bind() on first
+     * use and reused by all following summands with the same quadrature order.
+     * The contexts only support leaf function spaces with scalar bases.
+     *
+     * Operators without the flag keep receiving the plain calls, so mixing
+     * both kinds of summands is allowed.
+     *
+     * \{
+     */
+
+    //! Whether the local operator LOP implements the quadrature context overloads.
+    template<typename LOP, typename = void>
+    struct uses_quadrature_context
+      : public std::false_type
+    {};
+
+#ifndef DOXYGEN
+
+    template<typename LOP>
+    struct uses_quadrature_context<LOP,typename std::enable_if<(LOP::usesQuadratureContext != 0)>::type>
+      : public std::true_type
+    {};
+
+#endif // DOXYGEN
+
+    //! The arguments of a volume call, without any precomputed data.
+    template<typename EG, typename LFSU, typename X>
+    class VolumeContext
+    {
+
+    public:
+
+      VolumeContext(const EG& eg, const LFSU& lfsu, const X& x)
+        : _eg(eg)
+        , _lfsu(lfsu)
+        , _x(x)
+      {}
+
+      //! The element geometry of the call.
+      const EG& entityGeometry() const
+      {
+        return _eg;
+      }
+
+      //! The local ansatz space of the call.
+      const LFSU& lfsu() const
+      {
+        return _lfsu;
+      }
+
+      //! The local coefficients of the call.
+      const X& x() const
+      {
+        return _x;
+      }
+
+    private:
+
+      const EG& _eg;
+      const LFSU& _lfsu;
+      const X& _x;
+
+    };
+
+    //! Quadrature data of a cell, evaluated once and shared by several local operators.
+    /**
+     * All data refers to the basis of lfsu(), which must be a scalar leaf
+     * space. The weights already include the integration element, the
+     * gradients are taken with respect to global coordinates.
+     */
+    template<typename EG, typename LFSU, typename X>
+    class VolumeQuadratureContext
+      : public VolumeContext<EG,LFSU,X>
+    {
+
+      typedef FiniteElementInterfaceSwitch<
+        typename LFSU::Traits::FiniteElementType
+        > FESwitch;
+      typedef BasisInterfaceSwitch<
+        typename FESwitch::Basis
+        > BasisSwitch;
+
+    public:
+
+      typedef typename EG::Geometry Geometry;
+      typedef typename BasisSwitch::DomainField DF;
+      typedef typename BasisSwitch::RangeField RF;
+      typedef typename BasisSwitch::Range Range;
+      typedef typename LFSU::Traits::SizeType size_type;
+
+      static const int dimLocal = Geometry::mydimension;
+      static const int dimGlobal = Geometry::coorddimension;
+
+      typedef FieldVector<DF,dimLocal> Coordinate;
+      typedef FieldVector<RF,dimGlobal> Gradient;
+      typedef typename Geometry::JacobianInverseTransposed JacobianInverseTransposed;
+
+      VolumeQuadratureContext(const EG& eg, const LFSU& lfsu, const X& x)
+        : VolumeContext<EG,LFSU,X>(eg,lfsu,x)
+        , _order(-1)
+        , _gradients(false)
+        , _basis_size(0)
+      {}
+
+      //! Evaluates the data for the quadrature rule of the given order, unless it is already available.
+      /**
+       * \param order     Order of the quadrature rule
+       * \param gradients Whether the gradients of the basis and of the solution are needed
+       */
+      void bind(int order, bool gradients = true)
+      {
+        if (order == _order && (_gradients || !gradients))
+          return;
+
+        const EG& eg = this->entityGeometry();
+        const LFSU& lfsu = this->lfsu();
+        const X& x = this->x();
+        const Geometry& geometry = eg.geometry();
+        const QuadratureRule<DF,dimLocal>& rule =
+          QuadratureRules<DF,dimLocal>::rule(geometry.type(),order);
+
+        const size_type n = lfsu.size();
+        _order = order;
+        _gradients = gradients;
+        _basis_size = n;
+
+        _positions.resize(rule.size());
+        _weights.resize(rule.size());
+        _phi.resize(rule.size() * n);
+        _u.resize(rule.size());
+        if (gradients)
+          {
+            _jit.resize(rule.size());
+            _gradphi.resize(rule.size() * n);
+            _gradu.resize(rule.size());
+          }
+
+        std::vector<Range> phi(n);
+        std::vector<FieldMatrix<RF,1,dimGlobal> > gradphi(n);
+
+        std::size_t q = 0;
+        for (typename QuadratureRule<DF,dimLocal>::const_iterator it = rule.begin(); it != rule.end(); ++it, ++q)
+          {
+            _positions[q] = it->position();
+            _weights[q] = it->weight() * geometry.integrationElement(it->position());
+
+            FESwitch::basis(lfsu.finiteElement()).evaluateFunction(it->position(),phi);
+            RF u = 0.0;
+            for (size_type i = 0; i < n; ++i)
+              {
+                _phi[q*n + i] = phi[i];
+                u += x(lfsu,i) * _phi[q*n + i];
+              }
+            _u[q] = u;
+
+            if (!gradients)
+              continue;
+
+            _jit[q] = geometry.jacobianInverseTransposed(it->position());
+            BasisSwitch::gradient(FESwitch::basis(lfsu.finiteElement()),
+                                  geometry, it->position(), gradphi);
+            Gradient gradu(0.0);
+            for (size_type i = 0; i < n; ++i)
+              {
+                _gradphi[q*n + i] = gradphi[i][0];
+                gradu.axpy(x(lfsu,i),gradphi[i][0]);
+              }
+            _gradu[q] = gradu;
+          }
+      }
+
+      //! The order of the bound quadrature rule, or -1 if bind() has not been called.
+      int order() const
+      {
+        return _order;
+      }
+
+      //! Number of quadrature points.
+      std::size_t size() const
+      {
+        return _weights.size();
+      }
+
+      //! Local position of quadrature point q.
+      const Coordinate& position(std::size_t q) const
+      {
+        return _positions[q];
+      }
+
+      //! Quadrature weight times integration element of point q.
+      DF weight(std::size_t q) const
+      {
+        return _weights[q];
+      }
+
+      //! Jacobian inverse transposed of the geometry at point q.
+      const JacobianInverseTransposed& jacobianInverseTransposed(std::size_t q) const
+      {
+        return _jit[q];
+      }
+
+      //! Basis function i at point q.
+      RF phi(std::size_t q, size_type i) const
+      {
+        return _phi[q*_basis_size + i];
+      }
+
+      //! Global gradient of basis function i at point q.
+      const Gradient& gradphi(std::size_t q, size_type i) const
+      {
+        return _gradphi[q*_basis_size + i];
+      }
+
+      //! Solution at point q.
+      RF u(std::size_t q) const
+      {
+        return _u[q];
+      }
+
+      //! Global gradient of the solution at point q.
+      const Gradient& gradu(std::size_t q) const
+      {
+        return _gradu[q];
+      }
+
+    private:
+
+      int _order;
+      bool _gradients;
+      size_type _basis_size;
+      std::vector<Coordinate> _positions;
+      std::vector<DF> _weights;
+      std::vector<JacobianInverseTransposed> _jit;
+      std::vector<RF> _phi;
+      std::vector<Gradient> _gradphi;
+      std::vector<RF> _u;
+      std::vector<Gradient> _gradu;
+
+    };
+
+    //! Selects the context a composite local operator LOP creates for a volume call.
+    template<typename LOP, typename EG, typename LFSU, typename X>
+    struct VolumeContextSelector
+    {
+      typedef typename std::conditional<
+        uses_quadrature_context<LOP>::value,
+        VolumeQuadratureContext<EG,LFSU,X>,
+        VolumeContext<EG,LFSU,X>
+        >::type type;
+    };
+
+    //! Calls the volume methods of a local operator from a context.
+    /**
+     * Dispatches to the context overloads if LOP uses quadrature contexts and
+     * to the plain methods otherwise. If doIt is false, nothing is called.
+     */
+    template<typename LOP, bool doIt, bool useContext = uses_quadrature_context<LOP>::value>
+    struct QuadratureContextCallSwitch
+    {
+      template<typename Context, typename LFSV, typename R>
+      static void alpha_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, R& r)
+      {
+        lop.alpha_volume(ctx.entityGeometry(),ctx.lfsu(),ctx.x(),lfsv,r);
+      }
+
+      template<typename Context, typename LFSV, typename M>
+      static void jacobian_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, M& mat)
+      {
+        lop.jacobian_volume(ctx.entityGeometry(),ctx.lfsu(),ctx.x(),lfsv,mat);
+      }
+    };
+
+#ifndef DOXYGEN
+
+    template<typename LOP>
+    struct QuadratureContextCallSwitch<LOP,true,true>
+    {
+      template<typename Context, typename LFSV, typename R>
+      static void alpha_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, R& r)
+      {
+        lop.alpha_volume(ctx,lfsv,r);
+      }
+
+      template<typename Context, typename LFSV, typename M>
+      static void jacobian_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, M& mat)
+      {
+        lop.jacobian_volume(ctx,lfsv,mat);
+      }
+    };
+
+    template<typename LOP, bool useContext>
+    struct QuadratureContextCallSwitch<LOP,false,useContext>
+    {
+      template<typename Context, typename LFSV, typename R>
+      static void alpha_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, R& r)
+      {}
+
+      template<typename Context, typename LFSV, typename M>
+      static void jacobian_volume(const LOP& lop, Context& ctx, const LFSV& lfsv, M& mat)
+      {}
+    };
+
+#endif // DOXYGEN
+
+    //! \} group QuadratureContext
+
+    //! \} group LocalOperator
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_LOCALOPERATOR_QUADRATURECONTEXT_HH
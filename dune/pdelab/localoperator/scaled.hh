@@ -3,6 +3,8 @@
 #ifndef DUNE_PDELAB_LOCALOPERATOR_SCALED_HH
 #define DUNE_PDELAB_LOCALOPERATOR_SCALED_HH
 
+#include <dune/pdelab/localoperator/quadraturecontext.hh>
+
 namespace Dune {
   namespace PDELab {
     //! \addtogroup LocalOperator
@@ -144,6 +146,11 @@ namespace Dune {
 
       //! \brief Whether to visit the skeleton methods from both sides
       enum { doSkeletonTwoSided = Backend::doSkeletonTwoSided };
+      //! \brief Whether the residual is affine linear in the trial function
+      enum { isLinear = Backend::isLinear };
+      //! \brief Whether the backend shares quadrature data through a
+      //!        quadrature context
+      enum { usesQuadratureContext = uses_quadrature_context<Backend>::value };
 
       //! \} Control flags
 
@@ -300,6 +307,22 @@ namespace Dune {
         }
       }
 
+      //! get an element's contribution to alpha from a shared context
+      /**
+       * Forwards the \ref QuadratureContext "quadrature context" of an
+       * enclosing composite operator to the backend.
+       */
+      template<typename Context, typename LFSV, typename R>
+      void alpha_volume(Context& ctx, const LFSV& lfsv, R& r) const
+      {
+        if(factor != 0) {
+          typename R::WeightedAccumulationView
+            my_r(r.weightedAccumulationView(factor));
+          QuadratureContextCallSwitch<Backend, true>::
+            alpha_volume(*bp, ctx, lfsv, my_r);
+        }
+      }
+
       //! \brief get an element's contribution to alpha after the
       //!        intersections have been handled
       /**
@@ -749,6 +772,89 @@ namespace Dune {
         }
       }
 
+      //! apply an element's jacobian at the linearization point x to z
+      /**
+       * Same as jacobian_apply_volume(eg,lfsu,x,lfsv,y), but the jacobian is
+       * evaluated at \c x and applied to \c z.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        if(factor != 0) {
+          typename Y::WeightedAccumulationView
+            my_y(y.weightedAccumulationView(factor));
+          bp->jacobian_apply_volume(eg, lfsu, x, z, lfsv, my_y);
+        }
+      }
+
+      //! \brief apply an element's jacobian at the linearization point x to z
+      //!        after the intersections have been handled
+      /**
+       * Same as jacobian_apply_volume_post_skeleton(eg,lfsu,x,lfsv,y), but the
+       * jacobian is evaluated at \c x and applied to \c z.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_volume_post_skeleton
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        if(factor != 0) {
+          typename Y::WeightedAccumulationView
+            my_y(y.weightedAccumulationView(factor));
+          bp->jacobian_apply_volume_post_skeleton(eg, lfsu, x, z, lfsv, my_y);
+        }
+      }
+
+      //! apply an internal intersections's jacobians at the linearization point x to z
+      /**
+       * Same as jacobian_apply_skeleton(ig,lfsu_s,x_s,lfsv_s,lfsu_n,x_n,lfsv_n,y_s,y_n),
+       * but the jacobian is evaluated at \c x_s, \c x_n and applied to \c z_s, \c z_n.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n) const
+      {
+        if(factor != 0) {
+          typename Y::WeightedAccumulationView
+            my_y_s(y_s.weightedAccumulationView(factor));
+          typename Y::WeightedAccumulationView
+            my_y_n(y_n.weightedAccumulationView(factor));
+          bp->jacobian_apply_skeleton(ig,
+                                      lfsu_s, x_s, z_s, lfsv_s,
+                                      lfsu_n, x_n, z_n, lfsv_n,
+                                      my_y_s, my_y_n);
+        }
+      }
+
+      //! apply a boundary intersections's jacobian at the linearization point x to z
+      /**
+       * Same as jacobian_apply_boundary(ig,lfsu_s,x_s,lfsv_s,y_s), but the
+       * jacobian is evaluated at \c x_s and applied to \c z_s.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s) const
+      {
+        if(factor != 0) {
+          typename Y::WeightedAccumulationView
+            my_y_s(y_s.weightedAccumulationView(factor));
+          bp->jacobian_apply_boundary(ig, lfsu_s, x_s, z_s, lfsv_s, my_y_s);
+        }
+      }
+
       //! \} Methods for the application of the jacobian
 
       //////////////////////////////////////////////////////////////////////
@@ -788,6 +894,22 @@ namespace Dune {
         }
       }
 
+      //! get an element's jacobian from a shared context
+      /**
+       * Forwards the \ref QuadratureContext "quadrature context" of an
+       * enclosing composite operator to the backend.
+       */
+      template<typename Context, typename LFSV, typename M>
+      void jacobian_volume(Context& ctx, const LFSV& lfsv, M& mat) const
+      {
+        if(factor != 0) {
+          typename M::WeightedAccumulationView
+            my_mat(mat.weightedAccumulationView(factor));
+          QuadratureContextCallSwitch<Backend, true>::
+            jacobian_volume(*bp, ctx, lfsv, my_mat);
+        }
+      }
+
       //! get an element's jacobian after the intersections have been handled
       /**
        * \param eg   ElementGeometry describing the entity.
@@ -11,6 +11,7 @@
 #include <dune/common/typetraits.hh>
 
 #include <dune/pdelab/localoperator/callswitch.hh>
+#include <dune/pdelab/localoperator/quadraturecontext.hh>
 
 namespace Dune {
   namespace PDELab {
@@ -22,6 +23,10 @@ namespace Dune {
     /**
      * \nosubgrouping
      *
+     * If any summand uses a \ref QuadratureContext "quadrature context",
+     * alpha_volume() and jacobian_volume() evaluate the quadrature data of a
+     * cell once and share it between all summands.
+     *
      * \tparam Args Tuple of local operators.  Must fulfill \c
      *              tuple_size<Args>::value>=1.
      */
@@ -126,6 +131,16 @@ namespace Dune {
       < bool, tuple_element<i, Args>::type::doLambdaBoundary>
       { };
 
+      template<int i>
+      struct UsesQuadratureContextValue : public integral_constant
+      < bool, uses_quadrature_context<typename tuple_element<i, Args>::type>::value>
+      { };
+
+      template<int i>
+      struct NonlinearValue : public integral_constant
+      < bool, ! tuple_element<i, Args>::type::isLinear>
+      { };
+
       template<int i>
       struct OneSidedSkeletonRequiredValue : public integral_constant
       < bool, ( ( tuple_element<i, Args>::type::doAlphaSkeleton ||
@@ -196,6 +211,13 @@ namespace Dune {
       //! \brief Whether to visit the skeleton methods from both sides
       enum { doSkeletonTwoSided          =
              AccFlag<TwoSidedSkeletonRequiredValue>::value  };
+      //! \brief Whether all summands are linear
+      enum { isLinear                    =
+             ! AccFlag<NonlinearValue>::value               };
+      //! \brief Whether any summand shares quadrature data through a
+      //!        quadrature context
+      enum { usesQuadratureContext       =
+             AccFlag<UsesQuadratureContextValue>::value     };
       static_assert(!(AccFlag<OneSidedSkeletonRequiredValue>::value &&
                       AccFlag<TwoSidedSkeletonRequiredValue>::value),
                     "Some summands require a one-sided skelton, others a "
@@ -346,15 +368,13 @@ namespace Dune {
 
       template<int i>
       struct AlphaVolumeOperation {
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename R>
-        static void apply(const ArgPtrs& lops, const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
-                          R& r)
+        template<typename Context, typename LFSV, typename R>
+        static void apply(const ArgPtrs& lops, Context& ctx,
+                          const LFSV& lfsv, R& r)
         {
-          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+          QuadratureContextCallSwitch<typename tuple_element<i,Args>::type,
             tuple_element<i,Args>::type::doAlphaVolume>::
-          alpha_volume(*get<i>(lops), eg, lfsu, x, lfsv, r);
+          alpha_volume(*get<i>(lops), ctx, lfsv, r);
         }
       };
 
@@ -418,9 +438,18 @@ namespace Dune {
       ( const EG& eg,
         const LFSU& lfsu, const X& x, const LFSV& lfsv,
         R& r) const
+      {
+        typename VolumeContextSelector
+          <InstationarySumLocalOperator, EG, LFSU, X>::type ctx(eg, lfsu, x);
+        alpha_volume(ctx, lfsv, r);
+      }
+
+      //! get an element's contribution to alpha from a shared context
+      template<typename Context, typename LFSV, typename R>
+      void alpha_volume(Context& ctx, const LFSV& lfsv, R& r) const
       {
         ForLoop<AlphaVolumeOperation, 0, size-1>::
-          apply(lops, eg, lfsu, x, lfsv, r);
+          apply(lops, ctx, lfsv, r);
       }
 
       //! \brief get an element's contribution to alpha after the
@@ -619,6 +648,16 @@ namespace Dune {
             tuple_element<i,Args>::type::doAlphaVolume>::
             jacobian_apply_volume(*get<i>(lops), eg, lfsu, x, lfsv, y);
         }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename Y>
+        static void apply(const ArgPtrs& lops, const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+            tuple_element<i,Args>::type::doAlphaVolume>::
+            jacobian_apply_volume(*get<i>(lops), eg, lfsu, x, z, lfsv, y);
+        }
       };
 
       template<int i>
@@ -635,6 +674,18 @@ namespace Dune {
                                                 lfsu, x, lfsv,
                                                 y);
         }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename Y>
+        static void apply(const ArgPtrs& lops, const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv, Y& y)
+        {
+          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+            tuple_element<i,Args>::type::doAlphaVolumePostSkeleton>::
+            jacobian_apply_volume_post_skeleton(*get<i>(lops), eg,
+                                                lfsu, x, z, lfsv,
+                                                y);
+        }
       };
 
       template<int i>
@@ -653,6 +704,22 @@ namespace Dune {
                                   lfsu_n, x_n, lfsv_n,
                                   y_s, y_n);
         }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename Y>
+        static void apply(const ArgPtrs& lops, const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          const LFSU& lfsu_n, const X& x_n, const Z& z_n,
+                          const LFSV& lfsv_n,
+                          Y& y_s, Y& y_n)
+        {
+          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+            tuple_element<i,Args>::type::doAlphaSkeleton>::
+          jacobian_apply_skeleton(*get<i>(lops), ig,
+                                  lfsu_s, x_s, z_s, lfsv_s,
+                                  lfsu_n, x_n, z_n, lfsv_n,
+                                  y_s, y_n);
+        }
       };
 
       template<int i>
@@ -669,6 +736,19 @@ namespace Dune {
                                     lfsu_s, x_s, lfsv_s,
                                     y_s);
         }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename Y>
+        static void apply(const ArgPtrs& lops, const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          Y& y_s)
+        {
+          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+            tuple_element<i,Args>::type::doAlphaBoundary>::
+            jacobian_apply_boundary(*get<i>(lops), ig,
+                                    lfsu_s, x_s, z_s, lfsv_s,
+                                    y_s);
+        }
       };
 
     public:
@@ -741,6 +821,75 @@ namespace Dune {
           apply(lops, ig, lfsu_s, x_s, lfsv_s, y_s);
       }
 
+      //! apply an element's jacobian at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        ForLoop<JacobianApplyVolumeOperation, 0, size-1>::
+          apply(lops, eg, lfsu, x, z, lfsv, y);
+      }
+
+      //! \brief apply an element's jacobian at the linearization point x to z
+      //!        after the intersections have been handled
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_volume_post_skeleton
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        Y& y) const
+      {
+        ForLoop<JacobianApplyVolumePostSkeletonOperation, 0, size-1>::
+          apply(lops, eg, lfsu, x, z, lfsv, y);
+      }
+
+      //! apply an internal intersections's jacobians at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        Y& y_s, Y& y_n) const
+      {
+        ForLoop<JacobianApplySkeletonOperation, 0, size-1>::
+          apply(lops, ig,
+                lfsu_s, x_s, z_s, lfsv_s,
+                lfsu_n, x_n, z_n, lfsv_n,
+                y_s, y_n);
+      }
+
+      //! apply a boundary intersections's jacobian at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename Y>
+      void jacobian_apply_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        Y& y_s) const
+      {
+        ForLoop<JacobianApplyBoundaryOperation, 0, size-1>::
+          apply(lops, ig, lfsu_s, x_s, z_s, lfsv_s, y_s);
+      }
+
       //! \} Methods for the application of the jacobian
 
       //////////////////////////////////////////////////////////////////////
@@ -754,15 +903,13 @@ namespace Dune {
 
       template<int i>
       struct JacobianVolumeOperation {
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename LocalMatrix>
-        static void apply(const ArgPtrs& lops, const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
-                          LocalMatrix& mat)
+        template<typename Context, typename LFSV, typename LocalMatrix>
+        static void apply(const ArgPtrs& lops, Context& ctx,
+                          const LFSV& lfsv, LocalMatrix& mat)
         {
-          LocalAssemblerCallSwitch<typename tuple_element<i,Args>::type,
+          QuadratureContextCallSwitch<typename tuple_element<i,Args>::type,
             tuple_element<i,Args>::type::doAlphaVolume>::
-            jacobian_volume(*get<i>(lops), eg, lfsu, x, lfsv, mat);
+            jacobian_volume(*get<i>(lops), ctx, lfsv, mat);
         }
       };
 
@@ -828,9 +975,18 @@ namespace Dune {
       ( const EG& eg,
         const LFSU& lfsu, const X& x, const LFSV& lfsv,
         LocalMatrix& mat) const
+      {
+        typename VolumeContextSelector
+          <InstationarySumLocalOperator, EG, LFSU, X>::type ctx(eg, lfsu, x);
+        jacobian_volume(ctx, lfsv, mat);
+      }
+
+      //! get an element's jacobian from a shared context
+      template<typename Context, typename LFSV, typename LocalMatrix>
+      void jacobian_volume(Context& ctx, const LFSV& lfsv, LocalMatrix& mat) const
       {
         ForLoop<JacobianVolumeOperation, 0, size-1>::
-          apply(lops, eg, lfsu, x, lfsv, mat);
+          apply(lops, ctx, lfsv, mat);
       }
 
       //! get an element's jacobian after the intersections have been handled
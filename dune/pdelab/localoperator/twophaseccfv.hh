@@ -10,6 +10,7 @@
 #include <dune/pdelab/localoperator/defaultimp.hh>
 
 #include"../common/function.hh"
+#include"coefficientcache.hh"
 #include"pattern.hh"
 #include"flags.hh"
 #include"idefault.hh"
@@ -235,6 +236,181 @@ namespace Dune {
     };
 
 
+    /** \brief Two phase parameter class that stores the rock properties of another parameter class
+     *
+     * Porosity and absolute permeability are evaluated only once per cell and
+     * local coordinate (or once per cell if they are cellwise constant); all
+     * other methods are forwarded unchanged, since the constitutive relations
+     * depend on the solution and cannot be stored per cell. The stored values
+     * are discarded by invalidate().
+     *
+     * \note The cache has to be recreated after the grid has been modified.
+     *
+     * \tparam TP model of TwoPhaseParameterInterface
+     */
+    template<typename TP>
+    class TwoPhaseParameterCache
+      : public TwoPhaseParameterInterface<typename TP::Traits,TwoPhaseParameterCache<TP> >
+    {
+    public:
+      typedef typename TP::Traits Traits;
+      typedef typename Traits::RangeFieldType RF;
+
+      /** \brief Constructor
+       *
+       * \param gv       the grid view of the operator
+       * \param param    the wrapped parameter object
+       * \param cellwise whether porosity and permeability are constant on each cell
+       */
+      TwoPhaseParameterCache (const typename Traits::GridViewType& gv, const TP& param, bool cellwise = false)
+        : _param(param)
+        , _phi(gv,cellwise)
+        , _k_abs(gv,cellwise)
+      {}
+
+      //! porosity
+      RF phi (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const RF* value = _phi.find(e,x);
+        return value ? *value : _phi.insert(e,x,_param.phi(e,x));
+      }
+
+      //! absolute permeability
+      typename Traits::PermTensorType
+      k_abs (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+      {
+        const typename Traits::PermTensorType* value = _k_abs.find(e,x);
+        return value ? *value : _k_abs.insert(e,x,_param.k_abs(e,x));
+      }
+
+      //! capillary pressure function
+      RF pc (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF s_l) const
+      {
+        return _param.pc(e,x,s_l);
+      }
+
+      //! inverse capillary pressure function
+      RF s_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF pc) const
+      {
+        return _param.s_l(e,x,pc);
+      }
+
+      //! liquid phase relative permeability
+      RF kr_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF s_l) const
+      {
+        return _param.kr_l(e,x,s_l);
+      }
+
+      //! gas phase relative permeability
+      RF kr_g (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF s_g) const
+      {
+        return _param.kr_g(e,x,s_g);
+      }
+
+      //! liquid phase viscosity
+      RF mu_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_l) const
+      {
+        return _param.mu_l(e,x,p_l);
+      }
+
+      //! gas phase viscosity
+      RF mu_g (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_g) const
+      {
+        return _param.mu_g(e,x,p_g);
+      }
+
+      //! gravity vector
+      const typename Traits::RangeType& gravity () const
+      {
+        return _param.gravity();
+      }
+
+      //! liquid phase molar density
+      RF nu_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_l) const
+      {
+        return _param.nu_l(e,x,p_l);
+      }
+
+      //! gas phase molar density
+      RF nu_g (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_g) const
+      {
+        return _param.nu_g(e,x,p_g);
+      }
+
+      //! liquid phase mass density
+      RF rho_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_l) const
+      {
+        return _param.rho_l(e,x,p_l);
+      }
+
+      //! gas phase mass density
+      RF rho_g (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF p_g) const
+      {
+        return _param.rho_g(e,x,p_g);
+      }
+
+      //! liquid phase boundary condition type
+      int bc_l (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.bc_l(is,x,time);
+      }
+
+      //! gas phase boundary condition type
+      int bc_g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.bc_g(is,x,time);
+      }
+
+      //! liquid phase Dirichlet boundary condition
+      RF g_l (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.g_l(is,x,time);
+      }
+
+      //! gas phase Dirichlet boundary condition
+      RF g_g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.g_g(is,x,time);
+      }
+
+      //! liquid phase Neumann boundary condition
+      RF j_l (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.j_l(is,x,time);
+      }
+
+      //! gas phase Neumann boundary condition
+      RF j_g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, RF time) const
+      {
+        return _param.j_g(is,x,time);
+      }
+
+      //! liquid phase source term
+      RF q_l (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF time) const
+      {
+        return _param.q_l(e,x,time);
+      }
+
+      //! gas phase source term
+      RF q_g (const typename Traits::ElementType& e, const typename Traits::DomainType& x, RF time) const
+      {
+        return _param.q_g(e,x,time);
+      }
+
+      //! discard all stored values
+      void invalidate ()
+      {
+        _phi.clear();
+        _k_abs.clear();
+      }
+
+    private:
+      const TP& _param;
+      mutable CoefficientCache<typename Traits::GridViewType,RF> _phi;
+      mutable CoefficientCache<typename Traits::GridViewType,typename Traits::PermTensorType> _k_abs;
+    };
+
+
     // a local operator for solving the two-phase flow in pressure-pressure formulation
     // with two-point flux approximation
     // TP : parameter class, see above
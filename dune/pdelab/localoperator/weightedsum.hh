@@ -15,6 +15,7 @@
 #include <dune/pdelab/gridoperator/common/localmatrix.hh>
 
 #include <dune/pdelab/localoperator/callswitch.hh>
+#include <dune/pdelab/localoperator/quadraturecontext.hh>
 
 namespace Dune {
   namespace PDELab {
@@ -29,6 +30,10 @@ namespace Dune {
      * If the weight for one summand is zero, calls to that local operators
      * evaluation and pattern methods are eliminated at run-time.
      *
+     * If any summand uses a \ref QuadratureContext "quadrature context",
+     * alpha_volume() and jacobian_volume() evaluate the quadrature data of a
+     * cell once and share it between all summands.
+     *
      * \tparam K    Type of the scaling factors.
      * \tparam Args Tuple of local operators.  Must fulfill \c
      *              tuple_size<Args>::value>=1.
@@ -155,6 +160,16 @@ namespace Dune {
       < bool, tuple_element<i, Args>::type::doLambdaBoundary>
       { };
 
+      template<int i>
+      struct UsesQuadratureContextValue : public integral_constant
+      < bool, uses_quadrature_context<typename tuple_element<i, Args>::type>::value>
+      { };
+
+      template<int i>
+      struct NonlinearValue : public integral_constant
+      < bool, ! tuple_element<i, Args>::type::isLinear>
+      { };
+
       template<int i>
       struct OneSidedSkeletonRequiredValue : public integral_constant
       < bool, ( ( tuple_element<i, Args>::type::doAlphaSkeleton ||
@@ -225,6 +240,13 @@ namespace Dune {
       //! \brief Whether to visit the skeleton methods from both sides
       enum { doSkeletonTwoSided          =
              AccFlag<TwoSidedSkeletonRequiredValue>::value  };
+      //! \brief Whether all summands are linear
+      enum { isLinear                    =
+             ! AccFlag<NonlinearValue>::value               };
+      //! \brief Whether any summand shares quadrature data through a
+      //!        quadrature context
+      enum { usesQuadratureContext       =
+             AccFlag<UsesQuadratureContextValue>::value     };
       static_assert(!(AccFlag<OneSidedSkeletonRequiredValue>::value &&
                       AccFlag<TwoSidedSkeletonRequiredValue>::value),
                     "Some summands require a one-sided skelton, others a "
@@ -380,26 +402,22 @@ namespace Dune {
       template<int i>
       struct AlphaVolumeOperation {
         typedef typename tuple_element<i,Args>::type Arg;
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename C>
+        template<typename Context, typename LFSV, typename C>
         static void apply(const ArgPtrs& lops, const Weights& weights,
-                          const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                          Context& ctx, const LFSV& lfsv,
                           WeightedVectorAccumulationView<C>& r)
         {
-          apply(lops, weights[i]*r.weight(), eg, lfsu, x, lfsv, r.container());
+          apply(lops, weights[i]*r.weight(), ctx, lfsv, r.container());
         }
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename C>
+        template<typename Context, typename LFSV, typename C>
         static void apply(const ArgPtrs& lops, typename C::weight_type weight,
-                          const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                          Context& ctx, const LFSV& lfsv,
                           C& r)
         {
           if(weight != K(0)) {
             WeightedVectorAccumulationView<C> view(r, weight);
-            LocalAssemblerCallSwitch<Arg, Arg::doAlphaVolume>::
-              alpha_volume(*get<i>(lops), eg, lfsu, x, lfsv, view);
+            QuadratureContextCallSwitch<Arg, Arg::doAlphaVolume>::
+              alpha_volume(*get<i>(lops), ctx, lfsv, view);
           }
         }
       };
@@ -515,9 +533,18 @@ namespace Dune {
       ( const EG& eg,
         const LFSU& lfsu, const X& x, const LFSV& lfsv,
         C& r) const
+      {
+        typename VolumeContextSelector
+          <WeightedSumLocalOperator, EG, LFSU, X>::type ctx(eg, lfsu, x);
+        alpha_volume(ctx, lfsv, r);
+      }
+
+      //! get an element's contribution to alpha from a shared context
+      template<typename Context, typename LFSV, typename C>
+      void alpha_volume(Context& ctx, const LFSV& lfsv, C& r) const
       {
         ForLoop<AlphaVolumeOperation, 0, size-1>::
-          apply(lops, weights, eg, lfsu, x, lfsv, r);
+          apply(lops, weights, ctx, lfsv, r);
       }
 
       //! \brief get an element's contribution to alpha after the
@@ -784,6 +811,30 @@ namespace Dune {
               jacobian_apply_volume(*get<i>(lops), eg, lfsu, x, lfsv, view);
           }
         }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, const Weights& weights,
+                          const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv,
+                          WeightedVectorAccumulationView<C>& r)
+        {
+          apply(lops, weights[i]*r.weight(), eg, lfsu, x, z, lfsv, r.container());
+        }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, typename C::weight_type weight,
+                          const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv,
+                          C& r)
+        {
+          if(weight != K(0)) {
+            WeightedVectorAccumulationView<C> view(r, weight);
+            LocalAssemblerCallSwitch<Arg, Arg::doAlphaVolume>::
+              jacobian_apply_volume(*get<i>(lops), eg, lfsu, x, z, lfsv, view);
+          }
+        }
       };
 
       template<int i>
@@ -813,6 +864,32 @@ namespace Dune {
                                                   view);
           }
         }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, const Weights& weights,
+                          const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv,
+                          WeightedVectorAccumulationView<C>& r)
+        {
+          apply(lops, weights[i]*r.weight(), eg, lfsu, x, z, lfsv, r.container());
+        }
+        template<typename EG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, typename C::weight_type weight,
+                          const EG& eg,
+                          const LFSU& lfsu, const X& x, const Z& z,
+                          const LFSV& lfsv,
+                          C& r)
+        {
+          if(weight != K(0)) {
+            WeightedVectorAccumulationView<C> view(r, weight);
+            LocalAssemblerCallSwitch<Arg, Arg::doAlphaVolumePostSkeleton>::
+              jacobian_apply_volume_post_skeleton(*get<i>(lops), eg,
+                                                  lfsu, x, z, lfsv,
+                                                  view);
+          }
+        }
       };
 
       template<int i>
@@ -853,6 +930,45 @@ namespace Dune {
                                       view_s, view_n);
           }
         }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, const Weights& weights,
+                          const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          const LFSU& lfsu_n, const X& x_n, const Z& z_n,
+                          const LFSV& lfsv_n,
+                          WeightedVectorAccumulationView<C>& r_s,
+                          WeightedVectorAccumulationView<C>& r_n)
+        {
+          apply(lops, weights[i]*r_s.weight(), weights[i]*r_n.weight(),
+                ig,
+                lfsu_s, x_s, z_s, lfsv_s,
+                lfsu_n, x_n, z_n, lfsv_n,
+                r_s.container(), r_n.container());
+        }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops,
+                          typename C::weight_type weight_s,
+                          typename C::weight_type weight_n,
+                          const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          const LFSU& lfsu_n, const X& x_n, const Z& z_n,
+                          const LFSV& lfsv_n,
+                          C& r_s, C& r_n)
+        {
+          if(weight_s != K(0) || weight_n != K(0)) {
+            WeightedVectorAccumulationView<C> view_s(r_s, weight_s);
+            WeightedVectorAccumulationView<C> view_n(r_n, weight_n);
+            LocalAssemblerCallSwitch<Arg, Arg::doAlphaSkeleton>::
+              jacobian_apply_skeleton(*get<i>(lops), ig,
+                                      lfsu_s, x_s, z_s, lfsv_s,
+                                      lfsu_n, x_n, z_n, lfsv_n,
+                                      view_s, view_n);
+          }
+        }
       };
 
       template<int i>
@@ -885,6 +1001,35 @@ namespace Dune {
                                       view_s);
           }
         }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops, const Weights& weights,
+                          const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          WeightedVectorAccumulationView<C>& r_s)
+        {
+          apply(lops, weights[i]*r_s.weight(), ig,
+                lfsu_s, x_s, z_s, lfsv_s,
+                r_s.container());
+        }
+        template<typename IG, typename LFSU, typename X, typename Z,
+                 typename LFSV, typename C>
+        static void apply(const ArgPtrs& lops,
+                          typename C::weight_type weight_s,
+                          const IG& ig,
+                          const LFSU& lfsu_s, const X& x_s, const Z& z_s,
+                          const LFSV& lfsv_s,
+                          C& r_s)
+        {
+          if(weight_s != K(0)) {
+            WeightedVectorAccumulationView<C> view_s(r_s, weight_s);
+            LocalAssemblerCallSwitch<Arg, Arg::doAlphaBoundary>::
+              jacobian_apply_boundary(*get<i>(lops), ig,
+                                      lfsu_s, x_s, z_s, lfsv_s,
+                                      view_s);
+          }
+        }
       };
 
     public:
@@ -957,6 +1102,75 @@ namespace Dune {
           apply(lops, weights, ig, lfsu_s, x_s, lfsv_s, r_s);
       }
 
+      //! apply an element's jacobian at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename C>
+      void jacobian_apply_volume
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        C& r) const
+      {
+        ForLoop<JacobianApplyVolumeOperation, 0, size-1>::
+          apply(lops, weights, eg, lfsu, x, z, lfsv, r);
+      }
+
+      //! \brief apply an element's jacobian at the linearization point x to z
+      //!        after the intersections have been handled
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename EG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename C>
+      void jacobian_apply_volume_post_skeleton
+      ( const EG& eg,
+        const LFSU& lfsu, const X& x, const Z& z, const LFSV& lfsv,
+        C& r) const
+      {
+        ForLoop<JacobianApplyVolumePostSkeletonOperation, 0, size-1>::
+          apply(lops, weights, eg, lfsu, x, z, lfsv, r);
+      }
+
+      //! apply an internal intersections's jacobians at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename C>
+      void jacobian_apply_skeleton
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        const LFSU& lfsu_n, const X& x_n, const Z& z_n, const LFSV& lfsv_n,
+        C& r_s, C& r_n) const
+      {
+        ForLoop<JacobianApplySkeletonOperation, 0, size-1>::
+          apply(lops, weights, ig,
+                lfsu_s, x_s, z_s, lfsv_s,
+                lfsu_n, x_n, z_n, lfsv_n,
+                r_s, r_n);
+      }
+
+      //! apply a boundary intersections's jacobian at the linearization point x to z
+      /**
+       * \note Summands with zero weight don't contribute to the jacobian, and
+       *       the calls to the evaluation methods are eliminated at run-time.
+       */
+      template<typename IG, typename LFSU, typename X, typename Z,
+               typename LFSV, typename C>
+      void jacobian_apply_boundary
+      ( const IG& ig,
+        const LFSU& lfsu_s, const X& x_s, const Z& z_s, const LFSV& lfsv_s,
+        C& r_s) const
+      {
+        ForLoop<JacobianApplyBoundaryOperation, 0, size-1>::
+          apply(lops, weights, ig, lfsu_s, x_s, z_s, lfsv_s, r_s);
+      }
+
       //! \} Methods for the application of the jacobian
 
       //////////////////////////////////////////////////////////////////////
@@ -971,26 +1185,22 @@ namespace Dune {
       template<int i>
       struct JacobianVolumeOperation {
         typedef typename tuple_element<i,Args>::type Arg;
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename C>
+        template<typename Context, typename LFSV, typename C>
         static void apply(const ArgPtrs& lops, const Weights& weights,
-                          const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                          Context& ctx, const LFSV& lfsv,
                           WeightedMatrixAccumulationView<C>& m)
         {
-          apply(lops, weights[i]*m.weight(), eg, lfsu, x, lfsv, m.container());
+          apply(lops, weights[i]*m.weight(), ctx, lfsv, m.container());
         }
-        template<typename EG, typename LFSU, typename X, typename LFSV,
-                 typename C>
+        template<typename Context, typename LFSV, typename C>
         static void apply(const ArgPtrs& lops, typename C::weight_type weight,
-                          const EG& eg,
-                          const LFSU& lfsu, const X& x, const LFSV& lfsv,
+                          Context& ctx, const LFSV& lfsv,
                           C& m)
         {
           if(weight != K(0)) {
             WeightedMatrixAccumulationView<C> view(m, weight);
-            LocalAssemblerCallSwitch<Arg, Arg::doAlphaVolume>::
-              jacobian_volume(*get<i>(lops), eg, lfsu, x, lfsv, view);
+            QuadratureContextCallSwitch<Arg, Arg::doAlphaVolume>::
+              jacobian_volume(*get<i>(lops), ctx, lfsv, view);
           }
         }
       };
@@ -1119,9 +1329,18 @@ namespace Dune {
       ( const EG& eg,
         const LFSU& lfsu, const X& x, const LFSV& lfsv,
         C& m) const
+      {
+        typename VolumeContextSelector
+          <WeightedSumLocalOperator, EG, LFSU, X>::type ctx(eg, lfsu, x);
+        jacobian_volume(ctx, lfsv, m);
+      }
+
+      //! get an element's jacobian from a shared context
+      template<typename Context, typename LFSV, typename C>
+      void jacobian_volume(Context& ctx, const LFSV& lfsv, C& m) const
       {
         ForLoop<JacobianVolumeOperation, 0, size-1>::
-          apply(lops, weights, eg, lfsu, x, lfsv, m);
+          apply(lops, weights, ctx, lfsv, m);
       }
 
       //! get an element's jacobian after the intersections have been handled
@@ -8,6 +8,8 @@
 #include <cmath>
 
 #include <math.h>
+#include <type_traits>
+#include <utility>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/ios_state.hh>
@@ -15,6 +17,7 @@
 #include <dune/common/parametertree.hh>
 
 #include <dune/pdelab/backend/solver.hh>
+#include <dune/pdelab/common/workspace.hh>
 
 namespace Dune
 {
@@ -42,6 +45,46 @@ namespace Dune
         linear_solver_iterations(0) {}
     };
 
+#ifndef DOXYGEN
+
+    namespace impl {
+
+      // Assembles residual and jacobian in a single sweep if the grid operator
+      // provides residual_and_jacobian(), and with two sweeps otherwise.
+      template<typename GO, typename X, typename R, typename A>
+      struct ResidualAndJacobian
+      {
+        template<typename T>
+        static auto test(T* go)
+          -> decltype(go->residual_and_jacobian(std::declval<const X&>(),
+                                                std::declval<R&>(),
+                                                std::declval<A&>()),
+                      std::true_type());
+
+        template<typename T>
+        static std::false_type test(...);
+
+        static void assemble(GO& go, const X& x, R& r, A& a, std::true_type)
+        {
+          go.residual_and_jacobian(x,r,a);
+        }
+
+        static void assemble(GO& go, const X& x, R& r, A& a, std::false_type)
+        {
+          go.residual(x,r);
+          go.jacobian(x,a);
+        }
+
+        static void assemble(GO& go, const X& x, R& r, A& a)
+        {
+          assemble(go,x,r,a,decltype(test<GO>(nullptr))());
+        }
+      };
+
+    } // namespace impl
+
+#endif // DOXYGEN
+
     template<class GOS, class TrlV, class TstV>
     class NewtonBase
     {
@@ -65,6 +108,35 @@ namespace Dune
           verbosity_level = verbosity_level_;
       }
 
+      //! Releases the vectors and the matrix that are kept between calls of apply().
+      void releaseWorkspace()
+      {
+        trial_workspace.clear();
+        test_workspace.clear();
+        matrix_workspace.clear();
+        jacobian_assembled = false;
+      }
+
+      //! Whether a jacobian from an earlier call of apply() may be used for the next one.
+      /**
+       * The matrix is kept between calls of apply(), but by default the first
+       * step of every call assembles the jacobian at the new initial guess. If
+       * this is enabled, the jacobian of the previous call is kept as long as the
+       * reassemble threshold permits, e.g. for a modified Newton method over
+       * several time steps with setReassembleThreshold() >= 1. The matrix is
+       * still reassembled if it had to be recreated for an updated function space.
+       */
+      void setReuseJacobian(bool reuse_jacobian_)
+      {
+        reuse_jacobian = reuse_jacobian_;
+      }
+
+      //! The matrix that is kept between calls of apply().
+      const Workspace<Matrix>& matrixWorkspace() const
+      {
+        return matrix_workspace;
+      }
+
     protected:
       GridOperator& gridoperator;
       TrialVector *u;
@@ -75,11 +147,55 @@ namespace Dune
       bool reassembled;
       RFType reduction;
       RFType abs_limit;
+      //! The matrix of the running solve, may be assembled together with the defect
+      Matrix *jacobian;
+      //! Whether jacobian has been assembled at the current iterate by defect_for_step()
+      bool jacobian_current;
+      //! Whether the matrix holds a complete jacobian that may be used for the next step
+      bool jacobian_assembled;
+      //! Whether the jacobian of an earlier call of apply() may be used
+      bool reuse_jacobian;
+      //! Correction and line search vectors, kept between calls of apply()
+      Workspace<TrialVector> trial_workspace;
+      //! Residual vector, kept between calls of apply()
+      Workspace<TestVector> test_workspace;
+      //! Matrix, kept between calls of apply()
+      Workspace<Matrix> matrix_workspace;
+
+      //! Returns the trial space vector in the given slot of the workspace.
+      TrialVector& trialVector(std::size_t slot)
+      {
+        return trial_workspace.get(slot,gridoperator.trialGridFunctionSpace(),
+                                   gridoperator.trialGridFunctionSpace().revision());
+      }
+
+      //! Returns the test space vector in the given slot of the workspace.
+      TestVector& testVector(std::size_t slot)
+      {
+        return test_workspace.get(slot,gridoperator.testGridFunctionSpace(),
+                                  gridoperator.testGridFunctionSpace().revision());
+      }
+
+      //! Returns the matrix of the workspace, which is recreated if either space has been updated.
+      Matrix& matrix()
+      {
+        const std::size_t allocations = matrix_workspace.allocations();
+        Matrix& A = matrix_workspace.get(0,gridoperator,
+                                         gridoperator.testGridFunctionSpace().revision()
+                                         + gridoperator.trialGridFunctionSpace().revision());
+        if (matrix_workspace.allocations() != allocations)
+          jacobian_assembled = false;
+        return A;
+      }
 
       NewtonBase(GridOperator& go, TrialVector& u_)
         : gridoperator(go)
         , u(&u_)
         , verbosity_level(1)
+        , jacobian(0)
+        , jacobian_current(false)
+        , jacobian_assembled(false)
+        , reuse_jacobian(false)
       {
         if (gridoperator.trialGridFunctionSpace().gridView().comm().rank()>0)
           verbosity_level = 0;
@@ -89,6 +205,10 @@ namespace Dune
         : gridoperator(go)
         , u(0)
         , verbosity_level(1)
+        , jacobian(0)
+        , jacobian_current(false)
+        , jacobian_assembled(false)
+        , reuse_jacobian(false)
       {
         if (gridoperator.trialGridFunctionSpace().gridView().comm().rank()>0)
           verbosity_level = 0;
@@ -100,6 +220,26 @@ namespace Dune
       virtual void prepare_step(Matrix& A, TestVector& r) = 0;
       virtual void line_search(TrialVector& z, TestVector& r) = 0;
       virtual void defect(TestVector& r) = 0;
+
+      //! Computes the defect at an iterate that the next step will start from.
+      /**
+       * In contrast to defect(), the iterate is known to be accepted, so
+       * implementations may assemble the jacobian for the next step in the
+       * same grid traversal.
+       *
+       * \param r       The defect.
+       * \param initial Whether this is the defect of the initial guess.
+       */
+      virtual void defect_for_step(TestVector& r, bool initial)
+      {
+        defect(r);
+      }
+
+      //! Whether the next prepare_step() is certain to reassemble the jacobian.
+      virtual bool jacobian_needed_for_step(bool initial) const
+      {
+        return false;
+      }
     };
 
     template<class GOS, class S, class TrlV, class TstV>
@@ -143,6 +283,7 @@ namespace Dune
     protected:
       virtual void defect(TestVector& r)
       {
+        this->jacobian_current = false;
         r = 0.0;                                        // TODO: vector interface
         this->gridoperator.residual(*this->u, r);
         this->res.defect = this->solver.norm(r);                    // TODO: solver interface
@@ -151,6 +292,27 @@ namespace Dune
                      "NewtonSolver::defect(): Non-linear defect is NaN or Inf");
       }
 
+      virtual void defect_for_step(TestVector& r, bool initial)
+      {
+        if (!this->jacobian || !this->jacobian_needed_for_step(initial))
+          {
+            this->defect(r);
+            return;
+          }
+        if (this->verbosity_level >= 4)
+          std::cout << "      Assembling matrix together with defect..." << std::endl;
+        r = 0.0;                                        // TODO: vector interface
+        *this->jacobian = 0.0;                          // TODO: Matrix interface
+        impl::ResidualAndJacobian<GOS,TrlV,TstV,Matrix>::
+          assemble(this->gridoperator, *this->u, r, *this->jacobian);
+        this->jacobian_current = true;
+        this->jacobian_assembled = true;
+        this->res.defect = this->solver.norm(r);                    // TODO: solver interface
+        if (!std::isfinite(this->res.defect))
+          DUNE_THROW(NewtonDefectError,
+                     "NewtonSolver::defect_for_step(): Non-linear defect is NaN or Inf");
+      }
+
 
     private:
       void linearSolve(Matrix& A, TrialVector& z, TestVector& r) const
@@ -201,8 +363,12 @@ namespace Dune
 
       try
         {
-          TestVector r(this->gridoperator.testGridFunctionSpace());
-          this->defect(r);
+          TestVector& r = this->testVector(0);
+          Matrix& A = this->matrix();
+          this->jacobian = &A;
+          if (!this->reuse_jacobian)
+            this->jacobian_assembled = false;
+          this->defect_for_step(r,true);
           this->res.first_defect = this->res.defect;
           this->prev_defect = this->res.defect;
 
@@ -215,8 +381,7 @@ namespace Dune
                         << this->res.defect << std::endl;
             }
 
-          Matrix A(this->gridoperator);
-          TrialVector z(this->gridoperator.trialGridFunctionSpace());
+          TrialVector& z = this->trialVector(0);
 
           while (!this->terminate())
             {
@@ -304,9 +469,15 @@ namespace Dune
         }
       catch(...)
         {
+          // the matrix may be incomplete
+          this->jacobian = 0;
+          this->jacobian_current = false;
+          this->jacobian_assembled = false;
           this->res.elapsed = timer.elapsed();
           throw;
         }
+      this->jacobian = 0;
+      this->jacobian_current = false;
       this->res.elapsed = timer.elapsed();
 
       ios_base_all_saver restorer(std::cout); // store old ios flags
@@ -399,6 +570,7 @@ namespace Dune
         , min_linear_reduction(1e-3)
         , fixed_linear_reduction(0.0)
         , reassemble_threshold(0.0)
+        , fused_assembly(false)
       {}
 
       NewtonPrepareStep(GridOperator& go)
@@ -406,6 +578,7 @@ namespace Dune
         , min_linear_reduction(1e-3)
         , fixed_linear_reduction(0.0)
         , reassemble_threshold(0.0)
+        , fused_assembly(false)
       {}
 
       /* with min_linear_reduction > 0, the linear reduction will be
@@ -429,17 +602,44 @@ namespace Dune
         reassemble_threshold = reassemble_threshold_;
       }
 
+      /* with fused_assembly == true, the jacobian is also assembled
+         together with the defect of the new iterate in later steps if
+         the line search does not have to test the new iterate first.
+         This saves one grid traversal per step, but assembles one
+         unneeded jacobian after the last step. The jacobian for the
+         first step is always assembled together with the initial
+         defect. */
+      void setFusedAssembly(bool fused_assembly_)
+      {
+        fused_assembly = fused_assembly_;
+      }
+
+      virtual bool jacobian_needed_for_step(bool initial) const
+      {
+        // before the first step, the defect reduction is 1
+        if (initial)
+          return !this->jacobian_assembled || reassemble_threshold < 1.0;
+        return fused_assembly && reassemble_threshold <= 0.0;
+      }
+
       virtual void prepare_step(Matrix& A, TstV& )
       {
         this->reassembled = false;
-        if (this->res.defect/this->prev_defect > reassemble_threshold)
+        if (this->jacobian_current)
+          {
+            // assembled together with the defect at the current iterate
+            this->reassembled = true;
+          }
+        else if (!this->jacobian_assembled || this->res.defect/this->prev_defect > reassemble_threshold)
           {
             if (this->verbosity_level >= 3)
               std::cout << "      Reassembling matrix..." << std::endl;
             A = 0.0;                                    // TODO: Matrix interface
             this->gridoperator.jacobian(*this->u, A);
             this->reassembled = true;
+            this->jacobian_assembled = true;
           }
+        this->jacobian_current = false;
 
         if (fixed_linear_reduction == true)
           this->linear_reduction = min_linear_reduction;
@@ -480,6 +680,7 @@ namespace Dune
       RFType min_linear_reduction;
       bool fixed_linear_reduction;
       RFType reassemble_threshold;
+      bool fused_assembly;
     };
 
     template<class GOS, class TrlV, class TstV>
@@ -535,7 +736,7 @@ namespace Dune
         if (strategy == noLineSearch)
           {
             this->u->axpy(-1.0, z);                     // TODO: vector interface
-            this->defect(r);
+            this->defect_for_step(r,false);
             return;
           }
 
@@ -544,7 +745,8 @@ namespace Dune
         RFType lambda = 1.0;
         RFType best_lambda = 0.0;
         RFType best_defect = this->res.defect;
-        TrialVector prev_u(*this->u);  // TODO: vector interface
+        TrialVector& prev_u = this->trialVector(1);
+        prev_u = *this->u;                              // TODO: vector interface
         unsigned int i = 0;
         ios_base_all_saver restorer(std::cout); // store old ios flags
 
@@ -715,6 +917,12 @@ namespace Dune
         if (param.hasKey("ReassembleThreshold"))
           this->setReassembleThreshold(
             param.get<RFType>("ReassembleThreshold"));
+        if (param.hasKey("FusedAssembly"))
+          this->setFusedAssembly(
+            param.get<bool>("FusedAssembly"));
+        if (param.hasKey("ReuseJacobian"))
+          this->setReuseJacobian(
+            param.get<bool>("ReuseJacobian"));
         if (param.hasKey("LineSearchStrategy"))
           this->setLineSearchStrategy(
             param.get<std::string>("LineSearchStrategy"));
@@ -9,6 +9,7 @@
 #include <dune/pdelab/ordering/utility.hh>
 #include <dune/pdelab/ordering/localorderingbase.hh>
 #include <dune/pdelab/ordering/orderingbase.hh>
+#include <dune/pdelab/ordering/updatemap.hh>
 #include <dune/pdelab/ordering/leaflocalordering.hh>
 #include <dune/pdelab/ordering/lexicographicordering.hh>
 #include <dune/pdelab/ordering/leafgridviewordering.hh>
@@ -473,6 +474,8 @@ namespace Dune {
         , _gt_dof_offsets(r._gt_dof_offsets)
         , _gt_entity_offsets(r._gt_entity_offsets)
         , _entity_dof_offsets(r._entity_dof_offsets)
+        , _update_map(r._update_map)
+        , _cell_record(r._cell_record)
       {
         this->setDelegate(this);
       }
@@ -484,6 +487,8 @@ namespace Dune {
         , _gt_dof_offsets(std::move(r._gt_dof_offsets))
         , _gt_entity_offsets(std::move(r._gt_entity_offsets))
         , _entity_dof_offsets(std::move(r._entity_dof_offsets))
+        , _update_map(std::move(r._update_map))
+        , _cell_record(std::move(r._cell_record))
       {
         this->setDelegate(this);
       }
@@ -626,6 +631,16 @@ namespace Dune {
         return 0;
       }
 
+      //! Returns the map from the DOF indices before the last call to update() to the current ones.
+      /**
+       * The map is only valid() if the ordering is neither fixed size nor container blocked
+       * and the grid view did not change, see OrderingUpdateMap.
+       */
+      const OrderingUpdateMap<typename Traits::SizeType>& updateMap() const
+      {
+        return _update_map;
+      }
+
       void update()
       {
 
@@ -634,6 +649,9 @@ namespace Dune {
         const size_type dim = GV::dimension;
         GTVector geom_types;
 
+        // the per-entity offsets of the last update are kept for the update map
+        const bool had_entity_offsets = !_entity_dof_offsets.empty() && !_fixed_size;
+
         for (size_type cc = 0; cc <= dim; ++cc)
           {
             auto per_codim_geom_types = _gv.indexSet().types(cc);
@@ -662,9 +680,11 @@ namespace Dune {
             typedef typename GV::template Codim<0>::Entity Cell;
 
             const CellIterator end_it = _gv.template end<0>();
+            _cell_record.start();
             for (CellIterator it = _gv.template begin<0>(); it != end_it; ++it)
               {
                 TypeTree::applyToTree(localOrdering(),collect_used_geometry_types_from_cell_visitor<Cell>(*it));
+                _cell_record.record(_gv,*it);
               }
             TypeTree::applyToTree(localOrdering(),post_collect_used_geometry_types<GV>(_gv,geom_types));
             // allocate
@@ -706,9 +726,19 @@ namespace Dune {
 
             _codim_fixed_size.set();
 
+            _update_map.clear();
+            _cell_record.clear();
           }
         else
           {
+            std::vector<size_type> old_gt_entity_offsets;
+            std::vector<size_type> old_entity_dof_offsets;
+            if (had_entity_offsets)
+              {
+                old_gt_entity_offsets.swap(_gt_entity_offsets);
+                old_entity_dof_offsets.swap(_entity_dof_offsets);
+              }
+
             _gt_entity_offsets.assign(gt_index_count + 1,0);
 
             for (GTVector::const_iterator it = geom_types.begin(); it != geom_types.end(); ++it)
@@ -743,6 +773,13 @@ namespace Dune {
               _block_count = _size;
 
             _codim_fixed_size.reset();
+
+            // the cells were recorded by the sweep above, as the ordering is not fixed size
+            const bool cells_unchanged = _cell_record.finish();
+            if (!_container_blocked && cells_unchanged && old_gt_entity_offsets == _gt_entity_offsets)
+              _update_map.record(old_entity_dof_offsets,_entity_dof_offsets);
+            else
+              _update_map.clear();
           }
 
         _max_local_size = localOrdering().maxLocalSize();
@@ -764,6 +801,8 @@ namespace Dune {
       std::vector<typename Traits::SizeType> _gt_dof_offsets;
       std::vector<typename Traits::SizeType> _gt_entity_offsets;
       std::vector<typename Traits::SizeType> _entity_dof_offsets;
+      OrderingUpdateMap<typename Traits::SizeType> _update_map;
+      CellRecord<GV> _cell_record;
 
     };
 
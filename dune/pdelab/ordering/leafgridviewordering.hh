@@ -6,6 +6,7 @@
 
 #include <dune/pdelab/ordering/directleaflocalordering.hh>
 #include <dune/pdelab/ordering/leaforderingbase.hh>
+#include <dune/pdelab/ordering/updatemap.hh>
 
 namespace Dune {
   namespace PDELab {
@@ -43,18 +44,42 @@ namespace Dune {
       LeafGridViewOrdering(const LeafGridViewOrdering& r)
         : BaseT(r)
         , _gv(r._gv)
+        , _update_map(r._update_map)
+        , _cell_record(r._cell_record)
       {}
 
       LeafGridViewOrdering(LeafGridViewOrdering&& r)
         : BaseT(std::move(r))
         , _gv(r._gv)
+        , _update_map(std::move(r._update_map))
+        , _cell_record(std::move(r._cell_record))
       {}
 
 #endif // DOXYGEN
 
+      //! Returns the map from the DOF indices before the last call to update() to the current ones.
+      /**
+       * The map is only valid() if the ordering is neither fixed size nor container blocked
+       * and the grid view did not change, see OrderingUpdateMap.
+       */
+      const OrderingUpdateMap<typename Traits::SizeType>& updateMap() const
+      {
+        return _update_map;
+      }
+
       virtual void update()
       {
         LocalOrdering& lo = this->localOrdering();
+
+        // the per-entity offsets of the last update are kept for the update map
+        std::vector<typename Traits::SizeType> old_gt_entity_offsets;
+        std::vector<typename Traits::SizeType> old_entity_dof_offsets;
+        if (!lo._fixed_size)
+          {
+            old_gt_entity_offsets = lo._gt_entity_offsets;
+            old_entity_dof_offsets.swap(lo._entity_dof_offsets);
+          }
+
         lo.update_a_priori_fixed_size();
 
         const std::size_t dim = GV::dimension;
@@ -69,6 +94,8 @@ namespace Dune {
             std::copy(per_codim_geom_types.begin(),per_codim_geom_types.end(),std::back_inserter(geom_types));
           }
 
+        bool cells_unchanged = false;
+
         if (lo._fixed_size)
           {
             lo.update_fixed_size(geom_types.begin(),geom_types.end());
@@ -80,10 +107,13 @@ namespace Dune {
             typedef typename GV::template Codim<0>::Iterator CellIterator;
 
             const CellIterator end_it = _gv.template end<0>();
+            _cell_record.start();
             for (CellIterator it = _gv.template begin<0>(); it != end_it; ++it)
               {
                 lo.collect_used_geometry_types_from_cell(*it);
+                _cell_record.record(_gv,*it);
               }
+            cells_unchanged = _cell_record.finish();
 
             lo.allocate_entity_offset_vector(geom_types.begin(),geom_types.end());
 
@@ -124,6 +154,14 @@ namespace Dune {
             _codim_fixed_size.reset();
           }
 
+        if (lo._fixed_size)
+          _cell_record.clear();
+
+        if (!lo._fixed_size && !_container_blocked && cells_unchanged && old_gt_entity_offsets == lo._gt_entity_offsets)
+          _update_map.record(old_entity_dof_offsets,lo._entity_dof_offsets);
+        else
+          _update_map.clear();
+
         _fixed_size = lo._fixed_size;
         _max_local_size = lo.maxLocalSize();
 
@@ -146,6 +184,8 @@ namespace Dune {
       using BaseT::_gt_dof_offsets;
 
       typename Traits::GridView _gv;
+      OrderingUpdateMap<typename Traits::SizeType> _update_map;
+      CellRecord<GV> _cell_record;
     };
 
 
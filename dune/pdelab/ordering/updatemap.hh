@@ -0,0 +1,261 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#ifndef DUNE_PDELAB_ORDERING_UPDATEMAP_HH
+#define DUNE_PDELAB_ORDERING_UPDATEMAP_HH
+
+#include <algorithm>
+#include <vector>
+
+#include <dune/geometry/referenceelements.hh>
+
+namespace Dune {
+  namespace PDELab {
+
+    //! \addtogroup Ordering
+    //! \{
+
+    //! Compact map from the DOF indices before the last update() of an ordering to the indices after it.
+    /**
+     * The map is recorded by the GridView orderings of spaces that are not fixed size
+     * and not container blocked, i.e. orderings that store the DOFs of each entity in
+     * a contiguous range, if the grid view did not change during the update: the
+     * orderings compare the local ids and the indices of all cells and of their
+     * subentities with the ones seen by the previous update (see CellRecord), so the
+     * map is discarded after any adaptation of the grid. This leaves the change of the
+     * polynomial degree of some cells of a variable order space as the use case.
+     *
+     * The DOFs of an entity keep their position within the entity: the first
+     * min(old size, new size) DOFs of each entity are mapped, DOFs that were removed
+     * are dropped and DOFs that were added have no predecessor. valid() only states
+     * this correspondence of positions. Whether the coefficients keep their meaning
+     * depends on the basis: for hierarchical bases (e.g. the monomial and orthonormal
+     * polynomial bases), transfer() moves a function to the new space without
+     * interpolation, for other bases the coefficients of the entities whose number
+     * of DOFs changed have to be interpolated instead.
+     *
+     * The map is stored as a sorted list of runs of consecutive indices, so its size
+     * is proportional to the number of entities whose DOFs changed instead of the
+     * number of DOFs.
+     *
+     * \note Only the GridView orderings carry a map, i.e. the orderings of leaf spaces
+     *       and the entity blocked orderings of power and composite spaces. The map is
+     *       derived from the per-entity offsets, which update() still rebuilds with
+     *       full sweeps over the cells; it saves clients the matching of the old and
+     *       new DOFs, not the update of the ordering itself.
+     */
+    template<typename SizeType>
+    class OrderingUpdateMap
+    {
+
+    public:
+
+      typedef SizeType size_type;
+
+      //! Marker for indices without a counterpart.
+      static const size_type invalid = ~size_type(0);
+
+      //! A range of consecutive old indices that is mapped to consecutive new indices.
+      struct Run
+      {
+        size_type old_begin;
+        size_type new_begin;
+        size_type size;
+      };
+
+      typedef typename std::vector<Run>::const_iterator const_iterator;
+
+      OrderingUpdateMap()
+        : _valid(false)
+        , _old_size(0)
+        , _new_size(0)
+      {}
+
+      //! Returns whether the last update() recorded a map.
+      bool valid() const
+      {
+        return _valid;
+      }
+
+      //! Returns whether the last update() left all DOF indices unchanged.
+      bool identity() const
+      {
+        if (!_valid || _old_size != _new_size)
+          return false;
+        if (_runs.empty())
+          return _old_size == 0;
+        return _runs.size() == 1 && _runs[0].old_begin == 0 && _runs[0].new_begin == 0 && _runs[0].size == _old_size;
+      }
+
+      //! Number of DOFs before the update.
+      size_type oldSize() const
+      {
+        return _old_size;
+      }
+
+      //! Number of DOFs after the update.
+      size_type newSize() const
+      {
+        return _new_size;
+      }
+
+      //! Iterators over the runs, sorted by their old (and new) indices.
+      //! @{
+      const_iterator begin() const
+      {
+        return _runs.begin();
+      }
+
+      const_iterator end() const
+      {
+        return _runs.end();
+      }
+      //! @}
+
+      //! Returns the new index of the old DOF i, or invalid if it was removed.
+      size_type operator[](size_type i) const
+      {
+        const_iterator it = std::upper_bound(_runs.begin(),_runs.end(),i,
+                                             [](size_type index, const Run& run) { return index < run.old_begin; });
+        if (it == _runs.begin())
+          return invalid;
+        --it;
+        return i < it->old_begin + it->size ? it->new_begin + (i - it->old_begin) : invalid;
+      }
+
+      //! Copies the entries of old_v into new_v according to the map.
+      /**
+       * Entries of new_v without a predecessor are left unchanged. Both containers
+       * must provide operator[] for the flat DOF indices, e.g. the raw ISTL vectors
+       * of an unblocked backend.
+       */
+      template<typename OldV, typename NewV>
+      void transfer(const OldV& old_v, NewV& new_v) const
+      {
+        for (const_iterator it = _runs.begin(); it != _runs.end(); ++it)
+          for (size_type k = 0; k < it->size; ++k)
+            new_v[it->new_begin + k] = old_v[it->old_begin + k];
+      }
+
+      //! Discards the map.
+      void clear()
+      {
+        _valid = false;
+        _old_size = 0;
+        _new_size = 0;
+        _runs.clear();
+      }
+
+      //! Records the map from two per-entity offset vectors of the same length.
+      /**
+       * Entity e owns the DOFs [offsets[e],offsets[e+1]) in both vectors.
+       */
+      template<typename Offsets>
+      void record(const Offsets& old_offsets, const Offsets& new_offsets)
+      {
+        clear();
+        if (old_offsets.size() != new_offsets.size() || old_offsets.empty())
+          return;
+
+        _valid = true;
+        _old_size = old_offsets.back();
+        _new_size = new_offsets.back();
+        for (size_type e = 0; e + 1 < old_offsets.size(); ++e)
+          {
+            const size_type count = std::min(old_offsets[e+1] - old_offsets[e],
+                                             new_offsets[e+1] - new_offsets[e]);
+            if (count == 0)
+              continue;
+            if (!_runs.empty() &&
+                _runs.back().old_begin + _runs.back().size == old_offsets[e] &&
+                _runs.back().new_begin + _runs.back().size == new_offsets[e])
+              _runs.back().size += count;
+            else
+              {
+                Run run = { old_offsets[e], new_offsets[e], count };
+                _runs.push_back(run);
+              }
+          }
+      }
+
+    private:
+
+      bool _valid;
+      size_type _old_size;
+      size_type _new_size;
+      std::vector<Run> _runs;
+
+    };
+
+    template<typename SizeType>
+    const SizeType OrderingUpdateMap<SizeType>::invalid;
+
+    //! Local ids and indices of the cells of a grid view, used to detect changes of the grid between two updates.
+    /**
+     * The cells are recorded in iteration order with their local id and the indices
+     * of all their subentities. Two records are equal if the grid view consists of
+     * the same cells and all entities kept their indices.
+     */
+    template<typename GV>
+    class CellRecord
+    {
+
+      typedef typename GV::Grid::LocalIdSet::IdType Id;
+      typedef typename GV::IndexSet::IndexType Index;
+
+    public:
+
+      //! Starts a new record, the previous one is kept until finish().
+      void start()
+      {
+        _new_ids.clear();
+        _new_indices.clear();
+      }
+
+      //! Appends a cell of the grid view gv to the new record.
+      template<typename Cell>
+      void record(const GV& gv, const Cell& cell)
+      {
+        const int dim = GV::dimension;
+        _new_ids.push_back(gv.grid().localIdSet().id(cell));
+        const ReferenceElement<typename GV::ctype,dim>& ref_el =
+          ReferenceElements<typename GV::ctype,dim>::general(cell.type());
+        for (int codim = 0; codim <= dim; ++codim)
+          for (int i = 0; i < ref_el.size(codim); ++i)
+            _new_indices.push_back(gv.indexSet().subIndex(cell,i,codim));
+      }
+
+      //! Replaces the previous record by the new one and returns whether both are equal.
+      bool finish()
+      {
+        const bool unchanged = !_ids.empty() && _ids == _new_ids && _indices == _new_indices;
+        _ids.swap(_new_ids);
+        _indices.swap(_new_indices);
+        std::vector<Id>().swap(_new_ids);
+        std::vector<Index>().swap(_new_indices);
+        return unchanged;
+      }
+
+      //! Discards all records.
+      void clear()
+      {
+        std::vector<Id>().swap(_ids);
+        std::vector<Index>().swap(_indices);
+        std::vector<Id>().swap(_new_ids);
+        std::vector<Index>().swap(_new_indices);
+      }
+
+    private:
+
+      std::vector<Id> _ids;
+      std::vector<Index> _indices;
+      std::vector<Id> _new_ids;
+      std::vector<Index> _new_indices;
+
+    };
+
+   //! \} group Ordering
+  } // namespace PDELab
+} // namespace Dune
+
+#endif // DUNE_PDELAB_ORDERING_UPDATEMAP_HH
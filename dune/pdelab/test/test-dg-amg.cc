@@ -6,6 +6,7 @@
 #include <dune/istl/matrixmatrix.hh>
 #include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
 #include <dune/pdelab/localoperator/convectiondiffusiondg.hh>
+#include <dune/pdelab/localoperator/errorindicatordg.hh>
 #include <dune/pdelab/localoperator/l2.hh>
 
 #include <dune/pdelab/backend/istl/cg_to_dg_prolongation.hh>
@@ -238,6 +239,43 @@ int main(int argc, char **argv)
       slp.apply();
   }
 
+  /////////////////// ERROR ESTIMATE
+  // compare the estimate fused into the residual evaluation with a separate grid operator
+  {
+      typedef Dune::PDELab::P0LocalFiniteElementMap<GM::ctype,NumberType,dim> P0FEM;
+      P0FEM p0fem(Dune::GeometryType(elemtype,dim));
+      typedef Dune::PDELab::GridFunctionSpace<GM::LeafGridView,P0FEM,Dune::PDELab::NoConstraints,
+                                              Dune::PDELab::ISTLVectorBackend<> > P0GFS;
+      P0GFS p0gfs(grid->leafGridView(),p0fem);
+      typedef typename Dune::PDELab::BackendVectorSelector<P0GFS,NumberType>::Type U0;
+
+      typedef Dune::PDELab::ConvectionDiffusionDG_ErrorIndicator<Problem> ESTLOP;
+      ESTLOP estlop(problem,Dune::PDELab::ConvectionDiffusionDGMethod::SIPG,Dune::PDELab::ConvectionDiffusionDGWeights::weightsOn,2.0);
+      typedef Dune::PDELab::EmptyTransformation NoTrafo;
+      typedef Dune::PDELab::GridOperator<GFS,P0GFS,ESTLOP,MBE,NumberType,NumberType,NumberType,NoTrafo,NoTrafo> ESTGO;
+      ESTGO estgo(fs.getGFS(),p0gfs,estlop);
+
+      U0 eta(p0gfs,0.0);
+      estgo.residual(x,eta);
+      V r(fs.getGFS(),0.0);
+      dggo2.residual(x,r);
+
+      U0 eta_fused(p0gfs,0.0);
+      V r_fused(fs.getGFS(),0.0);
+      dggo2.residual_and_estimate(x,r_fused,estlop,p0gfs,eta_fused);
+
+      eta_fused -= eta;
+      r_fused -= r;
+      std::cout << "difference of fused error estimate " << eta_fused.infinity_norm()
+                << ", of fused residual " << r_fused.infinity_norm() << std::endl;
+      if (eta_fused.infinity_norm() > 1e-10 * (1.0 + eta.infinity_norm()) ||
+          r_fused.infinity_norm() > 1e-10 * (1.0 + r.infinity_norm()))
+        {
+          std::cerr << "fused error estimate does not match separate evaluation" << std::endl;
+          return 1;
+        }
+  }
+
   // done
   return 0;
 }
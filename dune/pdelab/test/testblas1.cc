@@ -0,0 +1,125 @@
+// -*- tab-width: 8; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=8 sw=2 sts=2:
+
+#include "config.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <dune/common/fvector.hh>
+#include <dune/istl/bvector.hh>
+
+#include <dune/pdelab/backend/common/blas1.hh>
+#include <dune/pdelab/backend/istl/vectorhelpers.hh>
+
+bool check(const char* name, double value, double reference)
+{
+  if (std::abs(value - reference) <= 1e-9 * (1.0 + std::abs(reference)))
+    return true;
+  std::cerr << name << ": got " << value << ", expected " << reference << std::endl;
+  return false;
+}
+
+// compares the BLAS-1 kernels on the flat storage with the ISTL implementation
+template<int n>
+bool test(std::size_t blocks)
+{
+  typedef Dune::BlockVector<Dune::FieldVector<double,n> > V;
+  typedef Dune::PDELab::istl::flat_vector<V> Flat;
+  namespace blas1 = Dune::PDELab::blas1;
+
+  static_assert(Flat::value,"BlockVector of FieldVector should be flat");
+
+  V x(blocks), y(blocks);
+  for (std::size_t i = 0; i < blocks; ++i)
+    for (int j = 0; j < n; ++j)
+      {
+        x[i][j] = std::sin(1.0 + i * n + j);
+        y[i][j] = std::cos(2.0 * (i * n + j));
+      }
+
+  const std::size_t size = Flat::size(x);
+  bool passed = size == blocks * n;
+
+  passed &= check("dot",blas1::dot(size,Flat::data(x),Flat::data(y)),x.dot(y));
+  passed &= check("two_norm",blas1::two_norm(size,Flat::data(x)),x.two_norm());
+  passed &= check("one_norm",blas1::one_norm(size,Flat::data(x)),x.one_norm());
+  passed &= check("infinity_norm",blas1::infinity_norm(size,Flat::data(x)),x.infinity_norm());
+
+  V z(y);
+  z.axpy(0.5,x);
+  blas1::axpy(size,0.5,Flat::data(x),Flat::data(y));
+  z -= y;
+  passed &= check("axpy",z.two_norm(),0.0);
+
+  blas1::scale(size,2.0,Flat::data(x));
+  blas1::subtract(size,Flat::data(x),Flat::data(y));
+  blas1::add(size,Flat::data(x),Flat::data(y));
+  blas1::copy(size,Flat::data(y),Flat::data(z));
+  z -= y;
+  passed &= check("copy",z.two_norm(),0.0);
+
+  blas1::fill(size,Flat::data(x),3.0);
+  passed &= check("fill",blas1::one_norm(size,Flat::data(x)),3.0 * size);
+
+  return passed;
+}
+
+#ifdef _OPENMP
+// the reductions must not depend on the number of threads
+bool test_reproducibility()
+{
+  namespace blas1 = Dune::PDELab::blas1;
+  const std::size_t size = 10 * blas1::chunk_size + 3;
+  std::vector<double> x(size), y(size);
+  for (std::size_t i = 0; i < size; ++i)
+    {
+      x[i] = std::sin(1.0 + i) * (1.0 + 1e-3 * i);
+      y[i] = std::cos(2.0 * i);
+    }
+
+  omp_set_num_threads(1);
+  const double dot = blas1::dot(size,x.data(),y.data());
+  const double two_norm = blas1::two_norm(size,x.data());
+  const double one_norm = blas1::one_norm(size,x.data());
+
+  bool passed = true;
+  for (int threads = 2; threads <= 5; ++threads)
+    {
+      omp_set_num_threads(threads);
+      if (blas1::dot(size,x.data(),y.data()) != dot ||
+          blas1::two_norm(size,x.data()) != two_norm ||
+          blas1::one_norm(size,x.data()) != one_norm)
+        {
+          std::cerr << "reductions with " << threads << " threads differ from a single thread" << std::endl;
+          passed = false;
+        }
+    }
+  return passed;
+}
+#endif
+
+int main(int argc, char** argv)
+{
+  bool passed = true;
+
+#ifdef _OPENMP
+  passed &= test_reproducibility();
+  // run the kernels below with more threads than chunks for some of the sizes
+  omp_set_num_threads(4);
+#endif
+
+  // sizes below, at and above the chunk size of the kernels
+  passed &= test<1>(0);
+  passed &= test<1>(7);
+  passed &= test<1>(Dune::PDELab::blas1::chunk_size);
+  passed &= test<3>(Dune::PDELab::blas1::chunk_size + 5);
+  passed &= test<2>(10 * Dune::PDELab::blas1::chunk_size + 1);
+
+  return passed ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/common/exceptions.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/checkpoint.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+
+// reading the checkpoint into v has to fail with a CheckpointError
+template<typename Checkpoint, typename V>
+bool expectError(const Checkpoint& checkpoint, const std::string& basename, V& v, const std::string& name)
+{
+  try {
+    checkpoint.read(basename,v);
+  }
+  catch (Dune::PDELab::CheckpointError&) {
+    return true;
+  }
+  std::cerr << name << ": reading the checkpoint did not throw a CheckpointError" << std::endl;
+  return false;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> Q1FEM;
+    Q1FEM q1fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<GV,Q1FEM,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > Q1GFS;
+    Q1GFS q1gfs(gv,q1fem);
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,2> Q2FEM;
+    Q2FEM q2fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<GV,Q2FEM,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > Q2GFS;
+    Q2GFS q2gfs(gv,q2fem);
+
+    typedef Dune::PDELab::BackendVectorSelector<Q1GFS,double>::Type V;
+    V x(q1gfs,0.0);
+    std::size_t i = 0;
+    for (V::iterator it = x.begin(); it != x.end(); ++it, ++i)
+      *it = 1.0 / (1.0 + i);
+
+    const std::string basename = "testcheckpoint";
+    Dune::PDELab::DOFVectorCheckpoint<Q1GFS> checkpoint(q1gfs);
+    checkpoint.write(basename,x);
+
+    bool passed = true;
+
+    // the checkpoint restores the vector exactly
+    V xr(q1gfs,0.0);
+    checkpoint.read(basename,xr);
+    xr -= x;
+    if (xr.infinity_norm() != 0.0)
+      {
+        std::cerr << "restored checkpoint differs from the written vector by "
+                  << xr.infinity_norm() << std::endl;
+        passed = false;
+      }
+
+    // a space of a different size
+    {
+      Dune::PDELab::DOFVectorCheckpoint<Q2GFS> q2checkpoint(q2gfs);
+      typedef Dune::PDELab::BackendVectorSelector<Q2GFS,double>::Type V2;
+      V2 x2(q2gfs,0.0);
+      passed = expectError(q2checkpoint,basename,x2,"different space") && passed;
+    }
+
+    // a vector with a different field type
+    {
+      typedef Dune::PDELab::BackendVectorSelector<Q1GFS,float>::Type VF;
+      VF xf(q1gfs,0.0);
+      passed = expectError(checkpoint,basename,xf,"different field type") && passed;
+    }
+
+    // a missing file
+    passed = expectError(checkpoint,"testcheckpoint-missing",xr,"missing file") && passed;
+
+    // a file that ends within the entries
+    {
+      const std::string truncated = "testcheckpoint-truncated";
+      checkpoint.write(truncated,x);
+      std::ifstream in(checkpoint.fileName(truncated).c_str(),std::ios::binary);
+      std::string content((std::istreambuf_iterator<char>(in)),std::istreambuf_iterator<char>());
+      in.close();
+      std::ofstream out(checkpoint.fileName(truncated).c_str(),std::ios::binary | std::ios::trunc);
+      out.write(content.data(),content.size() - sizeof(double));
+      out.close();
+      passed = expectError(checkpoint,truncated,xr,"truncated file") && passed;
+      std::remove(checkpoint.fileName(truncated).c_str());
+    }
+
+    std::remove(checkpoint.fileName(basename).c_str());
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
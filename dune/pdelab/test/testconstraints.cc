@@ -223,6 +223,49 @@ void testpowerp1 (const GV& gv)
   BmType bm(gv);
   Dune::PDELab::constraints(bm,p1mgfs,p1mcg);
 
+  // the compressed constraints have to match the constraints map
+  if (!p1mcg.finalized() || p1mcg.rowCount() != p1mcg.size())
+    DUNE_THROW(Dune::Exception,"compressed constraints not available after constraints assembly");
+  for (typename P1mC::const_iterator it = p1mcg.begin(); it != p1mcg.end(); ++it)
+    {
+      const std::size_t r = p1mcg.findRow(it->first);
+      if (r == P1mC::npos || !(p1mcg.rowIndex(r) == it->first)
+          || p1mcg.rowEnd(r) - p1mcg.rowBegin(r) != it->second.size())
+        DUNE_THROW(Dune::Exception,"compressed constraints do not match the constraints map");
+    }
+
+  // modifying the map discards the compressed constraints, even if the number of rows stays the same
+  if (!p1mcg.empty())
+    {
+      const typename P1mC::key_type ci = p1mcg.begin()->first;
+      p1mcg[ci];
+      if (p1mcg.finalized())
+        DUNE_THROW(Dune::Exception,"compressed constraints still used after operator[]");
+      p1mcg.finalize();
+      typename P1mC::mapped_type row = p1mcg.find(ci)->second;
+      p1mcg.erase(ci);
+      p1mcg.insert(std::make_pair(ci,row));
+      if (p1mcg.finalized())
+        DUNE_THROW(Dune::Exception,"compressed constraints still used after erase() and insert()");
+      p1mcg.finalize();
+    }
+
+  // releasing the map keeps the compressed constraints, and modifications restore the map
+  {
+    const std::size_t rows = p1mcg.size();
+    p1mcg.finalize(true);
+    if (!p1mcg.mapsReleased() || !p1mcg.empty() || !p1mcg.finalized() || p1mcg.rowCount() != rows)
+      DUNE_THROW(Dune::Exception,"finalize(true) did not release the constraints map");
+    if (rows > 0)
+      {
+        const typename P1mC::key_type ci = p1mcg.rowIndex(0);
+        p1mcg[ci];
+        if (p1mcg.mapsReleased() || p1mcg.size() != rows)
+          DUNE_THROW(Dune::Exception,"modifying released constraints did not restore the map");
+      }
+    p1mcg.finalize(true);
+  }
+
   // set Dirichlet nodes to zero
   Dune::PDELab::set_constrained_dofs(p1mcg,0.0,p1mxg);
 
@@ -0,0 +1,249 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/backend/seqistlsolverbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/conforming.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionparameter.hh>
+
+// reaction-diffusion problem with Dirichlet boundary on the left side
+template<typename GV, typename RF>
+class Parameter
+{
+  typedef Dune::PDELab::ConvectionDiffusionBoundaryConditions::Type BCType;
+
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  typename Traits::PermTensorType
+  A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0 + e.geometry().global(x)[0];
+    return I;
+  }
+
+  typename Traits::RangeType
+  b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return typename Traits::RangeType(0.0);
+  }
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 1.0;
+  }
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[1];
+  }
+
+  BCType
+  bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    if (is.geometry().global(x)[0] < 1e-6)
+      return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Dirichlet;
+    return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Neumann;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[1];
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+};
+
+// checks that A z = r up to rounding
+template<typename M, typename V>
+bool check_solution(const M& a, const V& z, const V& r, const std::string& name)
+{
+  V d(r);
+  a.base().mmv(z.base(),d.base());
+  if (d.infinity_norm() > 1e-10 * (1.0 + r.infinity_norm()))
+    {
+      std::cerr << name << ": residual of the solution is " << d.infinity_norm() << std::endl;
+      return false;
+    }
+  return true;
+}
+
+bool check_statistics(const Dune::PDELab::istl::DirectSolverStatistics& stats,
+                      std::size_t symbolic, std::size_t numeric, std::size_t solves,
+                      const std::string& name)
+{
+  if (stats.symbolic_factorizations != symbolic ||
+      stats.numeric_factorizations != numeric ||
+      stats.solves != solves)
+    {
+      std::cerr << name << ": " << stats.symbolic_factorizations << " symbolic and "
+                << stats.numeric_factorizations << " numeric factorizations for "
+                << stats.solves << " solves, expected " << symbolic << ", " << numeric
+                << " and " << solves << std::endl;
+      return false;
+    }
+  return true;
+}
+
+// solves repeatedly with the same matrix, with new values, with several right hand sides
+// and after a reset, and checks the solutions and the number of factorizations. Solver
+// backends without a separate symbolic phase report no symbolic factorizations.
+template<typename Solver, typename GO>
+bool test(Solver& solver, const GO& go, bool has_symbolic_phase, const std::string& name)
+{
+  typedef typename GO::Traits::Domain V;
+  typedef typename GO::Jacobian M;
+  const std::size_t s = has_symbolic_phase ? 1 : 0;
+
+  V x(go.trialGridFunctionSpace(),0.0);
+  V r(go.testGridFunctionSpace(),0.0);
+  go.residual(x,r);
+  M a(go);
+  a = 0.0;
+  go.jacobian(x,a);
+
+  bool passed = true;
+
+  // the first solve factorizes the matrix
+  V z(go.trialGridFunctionSpace(),0.0);
+  solver.apply(a,z,r,1e-10);
+  passed = check_solution(a,z,r,name + " (first solve)") && passed;
+  passed = check_statistics(solver.statistics(),s,1,1,name + " (first solve)") && passed;
+
+  // an unchanged matrix reuses the factorization
+  V z2(go.trialGridFunctionSpace(),0.0);
+  solver.apply(a,z2,r,1e-10);
+  z2 -= z;
+  if (z2.infinity_norm() != 0.0)
+    {
+      std::cerr << name << ": solution with the cached factorization differs by "
+                << z2.infinity_norm() << std::endl;
+      passed = false;
+    }
+  passed = check_statistics(solver.statistics(),s,1,2,name + " (unchanged matrix)") && passed;
+
+  // several right hand sides share the factorization
+  std::vector<V> rs(3,r);
+  std::vector<V> zs(3,V(go.trialGridFunctionSpace(),0.0));
+  for (std::size_t i = 0; i < rs.size(); ++i)
+    rs[i] *= 1.0 + i;
+  solver.apply(a,zs,rs,1e-10);
+  for (std::size_t i = 0; i < rs.size(); ++i)
+    passed = check_solution(a,zs[i],rs[i],name + " (multiple right hand sides)") && passed;
+  passed = check_statistics(solver.statistics(),s,1,5,name + " (multiple right hand sides)") && passed;
+
+  // new values with the same pattern only need a numeric factorization
+  a.base() *= 2.0;
+  solver.apply(a,z,r,1e-10);
+  passed = check_solution(a,z,r,name + " (new values)") && passed;
+  passed = check_statistics(solver.statistics(),s,2,6,name + " (new values)") && passed;
+
+  // after a reset, the matrix is factorized from scratch
+  solver.reset();
+  solver.apply(a,z,r,1e-10);
+  passed = check_solution(a,z,r,name + " (reset)") && passed;
+  passed = check_statistics(solver.statistics(),2*s,3,7,name + " (reset)") && passed;
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(8));
+    Grid grid(L,N);
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::ConformingDirichletConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    Dune::PDELab::ConvectionDiffusionBoundaryConditionAdapter<Param> bc(param);
+    typedef GFS::ConstraintsContainer<double>::Type CC;
+    CC cc;
+    Dune::PDELab::constraints(bc,gfs,cc);
+
+    typedef Dune::PDELab::ConvectionDiffusionFEM<Param,FEM> LOP;
+    LOP lop(param);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(9);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double,CC,CC> GO;
+    GO go(gfs,cc,gfs,cc,lop,mbe);
+
+    bool passed = true;
+
+#if HAVE_SUPERLU
+    {
+      Dune::PDELab::ISTLBackend_SEQ_SuperLU solver(0);
+      passed = test(solver,go,false,"SuperLU") && passed;
+    }
+#endif
+
+#if HAVE_UMFPACK
+    {
+      Dune::PDELab::ISTLBackend_SEQ_UMFPack solver(0);
+      passed = test(solver,go,true,"UMFPack") && passed;
+    }
+#endif
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -260,6 +260,38 @@ void poisson (const GV& gv, const FEM& fem, std::string filename, int q)
     x += x0;
   }
 
+  // test the direct solver backend with factorisation reuse
+  {
+    DV y(gfs,0.0);
+    Dune::PDELab::EigenBackend_SparseLU solver(true);
+    solver.apply(m,y,r,1e-10);
+    // this solve reuses the factorisation of the first one
+    y = 0.0;
+    solver.apply(m,y,r,1e-10);
+    y += x0;
+    y -= x;
+    if (!solver.result().converged || y.infinity_norm() > 1e-6 * x.infinity_norm())
+      DUNE_THROW(Dune::Exception,"EigenBackend_SparseLU with reuse does not reproduce the iterative solution");
+
+    // new values are only picked up after invalidate(), which halves the correction
+    DV y1(gfs,0.0);
+    solver.apply(m,y1,r,1e-10);
+    m.base() *= 2.0;
+    DV y2(gfs,0.0);
+    solver.apply(m,y2,r,1e-10);
+    y2 -= y1;
+    if (y2.infinity_norm() != 0.0)
+      DUNE_THROW(Dune::Exception,"EigenBackend_SparseLU with reuse refactorised without invalidate()");
+    solver.invalidate();
+    y2 = 0.0;
+    solver.apply(m,y2,r,1e-10);
+    y2 *= 2.0;
+    y2 -= y1;
+    if (!solver.result().converged || y2.infinity_norm() > 1e-10 * y1.infinity_norm())
+      DUNE_THROW(Dune::Exception,"EigenBackend_SparseLU did not refactorise after invalidate()");
+    m.base() *= 0.5;
+  }
+
   // output grid function with VTKWriter
   Dune::VTKWriter<GV> vtkwriter(gv,Dune::VTK::conforming);
   Dune::PDELab::addSolutionToVTKWriter(vtkwriter,gfs,x);
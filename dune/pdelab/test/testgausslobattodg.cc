@@ -0,0 +1,193 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/common/function.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkdggl.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/interpolate.hh>
+#include <dune/pdelab/gridfunctionspace/powergridfunctionspace.hh>
+#include <dune/pdelab/instationary/linearhyperbolicdg.hh>
+#include <dune/pdelab/instationary/onestep.hh>
+#include <dune/pdelab/localoperator/linearacousticsdg.hh>
+
+// acoustics problem with constant speed of sound and a linear source
+template<typename GV, typename RF>
+class Parameter
+{
+public:
+  typedef Dune::PDELab::LinearAcousticsParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 2.0;
+  }
+
+  typename Traits::StateType
+  g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, const typename Traits::StateType& s) const
+  {
+    typename Traits::StateType u(0.0);
+    u[0] = s[0];
+    return u;
+  }
+
+  typename Traits::StateType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::StateType rhs(0.0);
+    rhs[0] = e.geometry().global(x)[1];
+    return rhs;
+  }
+
+  void setTime (RF t)
+  {}
+};
+
+// a bilinear state, integrated exactly by the Gauss-Lobatto rule for k = 2
+template<typename GV, typename RF>
+class State
+  : public Dune::PDELab::AnalyticGridFunctionBase<Dune::PDELab::AnalyticGridFunctionTraits<GV,RF,3>,
+                                                  State<GV,RF> >
+{
+public:
+  typedef Dune::PDELab::AnalyticGridFunctionTraits<GV,RF,3> Traits;
+  typedef Dune::PDELab::AnalyticGridFunctionBase<Traits,State<GV,RF> > BaseT;
+
+  State (const GV& gv) : BaseT(gv) {}
+  inline void evaluateGlobal (const typename Traits::DomainType& x,
+                              typename Traits::RangeType& y) const
+  {
+    y[0] = 1.0 + x[0] + 2.0*x[1] + x[0]*x[1];
+    y[1] = x[0] - x[1];
+    y[2] = 2.0 + 0.5*x[0]*x[1];
+  }
+};
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkDGGLLocalFiniteElementMap<double,double,2,2> FEM;
+    FEM fem;
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS0;
+    GFS0 gfs0(gv,fem);
+    typedef Dune::PDELab::PowerGridFunctionSpace<GFS0,3,Dune::PDELab::ISTLVectorBackend<> > GFS;
+    GFS gfs(gfs0);
+
+    typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+    V x0(gfs,0.0);
+    State<GV,double> state(gv);
+    Dune::PDELab::interpolate(state,gfs,x0);
+    V ones(gfs,1.0);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    typedef Dune::PDELab::LinearAcousticsSystem<Param> System;
+    System system(param);
+    typedef Dune::PDELab::LinearHyperbolicDGOperator<GFS,System> IGOS;
+    IGOS igos_q(gfs,system);
+    IGOS igos_gl(gfs,system,IGOS::gaussLobattoCollocation);
+
+    Dune::PDELab::ExplicitEulerParameter<double> method;
+    const double dt = 0.01;
+    igos_q.preStep(method,0.0,dt);
+    igos_gl.preStep(method,0.0,dt);
+
+    bool passed = true;
+
+    // spatial operator: both variants integrate the bilinear state exactly
+    std::vector<V*> x(1,&x0);
+    IGOS::MatrixContainer<double>::Type D_q(igos_q), D_gl(igos_gl);
+    V alpha_q(gfs,0.0), beta_q(gfs,0.0), alpha_gl(gfs,0.0), beta_gl(gfs,0.0);
+    igos_q.explicit_jacobian_residual(1,x,D_q,alpha_q,beta_q);
+    igos_gl.explicit_jacobian_residual(1,x,D_gl,alpha_gl,beta_gl);
+    beta_gl -= beta_q;
+    if (beta_gl.two_norm() > 1e-10 * beta_q.two_norm())
+      {
+        std::cerr << "spatial terms differ by " << beta_gl.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // lumped mass: the row sums of the mass matrix are the Gauss-Lobatto weights
+    x[0] = &ones;
+    alpha_q = 0.0;
+    alpha_gl = 0.0;
+    beta_q = 0.0;
+    beta_gl = 0.0;
+    igos_q.explicit_jacobian_residual(1,x,D_q,alpha_q,beta_q);
+    igos_gl.explicit_jacobian_residual(1,x,D_gl,alpha_gl,beta_gl);
+    V diff(alpha_gl);
+    diff -= alpha_q;
+    if (diff.two_norm() > 1e-12 * alpha_q.two_norm())
+      {
+        std::cerr << "lumped mass differs from the row sums by " << diff.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // the stage solve inverts the diagonal mass matrix
+    V z(gfs,0.0);
+    Dune::PDELab::LinearHyperbolicDGMassSolver ls;
+    ls.apply(D_gl,z,alpha_gl,0.99);
+    z -= ones;
+    if (z.two_norm() > 1e-12 * ones.two_norm())
+      {
+        std::cerr << "inverse lumped mass matrix is wrong, defect " << z.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // a complete time step with the CFL controller
+    typedef Dune::PDELab::CFLTimeController<double,IGOS> TC;
+    TC tc(0.5,igos_gl);
+    Dune::PDELab::ExplicitOneStepMethod<double,IGOS,Dune::PDELab::LinearHyperbolicDGMassSolver,V,V,TC>
+      osm(method,igos_gl,ls,tc);
+    osm.setVerbosityLevel(0);
+    V xnew(gfs,0.0);
+    const double taken = osm.apply(0.0,1.0,x0,xnew);
+    if (!(taken > 0.0 && taken <= 0.5*igos_gl.suggestTimestep(1.0)) || !std::isfinite(xnew.two_norm()))
+      {
+        std::cerr << "collocated time step failed" << std::endl;
+        passed = false;
+      }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
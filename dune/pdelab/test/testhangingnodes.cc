@@ -0,0 +1,211 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/alugrid/grid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/common/constraintsparameters.hh>
+#include <dune/pdelab/constraints/hangingnode.hh>
+#include <dune/pdelab/constraints/hangingnodemanager.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+
+typedef Dune::ALUGrid<2,2,Dune::cube,Dune::nonconforming> Grid;
+typedef Grid::LeafGridView GV;
+
+// Dirichlet boundary on the left side of the unit square
+struct BoundaryFunction
+  : public Dune::PDELab::DirichletConstraintsParameters
+{
+  template<typename I>
+  bool isDirichlet(const I & intersection, const Dune::FieldVector<typename I::ctype, I::dimension-1> & coord) const
+  {
+    return intersection.geometry().global(coord)[0] < 1e-6;
+  }
+};
+
+// no Dirichlet boundary, so that only the hanging nodes are constrained
+struct NeumannFunction
+  : public Dune::PDELab::DirichletConstraintsParameters
+{
+  template<typename I>
+  bool isDirichlet(const I & intersection, const Dune::FieldVector<typename I::ctype, I::dimension-1> & coord) const
+  {
+    return false;
+  }
+};
+
+typedef Dune::PDELab::HangingNodeManager<Grid,BoundaryFunction> Manager;
+
+// compares an incrementally updated manager with a fresh analysis of the leaf grid view
+bool compare(const Manager& manager, Grid& grid, const BoundaryFunction& bf, const std::string& name)
+{
+  Manager fresh(grid,bf);
+  bool passed = true;
+
+  if (manager.statistics().hanging_nodes != fresh.statistics().hanging_nodes ||
+      manager.statistics().cells_with_hanging_nodes != fresh.statistics().cells_with_hanging_nodes ||
+      manager.hasHangingNodes() != fresh.hasHangingNodes())
+    {
+      std::cerr << name << ": incremental analysis found " << manager.statistics().hanging_nodes
+                << " hanging nodes in " << manager.statistics().cells_with_hanging_nodes
+                << " cells instead of " << fresh.statistics().hanging_nodes << " in "
+                << fresh.statistics().cells_with_hanging_nodes << std::endl;
+      passed = false;
+    }
+
+  const GV gv = grid.leafGridView();
+  for (GV::Codim<0>::Iterator it = gv.begin<0>(); it != gv.end<0>(); ++it)
+    {
+      const std::vector<Manager::NodeState> states = manager.hangingNodes(*it);
+      const std::vector<Manager::NodeState> fresh_states = fresh.hangingNodes(*it);
+      bool has_hanging_node = false;
+      for (std::size_t i = 0; i < states.size(); ++i)
+        {
+          has_hanging_node = has_hanging_node || states[i].isHanging();
+          if (states[i].isHanging() != fresh_states[i].isHanging() ||
+              states[i].isBoundary() != fresh_states[i].isBoundary())
+            {
+              std::cerr << name << ": vertex " << i << " of cell at " << it->geometry().center()
+                        << " differs from a fresh analysis" << std::endl;
+              passed = false;
+            }
+        }
+      if (manager.hasHangingNodes(*it) != has_hanging_node)
+        {
+          std::cerr << name << ": cell at " << it->geometry().center() << " is "
+                    << (has_hanging_node ? "not " : "") << "flagged for hanging nodes" << std::endl;
+          passed = false;
+        }
+    }
+
+  return passed;
+}
+
+// marks the leaf cell containing x for refinement (1) or all leaf cells with a given father for coarsening (-1)
+void adapt(Grid& grid, const Dune::FieldVector<double,2>& x, int marker)
+{
+  const GV gv = grid.leafGridView();
+  for (GV::Codim<0>::Iterator it = gv.begin<0>(); it != gv.end<0>(); ++it)
+    {
+      const Dune::FieldVector<double,2> local = it->geometry().local(x);
+      if (Dune::ReferenceElements<double,2>::general(it->type()).checkInside(local))
+        grid.mark(marker,*it);
+    }
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    Dune::FieldVector<double,2> l(0.0);
+    Dune::FieldVector<double,2> u(1.0);
+    Dune::array<unsigned int,2> N = {{4,4}};
+    std::shared_ptr<Grid> grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(l,u,N);
+
+    BoundaryFunction bf;
+    Manager manager(*grid,bf);
+
+    bool passed = true;
+
+    // a conforming grid has no hanging nodes and no flagged cells
+    if (manager.hasHangingNodes() || manager.statistics().cells_with_hanging_nodes != 0 ||
+        manager.statistics().reanalyzed_cells != manager.statistics().cells)
+      {
+        std::cerr << "conforming grid: " << manager.statistics().hanging_nodes << " hanging nodes, "
+                  << manager.statistics().reanalyzed_cells << " of " << manager.statistics().cells
+                  << " cells analyzed" << std::endl;
+        passed = false;
+      }
+
+    // refining an interior cell creates four hanging nodes in its four children,
+    // only the children and their neighbours are re-analyzed
+    Dune::FieldVector<double,2> x(0.375);
+    adapt(*grid,x,1);
+    manager.analyzeView();
+    if (manager.statistics().hanging_nodes != 4 || manager.statistics().cells_with_hanging_nodes != 4 ||
+        manager.statistics().reanalyzed_cells != 8)
+      {
+        std::cerr << "refined grid: " << manager.statistics().hanging_nodes << " hanging nodes in "
+                  << manager.statistics().cells_with_hanging_nodes << " cells, "
+                  << manager.statistics().reanalyzed_cells << " cells re-analyzed" << std::endl;
+        passed = false;
+      }
+    passed = compare(manager,*grid,bf,"refined interior cell") && passed;
+
+    // refine a cell at the Dirichlet boundary
+    Dune::FieldVector<double,2> y(0.125);
+    adapt(*grid,y,1);
+    manager.analyzeView();
+    passed = compare(manager,*grid,bf,"refined boundary cell") && passed;
+
+    // the skeleton of the constraints assembly only visits cells with hanging nodes,
+    // but must still constrain every hanging node
+    {
+      typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+      FEM fem(grid->leafGridView());
+      typedef Dune::PDELab::HangingNodesDirichletConstraints<Grid,Dune::PDELab::HangingNodesConstraintsAssemblers::CubeGridQ1Assembler,NeumannFunction> CON;
+      NeumannFunction nf;
+      CON con(*grid,false,nf);
+      typedef Dune::PDELab::GridFunctionSpace<GV,FEM,CON,Dune::PDELab::ISTLVectorBackend<> > GFS;
+      GFS gfs(grid->leafGridView(),fem,con);
+      typedef GFS::ConstraintsContainer<double>::Type CC;
+      CC cc;
+      Dune::PDELab::constraints(nf,gfs,cc);
+      if (cc.size() != manager.statistics().hanging_nodes)
+        {
+          std::cerr << "hanging node constraints constrain " << cc.size() << " DOFs instead of "
+                    << manager.statistics().hanging_nodes << std::endl;
+          passed = false;
+        }
+      for (CC::const_iterator it = cc.begin(); it != cc.end(); ++it)
+        if (it->second.size() != 2)
+          {
+            std::cerr << "hanging node is interpolated from " << it->second.size() << " DOFs" << std::endl;
+            passed = false;
+          }
+    }
+
+    // coarsening removes all hanging nodes again
+    adapt(*grid,x,-1);
+    adapt(*grid,y,-1);
+    manager.analyzeView();
+    if (manager.hasHangingNodes())
+      {
+        std::cerr << "coarsened grid still has " << manager.statistics().hanging_nodes << " hanging nodes" << std::endl;
+        passed = false;
+      }
+    passed = compare(manager,*grid,bf,"coarsened grid") && passed;
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
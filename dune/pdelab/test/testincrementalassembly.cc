@@ -0,0 +1,313 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/conforming.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkdg.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/lfsindexcache.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/powergridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/gridoperator/incremental.hh>
+#include <dune/pdelab/localoperator/convectiondiffusion.hh>
+#include <dune/pdelab/localoperator/linearacousticsdg.hh>
+
+// acoustics problem with a varying speed of sound
+template<typename GV, typename RF>
+class Parameter
+{
+public:
+  typedef Dune::PDELab::LinearAcousticsParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 1.0 + e.geometry().global(x)[0];
+  }
+
+  typename Traits::StateType
+  g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, const typename Traits::StateType& s) const
+  {
+    typename Traits::StateType u(0.0);
+    u[0] = s[0];
+    return u;
+  }
+
+  typename Traits::StateType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::StateType rhs(0.0);
+    rhs[0] = e.geometry().global(x)[1];
+    return rhs;
+  }
+
+  void setTime (RF t)
+  {}
+};
+
+// nonlinear diffusion-reaction problem with Dirichlet boundary on the left side
+template<typename GV, typename RF>
+class NonlinearParameter
+{
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return 1.0 - u*u*u;
+  }
+
+  typename Traits::RangeFieldType
+  w (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return u;
+  }
+
+  typename Traits::RangeFieldType
+  v (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return 1.0 + u*u;
+  }
+
+  typename Traits::PermTensorType
+  D (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0;
+    return I;
+  }
+
+  typename Traits::RangeType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    typename Traits::RangeType flux(0.0);
+    flux[0] = 0.5*u*u;
+    return flux;
+  }
+
+  template<typename I>
+  bool isDirichlet(const I & intersection, const Dune::FieldVector<typename I::ctype, I::dimension-1> & coord) const
+  {
+    return intersection.geometry().global(coord)[0] < 1e-6;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[1];
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return u*u;
+  }
+
+  void setTime (double t)
+  {}
+};
+
+// compares the cached residual and jacobian with a complete assembly
+template<typename GO, typename IGO, typename V>
+bool compare(const GO& go, IGO& igo, const V& x, const std::string& what)
+{
+  bool passed = true;
+
+  V r(go.testGridFunctionSpace(),0.0);
+  go.residual(x,r);
+  V diff(igo.residual(x));
+  diff -= r;
+  if (diff.two_norm() > 1e-10 * r.two_norm())
+    {
+      std::cerr << what << ": residual differs by " << diff.two_norm() << std::endl;
+      passed = false;
+    }
+
+  typename GO::Jacobian a(go);
+  a = 0.0;
+  go.jacobian(x,a);
+  V y(go.testGridFunctionSpace(),0.0), y_inc(go.testGridFunctionSpace(),0.0);
+  a.base().mv(x.base(),y.base());
+  igo.jacobian(x).base().mv(x.base(),y_inc.base());
+  y_inc -= y;
+  if (y_inc.two_norm() > 1e-10 * y.two_norm())
+    {
+      std::cerr << what << ": jacobian differs by " << y_inc.two_norm() << std::endl;
+      passed = false;
+    }
+
+  return passed;
+}
+
+// nonlinear conforming discretization with Dirichlet constraints, where the
+// jacobian depends on the coefficients and the constrained rows are post-processed
+template<typename GV>
+bool testConforming(const GV& gv)
+{
+  typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+  FEM fem(gv);
+  typedef Dune::PDELab::GridFunctionSpace<
+    GV,
+    FEM,
+    Dune::PDELab::ConformingDirichletConstraints,
+    Dune::PDELab::ISTLVectorBackend<>
+    > GFS;
+  GFS gfs(gv,fem);
+
+  typedef NonlinearParameter<GV,double> Param;
+  Param param;
+  Dune::PDELab::BCTypeParam_CD<Param> bc(gv,param);
+  typedef typename GFS::template ConstraintsContainer<double>::Type CC;
+  CC cc;
+  Dune::PDELab::constraints(bc,gfs,cc);
+
+  typedef Dune::PDELab::ConvectionDiffusion<Param> LOP;
+  LOP lop(param);
+  typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+  MBE mbe(9);
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double,CC,CC> GO;
+  GO go(gfs,cc,gfs,cc,lop,mbe);
+
+  typedef typename GO::Traits::Domain V;
+  V x(gfs,0.0);
+  std::size_t k = 0;
+  for (typename V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+    *it = 0.5 * std::sin(1.0 + k);
+
+  typedef Dune::PDELab::IncrementalGridOperator<GO> IGO;
+  IGO igo(go);
+
+  bool passed = compare(go,igo,x,"conforming: initial assembly");
+
+  // the first DOF lies on the Dirichlet boundary
+  k = 0;
+  for (typename V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+    if (k == 0 || k == 40)
+      *it += 0.5;
+  passed = compare(go,igo,x,"conforming: changed coefficients") && passed;
+  if (igo.processedCells() == 0 || igo.processedCells() >= std::size_t(gv.size(0)))
+    {
+      std::cerr << "conforming: unexpected number of reassembled cells " << igo.processedCells() << std::endl;
+      passed = false;
+    }
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(8));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkDGLocalFiniteElementMap<double,double,1,2> FEM;
+    FEM fem;
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS0;
+    GFS0 gfs0(gv,fem);
+    typedef Dune::PDELab::PowerGridFunctionSpace<GFS0,3,Dune::PDELab::ISTLVectorBackend<> > GFS;
+    GFS gfs(gfs0);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    typedef Dune::PDELab::DGLinearAcousticsSpatialOperator<Param,FEM> LOP;
+    LOP lop(param);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(5);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO;
+    GO go(gfs,gfs,lop,mbe);
+
+    typedef GO::Traits::Domain V;
+    V x(gfs,0.0);
+    std::size_t k = 0;
+    for (V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+      *it = std::sin(1.0 + k);
+
+    typedef Dune::PDELab::IncrementalGridOperator<GO> IGO;
+    IGO igo(go);
+
+    bool passed = compare(go,igo,x,"initial assembly");
+
+    // change a few coefficients and let the operator find them
+    k = 0;
+    for (V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+      if (k == 0 || k == 50)
+        *it += 1.0;
+    passed = compare(go,igo,x,"changed coefficients") && passed;
+    if (igo.processedCells() == 0 || igo.processedCells() >= std::size_t(gv.size(0)))
+      {
+        std::cerr << "unexpected number of reassembled cells " << igo.processedCells() << std::endl;
+        passed = false;
+      }
+
+    // announce a change explicitly
+    typedef Dune::PDELab::LocalFunctionSpace<GFS> LFS;
+    typedef Dune::PDELab::LFSIndexCache<LFS> LFSCache;
+    LFS lfs(gfs);
+    LFSCache lfs_cache(lfs);
+    lfs.bind(*gv.begin<0>());
+    lfs_cache.update();
+    const LFSCache::ContainerIndex ci = lfs_cache.containerIndex(lfs.child(1).localIndex(2));
+    x[ci] += 3.0;
+    igo.markDirty(ci);
+    passed = compare(go,igo,x,"marked coefficient") && passed;
+
+    // nothing changed
+    igo.residual(x);
+    if (igo.processedCells() != 0)
+      {
+        std::cerr << "cells reassembled without a change" << std::endl;
+        passed = false;
+      }
+
+    passed = testConforming(gv) && passed;
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
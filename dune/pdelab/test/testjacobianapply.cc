@@ -0,0 +1,218 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/backend/seqistlsolverbackend.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/gridoperator/onestep.hh>
+#include <dune/pdelab/localoperator/convectiondiffusion.hh>
+#include <dune/pdelab/localoperator/l2.hh>
+
+// nonlinear convection-diffusion-reaction problem with a Robin boundary condition
+template<typename GV, typename RF>
+class Parameter
+{
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return 1.0 - u*u;
+  }
+
+  typename Traits::RangeFieldType
+  w (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return u;
+  }
+
+  typename Traits::RangeFieldType
+  v (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return 1.0 + u*u;
+  }
+
+  typename Traits::PermTensorType
+  D (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0;
+    return I;
+  }
+
+  typename Traits::RangeType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    typename Traits::RangeType flux(0.0);
+    flux[0] = 0.5*u*u;
+    return flux;
+  }
+
+  template<typename I>
+  bool isDirichlet(const I & intersection, const Dune::FieldVector<typename I::ctype, I::dimension-1> & coord) const
+  {
+    return false;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::ElementType& e, const typename Traits::DomainType& x,
+     typename Traits::RangeFieldType u) const
+  {
+    return u*u*u;
+  }
+
+  void setTime (double t)
+  {}
+};
+
+// compares jacobian_apply(x,z,y) with the assembled jacobian at x applied to z;
+// both are difference quotients of the residual, so they agree up to the
+// discretization error of the difference quotients
+template<typename GO, typename V>
+bool compare(const GO& go, const V& x, const V& z, const std::string& name)
+{
+  typedef typename GO::Jacobian M;
+  M a(go);
+  a = 0.0;
+  go.jacobian(x,a);
+  V az(z);
+  az = 0.0;
+  a.base().mv(z.base(),az.base());
+
+  V y(z);
+  y = 0.0;
+  go.jacobian_apply(x,z,y);
+
+  y -= az;
+  if (y.infinity_norm() > 1e-5 * (1.0 + az.infinity_norm()))
+    {
+      std::cerr << name << ": jacobian_apply(x,z,y) differs from the assembled jacobian by "
+                << y.infinity_norm() << std::endl;
+      return false;
+    }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<GV,FEM,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    typedef Dune::PDELab::ConvectionDiffusion<Param> LOP;
+    LOP lop(param);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(9);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO;
+    GO go(gfs,gfs,lop,mbe);
+
+    typedef GO::Traits::Domain V;
+    V x(gfs,0.0);
+    V z(gfs,0.0);
+    std::size_t i = 0;
+    for (V::iterator it = x.begin(), zit = z.begin(); it != x.end(); ++it, ++zit, ++i)
+      {
+        *it = 0.5 + 0.01 * i;
+        *zit = 1.0 + 0.5 * (i % 3);
+      }
+
+    bool passed = compare(go,x,z,"linearization point x");
+
+    // the result depends on the linearization point
+    V x0(gfs,0.0);
+    passed = compare(go,x0,z,"linearization point 0") && passed;
+    V y(gfs,0.0);
+    go.jacobian_apply(x,z,y);
+    V y0(gfs,0.0);
+    go.jacobian_apply(x0,z,y0);
+    y0 -= y;
+    if (y0.infinity_norm() < 1e-3 * y.infinity_norm())
+      {
+        std::cerr << "jacobian_apply(x,z,y) does not depend on the linearization point" << std::endl;
+        passed = false;
+      }
+
+    // the matrix free operator for Newton-Krylov solvers applies the same jacobian
+    Dune::PDELab::NonlinearOnTheFlyOperator<V,V,GO> op(go);
+    op.setLinearizationPoint(x);
+    V yo(gfs,1.0);
+    op.apply(z,yo);
+    yo -= y;
+    if (yo.infinity_norm() > 1e-12 * (1.0 + y.infinity_norm()))
+      {
+        std::cerr << "NonlinearOnTheFlyOperator differs from jacobian_apply(x,z,y) by "
+                  << yo.infinity_norm() << std::endl;
+        passed = false;
+      }
+
+    // the one step grid operator applies the jacobian of the current stage
+    {
+      typedef Dune::PDELab::L2 MLOP;
+      MLOP mlop(2);
+      typedef Dune::PDELab::GridOperator<GFS,GFS,MLOP,MBE,double,double,double> MGO;
+      MGO mgo(gfs,gfs,mlop,mbe);
+      typedef Dune::PDELab::OneStepGridOperator<GO,MGO> IGO;
+      IGO igo(go,mgo);
+
+      Dune::PDELab::ImplicitEulerParameter<double> method;
+      igo.preStep(method,0.0,0.1);
+      std::vector<V*> xs(1,&x0);
+      igo.preStage(1,xs);
+      passed = compare(igo,x,z,"one step") && passed;
+    }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
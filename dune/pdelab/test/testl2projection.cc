@@ -0,0 +1,244 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/geometry/quadraturerules.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/adaptivity/adaptivity.hh>
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+
+typedef Dune::YaspGrid<2> Grid;
+typedef Grid::LeafGridView GV;
+typedef GV::Codim<0>::Entity Cell;
+typedef GV::Codim<0>::EntityPointer CellPointer;
+typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,2> FEM;
+typedef FEM::Traits::FiniteElementType FE;
+typedef Dune::PDELab::GridFunctionSpace<
+  GV,
+  FEM,
+  Dune::PDELab::NoConstraints,
+  Dune::PDELab::ISTLVectorBackend<>
+  > GFS;
+typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+typedef Dune::PDELab::L2Projection<GFS,V> Projection;
+typedef Projection::TransferMatrix TransferMatrix;
+typedef FE::Traits::LocalBasisType::Traits::RangeType Range;
+
+// a basis function of the coarse finite element, evaluated through the global geometries
+struct CoarseBasisFunction
+{
+  template<typename X, typename Y>
+  void evaluate(const X& x, Y& y) const
+  {
+    fe.localBasis().evaluateFunction(coarse.local(fine.global(x)),phi);
+    y = phi[index];
+  }
+
+  CoarseBasisFunction(const FE& fe_, const Cell::Geometry& coarse_, const Cell::Geometry& fine_, std::size_t index_)
+    : fe(fe_), coarse(coarse_), fine(fine_), index(index_)
+  {}
+
+  const FE& fe;
+  Cell::Geometry coarse;
+  Cell::Geometry fine;
+  std::size_t index;
+  mutable std::vector<Range> phi;
+};
+
+double difference(const TransferMatrix& a, const TransferMatrix& b)
+{
+  if (a.N() != b.N() || a.M() != b.M())
+    return 1.0;
+  double d = 0.0;
+  for (std::size_t i = 0; i < a.N(); ++i)
+    for (std::size_t j = 0; j < a.M(); ++j)
+      d = std::max(d,std::abs(a[i][j] - b[i][j]));
+  return d;
+}
+
+// compares the cached transfer matrices between every leaf cell and its coarsest
+// ancestor with quadrature and interpolation on the global geometries
+bool testMatrices(const GV& gv, const GFS& gfs, const FEM& fem)
+{
+  const int intorder = 4;
+  Projection projection(gfs,intorder);
+  Dune::PDELab::NestedEmbedding<Cell> embedding;
+  bool passed = true;
+
+  for (GV::Codim<0>::Iterator it = gv.begin<0>(); it != gv.end<0>(); ++it)
+    {
+      const Cell& e = *it;
+      CellPointer ancestor = e.father();
+      while (ancestor->level() > 0)
+        ancestor = ancestor->father();
+      embedding.update(e,*ancestor);
+
+      const Cell::Geometry fine_geometry = e.geometry();
+      const Cell::Geometry coarse_geometry = ancestor->geometry();
+      const FE& fine_fe = fem.find(e);
+      const FE& coarse_fe = fem.find(*ancestor);
+      const Projection::MassMatrix& inverse_mass = projection.inverseMassMatrices(e)[0];
+
+      const TransferMatrix* r = projection.restrictionMatrix(0,coarse_fe,fine_fe,embedding,inverse_mass,intorder,
+                                                            coarse_geometry,fine_geometry);
+      const TransferMatrix* p = projection.prolongationMatrix(0,coarse_fe,fine_fe,embedding,e.type());
+      if (!r || !p)
+        {
+          std::cerr << "no transfer matrices for a cell of a dyadically refined grid" << std::endl;
+          passed = false;
+          continue;
+        }
+      if (r != projection.restrictionMatrix(0,coarse_fe,fine_fe,embedding,inverse_mass,intorder,
+                                            coarse_geometry,fine_geometry))
+        {
+          std::cerr << "restriction matrix was not taken from the cache" << std::endl;
+          passed = false;
+        }
+
+      // restriction by quadrature
+      TransferMatrix r_ref(coarse_fe.localBasis().size(),fine_fe.localBasis().size(),0.0);
+      std::vector<Range> coarse_phi;
+      std::vector<Range> fine_phi;
+      const Dune::QuadratureRule<double,2>& rule = Dune::QuadratureRules<double,2>::rule(e.type(),intorder);
+      for (Dune::QuadratureRule<double,2>::const_iterator qit = rule.begin(); qit != rule.end(); ++qit)
+        {
+          const Cell::Geometry::LocalCoordinate coarse_local = coarse_geometry.local(fine_geometry.global(qit->position()));
+          fine_fe.localBasis().evaluateFunction(qit->position(),fine_phi);
+          coarse_fe.localBasis().evaluateFunction(coarse_local,coarse_phi);
+          const double factor = qit->weight()
+            * fine_geometry.integrationElement(qit->position())
+            / coarse_geometry.integrationElement(coarse_local);
+          for (std::size_t i = 0; i < coarse_phi.size(); ++i)
+            {
+              Range x(0.0);
+              for (std::size_t j = 0; j < inverse_mass.M(); ++j)
+                x.axpy(inverse_mass[i][j],coarse_phi[j]);
+              for (std::size_t l = 0; l < fine_phi.size(); ++l)
+                r_ref[i][l] += factor * (x * fine_phi[l]);
+            }
+        }
+
+      // prolongation by interpolation
+      TransferMatrix p_ref(fine_fe.localBasis().size(),coarse_fe.localBasis().size(),0.0);
+      std::vector<double> column;
+      for (std::size_t j = 0; j < coarse_fe.localBasis().size(); ++j)
+        {
+          CoarseBasisFunction f(coarse_fe,coarse_geometry,fine_geometry,j);
+          column.assign(fine_fe.localBasis().size(),0.0);
+          fine_fe.localInterpolation().interpolate(f,column);
+          for (std::size_t l = 0; l < column.size(); ++l)
+            p_ref[l][j] = column[l];
+        }
+
+      if (difference(*r,r_ref) > 1e-12 || difference(*p,p_ref) > 1e-12)
+        {
+          std::cerr << "cached transfer matrices differ from quadrature and interpolation by "
+                    << difference(*r,r_ref) << " and " << difference(*p,p_ref) << std::endl;
+          passed = false;
+        }
+    }
+
+  return passed;
+}
+
+// refines the grid once and transfers x to the new grid
+void refine(Grid& grid, GFS& gfs, V& x, bool cache_transfer_matrices)
+{
+  Projection projection(gfs,4,cache_transfer_matrices);
+  typedef Dune::PDELab::GridAdaptor<Grid,GFS,V,Projection> Adaptor;
+  Adaptor adaptor(gfs);
+
+  const GV gv = grid.leafGridView();
+  for (GV::Codim<0>::Iterator it = gv.begin<0>(); it != gv.end<0>(); ++it)
+    grid.mark(1,*it);
+  grid.preAdapt();
+  Adaptor::MapType transfer_map;
+  adaptor.backupData(grid,gfs,projection,x,transfer_map);
+  grid.adapt();
+  gfs.update();
+  x = V(gfs,0.0);
+  adaptor.replayData(grid,gfs,projection,x,transfer_map);
+  grid.postAdapt();
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(2));
+
+    bool passed = true;
+
+    // transfer matrices between cells two levels apart
+    {
+      Grid grid(L,N);
+      grid.globalRefine(2);
+      GV gv = grid.leafGridView();
+      FEM fem(gv);
+      GFS gfs(gv,fem);
+      passed = testMatrices(gv,gfs,fem) && passed;
+    }
+
+    // the transfer with cached matrices matches the one by quadrature and interpolation
+    {
+      Grid grid_cached(L,N);
+      grid_cached.globalRefine(1);
+      GV gv_cached = grid_cached.leafGridView();
+      FEM fem_cached(gv_cached);
+      GFS gfs_cached(gv_cached,fem_cached);
+
+      Grid grid_reference(L,N);
+      grid_reference.globalRefine(1);
+      GV gv_reference = grid_reference.leafGridView();
+      FEM fem_reference(gv_reference);
+      GFS gfs_reference(gv_reference,fem_reference);
+
+      V x_cached(gfs_cached,0.0);
+      V x_reference(gfs_reference,0.0);
+      std::size_t k = 0;
+      for (V::iterator it = x_cached.begin(), rit = x_reference.begin(); it != x_cached.end(); ++it, ++rit, ++k)
+        *it = *rit = std::sin(0.1 * k);
+
+      refine(grid_cached,gfs_cached,x_cached,true);
+      refine(grid_reference,gfs_reference,x_reference,false);
+
+      x_cached -= x_reference;
+      if (x_cached.two_norm() > 1e-12 * x_reference.two_norm())
+        {
+          std::cerr << "transfer with cached matrices differs by " << x_cached.two_norm() << std::endl;
+          passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,190 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkdg.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/powergridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/gridoperator/onestep.hh>
+#include <dune/pdelab/instationary/linearhyperbolicdg.hh>
+#include <dune/pdelab/instationary/onestep.hh>
+#include <dune/pdelab/localoperator/linearacousticsdg.hh>
+
+// time independent acoustics problem with a varying speed of sound
+template<typename GV, typename RF>
+class Parameter
+{
+public:
+  typedef Dune::PDELab::LinearAcousticsParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 1.0 + e.geometry().global(x)[0];
+  }
+
+  typename Traits::StateType
+  g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, const typename Traits::StateType& s) const
+  {
+    typename Traits::StateType u(0.0);
+    u[0] = s[0];
+    return u;
+  }
+
+  typename Traits::StateType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::StateType rhs(0.0);
+    rhs[0] = e.geometry().global(x)[1];
+    return rhs;
+  }
+
+  void setTime (RF t)
+  {}
+};
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkDGLocalFiniteElementMap<double,double,2,2> FEM;
+    FEM fem;
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS0;
+    GFS0 gfs0(gv,fem);
+    typedef Dune::PDELab::PowerGridFunctionSpace<GFS0,3,Dune::PDELab::ISTLVectorBackend<> > GFS;
+    GFS gfs(gfs0);
+
+    typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+    V x0(gfs,0.0), x1(gfs,0.0);
+    std::size_t k = 0;
+    for (V::iterator it = x0.begin(); it != x0.end(); ++it, ++k)
+      *it = std::sin(1.0 + k);
+    k = 0;
+    for (V::iterator it = x1.begin(); it != x1.end(); ++it, ++k)
+      *it = std::cos(2.0 + k);
+    std::vector<V*> x;
+    x.push_back(&x0);
+    x.push_back(&x1);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    Dune::PDELab::HeunParameter<double> method;
+    const double dt = 0.01;
+
+    // the second Heun stage, assembled by the generic grid operators
+    typedef Dune::PDELab::DGLinearAcousticsSpatialOperator<Param,FEM> LOP;
+    typedef Dune::PDELab::DGLinearAcousticsTemporalOperator<Param,FEM> TLOP;
+    LOP lop(param);
+    TLOP tlop(param);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(5);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO0;
+    typedef Dune::PDELab::GridOperator<GFS,GFS,TLOP,MBE,double,double,double> GO1;
+    GO0 go0(gfs,gfs,lop,mbe);
+    GO1 go1(gfs,gfs,tlop,mbe);
+    typedef Dune::PDELab::OneStepGridOperator<GO0,GO1,false> IGO;
+    IGO igo(go0,go1);
+
+    IGO::Jacobian D(igo);
+    D = 0.0;
+    V alpha(gfs,0.0), beta(gfs,0.0);
+    igo.preStep(method,0.0,dt);
+    igo.explicit_jacobian_residual(2,x,D,alpha,beta);
+
+    // the same stage from the matrix-free operator
+    typedef Dune::PDELab::LinearAcousticsSystem<Param> System;
+    System system(param);
+    typedef Dune::PDELab::LinearHyperbolicDGOperator<GFS,System> IGOS;
+    IGOS igos(gfs,system);
+
+    IGOS::MatrixContainer<double>::Type D_mf(igos);
+    D_mf = 0.0;
+    V alpha_mf(gfs,0.0), beta_mf(gfs,0.0);
+    igos.preStep(method,0.0,dt);
+    igos.explicit_jacobian_residual(2,x,D_mf,alpha_mf,beta_mf);
+
+    bool passed = true;
+
+    alpha_mf -= alpha;
+    beta_mf -= beta;
+    if (alpha_mf.two_norm() > 1e-10 * alpha.two_norm())
+      {
+        std::cerr << "mass terms differ by " << alpha_mf.two_norm() << std::endl;
+        passed = false;
+      }
+    if (beta_mf.two_norm() > 1e-10 * beta.two_norm())
+      {
+        std::cerr << "spatial terms differ by " << beta_mf.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // the stage solution has to solve the assembled system
+    V z(gfs,0.0), Dz(gfs,0.0);
+    Dune::PDELab::LinearHyperbolicDGMassSolver ls;
+    ls.apply(D_mf,z,alpha,0.99);
+    D.base().mv(z.base(),Dz.base());
+    Dz -= alpha;
+    if (Dz.two_norm() > 1e-10 * alpha.two_norm())
+      {
+        std::cerr << "inverse mass matrix is wrong, defect " << Dz.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // a complete time step with the CFL controller
+    typedef Dune::PDELab::CFLTimeController<double,IGOS> TC;
+    TC tc(0.5,igos);
+    Dune::PDELab::ExplicitOneStepMethod<double,IGOS,Dune::PDELab::LinearHyperbolicDGMassSolver,V,V,TC>
+      osm(method,igos,ls,tc);
+    osm.setVerbosityLevel(0);
+    V xnew(gfs,0.0);
+    const double taken = osm.apply(0.0,1.0,x0,xnew);
+    if (!(taken > 0.0 && taken <= 0.5*igos.suggestTimestep(1.0)))
+      {
+        std::cerr << "time step " << taken << " violates the CFL condition" << std::endl;
+        passed = false;
+      }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,172 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#if HAVE_DUNE_ALUGRID
+#include <dune/alugrid/grid.hh>
+#include <dune/grid/utility/structuredgridfactory.hh>
+#endif
+
+#include <dune/pdelab/adaptivity/loadbalancing.hh>
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/common/function.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/interpolate.hh>
+
+// smooth function that is interpolated into the migrated vectors
+template<typename GV, typename RF>
+class F
+  : public Dune::PDELab::AnalyticGridFunctionBase<Dune::PDELab::AnalyticGridFunctionTraits<GV,RF,1>,
+                                                  F<GV,RF> >
+{
+public:
+  typedef Dune::PDELab::AnalyticGridFunctionTraits<GV,RF,1> Traits;
+  typedef Dune::PDELab::AnalyticGridFunctionBase<Traits,F<GV,RF> > BaseT;
+
+  F (const GV& gv, RF scale_)
+    : BaseT(gv)
+    , scale(scale_)
+  {}
+
+  inline void evaluateGlobal (const typename Traits::DomainType& x,
+                              typename Traits::RangeType& y) const
+  {
+    y = scale * std::sin(3.0 * x[0]) * std::cos(2.0 * x[1]);
+  }
+
+  RF scale;
+};
+
+// checks that x is the interpolant of F with the given scale on the current partitioning
+template<typename GFS, typename V>
+bool check_interpolant(const GFS& gfs, const V& x, double scale, const std::string& name)
+{
+  typedef typename GFS::Traits::GridViewType GV;
+  V y(gfs,0.0);
+  F<GV,double> f(gfs.gridView(),scale);
+  Dune::PDELab::interpolate(f,gfs,y);
+  y -= x;
+  const double error = gfs.gridView().comm().max(y.infinity_norm());
+  if (error > 1e-12)
+    {
+      std::cerr << name << ": migrated vector differs from the interpolant by " << error << std::endl;
+      return false;
+    }
+  return true;
+}
+
+// migrates two vectors with load_balance() and checks them against the
+// interpolants on the new partitioning. On a single rank or with a grid
+// manager that cannot repartition, the vectors must be left untouched.
+template<typename Grid>
+bool test(Grid& grid, const std::string& name)
+{
+  typedef typename Grid::LeafGridView GV;
+  GV gv = grid.leafGridView();
+
+  typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+  FEM fem(gv);
+  typedef Dune::PDELab::GridFunctionSpace<
+    GV,
+    FEM,
+    Dune::PDELab::NoConstraints,
+    Dune::PDELab::ISTLVectorBackend<>
+    > GFS;
+  GFS gfs(gv,fem);
+
+  typedef typename Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+  V x(gfs,0.0);
+  V y(gfs,0.0);
+  F<GV,double> f(gv,1.0);
+  F<GV,double> g(gv,2.0);
+  Dune::PDELab::interpolate(f,gfs,x);
+  Dune::PDELab::interpolate(g,gfs,y);
+
+  bool passed = true;
+
+  // the tolerance is never exceeded, so nothing must happen
+  Dune::PDELab::LoadBalanceStatistics statistics = Dune::PDELab::load_balance(grid,gfs,1e10,x,y);
+  if (statistics.rebalanced || statistics.imbalance_after != statistics.imbalance_before)
+    {
+      std::cerr << name << ": grid was repartitioned below the tolerance" << std::endl;
+      passed = false;
+    }
+  if (gv.comm().size() == 1 && statistics.imbalance_before != 1.0)
+    {
+      std::cerr << name << ": imbalance of a single rank is " << statistics.imbalance_before << std::endl;
+      passed = false;
+    }
+
+  // a tolerance below one always asks the grid manager to repartition
+  statistics = Dune::PDELab::load_balance(grid,gfs,0.0,x,y);
+  passed = check_interpolant(gfs,x,1.0,name + " (x)") && passed;
+  passed = check_interpolant(gfs,y,2.0,name + " (y)") && passed;
+  if (statistics.rebalanced && statistics.imbalance_after > statistics.imbalance_before)
+    {
+      std::cerr << name << ": repartitioning increased the imbalance from "
+                << statistics.imbalance_before << " to " << statistics.imbalance_after << std::endl;
+      passed = false;
+    }
+
+  // without any vectors, only the grid and the function space are updated
+  statistics = Dune::PDELab::load_balance(grid,gfs,0.0);
+  V z(gfs,0.0);
+  Dune::PDELab::interpolate(f,gfs,z);
+  passed = check_interpolant(gfs,z,1.0,name + " (no vectors)") && passed;
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    bool passed = true;
+
+    {
+      typedef Dune::YaspGrid<2> Grid;
+      Dune::FieldVector<double,2> L(1.0);
+      Dune::array<int,2> N(Dune::fill_array<int,2>(8));
+      Grid grid(L,N);
+      passed = test(grid,"YaspGrid") && passed;
+    }
+
+#if HAVE_DUNE_ALUGRID
+    {
+      typedef Dune::ALUGrid<2,2,Dune::cube,Dune::nonconforming> Grid;
+      Dune::FieldVector<double,2> l(0.0);
+      Dune::FieldVector<double,2> u(1.0);
+      Dune::array<unsigned int,2> N = {{8,8}};
+      std::shared_ptr<Grid> grid = Dune::StructuredGridFactory<Grid>::createCubeGrid(l,u,N);
+      passed = test(*grid,"ALUGrid") && passed;
+    }
+#endif
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
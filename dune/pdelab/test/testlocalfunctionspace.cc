@@ -8,11 +8,15 @@
 
 #include <dune/common/parallel/mpihelper.hh>
 #include <dune/grid/yaspgrid.hh>
+#include <dune/localfunctions/common/localtoglobaladaptors.hh>
+#include <dune/localfunctions/lagrange/q1.hh>
 
 #include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/finiteelementmap/global.hh>
 #include <dune/pdelab/finiteelementmap/qkfem.hh>
 #include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
 #include <dune/pdelab/gridfunctionspace/localvector.hh>
+#include <dune/pdelab/gridfunctionspace/staticlocalsize.hh>
 #include <dune/pdelab/gridfunctionspace/subspace.hh>
 
 
@@ -42,6 +46,11 @@ void test (const GV& gv)
       Dune::PDELab::LexicographicOrderingTag,PowerGFS,Q1GFS> CompositeGFS;
   CompositeGFS compositegfs(powergfs,q1gfs);
 
+  // compile time bounds for the local sizes
+  static_assert(Dune::PDELab::StaticMaxLocalSize<Q2GFS>::value == 9,"wrong static local size");
+  static_assert(Dune::PDELab::StaticMaxLocalSize<PowerGFS>::value == 18,"wrong static local size");
+  static_assert(Dune::PDELab::StaticMaxLocalSize<CompositeGFS>::value == 22,"wrong static local size");
+
   // make coefficent Vectors - we need to make copies of the spaces because we stuck
   // them in a hierarchy
   typedef typename Dune::PDELab::BackendVectorSelector<Q2GFS,double>::Type V;
@@ -63,6 +72,7 @@ void test (const GV& gv)
   typedef typename V::template ConstLocalView<Q2LFSCache> VView;
   VView x_view(x);
   Dune::PDELab::LocalVector<double, Tag> xl(q2lfs.maxSize());
+  Dune::PDELab::LocalVector<double, Tag, double, Dune::PDELab::StaticMaxLocalSize<Q2GFS>::value> xl_fixed(q2lfs.maxSize());
 
   typedef typename Dune::PDELab::LocalFunctionSpace<PowerGFS> PowerLFS;
   PowerLFS powerlfs(powergfs2);
@@ -94,7 +104,11 @@ void test (const GV& gv)
       q2lfsCache.update();
       x_view.bind(q2lfsCache);
       x_view.read(xl);
+      x_view.read(xl_fixed);
       x_view.unbind();
+      assert(xl_fixed.size() == xl.size());
+      for (std::size_t i = 0; i < xl.size(); ++i)
+        assert(xl_fixed.base()[i] == xl.base()[i]);
       assert(q2lfs.size() ==
           q2lfs.localVectorSize());
 
@@ -140,6 +154,86 @@ void test (const GV& gv)
     }
 }
 
+// Q1 elements wrapped as global finite elements, which provide coefficients()
+// instead of localCoefficients()
+template<class GV>
+class GlobalQ1FiniteElementMap :
+  public Dune::PDELab::GeometryFiniteElementMap<
+    Dune::ScalarLocalToGlobalFiniteElementAdaptorFactory<
+      Dune::Q1LocalFiniteElement<typename GV::ctype,double,GV::dimension>,
+      typename GV::template Codim<0>::Geometry
+      >
+    >
+{
+  typedef Dune::Q1LocalFiniteElement<typename GV::ctype,double,GV::dimension> LocalFE;
+  typedef Dune::ScalarLocalToGlobalFiniteElementAdaptorFactory<
+    LocalFE,typename GV::template Codim<0>::Geometry> Factory;
+  typedef Dune::PDELab::GeometryFiniteElementMap<Factory> Base;
+
+  static Factory &factory() {
+    static LocalFE localFE;
+    static Factory factory_(localFE);
+    return factory_;
+  }
+
+public:
+  GlobalQ1FiniteElementMap() :
+    Base(factory())
+  { }
+
+  bool fixedSize() const
+  {
+    return true;
+  }
+
+  std::size_t size(Dune::GeometryType gt) const
+  {
+    return gt.dim() == 0 ? 1 : 0;
+  }
+
+  std::size_t maxLocalSize() const
+  {
+    return 1 << GV::dimension;
+  }
+};
+
+// a local function space of a global finite element map has the same DOF
+// indices as the one of the corresponding local finite element map
+template<class GV>
+void testGlobal (const GV& gv)
+{
+  typedef GlobalQ1FiniteElementMap<GV> GlobalFEM;
+  GlobalFEM globalfem;
+  typedef Dune::PDELab::GridFunctionSpace<GV,GlobalFEM> GlobalGFS;
+  GlobalGFS globalgfs(gv,globalfem);
+  typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> Q1FEM;
+  Q1FEM q1fem(gv);
+  typedef Dune::PDELab::GridFunctionSpace<GV,Q1FEM> Q1GFS;
+  Q1GFS q1gfs(gv,q1fem);
+
+  Dune::PDELab::LocalFunctionSpace<GlobalGFS> globallfs(globalgfs);
+  Dune::PDELab::LocalFunctionSpace<Q1GFS> q1lfs(q1gfs);
+
+  typedef typename GV::Traits::template Codim<0>::Iterator ElementIterator;
+  for (ElementIterator it = gv.template begin<0>();
+       it!=gv.template end<0>(); ++it)
+    {
+      globallfs.bind(*it);
+      q1lfs.bind(*it);
+      assert(globallfs.size() == q1lfs.size());
+      for (unsigned int i=0; i<globallfs.size(); i++)
+        {
+          if ( !(globallfs.dofIndex(i) == q1lfs.dofIndex(i)) )
+            {
+              std::cout << "DOF " << i << ": \n"
+                        << "global\t" << globallfs.dofIndex(i) << "\n"
+                        << "local\t" << q1lfs.dofIndex(i) << "\n";
+            }
+          assert( globallfs.dofIndex(i) == q1lfs.dofIndex(i) );
+        }
+    }
+}
+
 int main(int argc, char** argv)
 {
   try{
@@ -153,6 +247,7 @@ int main(int argc, char** argv)
     grid.globalRefine(1);
 
     test(grid.leafGridView());
+    testGlobal(grid.leafGridView());
 
     // test passed
     return 0;
@@ -0,0 +1,247 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/backend/istl/mixedprecision.hh>
+#include <dune/pdelab/backend/seqistlsolverbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/conforming.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionparameter.hh>
+
+// symmetric diffusion-reaction problem with Dirichlet boundary on the left side
+template<typename GV, typename RF>
+class Parameter
+{
+  typedef Dune::PDELab::ConvectionDiffusionBoundaryConditions::Type BCType;
+
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  typename Traits::PermTensorType
+  A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0 + 10.0 * e.geometry().global(x)[0];
+    return I;
+  }
+
+  typename Traits::RangeType
+  b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return typename Traits::RangeType(0.0);
+  }
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 0.1;
+  }
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[1];
+  }
+
+  BCType
+  bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    if (is.geometry().global(x)[0] < 1e-6)
+      return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Dirichlet;
+    return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Neumann;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 1.0;
+  }
+
+  typename Traits::RangeFieldType
+  o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+};
+
+// the float copy only reports changes that survive the rounding to float
+template<typename M>
+bool testFloatMatrixCopy(M a)
+{
+  Dune::PDELab::istl::FloatMatrixCopy<M> copy;
+  bool passed = true;
+
+  a[0][0][0][0] = 1.0;
+  if (!copy.update(a))
+    {
+      std::cerr << "FloatMatrixCopy: first update reported no change" << std::endl;
+      passed = false;
+    }
+  if (copy.update(a))
+    {
+      std::cerr << "FloatMatrixCopy: unchanged matrix reported a change" << std::endl;
+      passed = false;
+    }
+  a[0][0][0][0] = 1.0 + 1e-12;
+  if (copy.update(a))
+    {
+      std::cerr << "FloatMatrixCopy: change below float precision reported a change" << std::endl;
+      passed = false;
+    }
+  a[0][0][0][0] = 2.0;
+  if (!copy.update(a))
+    {
+      std::cerr << "FloatMatrixCopy: changed value was not detected" << std::endl;
+      passed = false;
+    }
+  if (copy.matrix()[0][0][0][0] != 2.0f)
+    {
+      std::cerr << "FloatMatrixCopy: copy was not updated" << std::endl;
+      passed = false;
+    }
+  return passed;
+}
+
+// solves A z = r with a mixed precision backend to a reduction far below float precision
+// and compares the solution with a reference computed entirely in double precision
+template<typename Solver, typename M, typename V>
+bool test(Solver& solver, M& a, const V& r, const V& reference, const std::string& name)
+{
+  bool passed = true;
+
+  // the second solve uses the cached preconditioner
+  for (int i = 0; i < 2; ++i)
+    {
+      V z(reference);
+      z = 0.0;
+      V b(r);
+      solver.apply(a,z,b,1e-10);
+
+      V d(r);
+      a.base().mmv(z.base(),d.base());
+      if (!solver.result().converged || d.two_norm() > 1e-9 * r.two_norm())
+        {
+          std::cerr << name << ": residual reduction " << d.two_norm() / r.two_norm()
+                    << " after " << solver.result().iterations << " iterations" << std::endl;
+          passed = false;
+        }
+
+      z -= reference;
+      if (z.two_norm() > 1e-7 * reference.two_norm())
+        {
+          std::cerr << name << ": solution differs from the double precision solution by "
+                    << z.two_norm() / reference.two_norm() << std::endl;
+          passed = false;
+        }
+    }
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(32));
+    Grid grid(L,N);
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::ConformingDirichletConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+    Dune::PDELab::ConvectionDiffusionBoundaryConditionAdapter<Param> bc(param);
+    typedef GFS::ConstraintsContainer<double>::Type CC;
+    CC cc;
+    Dune::PDELab::constraints(bc,gfs,cc);
+
+    typedef Dune::PDELab::ConvectionDiffusionFEM<Param,FEM> LOP;
+    LOP lop(param);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(9);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double,CC,CC> GO;
+    GO go(gfs,cc,gfs,cc,lop,mbe);
+
+    // the correction problem: homogeneous on the Dirichlet rows, where the matrix has unit rows
+    typedef GO::Traits::Domain V;
+    typedef GO::Jacobian M;
+    V x(gfs,0.0);
+    V r(gfs,0.0);
+    go.residual(x,r);
+    Dune::PDELab::set_constrained_dofs(cc,0.0,r);
+    M a(go);
+    a = 0.0;
+    go.jacobian(x,a);
+
+    bool passed = testFloatMatrixCopy(a.base());
+
+    V reference(gfs,0.0);
+    {
+      Dune::PDELab::ISTLBackend_SEQ_CG_SSOR solver(5000,0);
+      V b(r);
+      solver.apply(a,reference,b,1e-14);
+    }
+
+    {
+      Dune::PDELab::ISTLBackend_SEQ_CG_SSOR_MixedPrecision solver(5000,3,0);
+      passed = test(solver,a,r,reference,"CG with float SSOR") && passed;
+    }
+    {
+      Dune::PDELab::ISTLBackend_SEQ_BCGS_ILU0_MixedPrecision solver(5000,0);
+      passed = test(solver,a,r,reference,"BiCGStab with float ILU0") && passed;
+    }
+    {
+      Dune::PDELab::ISTLBackend_SEQ_CG_AMG_SSOR_MixedPrecision<GO> solver(5000,0);
+      passed = test(solver,a,r,reference,"CG with float AMG") && passed;
+    }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -4,7 +4,10 @@
 #ifdef HAVE_CONFIG_H
 #include "config.h"
 #endif
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 #include <dune/pdelab/finiteelementmap/opbfem.hh>
 
@@ -149,6 +152,183 @@ namespace Dune {
       MassMatrixTest<double,8,3,Dune::GeometryType::cube,Dune::GMPField<512>,BasisType::Qk >::compute();
     }
 
+    //! \brief Compares the Jacobians with central differences of the function values
+    template<typename FieldType, int k, int d, Dune::GeometryType::BasicType bt, BasisType basisType = BasisType::Pk>
+    bool testjacobian ()
+    {
+      typedef Dune::PB::OrthonormalPolynomialBasis<FieldType,k,d,bt,FieldType,basisType> PolynomialBasis;
+      typedef Dune::FieldVector<FieldType,1> RangeType;
+      typedef Dune::FieldMatrix<FieldType,1,d> JacobianType;
+      PolynomialBasis polynomialbasis;
+
+      Dune::FieldVector<FieldType,d> x;
+      for (int s=0; s<d; s++) x[s] = 0.1 + 0.15*s;
+
+      std::vector<JacobianType> jacobian(PolynomialBasis::n);
+      polynomialbasis.evaluateJacobian(x,jacobian);
+
+      const FieldType h = 1e-6;
+      FieldType error = 0.0;
+      for (int s=0; s<d; s++)
+        {
+          std::vector<RangeType> phi_plus(PolynomialBasis::n), phi_minus(PolynomialBasis::n);
+          Dune::FieldVector<FieldType,d> y(x);
+          y[s] += h;
+          polynomialbasis.evaluateFunction(y,phi_plus);
+          y[s] -= 2*h;
+          polynomialbasis.evaluateFunction(y,phi_minus);
+          for (int i=0; i<PolynomialBasis::n; i++)
+            error = std::max(error,std::abs((phi_plus[i][0]-phi_minus[i][0])/(2*h) - jacobian[i][0][s]));
+        }
+
+      std::cout << "jacobian test k=" << k << " on " << Dune::GeometryType(bt,d)
+                << " maxerror=" << error << std::endl;
+      return error < 1e-5;
+    }
+
+    //! \brief Compares the closed form on the cube with the Gram-Schmidt orthonormalized monomials
+    /**
+     * The reference basis is computed here in high precision by the same procedure
+     * that OrthonormalPolynomialBasis used on the cube before it was evaluated from
+     * Legendre polynomials.
+     */
+    template<typename FieldType, int k, int d, BasisType basisType = BasisType::Pk>
+    bool testcubevalues ()
+    {
+      typedef Dune::GMPField<512> ComputationFieldType;
+      typedef Dune::PB::OrthonormalPolynomialBasis<FieldType,k,d,Dune::GeometryType::cube,FieldType,basisType> PolynomialBasis;
+      typedef Dune::FieldVector<FieldType,1> RangeType;
+      const int n = PolynomialBasis::n;
+      PolynomialBasis polynomialbasis;
+
+      std::vector<MultiIndex<d> > alpha(n);
+      for (int i=0; i<n; i++)
+        BasisTraits<basisType>::multiindex(i,k,alpha[i]);
+
+      // Gram-Schmidt orthonormalization of the monomials
+      std::vector<std::vector<ComputationFieldType> > c(n,std::vector<ComputationFieldType>(n,ComputationFieldType(0.0)));
+      MonomialIntegrator<ComputationFieldType,Dune::GeometryType::cube,d> integrator;
+      for (int i=0; i<n; i++)
+        {
+          c[i][i] = ComputationFieldType(1.0);
+          std::vector<ComputationFieldType> bi(n,ComputationFieldType(0.0));
+          for (int j=0; j<i; j++)
+            {
+              for (int l=0; l<=j; l++)
+                {
+                  MultiIndex<d> a;
+                  for (int m=0; m<d; m++) a[m] = alpha[i][m] + alpha[l][m];
+                  bi[j] = bi[j] + c[j][l]*integrator.integrate(a);
+                }
+              for (int l=0; l<=j; l++)
+                c[i][l] = c[i][l] - bi[j]*c[j][l];
+            }
+          MultiIndex<d> a;
+          for (int m=0; m<d; m++) a[m] = 2*alpha[i][m];
+          ComputationFieldType s2 = integrator.integrate(a);
+          for (int j=0; j<i; j++)
+            s2 = s2 - bi[j]*bi[j];
+          ComputationFieldType scale(1.0);
+          scale = scale/std::sqrt(s2);
+          for (int l=0; l<=i; l++)
+            c[i][l] = scale*c[i][l];
+        }
+
+      FieldType error = 0.0;
+      for (int p=0; p<5; p++)
+        {
+          Dune::FieldVector<FieldType,d> x;
+          for (int s=0; s<d; s++) x[s] = 0.05 + 0.2*p + 0.07*s;
+
+          std::vector<RangeType> phi(n);
+          polynomialbasis.evaluateFunction(x,phi);
+
+          for (int i=0; i<n; i++)
+            {
+              ComputationFieldType value(0.0);
+              for (int j=0; j<=i; j++)
+                {
+                  ComputationFieldType monomial(1.0);
+                  for (int s=0; s<d; s++)
+                    for (int e=0; e<alpha[j][s]; e++)
+                      monomial = monomial*ComputationFieldType(x[s]);
+                  value = value + c[i][j]*monomial;
+                }
+              const FieldType reference = value;
+              error = std::max(error,std::abs(phi[i][0] - reference));
+            }
+        }
+
+      std::cout << "cube value test k=" << k << " d=" << d
+                << " maxerror=" << error << std::endl;
+      return error < 1e-10;
+    }
+
+    //! \brief Checks that the Dubiner basis on the simplex is L_2 orthonormal
+    template<typename FieldType, int k, int d>
+    bool testdubiner ()
+    {
+      typedef Dune::PB::OrthonormalPolynomialBasis<FieldType,k,d,Dune::GeometryType::simplex,FieldType,BasisType::PkDubiner> PolynomialBasis;
+      typedef Dune::FieldVector<FieldType,1> RangeType;
+      const int n = PolynomialBasis::n;
+      PolynomialBasis polynomialbasis;
+
+      std::vector<std::vector<FieldType> > mass(n,std::vector<FieldType>(n,0.0));
+      Dune::GeometryType gt(Dune::GeometryType::simplex,d);
+      const Dune::QuadratureRule<FieldType,d>& rule = Dune::QuadratureRules<FieldType,d>::rule(gt,2*k);
+      std::vector<RangeType> phi(n);
+      for (typename Dune::QuadratureRule<FieldType,d>::const_iterator it=rule.begin(); it!=rule.end(); ++it)
+        {
+          polynomialbasis.evaluateFunction(it->position(),phi);
+          for (int i=0; i<n; i++)
+            for (int j=0; j<n; j++)
+              mass[i][j] += phi[i][0]*phi[j][0]*it->weight();
+        }
+
+      FieldType error = 0.0;
+      for (int i=0; i<n; i++)
+        for (int j=0; j<n; j++)
+          error = std::max(error,std::abs(mass[i][j] - (i==j ? 1.0 : 0.0)));
+
+      std::cout << "dubiner orthonormality test k=" << k << " d=" << d
+                << " maxerror=" << error << std::endl;
+      return error < 1e-10;
+    }
+
+    bool testdubiners()
+    {
+      bool passed = true;
+      passed &= testdubiner<double,5,1>();
+      passed &= testdubiner<double,5,2>();
+      passed &= testdubiner<double,4,3>();
+      return passed;
+    }
+
+    bool testcubes()
+    {
+      bool passed = true;
+      passed &= testcubevalues<double,1,1>();
+      passed &= testcubevalues<double,5,1>();
+      passed &= testcubevalues<double,4,2>();
+      passed &= testcubevalues<double,3,3>();
+      passed &= testcubevalues<double,3,2,BasisType::Qk>();
+      passed &= testcubevalues<double,2,3,BasisType::Qk>();
+      return passed;
+    }
+
+    bool testjacobians()
+    {
+      bool passed = true;
+      passed &= testjacobian<double,4,2,Dune::GeometryType::cube>();
+      passed &= testjacobian<double,3,3,Dune::GeometryType::cube>();
+      passed &= testjacobian<double,3,2,Dune::GeometryType::cube,BasisType::Qk>();
+      passed &= testjacobian<double,4,2,Dune::GeometryType::simplex>();
+      passed &= testjacobian<double,3,3,Dune::GeometryType::simplex>();
+      passed &= testjacobian<double,4,2,Dune::GeometryType::simplex,BasisType::PkDubiner>();
+      passed &= testjacobian<double,3,3,Dune::GeometryType::simplex,BasisType::PkDubiner>();
+      return passed;
+    }
+
   } // namespace PB
 
 } // namespace Dune
@@ -160,8 +340,11 @@ int main(int argc, char** argv)
     // run tests
     Dune::PB::testmassmatrix();
 
-    // test passed
-    return 0;
+    bool passed = Dune::PB::testcubes();
+    passed = Dune::PB::testjacobians() && passed;
+    passed = Dune::PB::testdubiners() && passed;
+
+    return passed ? 0 : 1;
   }
   catch (Dune::Exception &e){
     std::cerr << "Dune reported error: " << e << std::endl;
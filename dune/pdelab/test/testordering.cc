@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include <memory>
+#include <vector>
 
 #include <dune/common/exceptions.hh>
 #include <dune/common/fvector.hh>
@@ -29,6 +30,7 @@
 #include <dune/pdelab/backend/istlvectorbackend.hh>
 
 #include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
 
 template<typename GFS>
 void check_ordering(const GFS& gfs)
@@ -68,6 +70,110 @@ void check_ordering(const GFS& gfs)
 }
 
 
+// collects the flat container indices of all cells
+template<typename GFS>
+std::vector<std::vector<std::size_t> > cell_indices(const GFS& gfs)
+{
+  typedef typename GFS::Traits::GridView GV;
+  Dune::PDELab::LocalFunctionSpace<GFS> lfs(gfs);
+  std::vector<std::vector<std::size_t> > indices;
+
+  for (typename GV::template Codim<0>::Iterator it = gfs.gridView().template begin<0>();
+       it != gfs.gridView().template end<0>(); ++it)
+    {
+      lfs.bind(*it);
+      indices.push_back(std::vector<std::size_t>(lfs.size()));
+      for (unsigned i = 0; i < lfs.size(); ++i)
+        indices.back()[i] = gfs.ordering().mapIndex(lfs.dofIndex(i))[0];
+    }
+  return indices;
+}
+
+// changes the polynomial degree of some cells and checks the map from
+// the old to the new DOF indices
+template<typename GFS, typename FEM>
+void check_update_map(GFS& gfs, FEM& fem)
+{
+  typedef typename GFS::Traits::GridView GV;
+
+  const std::vector<std::vector<std::size_t> > old_indices = cell_indices(gfs);
+  const std::size_t old_size = gfs.size();
+
+  unsigned int n = 0;
+  for (typename GV::template Codim<0>::Iterator it = gfs.gridView().template begin<0>();
+       it != gfs.gridView().template end<0>(); ++it, ++n)
+    if (n % 3 == 1)
+      fem.setOrder(*it,fem.getOrder(*it) + 1);
+    else if (n % 3 == 2 && fem.getOrder(*it) > 0)
+      fem.setOrder(*it,fem.getOrder(*it) - 1);
+  gfs.update();
+
+  const std::vector<std::vector<std::size_t> > new_indices = cell_indices(gfs);
+  const auto& map = gfs.ordering().updateMap();
+
+  if (!map.valid() || map.identity() || map.oldSize() != old_size || map.newSize() != gfs.size())
+    DUNE_THROW(Dune::Exception,"invalid ordering update map");
+
+  for (std::size_t c = 0; c < old_indices.size(); ++c)
+    for (std::size_t i = 0; i < old_indices[c].size(); ++i)
+      {
+        const std::size_t expected = i < new_indices[c].size() ? new_indices[c][i] : map.invalid;
+        if (map[old_indices[c][i]] != expected)
+          DUNE_THROW(Dune::Exception,"ordering update map maps DOF " << old_indices[c][i]
+                     << " to " << map[old_indices[c][i]] << " instead of " << expected);
+      }
+}
+
+// refines one corner cell of a grid with 2x2 cells, then coarsens it again and
+// refines the opposite corner cell instead. The second adaptation keeps the number
+// of entities of each GeometryType, but the update map must not be recorded.
+template<typename Grid>
+void check_update_map_after_adaptation(Grid& grid)
+{
+  typedef typename Grid::LeafGridView GV;
+  typedef typename GV::template Codim<0>::Iterator CellIterator;
+  typedef typename GV::ctype ctype;
+  const int dim = GV::dimension;
+
+  Dune::FieldVector<ctype,dim> corner(0.25);
+  const GV gv = grid.leafGridView();
+  for (CellIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+    if ((it->geometry().center() - corner).two_norm() < 1e-8)
+      grid.mark(1,*it);
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+
+  typedef Dune::SingleCodimSingleGeomTypeMapper<GV, 0> CellMapper;
+  CellMapper cellmapper(gv);
+  typedef Dune::PDELab::VariableMonomLocalFiniteElementMap<CellMapper,float,double,dim> MonomFEM;
+  MonomFEM monomfem(cellmapper,1);
+  typedef Dune::PDELab::GridFunctionSpace<GV,MonomFEM,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > GFS;
+  GFS gfs(gv,monomfem);
+  const std::size_t size = gfs.size();
+
+  // an update without any change gives the identity
+  gfs.update();
+  if (!gfs.ordering().updateMap().identity())
+    DUNE_THROW(Dune::Exception,"ordering update map of an unchanged grid is not the identity");
+
+  Dune::FieldVector<ctype,dim> opposite(0.75);
+  for (CellIterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+    if (it->level() > 0)
+      grid.mark(-1,*it);
+    else if ((it->geometry().center() - opposite).two_norm() < 1e-8)
+      grid.mark(1,*it);
+  grid.preAdapt();
+  grid.adapt();
+  grid.postAdapt();
+  gfs.update();
+
+  if (gfs.size() != size)
+    DUNE_THROW(Dune::Exception,"adaptation changed the size of the space from " << size << " to " << gfs.size());
+  if (gfs.ordering().updateMap().valid())
+    DUNE_THROW(Dune::Exception,"ordering update map was recorded after the grid was adapted");
+}
+
 // test function trees
 template<int dim, bool cube>
 struct test;
@@ -174,6 +280,7 @@ struct test<2,false> {
     typedef Dune::PDELab::GridFunctionSpace<GV,MonomFEM,CON,VBE> GFS3;
     GFS3 gfs3(gv,monomfem);
     check_ordering(gfs3);
+    check_update_map(gfs3,monomfem);
   }
 };
 
@@ -228,6 +335,7 @@ int main(int argc, char** argv)
 
       std::cout << Dune::GlobalGeometryTypeIndex::index(grid->leafGridView().template begin<0>()->type()) << std::endl;
       testleafgridfunction<true>(grid->leafGridView());
+      check_update_map_after_adaptation(*grid);
     }
 
     {
@@ -0,0 +1,232 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionparameter.hh>
+
+// convection-diffusion problem with varying coefficients that counts their evaluations
+template<typename GV, typename RF>
+class Parameter
+{
+  typedef Dune::PDELab::ConvectionDiffusionBoundaryConditions::Type BCType;
+
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  Parameter ()
+    : calls(0), time(0.0)
+  {}
+
+  typename Traits::PermTensorType
+  A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    ++calls;
+    typename Traits::DomainType xg = e.geometry().global(x);
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0 + xg[0];
+    return I;
+  }
+
+  typename Traits::RangeType
+  b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    ++calls;
+    typename Traits::RangeType v(0.0);
+    v[0] = e.geometry().global(x)[1];
+    return v;
+  }
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    ++calls;
+    typename Traits::DomainType xg = e.geometry().global(x);
+    return 1.0 + xg[0]*xg[1];
+  }
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    ++calls;
+    return time + e.geometry().global(x)[0];
+  }
+
+  BCType
+  bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Neumann;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return is.geometry().global(x)[1];
+  }
+
+  typename Traits::RangeFieldType
+  o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+
+  void setTime (RF t)
+  {
+    time = t;
+  }
+
+  mutable std::size_t calls;
+  RF time;
+};
+
+// assembles the residual of the convection-diffusion operator with the given parameter object
+template<typename GFS, typename P, typename V>
+void assemble(const GFS& gfs, P& param, const V& x, V& r)
+{
+  typedef Dune::PDELab::ConvectionDiffusionFEM<P,typename GFS::Traits::FiniteElementMapType> LOP;
+  LOP lop(param);
+  typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+  MBE mbe(25);
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO;
+  GO go(gfs,gfs,lop,mbe);
+  r = 0.0;
+  go.residual(x,r);
+}
+
+// compares the residual assembled with the given parameter object with a reference
+template<typename GFS, typename P, typename V>
+bool check(const GFS& gfs, P& param, const V& x, const V& reference, const std::string& what)
+{
+  V r(gfs,0.0);
+  assemble(gfs,param,x,r);
+  r -= reference;
+  if (r.two_norm() > 1e-12 * reference.two_norm())
+    {
+      std::cerr << what << ": residual differs by " << r.two_norm() << std::endl;
+      return false;
+    }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,2> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+    V x(gfs,0.0);
+    std::size_t k = 0;
+    for (V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+      *it = 0.1 * k;
+
+    typedef Parameter<GV,double> Param;
+    Param param;
+
+    // reference residual without cache
+    V reference(gfs,0.0);
+    assemble(gfs,param,x,reference);
+
+    typedef Dune::PDELab::ConvectionDiffusionParameterCache<Param> Cache;
+    Cache cache(gv,param);
+
+    bool passed = check(gfs,cache,x,reference,"first assembly");
+
+    // the second assembly only reads stored values
+    param.calls = 0;
+    passed = check(gfs,cache,x,reference,"second assembly") && passed;
+    if (param.calls != 0)
+      {
+        std::cerr << "coefficients evaluated " << param.calls << " times in second assembly" << std::endl;
+        passed = false;
+      }
+
+    // a new time discards the stored values
+    cache.setTime(1.0);
+    V shifted(gfs,0.0);
+    assemble(gfs,param,x,shifted);
+    param.calls = 0;
+    passed = check(gfs,cache,x,shifted,"assembly after setTime") && passed;
+    if (param.calls == 0)
+      {
+        std::cerr << "coefficients not reevaluated after setTime" << std::endl;
+        passed = false;
+      }
+
+    // the same time keeps them
+    cache.setTime(1.0);
+    param.calls = 0;
+    passed = check(gfs,cache,x,shifted,"assembly at same time") && passed;
+    if (param.calls != 0)
+      {
+        std::cerr << "coefficients reevaluated at the same time" << std::endl;
+        passed = false;
+      }
+
+    // cellwise coefficients are evaluated once per cell
+    param.calls = 0;
+    Cache cellwise(gv,param,Cache::diffusion | Cache::velocity | Cache::reaction | Cache::source);
+    V r(gfs,0.0);
+    assemble(gfs,cellwise,x,r);
+    if (param.calls != 4*std::size_t(gv.size(0)))
+      {
+        std::cerr << "cellwise coefficients evaluated " << param.calls << " times on "
+                  << gv.size(0) << " cells" << std::endl;
+        passed = false;
+      }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -209,6 +209,22 @@ void poisson (const GV& gv, const FEM& fem, std::string filename, int q)
   M m(gridoperator);
   gridoperator.jacobian(x,m);
 
+  // matrices of the same grid operator share their pattern, so assignment only copies values
+  {
+    M m2(gridoperator);
+    if (!m2.same_pattern(m))
+      DUNE_THROW(Dune::Exception,"matrices of the same grid operator have different patterns");
+    m2 = m;
+    M m3(m2);
+    m3 *= 2.0;
+    m2 = m3;
+    PETSC_CALL(MatAXPY(m2,-2.0,m,SAME_NONZERO_PATTERN));
+    PetscReal norm = 0.0;
+    PETSC_CALL(MatNorm(m2,NORM_INFINITY,&norm));
+    if (norm != 0.0)
+      DUNE_THROW(Dune::Exception,"copied matrix differs by " << norm);
+  }
+
   // evaluate residual w.r.t initial guess
   typedef typename GridOperator::Traits::Range RV;
   RV r(gfs,0.0);
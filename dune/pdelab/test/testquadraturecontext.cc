@@ -0,0 +1,138 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+#include <dune/common/tuples.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/l2.hh>
+#include <dune/pdelab/localoperator/laplace.hh>
+#include <dune/pdelab/localoperator/scaled.hh>
+#include <dune/pdelab/localoperator/weightedsum.hh>
+
+// Assembles the residual and the jacobian of lop and stores a linear
+// combination of them in r and y = jacobian * x.
+template<typename GFS, typename LOP, typename V>
+void assemble(const GFS& gfs, LOP& lop, const V& x, double weight, V& r, V& y)
+{
+  typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO;
+  MBE mbe(9);
+  GO go(gfs,gfs,lop,mbe);
+
+  V lop_r(gfs,0.0);
+  go.residual(x,lop_r);
+  r.axpy(weight,lop_r);
+
+  typename GO::Traits::Jacobian m(go);
+  m = 0.0;
+  go.jacobian(x,m);
+  V lop_y(gfs,0.0);
+  m.base().mv(x.base(),lop_y.base());
+  y.axpy(weight,lop_y);
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,2> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+    V x(gfs,0.0);
+    std::size_t k = 0;
+    for (V::iterator it = x.begin(); it != x.end(); ++it, ++k)
+      *it = std::sin(1.0 + k);
+
+    // summands sharing one quadrature context, one of them nested in a
+    // ScaledLocalOperator
+    typedef Dune::PDELab::L2 L2;
+    typedef Dune::PDELab::Laplace Laplace;
+    typedef Dune::PDELab::ScaledLocalOperator<Laplace,double> ScaledLaplace;
+    L2 l2(4);
+    Laplace laplace(4);
+    ScaledLaplace scaled_laplace(laplace,3.0);
+
+    static_assert(Dune::PDELab::uses_quadrature_context<L2>::value,
+                  "L2 should use the quadrature context");
+    static_assert(Dune::PDELab::uses_quadrature_context<ScaledLaplace>::value,
+                  "ScaledLocalOperator should forward the quadrature context");
+
+    typedef Dune::PDELab::WeightedSumLocalOperator<
+      double,
+      Dune::tuple<L2,ScaledLaplace>
+      > Sum;
+    Sum::Weights weights;
+    weights[0] = 2.0;
+    weights[1] = 0.5;
+    Sum sum(Dune::tie(l2,scaled_laplace),weights);
+
+    V r(gfs,0.0), y(gfs,0.0);
+    assemble(gfs,sum,x,1.0,r,y);
+
+    // the same sum, assembled from separate grid operators
+    V r_ref(gfs,0.0), y_ref(gfs,0.0);
+    assemble(gfs,l2,x,2.0,r_ref,y_ref);
+    assemble(gfs,laplace,x,1.5,r_ref,y_ref);
+
+    r -= r_ref;
+    y -= y_ref;
+
+    bool passed = true;
+    if (r.two_norm() > 1e-10 * r_ref.two_norm())
+      {
+        std::cerr << "residual of the weighted sum differs by " << r.two_norm() << std::endl;
+        passed = false;
+      }
+    if (y.two_norm() > 1e-10 * y_ref.two_norm())
+      {
+        std::cerr << "jacobian of the weighted sum differs by " << y.two_norm() << std::endl;
+        passed = false;
+      }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
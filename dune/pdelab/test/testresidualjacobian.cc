@@ -0,0 +1,214 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/constraints/common/constraints.hh>
+#include <dune/pdelab/constraints/conforming.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionparameter.hh>
+
+// convection-diffusion problem with varying coefficients and all boundary condition types
+template<typename GV, typename RF>
+class Parameter
+{
+  typedef Dune::PDELab::ConvectionDiffusionBoundaryConditions::Type BCType;
+
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  typename Traits::PermTensorType
+  A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::DomainType xg = e.geometry().global(x);
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0 + xg[0];
+    I[0][1] = I[1][0] = 0.25;
+    return I;
+  }
+
+  typename Traits::RangeType
+  b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::RangeType v(0.0);
+    v[0] = 1.0;
+    v[1] = e.geometry().global(x)[0];
+    return v;
+  }
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::DomainType xg = e.geometry().global(x);
+    return 1.0 + xg[0]*xg[1];
+  }
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[0];
+  }
+
+  BCType
+  bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    typename Traits::DomainType xg = is.geometry().global(x);
+    if (xg[0] < 1e-6)
+      return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Dirichlet;
+    if (xg[0] > 1.0 - 1e-6)
+      return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Outflow;
+    return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Neumann;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::DomainType xg = e.geometry().global(x);
+    return xg[1]*xg[1];
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return is.geometry().global(x)[0];
+  }
+
+  typename Traits::RangeFieldType
+  o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.5;
+  }
+};
+
+// compares residual_and_jacobian() with residual() and jacobian(), and the
+// analytic jacobian with a difference quotient of the residual
+template<int k, typename GV>
+bool test(const GV& gv)
+{
+  typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,k> FEM;
+  FEM fem(gv);
+  typedef Dune::PDELab::GridFunctionSpace<
+    GV,
+    FEM,
+    Dune::PDELab::ConformingDirichletConstraints,
+    Dune::PDELab::ISTLVectorBackend<>
+    > GFS;
+  GFS gfs(gv,fem);
+
+  typedef Parameter<GV,double> Param;
+  Param param;
+  Dune::PDELab::ConvectionDiffusionBoundaryConditionAdapter<Param> bc(param);
+  typedef typename GFS::template ConstraintsContainer<double>::Type CC;
+  CC cc;
+  Dune::PDELab::constraints(bc,gfs,cc);
+
+  typedef Dune::PDELab::ConvectionDiffusionFEM<Param,FEM> LOP;
+  LOP lop(param);
+  typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+  MBE mbe(25);
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double,CC,CC> GO;
+  GO go(gfs,cc,gfs,cc,lop,mbe);
+
+  typedef typename GO::Traits::Domain V;
+  V x(gfs,0.0);
+  std::size_t i = 0;
+  for (typename V::iterator it = x.begin(); it != x.end(); ++it, ++i)
+    *it = 0.01 * i;
+
+  bool passed = true;
+
+  V r(gfs,0.0);
+  go.residual(x,r);
+  typedef typename GO::Jacobian M;
+  M a(go);
+  a = 0.0;
+  go.jacobian(x,a);
+
+  V rf(gfs,0.0);
+  M af(go);
+  af = 0.0;
+  go.residual_and_jacobian(x,rf,af);
+
+  rf -= r;
+  if (rf.infinity_norm() > 1e-12 * (1.0 + r.infinity_norm()))
+    {
+      std::cerr << "Q" << k << ": residual_and_jacobian() residual differs by "
+                << rf.infinity_norm() << std::endl;
+      passed = false;
+    }
+  const double anorm = a.base().infinity_norm();
+  af.base() -= a.base();
+  if (af.base().infinity_norm() > 1e-12 * (1.0 + anorm))
+    {
+      std::cerr << "Q" << k << ": residual_and_jacobian() jacobian differs by "
+                << af.base().infinity_norm() << std::endl;
+      passed = false;
+    }
+
+  // the operator is affine, so the difference quotient is exact up to rounding;
+  // the direction vanishes on the Dirichlet rows, which are replaced by unit rows
+  V z(gfs,0.0);
+  i = 0;
+  for (typename V::iterator it = z.begin(); it != z.end(); ++it, ++i)
+    *it = 1.0 + 0.5 * (i % 3);
+  Dune::PDELab::set_constrained_dofs(cc,0.0,z);
+  V xz(x);
+  xz += z;
+  V rz(gfs,0.0);
+  go.residual(xz,rz);
+  rz -= r;
+  V az(gfs,0.0);
+  a.base().mv(z.base(),az.base());
+  az -= rz;
+  if (az.infinity_norm() > 1e-10 * (1.0 + rz.infinity_norm()))
+    {
+      std::cerr << "Q" << k << ": jacobian differs from the residual difference by "
+                << az.infinity_norm() << std::endl;
+      passed = false;
+    }
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    bool passed = test<1>(grid.leafGridView());
+    passed = test<2>(grid.leafGridView()) && passed;
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
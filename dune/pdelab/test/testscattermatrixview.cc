@@ -0,0 +1,150 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/common/exceptions.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/flags.hh>
+
+// local operator that only declares the diagonal couplings, but writes the
+// given value to all off-diagonal entries of the local jacobian
+class DiagonalPattern
+  : public Dune::PDELab::LocalOperatorDefaultFlags
+{
+public:
+
+  enum { doPatternVolume = true };
+  enum { doAlphaVolume = true };
+
+  explicit DiagonalPattern (double offdiagonal)
+    : _offdiagonal(offdiagonal)
+  {}
+
+  template<typename LFSU, typename LFSV, typename LocalPattern>
+  void pattern_volume (const LFSU& lfsu, const LFSV& lfsv, LocalPattern& pattern) const
+  {
+    for (std::size_t i=0; i<lfsv.size(); ++i)
+      pattern.addLink(lfsv,i,lfsu,i);
+  }
+
+  template<typename EG, typename LFSU, typename X, typename LFSV, typename R>
+  void alpha_volume (const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, R& r) const
+  {
+    for (std::size_t i=0; i<lfsv.size(); ++i)
+      r.accumulate(lfsv,i,x(lfsu,i));
+  }
+
+  template<typename EG, typename LFSU, typename X, typename LFSV, typename M>
+  void jacobian_volume (const EG& eg, const LFSU& lfsu, const X& x, const LFSV& lfsv, M& mat) const
+  {
+    for (std::size_t i=0; i<lfsv.size(); ++i)
+      for (std::size_t j=0; j<lfsu.size(); ++j)
+        mat.accumulate(lfsv,i,lfsu,j,i == j ? 1.0 : _offdiagonal);
+  }
+
+private:
+  double _offdiagonal;
+};
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> FEM;
+    FEM fem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS;
+    GFS gfs(gv,fem);
+
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(9);
+    typedef Dune::PDELab::GridOperator<GFS,GFS,DiagonalPattern,MBE,double,double,double> GO;
+    typedef GO::Traits::Domain V;
+    typedef GO::Jacobian M;
+    V x(gfs,0.0);
+
+    bool passed = true;
+
+    // zeros outside of the pattern are dropped, the diagonal counts the cells around each vertex
+    {
+      DiagonalPattern lop(0.0);
+      GO go(gfs,gfs,lop,mbe);
+      M a(go);
+      a = 0.0;
+      go.jacobian(x,a);
+      V ones(gfs,1.0);
+      V y(gfs,0.0);
+      a.base().mv(ones.base(),y.base());
+      double sum = 0.0;
+      for (V::iterator it = y.begin(); it != y.end(); ++it)
+        sum += *it;
+      if (a.base().nonzeroes() != gfs.globalSize() || sum != 4.0 * gv.size(0))
+        {
+          std::cerr << "diagonal jacobian has " << a.base().nonzeroes() << " entries and sum "
+                    << sum << std::endl;
+          passed = false;
+        }
+    }
+
+    // non-zero values outside of the pattern must not be dropped silently
+    {
+      DiagonalPattern lop(1.0);
+      GO go(gfs,gfs,lop,mbe);
+      M a(go);
+      a = 0.0;
+      bool thrown = false;
+      try {
+        go.jacobian(x,a);
+      }
+      catch (Dune::PDELab::MatrixPatternError&) {
+        thrown = true;
+      }
+      if (!thrown)
+        {
+          std::cerr << "non-zero entry outside of the pattern was accepted" << std::endl;
+          passed = false;
+        }
+    }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -252,6 +252,95 @@ void poisson (const GV& gv, const FEM& fem, std::string filename, int q)
   vtkwriter.write(filename,Dune::VTK::ascii);
 }
 
+// assemble the Poisson problem into CSR and SELL matrices, compare the
+// matrix-vector products and solve with the SELL solver backends
+template<typename GV, typename FEM, typename CON, typename SELLMBE>
+void sell_solvers (const GV& gv, const FEM& fem, int q)
+{
+  typedef typename FEM::Traits::FiniteElementType::Traits::
+    LocalBasisType::Traits::RangeFieldType R;
+
+  typedef Dune::PDELab::GridFunctionSpace<
+    GV,
+    FEM,
+    CON,
+    Dune::PDELab::SimpleVectorBackend<>
+    > GFS;
+  GFS gfs(gv,fem);
+
+  typedef typename GFS::template ConstraintsContainer<R>::Type C;
+  C cg;
+  cg.clear();
+  ConstraintsParameters constraintsparameters;
+  Dune::PDELab::constraints(constraintsparameters,gfs,cg);
+
+  typedef G<GV,R> GType;
+  GType g(gv);
+  typedef F<GV,R> FType;
+  FType f(gv);
+  typedef J<GV,R> JType;
+  JType j(gv);
+  typedef Dune::PDELab::Poisson<FType,ConstraintsParameters,JType> LOP;
+  LOP lop(f,constraintsparameters,j,q);
+
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,
+                                     Dune::PDELab::SimpleSparseMatrixBackend<>,
+                                     double,double,double,
+                                     C,C> CSRGridOperator;
+  CSRGridOperator csr_gridoperator(gfs,cg,gfs,cg,lop);
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,
+                                     SELLMBE,
+                                     double,double,double,
+                                     C,C> SELLGridOperator;
+  SELLGridOperator sell_gridoperator(gfs,cg,gfs,cg,lop);
+
+  typedef typename SELLGridOperator::Traits::Domain V;
+  V x0(gfs,0.0);
+  Dune::PDELab::interpolate(g,gfs,x0);
+  Dune::PDELab::set_nonconstrained_dofs(cg,0.0,x0);
+
+  typename CSRGridOperator::Traits::Jacobian csr_m(csr_gridoperator);
+  csr_gridoperator.jacobian(x0,csr_m);
+  typename SELLGridOperator::Traits::Jacobian sell_m(sell_gridoperator);
+  sell_gridoperator.jacobian(x0,sell_m);
+
+  // SELL and CSR products have to agree
+  V x(gfs,0.0), y_csr(gfs,0.0), y_sell(gfs,0.0);
+  Dune::PDELab::interpolate(g,gfs,x);
+  csr_m.mv(x,y_csr);
+  sell_m.mv(x,y_sell);
+  const double scale = y_csr.infinity_norm();
+  y_sell -= y_csr;
+  if (y_sell.infinity_norm() > 1e-12 * scale)
+    DUNE_THROW(Dune::Exception,"SELL matrix-vector product differs from CSR result");
+  sell_m.usmv(-2.0,x,y_csr);
+  csr_m.usmv(1.0,x,y_csr);
+  if (y_csr.infinity_norm() > 1e-12 * scale)
+    DUNE_THROW(Dune::Exception,"SELL usmv differs from CSR result");
+
+  V r(gfs,0.0);
+  sell_gridoperator.residual(x0,r);
+  r *= -1.0;
+
+  {
+    Dune::PDELab::SimpleBackend_SELL_CG_Jacobi solver(5000,1);
+    V z(gfs,0.0);
+    V rhs(r);
+    solver.apply(sell_m,z,rhs,1e-10);
+    if (!solver.result().converged)
+      DUNE_THROW(Dune::Exception,"CG with SELL Jacobi preconditioner did not converge");
+  }
+
+  {
+    Dune::PDELab::SimpleBackend_SELL_CG_Chebyshev solver(5000,1);
+    V z(gfs,0.0);
+    V rhs(r);
+    solver.apply(sell_m,z,rhs,1e-10);
+    if (!solver.result().converged)
+      DUNE_THROW(Dune::Exception,"CG with SELL Chebyshev preconditioner did not converge");
+  }
+}
+
 //===============================================================
 // Main program with grid setup
 //===============================================================
@@ -314,6 +403,17 @@ int main(int argc, char** argv)
       poisson<GV,FEM,Dune::PDELab::ConformingDirichletConstraints,
               Dune::PDELab::SimpleSparseMatrixBackend<>
               >(gv,fem,"simplesparsebackend_yasp_Q2_2d",2);
+
+      // and with the SELL-C-sigma matrix
+      poisson<GV,FEM,Dune::PDELab::ConformingDirichletConstraints,
+              Dune::PDELab::SimpleSELLMatrixBackend<>
+              >(gv,fem,"simplesellbackend_yasp_Q2_2d",2);
+
+      // the solvers on the SELL-C-sigma matrix, using a small chunk size and sorting
+      // window to get several windows and a partially filled last chunk
+      sell_solvers<GV,FEM,Dune::PDELab::ConformingDirichletConstraints,
+                   Dune::PDELab::SimpleSELLMatrixBackend<Dune::PDELab::simple::default_vector,std::size_t,4,12>
+                   >(gv,fem,2);
     }
 
     // test passed
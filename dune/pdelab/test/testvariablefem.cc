@@ -0,0 +1,265 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+#include <dune/grid/common/scsgmapper.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/finiteelementmap/variablemonomfem.hh>
+#include <dune/pdelab/finiteelementmap/variableopbfem.hh>
+#include <dune/pdelab/finiteelementmap/variableqkdgfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/localfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/localoperator/convectiondiffusiondg.hh>
+
+// Compares the basis of the statically dispatched finite element with the
+// virtual one returned by find().
+template<typename FE, typename X>
+struct CompareBasis
+{
+  CompareBasis(const FE& fe_, const X& x_, bool& passed_)
+    : fe(fe_), x(x_), passed(passed_)
+  {}
+
+  template<typename FixedOrderFE>
+  void operator()(const FixedOrderFE& fixed_fe) const
+  {
+    typedef typename FixedOrderFE::Traits::LocalBasisType::Traits::RangeType Range;
+    std::vector<Range> phi, phi_virtual;
+    fixed_fe.localBasis().evaluateFunction(x,phi);
+    fe.localBasis().evaluateFunction(x,phi_virtual);
+
+    if (phi.size() != phi_virtual.size() ||
+        fixed_fe.localBasis().order() != fe.localBasis().order())
+      {
+        std::cerr << "dispatched finite element has the wrong order" << std::endl;
+        passed = false;
+        return;
+      }
+    for (std::size_t i = 0; i < phi.size(); ++i)
+      if ((phi[i] - phi_virtual[i]).two_norm() > 1e-12)
+        {
+          std::cerr << "basis function " << i << " differs: "
+                    << phi[i] << " != " << phi_virtual[i] << std::endl;
+          passed = false;
+        }
+  }
+
+  const FE& fe;
+  const X& x;
+  bool& passed;
+};
+
+// Finite element map that only exposes the virtual finite elements of FEM,
+// so that local function spaces cannot use its dispatch().
+template<typename FEM>
+class VirtualFEM
+{
+public:
+  typedef typename FEM::Traits Traits;
+
+  explicit VirtualFEM(const FEM& fem_)
+    : fem(fem_)
+  {}
+
+  template<typename Entity>
+  const typename Traits::FiniteElementType& find(const Entity& e) const
+  {
+    return fem.find(e);
+  }
+
+  bool fixedSize() const
+  {
+    return fem.fixedSize();
+  }
+
+  std::size_t size(Dune::GeometryType gt) const
+  {
+    return fem.size(gt);
+  }
+
+  std::size_t maxLocalSize() const
+  {
+    return fem.maxLocalSize();
+  }
+
+private:
+  const FEM& fem;
+};
+
+// Compares the DOF indices of a local function space bound through the
+// dispatch of the finite element map with the ones of the virtual interface.
+template<typename FEM, typename GV>
+bool testLocalFunctionSpace(const FEM& fem, const GV& gv)
+{
+  typedef typename GV::template Codim<0>::Iterator Iterator;
+  typedef Dune::PDELab::GridFunctionSpace<GV,FEM> GFS;
+  typedef Dune::PDELab::GridFunctionSpace<GV,VirtualFEM<FEM> > VirtualGFS;
+  GFS gfs(gv,fem);
+  VirtualFEM<FEM> virtual_fem(fem);
+  VirtualGFS virtual_gfs(gv,virtual_fem);
+  Dune::PDELab::LocalFunctionSpace<GFS> lfs(gfs);
+  Dune::PDELab::LocalFunctionSpace<VirtualGFS> virtual_lfs(virtual_gfs);
+
+  bool passed = true;
+  for (Iterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+    {
+      lfs.bind(*it);
+      virtual_lfs.bind(*it);
+      if (lfs.size() != virtual_lfs.size())
+        {
+          std::cerr << "local function space has " << lfs.size() << " instead of "
+                    << virtual_lfs.size() << " DOFs" << std::endl;
+          passed = false;
+          continue;
+        }
+      for (std::size_t i = 0; i < lfs.size(); ++i)
+        if (!(lfs.dofIndex(i) == virtual_lfs.dofIndex(i)))
+          {
+            std::cerr << "DOF index " << i << " differs: " << lfs.dofIndex(i)
+                      << " != " << virtual_lfs.dofIndex(i) << std::endl;
+            passed = false;
+          }
+    }
+  return passed;
+}
+
+// Compares the DG residual assembled with the dispatched finite elements in the
+// volume kernel with the one assembled through the virtual interface.
+template<typename FEM, typename GV>
+bool testDGResidual(const FEM& fem, const GV& gv)
+{
+  typedef Dune::PDELab::GridFunctionSpace<GV,FEM,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > GFS;
+  typedef Dune::PDELab::GridFunctionSpace<GV,VirtualFEM<FEM>,Dune::PDELab::NoConstraints,Dune::PDELab::ISTLVectorBackend<> > VirtualGFS;
+  GFS gfs(gv,fem);
+  VirtualFEM<FEM> virtual_fem(fem);
+  VirtualGFS virtual_gfs(gv,virtual_fem);
+
+  typedef Dune::PDELab::ConvectionDiffusionModelProblem<GV,double> Param;
+  Param param;
+  typedef Dune::PDELab::ConvectionDiffusionDG<Param,FEM> LOP;
+  LOP lop(param,Dune::PDELab::ConvectionDiffusionDGMethod::SIPG,Dune::PDELab::ConvectionDiffusionDGWeights::weightsOn,2.0);
+  typedef Dune::PDELab::ConvectionDiffusionDG<Param,VirtualFEM<FEM> > VirtualLOP;
+  VirtualLOP virtual_lop(param,Dune::PDELab::ConvectionDiffusionDGMethod::SIPG,Dune::PDELab::ConvectionDiffusionDGWeights::weightsOn,2.0);
+
+  typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+  MBE mbe(5);
+  typedef Dune::PDELab::GridOperator<GFS,GFS,LOP,MBE,double,double,double> GO;
+  GO go(gfs,gfs,lop,mbe);
+  typedef Dune::PDELab::GridOperator<VirtualGFS,VirtualGFS,VirtualLOP,MBE,double,double,double> VirtualGO;
+  VirtualGO virtual_go(virtual_gfs,virtual_gfs,virtual_lop,mbe);
+
+  // both spaces have the same DOF indices, see testLocalFunctionSpace()
+  typedef typename GO::Traits::Domain V;
+  typedef typename VirtualGO::Traits::Domain VirtualV;
+  V x(gfs,0.0);
+  VirtualV virtual_x(virtual_gfs,0.0);
+  std::size_t k = 0;
+  typename VirtualV::iterator vit = virtual_x.begin();
+  for (typename V::iterator it = x.begin(); it != x.end(); ++it, ++vit, ++k)
+    *it = *vit = std::sin(1.0 + k);
+
+  V r(gfs,0.0);
+  go.residual(x,r);
+  VirtualV virtual_r(virtual_gfs,0.0);
+  virtual_go.residual(virtual_x,virtual_r);
+
+  bool passed = true;
+  vit = virtual_r.begin();
+  for (typename V::iterator it = r.begin(); it != r.end(); ++it, ++vit)
+    if (std::abs(*it - *vit) > 1e-10 * (1.0 + std::abs(*vit)))
+      {
+        std::cerr << "DG residual differs: " << *it << " != " << *vit << std::endl;
+        passed = false;
+      }
+  return passed;
+}
+
+template<typename FEM, typename GV>
+bool test(FEM& fem, const GV& gv, unsigned int maxP)
+{
+  typedef typename GV::template Codim<0>::Iterator Iterator;
+  typedef typename FEM::Traits::FiniteElementType FE;
+  typedef Dune::FieldVector<double,GV::dimension> X;
+
+  // assign all orders in turn
+  unsigned int p = 0;
+  for (Iterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+    fem.setOrder(*it,p++ % (maxP+1));
+
+  X x(0.3);
+  x[0] = 0.7;
+
+  bool passed = true;
+  for (Iterator it = gv.template begin<0>(); it != gv.template end<0>(); ++it)
+    fem.dispatch(*it,CompareBasis<FE,X>(fem.find(*it),x,passed));
+
+  passed = testLocalFunctionSpace(fem,gv) && passed;
+  passed = testDGResidual(fem,gv) && passed;
+
+  // orders beyond maxP are rejected
+  try
+    {
+      fem.dispatchOrder(maxP+1,CompareBasis<FE,X>(fem.getFEM(),x,passed));
+      std::cerr << "dispatching an order > maxP did not throw" << std::endl;
+      passed = false;
+    }
+  catch (Dune::Exception&)
+    {}
+
+  return passed;
+}
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(4));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::SingleCodimSingleGeomTypeMapper<GV, 0> CellMapper;
+    CellMapper cellmapper(gv);
+
+    bool passed = true;
+
+    Dune::PDELab::VariableQkDGLocalFiniteElementMap<CellMapper,double,double,2,3> qkdgfem(cellmapper,1);
+    passed &= test(qkdgfem,gv,3);
+
+    Dune::PDELab::VariableMonomLocalFiniteElementMap<CellMapper,double,double,2,3> monomfem(cellmapper,1);
+    passed &= test(monomfem,gv,3);
+
+    Dune::PDELab::VariableOPBLocalFiniteElementMap<CellMapper,double,double,2,double,3> opbfem(cellmapper,1);
+    passed &= test(opbfem,gv,3);
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
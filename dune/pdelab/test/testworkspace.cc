@@ -0,0 +1,298 @@
+// -*- tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 2 -*-
+// vi: set et ts=4 sw=2 sts=2:
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <cstddef>
+#include <iostream>
+
+#include <dune/common/array.hh>
+#include <dune/common/exceptions.hh>
+#include <dune/common/fvector.hh>
+#include <dune/common/parallel/mpihelper.hh>
+
+#include <dune/grid/yaspgrid.hh>
+
+#include <dune/pdelab/backend/istlvectorbackend.hh>
+#include <dune/pdelab/backend/istl/bcrsmatrixbackend.hh>
+#include <dune/pdelab/backend/seqistlsolverbackend.hh>
+#include <dune/pdelab/common/workspace.hh>
+#include <dune/pdelab/constraints/noconstraints.hh>
+#include <dune/pdelab/finiteelementmap/qkdg.hh>
+#include <dune/pdelab/finiteelementmap/qkfem.hh>
+#include <dune/pdelab/gridfunctionspace/gridfunctionspace.hh>
+#include <dune/pdelab/gridfunctionspace/powergridfunctionspace.hh>
+#include <dune/pdelab/gridoperator/gridoperator.hh>
+#include <dune/pdelab/instationary/linearhyperbolicdg.hh>
+#include <dune/pdelab/instationary/onestep.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionfem.hh>
+#include <dune/pdelab/localoperator/convectiondiffusionparameter.hh>
+#include <dune/pdelab/localoperator/linearacousticsdg.hh>
+#include <dune/pdelab/newton/newton.hh>
+
+// acoustics problem with constant speed of sound and a linear source
+template<typename GV, typename RF>
+class Parameter
+{
+public:
+  typedef Dune::PDELab::LinearAcousticsParameterTraits<GV,RF> Traits;
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 1.0;
+  }
+
+  typename Traits::StateType
+  g (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x, const typename Traits::StateType& s) const
+  {
+    typename Traits::StateType u(0.0);
+    u[0] = s[0];
+    return u;
+  }
+
+  typename Traits::StateType
+  q (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::StateType rhs(0.0);
+    rhs[0] = e.geometry().global(x)[1];
+    return rhs;
+  }
+
+  void setTime (RF t)
+  {}
+};
+
+// reaction-diffusion problem with Neumann boundary and an adjustable reaction rate
+template<typename GV, typename RF>
+class ReactionParameter
+{
+  typedef Dune::PDELab::ConvectionDiffusionBoundaryConditions::Type BCType;
+
+public:
+  typedef Dune::PDELab::ConvectionDiffusionParameterTraits<GV,RF> Traits;
+
+  ReactionParameter ()
+    : rate(1.0)
+  {}
+
+  typename Traits::PermTensorType
+  A (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    typename Traits::PermTensorType I(0.0);
+    for (std::size_t i=0; i<Traits::dimDomain; i++)
+      I[i][i] = 1.0;
+    return I;
+  }
+
+  typename Traits::RangeType
+  b (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return typename Traits::RangeType(0.0);
+  }
+
+  typename Traits::RangeFieldType
+  c (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return rate;
+  }
+
+  typename Traits::RangeFieldType
+  f (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return e.geometry().global(x)[0];
+  }
+
+  BCType
+  bctype (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return Dune::PDELab::ConvectionDiffusionBoundaryConditions::Neumann;
+  }
+
+  typename Traits::RangeFieldType
+  g (const typename Traits::ElementType& e, const typename Traits::DomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  j (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+
+  typename Traits::RangeFieldType
+  o (const typename Traits::IntersectionType& is, const typename Traits::IntersectionDomainType& x) const
+  {
+    return 0.0;
+  }
+
+  RF rate;
+};
+
+int main(int argc, char** argv)
+{
+  try{
+    Dune::MPIHelper::instance(argc, argv);
+
+    typedef Dune::YaspGrid<2> Grid;
+    Dune::FieldVector<double,2> L(1.0);
+    Dune::array<int,2> N(Dune::fill_array<int,2>(8));
+    Grid grid(L,N);
+
+    typedef Grid::LeafGridView GV;
+    GV gv = grid.leafGridView();
+
+    typedef Dune::PDELab::QkDGLocalFiniteElementMap<double,double,1,2> FEM;
+    FEM fem;
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      FEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > GFS0;
+    GFS0 gfs0(gv,fem);
+    typedef Dune::PDELab::PowerGridFunctionSpace<GFS0,3,Dune::PDELab::ISTLVectorBackend<> > GFS;
+    GFS gfs(gfs0);
+
+    typedef Dune::PDELab::BackendVectorSelector<GFS,double>::Type V;
+
+    bool passed = true;
+
+    // containers are created once per slot and function space
+    {
+      typedef Dune::PDELab::Workspace<V> WS;
+      WS ws;
+      V& a = ws.get(0,gfs,gfs.revision());
+      a = 1.0;
+      V& b = ws.get(1,gfs,gfs.revision());
+      if (&ws.get(0,gfs,gfs.revision()) != &a || &b == &a || ws.allocations() != 2)
+        {
+          std::cerr << "workspace did not reuse its vectors" << std::endl;
+          passed = false;
+        }
+      GFS other(gfs0);
+      ws.get(0,other,other.revision());
+      if (ws.allocations() != 3)
+        {
+          std::cerr << "workspace kept vectors of another function space" << std::endl;
+          passed = false;
+        }
+    }
+
+    // the explicit scheme keeps its stage and residual vectors between steps
+    typedef Parameter<GV,double> Param;
+    Param param;
+    typedef Dune::PDELab::LinearAcousticsSystem<Param> System;
+    System system(param);
+    typedef Dune::PDELab::LinearHyperbolicDGOperator<GFS,System> IGOS;
+    IGOS igos(gfs,system);
+    Dune::PDELab::LinearHyperbolicDGMassSolver ls;
+    Dune::PDELab::RK4Parameter<double> method;
+    typedef Dune::PDELab::ExplicitOneStepMethod<double,IGOS,Dune::PDELab::LinearHyperbolicDGMassSolver,V> OSM;
+    OSM osm(method,igos,ls);
+    osm.setVerbosityLevel(0);
+
+    V x0(gfs,1.0), x1(gfs,0.0), x2(gfs,0.0);
+    const double dt = 0.01;
+    osm.apply(0.0,dt,x0,x1);
+    osm.apply(dt,dt,x1,x2);
+    if (osm.stageWorkspace().allocations() != method.s()-1 || osm.residualWorkspace().allocations() != 2)
+      {
+        std::cerr << "time stepper allocated " << osm.stageWorkspace().allocations() << " stage and "
+                  << osm.residualWorkspace().allocations() << " residual vectors in two steps" << std::endl;
+        passed = false;
+      }
+
+    // the reused vectors give the same result as fresh ones
+    OSM fresh(method,igos,ls);
+    fresh.setVerbosityLevel(0);
+    V y2(gfs,0.0);
+    fresh.apply(dt,dt,x1,y2);
+    y2 -= x2;
+    if (y2.two_norm() > 1e-14 * x2.two_norm())
+      {
+        std::cerr << "step with reused vectors differs by " << y2.two_norm() << std::endl;
+        passed = false;
+      }
+
+    // Newton keeps its matrix between solves, but not the jacobian in it
+    typedef Dune::PDELab::QkLocalFiniteElementMap<GV,double,double,1> CGFEM;
+    CGFEM cgfem(gv);
+    typedef Dune::PDELab::GridFunctionSpace<
+      GV,
+      CGFEM,
+      Dune::PDELab::NoConstraints,
+      Dune::PDELab::ISTLVectorBackend<>
+      > CGFS;
+    CGFS cgfs(gv,cgfem);
+    typedef ReactionParameter<GV,double> RParam;
+    RParam rparam;
+    typedef Dune::PDELab::ConvectionDiffusionFEM<RParam,CGFEM> LOP;
+    LOP lop(rparam);
+    typedef Dune::PDELab::istl::BCRSMatrixBackend<> MBE;
+    MBE mbe(9);
+    typedef Dune::PDELab::GridOperator<CGFS,CGFS,LOP,MBE,double,double,double> GO;
+    GO go(cgfs,cgfs,lop,mbe);
+    typedef GO::Traits::Domain U;
+    typedef Dune::PDELab::ISTLBackend_SEQ_BCGS_SSOR LS;
+    LS ls(5000,0);
+    typedef Dune::PDELab::Newton<GO,LS,U,U> Newton;
+
+    // the threshold never triggers a reassembly, so a stale jacobian would change the iterations
+    Newton newton(go,ls);
+    newton.setVerbosityLevel(0);
+    newton.setReassembleThreshold(2.0);
+    newton.setReduction(1e-10);
+    U u(cgfs,0.0);
+    newton.apply(u);
+    rparam.rate = 10.0;
+    U v(cgfs,0.0);
+    newton.apply(v);
+
+    Newton reference(go,ls);
+    reference.setVerbosityLevel(0);
+    reference.setReassembleThreshold(2.0);
+    reference.setReduction(1e-10);
+    U w(cgfs,0.0);
+    reference.apply(w);
+    const unsigned int iterations = newton.result().iterations;
+    v -= w;
+    if (iterations != reference.result().iterations || v.two_norm() > 1e-8 * w.two_norm())
+      {
+        std::cerr << "second Newton solve took " << iterations << " instead of "
+                  << reference.result().iterations << " iterations and differs by "
+                  << v.two_norm() << std::endl;
+        passed = false;
+      }
+    if (newton.matrixWorkspace().allocations() != 1)
+      {
+        std::cerr << "Newton allocated " << newton.matrixWorkspace().allocations()
+                  << " matrices in two solves" << std::endl;
+        passed = false;
+      }
+
+    // an update of the space may change the pattern without changing the number of DOFs
+    cgfs.update();
+    U x(cgfs,0.0);
+    newton.apply(x);
+    x -= w;
+    if (newton.matrixWorkspace().allocations() != 2 || x.two_norm() > 1e-8 * w.two_norm())
+      {
+        std::cerr << "Newton kept its matrix after an update of the function space" << std::endl;
+        passed = false;
+      }
+
+    return passed ? 0 : 1;
+  }
+  catch (Dune::Exception &e){
+    std::cerr << "Dune reported error: " << e << std::endl;
+    return 1;
+  }
+  catch (...){
+    std::cerr << "Unknown exception thrown!" << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,42 @@
+dnl DUNE_PDELAB_OPENMP
+dnl ------------------------------------------------------
+dnl Check for the flags needed to compile with OpenMP.
+dnl
+dnl shell variables:
+dnl   HAVE_OPENMP
+dnl     "yes" or "no"
+dnl
+dnl Makefile variables:
+dnl   OPENMP_CXXFLAGS
+dnl     the compiler (and linker) flag enabling OpenMP, set by AC_OPENMP
+dnl
+dnl automake conditionals:
+dnl   OPENMP
+dnl
+dnl OpenMP is only used for all code if --enable-pdelab-openmp is given. Otherwise
+dnl the flags are only added to the programs that explicitly use OPENMP_CXXFLAGS.
+AC_DEFUN([DUNE_PDELAB_OPENMP], [
+  AC_LANG_PUSH([C++])
+  AC_OPENMP
+  AC_LANG_POP([C++])
+
+  AC_ARG_ENABLE([pdelab-openmp],
+    AS_HELP_STRING([--enable-pdelab-openmp],
+      [compile with OpenMP, which parallelizes the BLAS-1 kernels of the vector backends]),
+    [], [enable_pdelab_openmp=no])
+
+  AS_IF([test "x$enable_openmp" != xno &&
+         test "x$ac_cv_prog_cxx_openmp" != x &&
+         test "x$ac_cv_prog_cxx_openmp" != xunsupported],
+    [HAVE_OPENMP=yes],
+    [HAVE_OPENMP=no])
+
+  AS_IF([test x$HAVE_OPENMP = xyes && test x$enable_pdelab_openmp = xyes],
+    [DUNE_ADD_ALL_PKG([OPENMP], [\${OPENMP_CXXFLAGS}], [\${OPENMP_CXXFLAGS}], [])])
+
+  # add automake conditional
+  AM_CONDITIONAL(OPENMP, test x$HAVE_OPENMP = xyes)
+
+  # print summary
+  DUNE_ADD_SUMMARY_ENTRY([OpenMP],["$HAVE_OPENMP"])
+])